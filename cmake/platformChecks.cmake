@@ -44,5 +44,11 @@ CHECK_INCLUDE_FILE("strings.h" SCP_HAVE_STRINGS_H)
 check_symbol_exists(snprintf "stdio.h" SCP_HAVE_SNPRINTF)
 check_symbol_exists(_snprintf "stdio.h" SCP_HAVE__SNPRINTF)
 
+# batched datagram I/O (Linux)
+set(CMAKE_REQUIRED_DEFINITIONS -D_GNU_SOURCE)
+check_symbol_exists(recvmmsg "sys/socket.h" SCP_HAVE_RECVMMSG)
+check_symbol_exists(sendmmsg "sys/socket.h" SCP_HAVE_SENDMMSG)
+set(CMAKE_REQUIRED_DEFINITIONS)
+
 set(PLATFORM_CHECK_HEADER "${GENERATED_SOURCE_DIR}/platformChecks.h")
 CONFIGURE_FILE(${CMAKE_CURRENT_LIST_DIR}/platformChecks.h.in "${PLATFORM_CHECK_HEADER}")
@@ -1761,11 +1761,11 @@ int ai_big_maybe_enter_strafe_mode(const object *pl_objp, int weapon_objnum)
 		return 0;
 	}
 
-	Assert(weapon_objnum >= 0 && weapon_objnum < MAX_OBJECTS);
+	Assert(weapon_objnum >= 0 && weapon_objnum < objects_size());
 	weapon_objp = &Objects[weapon_objnum];
 	Assert(weapon_objp->type == OBJ_WEAPON);
 
-	Assert(weapon_objp->parent >= 0 && weapon_objp->parent < MAX_OBJECTS);
+	Assert(weapon_objp->parent >= 0 && weapon_objp->parent < objects_size());
 	parent_objp = &Objects[weapon_objp->parent];
 	if ( (parent_objp->signature != weapon_objp->parent_sig) || (parent_objp->type != OBJ_SHIP) ) {
 		return 0;
@@ -1826,7 +1826,7 @@ void ai_big_strafe_maybe_attack_turret(const object *ship_objp, const object *we
 		return;
 	}
 
-	Assert(weapon_objp->parent >= 0 && weapon_objp->parent < MAX_OBJECTS);
+	Assert(weapon_objp->parent >= 0 && weapon_objp->parent < objects_size());
 	parent_objp = &Objects[weapon_objp->parent];
 	
 	// UnknownPlayer : Decide whether or not this weapon was a beam, in which case it might be a good
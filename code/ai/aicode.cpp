@@ -53,6 +53,7 @@
 #include "object/object.h"
 #include "object/objectdock.h"
 #include "object/objectshield.h"
+#include "object/objectsnapshot.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
 #include "physics/physics.h"
@@ -401,7 +402,7 @@ void ai_init_secondary_info()
  *	Compresses Path_points buffer, updating aip->path_start and aip->path_cur indices.
  *	Updates Ppfp to point to first free record.
  *	This function is fairly fast.  Its worst-case running time is proportional to
- *	3*MAX_PATH_POINTS + MAX_OBJECTS
+ *	3*MAX_PATH_POINTS + objects_size()
  *
  * @todo Things to do to optimize this function:
  *		1. if (t != 0) xlt++; can be replaced by xlt += t; assuming t can only be 0 or 1.
@@ -1745,7 +1746,7 @@ float get_wing_lowest_max_speed(object *objp)
 	ship_obj	*so;
 
 	Assert(objp->type == OBJ_SHIP);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < objects_size()));
 	shipp = &Ships[objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
 	aip = &Ai_info[shipp->ai_index];
@@ -1797,7 +1798,7 @@ float get_wing_lowest_av_ab_speed(object *objp)
 	ship_info *sip;
 
 	Assert(objp->type == OBJ_SHIP);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < objects_size()));
 	shipp = &Ships[objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
 	aip = &Ai_info[shipp->ai_index];
@@ -3015,7 +3016,7 @@ void ai_stay_still(object *still_objp, vec3d *view_pos)
 	ai_info	*aip;
 
 	Assert(still_objp->type == OBJ_SHIP);
-	Assert((still_objp->instance >= 0) && (still_objp->instance < MAX_OBJECTS));
+	Assert((still_objp->instance >= 0) && (still_objp->instance < objects_size()));
 
 	shipp = &Ships[still_objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
@@ -3797,7 +3798,7 @@ float ai_path_0()
 	gobjp = &Objects[aip->goal_objnum];
 
 	if (aip->path_start == -1) {
-		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < MAX_OBJECTS);
+		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < objects_size());
 		int path_num;
 		Assert(aip->active_goal >= 0);
 		ai_goal *aigp = &aip->goals[aip->active_goal];
@@ -3940,7 +3941,7 @@ float ai_path_1()
 	gobjp = &Objects[aip->goal_objnum];
 
 	if (aip->path_start == -1) {
-		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < MAX_OBJECTS);
+		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < objects_size());
 		int path_num;
 		Assert(aip->active_goal >= 0);
 		ai_goal *aigp = &aip->goals[aip->active_goal];
@@ -5513,12 +5514,13 @@ void set_primary_weapon_linkage(object *objp)
 
 	shipp = &Ships[objp->instance];
 
-	if (Num_weapons > (int) (MAX_WEAPONS * 0.75f)) {
+	// the weapons pool grows when it is full, so this is relative to its current size
+	if (Num_weapons > (int) (weapons_size() * 0.75f)) {
 		if (shipp->flags[Ship::Ship_Flags::Primary_linked]) {
 			nprintf(("AI", "Frame %i, ship %s: Unlinking primaries.\n", Framecount, shipp->ship_name));
 			shipp->flags.remove(Ship::Ship_Flags::Primary_linked);
 		}
-		return;		//	If low on slots, don't link.
+		return;		//	If there are lots of weapons in flight already, don't link.
 	}
 
 	sip = &Ship_info[shipp->ship_info_index];
@@ -5646,8 +5648,8 @@ int ai_fire_primary_weapon(object *objp)
 
 	aip = &Ai_info[shipp->ai_index];
 
-	//	If low on slots, fire a little less often.
-	if (Num_weapons > (int) (0.9f * MAX_WEAPONS)) {
+	//	If there are lots of weapons in flight already, fire a little less often.
+	if (Num_weapons > (int) (0.9f * weapons_size())) {
 		if (frand() > 0.5f) {
 			nprintf(("AI", "Frame %i, %s not fire.\n", Framecount, shipp->ship_name));
 			return 0;
@@ -7495,7 +7497,7 @@ void ai_set_guard_wing(object *objp, int wingnum)
 		leader_shipnum = Wings[wingnum].ship_index[0];
 		leader_objnum = Ships[leader_shipnum].objnum;
 
-		Assert((leader_objnum >= 0) && (leader_objnum < MAX_OBJECTS));
+		Assert((leader_objnum >= 0) && (leader_objnum < objects_size()));
 		
 		if (leader_objnum == OBJ_INDEX(objp)) {
 			return;
@@ -9644,7 +9646,7 @@ int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 	weapon_info	*wip;
 
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < objects_size());
 		bomb_objp = &Objects[mo->objnum];
 
 		wp = &Weapons[bomb_objp->instance];
@@ -9731,25 +9733,37 @@ void ai_guard_find_nearby_asteroid(object *guarding_objp, object *guarded_objp)
 
 	object	*closest_asteroid_objp=NULL, *danger_asteroid_objp=NULL, *asteroid_objp;
 	float		dist_to_self, closest_danger_asteroid_dist=999999.0f, closest_asteroid_dist=999999.0f;
+	float		guard_dist = (MAX_GUARD_DIST + guarded_objp->radius)*2;
 
-	for ( asteroid_objp = GET_FIRST(&obj_used_list); asteroid_objp != END_OF_LIST(&obj_used_list); asteroid_objp = GET_NEXT(asteroid_objp) ) {
-		if ( asteroid_objp->type == OBJ_ASTEROID ) {
-			// Attack asteroid if near guarded ship
-			dist = vm_vec_dist_quick(&asteroid_objp->pos, &guarded_objp->pos);
-			if ( dist < (MAX_GUARD_DIST + guarded_objp->radius)*2) {
-				dist_to_self = vm_vec_dist_quick(&asteroid_objp->pos, &guarding_objp->pos);
-				if ( OBJ_INDEX(guarded_objp) == asteroid_collide_objnum(asteroid_objp) ) {
-					if( dist_to_self < closest_danger_asteroid_dist ) {
-						danger_asteroid_objp=asteroid_objp;
-						closest_danger_asteroid_dist=dist_to_self;
-					}
-				} 
-				if ( dist_to_self < closest_asteroid_dist ) {
-					// only attack if moving slower than own max speed
-					if ( vm_vec_mag_quick(&asteroid_objp->phys_info.vel) < guarding_objp->phys_info.max_vel.xyz.z ) {
-						closest_asteroid_dist = dist_to_self;
-						closest_asteroid_objp = asteroid_objp;
-					}
+	// only look at what's near the guarded ship instead of every object in the mission; the snapshot is from the last
+	// frame, so leave some room for vm_vec_dist_quick() and for what moved since then
+	const auto& snapshot = obj_snapshot();
+	static SCP_vector<int> nearby;
+	nearby.clear();
+	snapshot.query_sphere(guarded_objp->pos, guard_dist * 1.25f, nearby);
+
+	for ( auto i : nearby ) {
+		if ( snapshot.type(i) != OBJ_ASTEROID || !snapshot.valid(i) ) {
+			continue;
+		}
+
+		asteroid_objp = &Objects[snapshot.objnum(i)];
+
+		// Attack asteroid if near guarded ship
+		dist = vm_vec_dist_quick(&asteroid_objp->pos, &guarded_objp->pos);
+		if ( dist < guard_dist) {
+			dist_to_self = vm_vec_dist_quick(&asteroid_objp->pos, &guarding_objp->pos);
+			if ( OBJ_INDEX(guarded_objp) == asteroid_collide_objnum(asteroid_objp) ) {
+				if( dist_to_self < closest_danger_asteroid_dist ) {
+					danger_asteroid_objp=asteroid_objp;
+					closest_danger_asteroid_dist=dist_to_self;
+				}
+			} 
+			if ( dist_to_self < closest_asteroid_dist ) {
+				// only attack if moving slower than own max speed
+				if ( vm_vec_mag_quick(&asteroid_objp->phys_info.vel) < guarding_objp->phys_info.max_vel.xyz.z ) {
+					closest_asteroid_dist = dist_to_self;
+					closest_asteroid_objp = asteroid_objp;
 				}
 			}
 		}
@@ -10554,7 +10568,7 @@ void ai_still()
 	ai_info	*aip;
 
 	Assert(Pl_objp->type == OBJ_SHIP);
-	Assert((Pl_objp->instance >= 0) && (Pl_objp->instance < MAX_OBJECTS));
+	Assert((Pl_objp->instance >= 0) && (Pl_objp->instance < objects_size()));
 
 	shipp = &Ships[Pl_objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
@@ -10881,7 +10895,7 @@ void ai_dock()
 	{
 		//	This mode is only for rearming/repairing.
 		//	The ship that is performing the rearm enters this mode after it docks.
-		Assert((aip->goal_objnum >= -1) && (aip->goal_objnum < MAX_OBJECTS));
+		Assert((aip->goal_objnum >= -1) && (aip->goal_objnum < objects_size()));
 
 		float dist = dock_orient_and_approach(Pl_objp, docker_index, goal_objp, dockee_index, DOA_DOCK);
 		Assert(dist != UNINITIALIZED_VALUE);
@@ -11183,7 +11197,7 @@ void process_subobjects(int objnum)
 				if(enemies_present == -1)
 				{
 					enemies_present = 0;
-					for(unsigned int i = 0; i < MAX_OBJECTS; i++)
+					for(int i = 0; i < objects_size(); i++)
 					{
 						objp = &Objects[i];
 						switch(objp->type)
@@ -11410,7 +11424,7 @@ float get_wing_largest_radius(object *objp, int formation_object_flag)
 	ai_info	*aip;
 
 	Assert(objp->type == OBJ_SHIP);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < objects_size()));
 	shipp = &Ships[objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
 	aip = &Ai_info[shipp->ai_index];
@@ -11646,7 +11660,7 @@ int ai_formation()
 	//	Determine which kind of formation flying.
 	//	If tracking an object, not in waypoint mode:
 	if (aip->ai_flags[AI::AI_Flags::Formation_object]) {
-		if ((aip->goal_objnum < 0) || (aip->goal_objnum >= MAX_OBJECTS) || (aip->mode == AIM_BAY_DEPART)) {
+		if ((aip->goal_objnum < 0) || (aip->goal_objnum >= objects_size()) || (aip->mode == AIM_BAY_DEPART)) {
 			aip->ai_flags.remove(AI::AI_Flags::Formation_object);
 			return 1;
 		}
@@ -13402,11 +13416,11 @@ static int ai_find_shockwave_weapon(const object *objp)
 		weapon		*wp;
 		weapon_info	*wip;
 	
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < objects_size());
 		A = &Objects[mo->objnum];
 
 		Assert(A->type == OBJ_WEAPON);
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < weapons_size()));
 		wp = &Weapons[A->instance];
 		wip = &Weapon_info[wp->weapon_info_index];
 		Assert( wip->subtype == WP_MISSILE );
@@ -13467,7 +13481,7 @@ static int ai_find_shockwave_ship(object *objp)
 		object		*A;
 		ship			*shipp;
 	
-		Assert(so->objnum >= 0 && so->objnum < MAX_OBJECTS);
+		Assert(so->objnum >= 0 && so->objnum < objects_size());
 		A = &Objects[so->objnum];
 
 		Assert(A->type == OBJ_SHIP);
@@ -14878,7 +14892,7 @@ void ai_ship_hit(object *objp_ship, object *hit_objp, vec3d *hit_normal)
 		// Added OBJ_BEAM for traitor detection - FUBAR
 		if ((hit_objp->type == OBJ_WEAPON) || (hit_objp->type == OBJ_BEAM)) {
 			hitter_objnum = hit_objp->parent;
-			Assert((hitter_objnum < MAX_OBJECTS));
+			Assert((hitter_objnum < objects_size()));
 			if (hitter_objnum == -1) {
 				return; // Possible SSM, bail while we still can.
 			}
@@ -14919,7 +14933,7 @@ void ai_ship_hit(object *objp_ship, object *hit_objp, vec3d *hit_normal)
 		}
 		
 		hitter_objnum = hit_objp->parent;
-		Assert((hitter_objnum >= 0) && (hitter_objnum < MAX_OBJECTS));
+		Assert((hitter_objnum >= 0) && (hitter_objnum < objects_size()));
 		objp_hitter = &Objects[hitter_objnum];
 
 		// lets not check hits by ghosts any further either
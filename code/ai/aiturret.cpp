@@ -2241,7 +2241,7 @@ void ai_fire_from_turret(ship *shipp, ship_subsys *ss, int parent_objnum)
 		}
 	}
 
-	Assert((parent_objnum >= 0) && (parent_objnum < MAX_OBJECTS));
+	Assert((parent_objnum >= 0) && (parent_objnum < objects_size()));
 	objp = &Objects[parent_objnum];
 	Assert(objp->type == OBJ_SHIP);
 	Assert( shipp->objnum == parent_objnum );
@@ -2249,7 +2249,7 @@ void ai_fire_from_turret(ship *shipp, ship_subsys *ss, int parent_objnum)
 	// Monitor number of calls to ai_fire_from_turret
 	Num_ai_firing++;
 
-	if ( (ss->turret_enemy_objnum < 0 || ss->turret_enemy_objnum >= MAX_OBJECTS) || (ss->turret_enemy_sig != Objects[ss->turret_enemy_objnum].signature))
+	if ( (ss->turret_enemy_objnum < 0 || ss->turret_enemy_objnum >= objects_size()) || (ss->turret_enemy_sig != Objects[ss->turret_enemy_objnum].signature))
 	{
 		ss->turret_enemy_objnum = -1;
 		lep = NULL;
@@ -326,7 +326,7 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
     
     objnum = obj_create(OBJ_ASTEROID, -1, n, &orient, &pos, radius, asteroid_default_flagset);
 	
-	if ( (objnum == -1) || (objnum >= MAX_OBJECTS) ) {
+	if ( (objnum == -1) || (objnum >= objects_size()) ) {
 		mprintf(("Couldn't create asteroid -- out of object slots\n"));
 		return NULL;
 	}
@@ -1405,7 +1405,7 @@ void asteroid_level_close()
 	for (i=0; i<MAX_ASTEROIDS; i++) {
 		if (Asteroids[i].flags & AF_USED) {
 			Asteroids[i].flags &= ~AF_USED;
-			Assert(Asteroids[i].objnum >=0 && Asteroids[i].objnum < MAX_OBJECTS);
+			Assert(Asteroids[i].objnum >=0 && Asteroids[i].objnum < objects_size());
 			Objects[Asteroids[i].objnum].flags.set(Object::Object_Flags::Should_be_dead);
 		}
 	}
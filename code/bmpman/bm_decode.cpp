@@ -0,0 +1,399 @@
+
+#define BMPMAN_INTERNAL
+
+#include "bmpman/bm_decode.h"
+#include "bmpman/bm_internal.h"
+#include "cfile/cfile.h"
+#include "jpgutils/jpgutils.h"
+#include "pngutils/pngutils.h"
+#include "tgautils/tgautils.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// upper limit on the worker threads, decoding is mostly limited by memory bandwidth after that
+#define BM_DECODE_MAX_THREADS		4
+
+enum class decode_state {
+	Queued,		// waiting for a worker
+	Running,	// being decoded
+	Done		// data and bpp are valid
+};
+
+typedef struct bm_decode_job {
+	int handle;
+	char filename[MAX_FILENAME_LEN];	// image which gets decoded, this is the frame filename for EFFs
+	BM_TYPE type;
+	int dest_size;						// bytes per pixel in the decoded data
+	size_t size;						// size of the decoded data
+
+	SCP_vector<ubyte> file_data;		// the image file, read by the thread which queued it
+	CFILE *cfp;							// memory file reading from file_data
+
+	decode_state state;
+	ubyte *data;						// decoded pixels, nullptr if the decode failed
+	int bpp;
+} bm_decode_job;
+
+static SCP_vector<std::thread> Decode_threads;
+static std::mutex Decode_mutex;
+static std::condition_variable Decode_work_cv;		// signalled when a job is queued or on shutdown
+static std::condition_variable Decode_done_cv;		// signalled when a job is done
+static SCP_deque<bm_decode_job*> Decode_queue;		// jobs waiting for a worker
+static bool Decode_shutdown = false;
+
+// every job which hasn't been taken, only touched by the thread which owns bmpman
+static SCP_unordered_map<int, std::unique_ptr<bm_decode_job>> Decode_jobs;
+
+/**
+ * Works out what bm_lock_*() would decode for a bitmap
+ *
+ * @returns false if the bitmap can't be decoded in the background
+ */
+static bool bm_decode_get_info(bitmap_entry *be, BM_TYPE *type, const char **filename, int *dest_size, size_t *size)
+{
+	// the texture cache hands out a DDS instead
+	if (be->cache_filename[0] != '\0') {
+		return false;
+	}
+
+	BM_TYPE c_type = (be->type == BM_TYPE_EFF) ? be->info.ani.eff.type : be->type;
+	size_t num_pixels = (size_t)be->bm.w * be->bm.h;
+
+	switch (c_type) {
+	case BM_TYPE_PNG:
+		// APNG frames are composed on top of each other, so they have to be decoded in order
+		if ( (be->type == BM_TYPE_PNG) && be->info.ani.apng.is_apng ) {
+			return false;
+		}
+
+		// same as bm_lock_png()
+		*dest_size = 4;
+		*size = num_pixels * 4;
+		break;
+
+	case BM_TYPE_JPG:
+		// same as bm_lock_jpg()
+		*dest_size = 3;
+		*size = be->mem_taken;
+		break;
+
+	case BM_TYPE_TGA:
+		// 16-bit targas are converted with bm_set_components(), which depends on the current screen format
+		if ( (be->bm.true_bpp != 24) && (be->bm.true_bpp != 32) ) {
+			return false;
+		}
+
+		// same as bm_lock_tga()
+		*dest_size = be->bm.true_bpp >> 3;
+		*size = num_pixels * *dest_size;
+		break;
+
+	default:
+		return false;
+	}
+
+	*type = c_type;
+	*filename = (be->type == BM_TYPE_EFF) ? be->info.ani.eff.filename : be->filename;
+
+	return (*size > 0);
+}
+
+static void bm_decode_run(bm_decode_job *job)
+{
+	ubyte *data = (ubyte*)vm_malloc(job->size);
+	int bpp = job->dest_size * 8;
+	bool ok = false;
+
+	memset(data, 0, job->size);
+
+	switch (job->type) {
+	case BM_TYPE_PNG:
+		ok = (png_read_bitmap(job->filename, data, &bpp, job->dest_size, CF_TYPE_ANY, job->cfp) == PNG_ERROR_NONE);
+		break;
+
+	case BM_TYPE_JPG:
+		ok = (jpeg_read_bitmap(job->filename, data, nullptr, job->dest_size, CF_TYPE_ANY, job->cfp) == JPEG_ERROR_NONE);
+		break;
+
+	case BM_TYPE_TGA:
+		ok = (targa_read_bitmap(job->filename, data, nullptr, job->dest_size, CF_TYPE_ANY, job->cfp) == TARGA_ERROR_NONE);
+		break;
+
+	default:
+		break;
+	}
+
+	if ( !ok ) {
+		vm_free(data);
+		data = nullptr;
+	}
+
+	job->data = data;
+	job->bpp = bpp;
+}
+
+static void bm_decode_thread()
+{
+	std::unique_lock<std::mutex> lock(Decode_mutex);
+
+	while (true) {
+		Decode_work_cv.wait(lock, []() { return Decode_shutdown || !Decode_queue.empty(); });
+
+		if (Decode_shutdown) {
+			return;
+		}
+
+		auto job = Decode_queue.front();
+		Decode_queue.pop_front();
+		job->state = decode_state::Running;
+
+		lock.unlock();
+		bm_decode_run(job);
+		lock.lock();
+
+		job->state = decode_state::Done;
+		Decode_done_cv.notify_all();
+	}
+}
+
+// makes sure a job is done. if no worker got to it yet it's either decoded right here or, if the result isn't wanted
+// anymore, simply dropped
+static void bm_decode_finish(bm_decode_job *job, bool decode)
+{
+	std::unique_lock<std::mutex> lock(Decode_mutex);
+
+	if (job->state == decode_state::Queued) {
+		Decode_queue.erase(std::find(Decode_queue.begin(), Decode_queue.end(), job));
+
+		if (decode) {
+			job->state = decode_state::Running;
+
+			lock.unlock();
+			bm_decode_run(job);
+			lock.lock();
+		}
+
+		job->state = decode_state::Done;
+	} else {
+		Decode_done_cv.wait(lock, [job]() { return job->state == decode_state::Done; });
+	}
+}
+
+// frees everything a job holds on to, which must be done
+static void bm_decode_free(bm_decode_job *job)
+{
+	Assert(job->state == decode_state::Done);
+
+	cfclose(job->cfp);
+	job->cfp = nullptr;
+
+	if (job->data != nullptr) {
+		vm_free(job->data);
+		job->data = nullptr;
+	}
+}
+
+void bm_decode_init()
+{
+	Assertion(Decode_threads.empty(), "Image decoder cannot be initialized more than once!");
+
+	int num_threads = (int)std::thread::hardware_concurrency() - 1;
+	CLAMP(num_threads, 1, BM_DECODE_MAX_THREADS);
+
+	Decode_shutdown = false;
+
+	for (int i = 0; i < num_threads; i++) {
+		Decode_threads.emplace_back(bm_decode_thread);
+	}
+
+	mprintf(("BmpMan: Decoding images on %d worker threads\n", num_threads));
+}
+
+void bm_decode_close()
+{
+	if (Decode_threads.empty()) {
+		return;
+	}
+
+	bm_decode_flush();
+
+	{
+		std::lock_guard<std::mutex> lock(Decode_mutex);
+		Decode_shutdown = true;
+	}
+	Decode_work_cv.notify_all();
+
+	for (auto& thread : Decode_threads) {
+		thread.join();
+	}
+	Decode_threads.clear();
+}
+
+bool bm_decode_queue(int handle)
+{
+	if (Decode_threads.empty()) {
+		return true;
+	}
+
+	if (Decode_jobs.find(handle) != Decode_jobs.end()) {
+		return true;
+	}
+
+	if ((int)Decode_jobs.size() >= BM_DECODE_MAX_JOBS) {
+		return false;
+	}
+
+	auto be = bm_get_entry(handle);
+
+	if ( (be->type == BM_TYPE_NONE) || (be->bm.data != 0) ) {
+		return true;
+	}
+
+	BM_TYPE type;
+	const char *filename;
+	int dest_size;
+	size_t size;
+
+	if ( !bm_decode_get_info(be, &type, &filename, &dest_size, &size) ) {
+		return true;
+	}
+
+	std::unique_ptr<bm_decode_job> job(new bm_decode_job());
+
+	job->handle = handle;
+	job->type = type;
+	job->dest_size = dest_size;
+	job->size = size;
+	job->state = decode_state::Queued;
+	job->data = nullptr;
+	job->bpp = 0;
+
+	strcpy_s(job->filename, filename);
+
+	// same name mangling as the decoders themselves
+	char real_filename[MAX_FILENAME_LEN];
+	strcpy_s(real_filename, filename);
+
+	char *p = strchr(real_filename, '.');
+	if (p) *p = 0;
+
+	strcat_s(real_filename, (type == BM_TYPE_PNG) ? ".png" : ((type == BM_TYPE_JPG) ? ".jpg" : ".tga"));
+
+	CFILE *cfp = cfopen(real_filename, "rb", CFILE_NORMAL, be->dir_type);
+
+	if (cfp == nullptr) {
+		return true;
+	}
+
+	int len = cfilelength(cfp);
+
+	if (len > 0) {
+		job->file_data.resize((size_t)len);
+		len = cfread(job->file_data.data(), 1, len, cfp);
+	}
+
+	cfclose(cfp);
+
+	if ( (len <= 0) || ((size_t)len != job->file_data.size()) ) {
+		return true;
+	}
+
+	job->cfp = cfopen_special(real_filename, "rb", job->file_data.size(), 0, job->file_data.data(), be->dir_type);
+
+	if (job->cfp == nullptr) {
+		return true;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Decode_mutex);
+		Decode_queue.push_back(job.get());
+	}
+	Decode_work_cv.notify_one();
+
+	Decode_jobs.emplace(handle, std::move(job));
+
+	return true;
+}
+
+void bm_decode_queue_frames(int handle, int num_frames)
+{
+	auto be = bm_get_entry(handle);
+
+	if (be->type != BM_TYPE_EFF) {
+		return;
+	}
+
+	int first_frame = be->info.ani.first_frame;
+	int last_frame = first_frame + bm_get_entry(first_frame)->info.ani.num_frames - 1;
+
+	for (int frame = handle + 1; (frame <= handle + num_frames) && (frame <= last_frame); frame++) {
+		if ( !bm_decode_queue(frame) ) {
+			break;
+		}
+	}
+}
+
+ubyte *bm_decode_take(int handle, size_t size, int *bpp)
+{
+	auto it = Decode_jobs.find(handle);
+
+	if (it == Decode_jobs.end()) {
+		return nullptr;
+	}
+
+	std::unique_ptr<bm_decode_job> job = std::move(it->second);
+	Decode_jobs.erase(it);
+
+	bm_decode_finish(job.get(), true);
+
+	// make sure the slot still holds the image this was queued for
+	auto be = bm_get_entry(handle);
+	BM_TYPE type;
+	const char *filename;
+	int dest_size;
+	size_t cur_size;
+
+	bool valid = (be->type != BM_TYPE_NONE) && bm_decode_get_info(be, &type, &filename, &dest_size, &cur_size)
+		&& (type == job->type) && (cur_size == job->size) && (size == job->size) && !stricmp(filename, job->filename);
+
+	ubyte *data = nullptr;
+
+	if (valid && (job->data != nullptr)) {
+		data = job->data;
+		*bpp = job->bpp;
+
+		job->data = nullptr;
+	}
+
+	bm_decode_free(job.get());
+
+	return data;
+}
+
+void bm_decode_discard(int handle)
+{
+	auto it = Decode_jobs.find(handle);
+
+	if (it == Decode_jobs.end()) {
+		return;
+	}
+
+	bm_decode_finish(it->second.get(), false);
+	bm_decode_free(it->second.get());
+
+	Decode_jobs.erase(it);
+}
+
+void bm_decode_flush()
+{
+	for (auto& entry : Decode_jobs) {
+		bm_decode_finish(entry.second.get(), false);
+		bm_decode_free(entry.second.get());
+	}
+
+	Decode_jobs.clear();
+}
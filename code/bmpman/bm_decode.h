@@ -0,0 +1,79 @@
+#ifndef __BM_DECODE_H__
+#define __BM_DECODE_H__
+
+/**
+ * @file bm_decode.h
+ * Decodes PNG, JPG and TGA images for bmpman on a pool of worker threads.
+ *
+ * @details cfile isn't thread safe, so a queued image is read into memory on the calling thread and only the
+ * decompression (libpng, libjpeg, targa RLE) happens on a worker. The bm_lock_* functions pick the decoded pixels up
+ * through bm_decode_take() instead of decoding the file themselves, waiting for the worker if it isn't done yet.
+ *
+ * Only images which decode the same way regardless of the screen/texture format are queued, which rules out APNGs
+ * (each frame is composed on top of the last) and 16-bit targas. Those are still decoded by bm_lock().
+ */
+
+#include "globalincs/pstypes.h"
+
+/**
+ * @brief How many decodes can be queued or running at once. Each one holds a cfile block until it's taken
+ */
+const int BM_DECODE_MAX_JOBS = 16;
+
+/**
+ * @brief How many frames of an EFF animation are decoded ahead of the one being locked
+ */
+const int BM_DECODE_PREFETCH_FRAMES = 4;
+
+/**
+ * @brief Starts the worker threads
+ */
+void bm_decode_init();
+
+/**
+ * @brief Discards all queued decodes and stops the worker threads
+ */
+void bm_decode_close();
+
+/**
+ * @brief Queues a bitmap to be decoded in the background
+ *
+ * @details Does nothing if the bitmap is already queued, already has its data or can't be decoded in the background.
+ *
+ * @returns false if the queue is full, true otherwise
+ */
+bool bm_decode_queue(int handle);
+
+/**
+ * @brief Queues the frames following a frame of an EFF animation
+ *
+ * @param[in] handle     The frame being locked
+ * @param[in] num_frames How many of the following frames to queue
+ */
+void bm_decode_queue_frames(int handle, int num_frames);
+
+/**
+ * @brief Hands over the decoded pixel data of a bitmap, if it was queued
+ *
+ * @details Waits for the worker if the decode is still running.
+ *
+ * @param[in] handle The bitmap
+ * @param[in] size   How much data the caller expects, a result of a different size is thrown away
+ * @param[out] bpp   The bits per pixel of the decoded data
+ *
+ * @returns The decoded data, allocated with vm_malloc() and now owned by the caller, or
+ * @returns nullptr if the bitmap wasn't queued or couldn't be decoded
+ */
+ubyte *bm_decode_take(int handle, size_t size, int *bpp);
+
+/**
+ * @brief Throws away the decode of a bitmap, if there is one
+ */
+void bm_decode_discard(int handle);
+
+/**
+ * @brief Throws away every decode which hasn't been taken
+ */
+void bm_decode_flush();
+
+#endif // __BM_DECODE_H__
@@ -74,6 +74,7 @@ struct bitmap_entry {
 	signed char ref_count;  //!< Number of locks on bitmap.  Can't unload unless ref_count is 0.
 
 	int dir_type;           //!< which directory this was loaded from (to skip other locations with same name)
+	char cache_filename[MAX_FILENAME_LEN];    //!< compressed copy in the texture cache that gets loaded instead, empty if none
 
 	// compressed bitmap stuff (.dds) - RT please take a look at this and tell me if we really need it
 	size_t mem_taken;          //!< How much memory does this bitmap use? - UnknownPlayer
@@ -85,6 +86,10 @@ struct bitmap_entry {
 	ubyte used_flags;       //!< What flags it was accessed thru
 	int   load_count;
 
+	// Stuff for the residency manager
+	uint   last_used_frame; //!< Residency frame this bitmap was last locked or drawn in
+	size_t resident_size;   //!< How much graphics memory the texture of this bitmap takes up, 0 if it isn't resident
+
 	bitmap bm;              //!< Bitmap info
 
 	bm_extra_info info;     //!< Data for animations and user bitmaps
@@ -0,0 +1,259 @@
+
+#include "bmpman/bm_texcache.h"
+#include "cmdline/cmdline.h"
+#include "ddsutils/ddsutils.h"
+#include "ddsutils/dxtc.h"
+#include "jpgutils/jpgutils.h"
+#include "pngutils/pngutils.h"
+#include "tgautils/tgautils.h"
+
+#include <md5.h>
+
+// bump this whenever the encoder output changes, so that old cache entries are ignored
+#define BM_TEXCACHE_VERSION		1
+
+static inline bool bm_texcache_is_power_of_two(int w, int h)
+{
+	return ( (w && !(w & (w-1))) && (h && !(h & (h-1))) );
+}
+
+// hash the contents of an image into its cache filename, leaving the file rewound
+static bool bm_texcache_hash(CFILE *cfp, char *cache_name)
+{
+	SCP_vector<char> contents;
+	int version = BM_TEXCACHE_VERSION;
+	int len = cfilelength(cfp);
+
+	if (len <= 0) {
+		return false;
+	}
+
+	contents.resize((size_t)len);
+
+	cfseek(cfp, 0, CF_SEEK_SET);
+	int read_len = cfread(contents.data(), 1, len, cfp);
+	cfseek(cfp, 0, CF_SEEK_SET);
+
+	if (read_len != len) {
+		return false;
+	}
+
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(&version), sizeof(version));
+	md5.update(contents.data(), (MD5::size_type)len);
+	md5.finalize();
+
+	// 80 bits of the hash is plenty, and keeps us inside MAX_FILENAME_LEN
+	sprintf(cache_name, "tc%.20s.dds", md5.hexdigest().c_str());
+
+	return true;
+}
+
+// 2x2 box filter down to the next mipmap level
+static void bm_texcache_downsample(const ubyte *src, int w, int h, ubyte *dst)
+{
+	int dw = MAX(1, w / 2);
+	int dh = MAX(1, h / 2);
+	int x, y, c;
+
+	for (y = 0; y < dh; y++) {
+		const ubyte *row0 = src + (MIN(y*2, h-1) * w) * 4;
+		const ubyte *row1 = src + (MIN(y*2 + 1, h-1) * w) * 4;
+
+		for (x = 0; x < dw; x++) {
+			int x0 = MIN(x*2, w-1) * 4;
+			int x1 = MIN(x*2 + 1, w-1) * 4;
+
+			for (c = 0; c < 4; c++) {
+				*dst++ = (ubyte)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+			}
+		}
+	}
+}
+
+bool bm_texcache_find(CFILE *img_cfp, char *cache_name)
+{
+	if ( !Cmdline_texture_cache || !Use_compressed_textures ) {
+		return false;
+	}
+
+	if ( !bm_texcache_hash(img_cfp, cache_name) ) {
+		return false;
+	}
+
+	return cf_exists_full(cache_name, CF_TYPE_CACHE) != 0;
+}
+
+bool bm_texcache_transcode(const char *filename, BM_TYPE type, int dir_type)
+{
+	char cache_name[MAX_FILENAME_LEN];
+	int w = 0, h = 0, bpp = 0;
+	int rc;
+
+	CFILE *cfp = cfopen(filename, "rb", CFILE_NORMAL, dir_type);
+
+	if (cfp == nullptr) {
+		return false;
+	}
+
+	bool hashed = bm_texcache_hash(cfp, cache_name);
+	cfclose(cfp);
+
+	if ( !hashed ) {
+		return false;
+	}
+
+	if ( cf_exists_full(cache_name, CF_TYPE_CACHE) ) {
+		return true;
+	}
+
+	switch (type) {
+	case BM_TYPE_TGA:
+		rc = targa_read_header(filename, nullptr, &w, &h, &bpp);
+		rc = (rc == TARGA_ERROR_NONE) ? 0 : -1;
+		break;
+
+	case BM_TYPE_PNG:
+		rc = png_read_header(filename, nullptr, &w, &h, &bpp);
+		rc = (rc == PNG_ERROR_NONE) ? 0 : -1;
+		break;
+
+	case BM_TYPE_JPG:
+		rc = jpeg_read_header(filename, nullptr, &w, &h, &bpp);
+		rc = (rc == JPEG_ERROR_NONE) ? 0 : -1;
+		break;
+
+	default:
+		UNREACHABLE("Unsupported texture cache image type %d!", static_cast<int>(type));
+		return false;
+	}
+
+	if (rc != 0) {
+		return false;
+	}
+
+	// compressed DDS files have to be power-of-2, and we only deal with truecolor images
+	if ( !bm_texcache_is_power_of_two(w, h) ) {
+		nprintf(("BmpMan", "Not caching %s, it isn't power-of-2 (%dx%d)\n", filename, w, h));
+		return false;
+	}
+
+	if ( (bpp != 24) && (bpp != 32) && (type != BM_TYPE_PNG) ) {
+		nprintf(("BmpMan", "Not caching %s, it is %d-bit\n", filename, bpp));
+		return false;
+	}
+
+	// decode to BGR(A), the same way bm_lock() would
+	SCP_vector<ubyte> pixels((size_t)w * h * 4);
+
+	switch (type) {
+	case BM_TYPE_TGA:
+		rc = targa_read_bitmap(filename, pixels.data(), nullptr, bpp >> 3, dir_type);
+		rc = (rc == TARGA_ERROR_NONE) ? 0 : -1;
+		break;
+
+	case BM_TYPE_PNG:
+		rc = png_read_bitmap(filename, pixels.data(), &bpp, 4, dir_type);
+		rc = (rc == PNG_ERROR_NONE) ? 0 : -1;
+		break;
+
+	default:
+		bpp = 24;
+		rc = jpeg_read_bitmap(filename, pixels.data(), nullptr, 3, dir_type);
+		rc = (rc == JPEG_ERROR_NONE) ? 0 : -1;
+		break;
+	}
+
+	if (rc != 0) {
+		mprintf(("BmpMan: Unable to decode %s for the texture cache!\n", filename));
+		return false;
+	}
+
+	bool has_alpha = false;
+	int num_pixels = w * h;
+	int i;
+
+	if (bpp == 24) {
+		// expand in place, back to front
+		for (i = num_pixels - 1; i >= 0; i--) {
+			pixels[i*4 + 3] = 255;
+			pixels[i*4 + 2] = pixels[i*3 + 2];
+			pixels[i*4 + 1] = pixels[i*3 + 1];
+			pixels[i*4 + 0] = pixels[i*3 + 0];
+		}
+	} else if (bpp == 32) {
+		for (i = 0; i < num_pixels; i++) {
+			if (pixels[i*4 + 3] != 255) {
+				has_alpha = true;
+				break;
+			}
+		}
+	} else {
+		nprintf(("BmpMan", "Not caching %s, it decoded to %d-bit\n", filename, bpp));
+		return false;
+	}
+
+	int compression_type = (has_alpha) ? DDS_DXT5 : DDS_DXT1;
+
+	// compress the full mipmap chain
+	SCP_vector<ubyte> compressed;
+	SCP_vector<ubyte> next_level;
+	int level_w = w;
+	int level_h = h;
+	int num_levels = 0;
+
+	while (true) {
+		size_t offset = compressed.size();
+
+		compressed.resize(offset + dxtc_compressed_size(level_w, level_h, compression_type));
+		dxtc_compress_image(pixels.data(), level_w, level_h, compression_type, &compressed[offset]);
+		num_levels++;
+
+		if ( (level_w == 1) && (level_h == 1) ) {
+			break;
+		}
+
+		next_level.resize((size_t)MAX(1, level_w / 2) * MAX(1, level_h / 2) * 4);
+		bm_texcache_downsample(pixels.data(), level_w, level_h, next_level.data());
+		pixels.swap(next_level);
+
+		level_w = MAX(1, level_w / 2);
+		level_h = MAX(1, level_h / 2);
+	}
+
+	dds_save_image(w, h, 32, num_levels, compressed.data(), 0, cache_name, compression_type);
+
+	nprintf(("BmpMan", "Cached %s as %s (%s, %d levels)\n", filename, cache_name, (has_alpha) ? "DXT5" : "DXT1", num_levels));
+
+	return cf_exists_full(cache_name, CF_TYPE_CACHE) != 0;
+}
+
+void bm_texcache_warm()
+{
+	const int dir_types[] = { CF_TYPE_MAPS, CF_TYPE_EFFECTS };
+	const BM_TYPE types[] = { BM_TYPE_TGA, BM_TYPE_PNG, BM_TYPE_JPG };
+	const char *exts[] = { ".tga", ".png", ".jpg" };
+	SCP_vector<SCP_string> files;
+	int num_files = 0, num_cached = 0;
+
+	for (auto dir_type : dir_types) {
+		for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+			SCP_string filter = SCP_string("*") + exts[i];
+
+			files.clear();
+			cf_get_file_list(files, dir_type, filter.c_str());
+
+			for (auto& file : files) {
+				SCP_string filename = file + exts[i];
+
+				num_files++;
+
+				if (bm_texcache_transcode(filename.c_str(), types[i], dir_type)) {
+					num_cached++;
+				}
+			}
+		}
+	}
+
+	mprintf(("BmpMan: Texture cache holds %d of %d textures, the rest couldn't be compressed\n", num_cached, num_files));
+}
@@ -0,0 +1,42 @@
+#ifndef __BM_TEXCACHE_H__
+#define __BM_TEXCACHE_H__
+
+/**
+ * @file bm_texcache.h
+ * Persistent cache of block compressed, pre-mipmapped DDS copies of PNG/TGA/JPG textures.
+ *
+ * @details Cache entries live in CF_TYPE_CACHE and are named after a hash of the source image's contents, so an edited
+ * texture simply misses the cache instead of picking up a stale copy.  The cache is filled offline with
+ * -warm_texture_cache and only consulted by bm_load() when -texture_cache is given.
+ */
+
+#include "bmpman/bmpman.h"
+#include "cfile/cfile.h"
+
+/**
+ * @brief Looks up the cached copy of an image
+ *
+ * @param[in] img_cfp         The open source image, rewound to the start when done
+ * @param[out] cache_name     Filename of the cached DDS in CF_TYPE_CACHE, must hold MAX_FILENAME_LEN chars
+ *
+ * @returns true if the cache is in use and has a copy of the image, false otherwise
+ */
+bool bm_texcache_find(CFILE *img_cfp, char *cache_name);
+
+/**
+ * @brief Adds a compressed copy of an image to the cache, if there isn't one already
+ *
+ * @param[in] filename    The source image, with extension
+ * @param[in] type        The type of the image, BM_TYPE_TGA, BM_TYPE_PNG or BM_TYPE_JPG
+ * @param[in] dir_type    Where to look for the source image
+ *
+ * @returns true if the cache has a copy of the image, false if it couldn't be transcoded
+ */
+bool bm_texcache_transcode(const char *filename, BM_TYPE type, int dir_type = CF_TYPE_ANY);
+
+/**
+ * @brief Transcodes every texture and effect image of the current mod into the cache
+ */
+void bm_texcache_warm();
+
+#endif // __BM_TEXCACHE_H__
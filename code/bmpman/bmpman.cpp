@@ -15,7 +15,10 @@
 
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
+#include "bmpman/bm_decode.h"
 #include "bmpman/bm_internal.h"
+#include "bmpman/bm_texcache.h"
+#include "cmdline/cmdline.h"
 #include "ddsutils/ddsutils.h"
 #include "debugconsole/console.h"
 #include "globalincs/systemvars.h"
@@ -33,6 +36,7 @@
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
+#include <algorithm>
 #include <cctype>
 #include <climits>
 #include <iomanip>
@@ -49,6 +53,10 @@
 // Monitor variables
 MONITOR(NumBitmapPage)
 MONITOR(SizeBitmapPage)
+MONITOR(TextureHits)
+MONITOR(TextureMisses)
+MONITOR(TextureEvictions)
+MONITOR(ResidentTextureKB)
 
 // --------------------------------------------------------------------------------------------------------------------
 // Definition of public variables (declared as extern in bmpman.h).
@@ -84,11 +92,27 @@ static int Bm_low_mem = 0;
 /**
  * How much RAM bmpman can use for textures.
  *
- * @details Set to <1 to make it use all it wants.
+ * @details Set to 0 to make it use all it wants. Otherwise bm_residency_do_frame() evicts the least recently used
+ * textures until the resident textures fit in this many bytes.
  *
  * @note was initialized to 16*1024*1024 at some point to "use only 16MB for textures"
  */
-static int Bm_max_ram = 0;
+static size_t Bm_max_ram = 0;
+
+/**
+ * Residency manager bookkeeping
+ */
+typedef struct bm_residency_stats {
+	uint   hits;           //!< Times a texture was already resident when it was set
+	uint   misses;         //!< Times a texture had to be (re)created when it was set
+	uint   evictions;      //!< Bitmaps evicted to get under the budget
+	size_t evicted_bytes;  //!< Graphics memory freed by those evictions
+} bm_residency_stats;
+
+static uint Bm_residency_frame = 1;                     //!< Stamped into bitmap_entry::last_used_frame
+static size_t Bm_resident_bytes = 0;                    //!< Sum of bitmap_entry::resident_size
+static bm_residency_stats Bm_residency_frame_stats;     //!< Stats of the current frame
+static bm_residency_stats Bm_residency_total_stats;     //!< Stats since startup or the last "bmpman stats reset"
 
 static int Bm_ignore_duplicates = 0;
 static int Bm_ignore_load_count = 0;
@@ -106,6 +130,27 @@ static bool bm_is_anim(bitmap_entry* entry)
 		(entry->type == BM_TYPE_PNG && entry->info.ani.apng.is_apng));
 }
 
+/**
+ * Picks up the pixels of a bitmap which was decoded in the background, with the same bookkeeping as bm_malloc()
+ *
+ * @returns nullptr if the bitmap wasn't decoded in the background
+ */
+static ubyte *bm_take_decoded(int handle, size_t size, int *bpp)
+{
+	auto data = bm_decode_take(handle, size, bpp);
+
+#ifdef BMPMAN_NDEBUG
+	if (data != nullptr) {
+		auto entry = bm_get_entry(handle);
+		Assert(entry->data_size == 0);
+		entry->data_size += size;
+		bm_texture_ram += size;
+	}
+#endif
+
+	return data;
+}
+
 bitmap_slot* bm_get_slot(int handle, bool separate_ani_frames) {
 	Assertion(handle >= 0, "Invalid handle %d passed to bm_get_slot!", handle);
 
@@ -269,6 +314,8 @@ static void allocate_new_block() {
 		entry.used_this_frame = 0;
 #endif
 		entry.load_count = 0;
+		entry.last_used_frame = 0;
+		entry.resident_size = 0;
 
 		gr_bm_init(&slot);
 
@@ -440,19 +487,21 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 		dc_printf("Usage: BmpMan [arg]\nWhere arg can be any of the following:\n");
 		dc_printf("\tflush    Unloads all bitmaps.\n");
 		dc_printf("\tram [x]  Sets max mem usage to x MB. (Set to 0 to have no limit.)\n");
+		dc_printf("\tstats    Displays texture residency hits, misses and evictions. 'stats reset' clears them.\n");
 		dc_printf("\t?        Displays status of Bitmap manager.\n");
 		return;
 	}
 
 	if (dc_optional_string_either("status", "--status") || dc_optional_string_either("?", "--?")) {
 		dc_printf("Total RAM usage: " SIZE_T_ARG " bytes\n", bm_texture_ram);
+		dc_printf("Resident textures: " SIZE_T_ARG " bytes\n", Bm_resident_bytes);
 
 		if (Bm_max_ram > 1024 * 1024) {
-			dc_printf("\tMax RAM allowed: %.1f MB\n", i2fl(Bm_max_ram) / (1024.0f*1024.0f));
+			dc_printf("\tMax RAM allowed: %.1f MB\n", (float)Bm_max_ram / (1024.0f*1024.0f));
 		} else if (Bm_max_ram > 1024) {
-			dc_printf("\tMax RAM allowed: %.1f KB\n", i2fl(Bm_max_ram) / (1024.0f));
+			dc_printf("\tMax RAM allowed: %.1f KB\n", (float)Bm_max_ram / (1024.0f));
 		} else if (Bm_max_ram > 0) {
-			dc_printf("\tMax RAM allowed: %d bytes\n", Bm_max_ram);
+			dc_printf("\tMax RAM allowed: " SIZE_T_ARG " bytes\n", Bm_max_ram);
 		} else {
 			dc_printf("\tNo RAM limit\n");
 		}
@@ -471,16 +520,34 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 		}
 		dc_printf("Total RAM after flush: " SIZE_T_ARG " bytes\n", bm_texture_ram);
 	} else if (dc_optional_string("ram")) {
-		dc_stuff_int(&Bm_max_ram);
+		int max_mb;
+
+		dc_stuff_int(&max_mb);
 
-		if (Bm_max_ram > 0) {
-			dc_printf("BmpMan limited to %i, MB's\n", Bm_max_ram);
-			Bm_max_ram *= 1024 * 1024;
-		} else if (Bm_max_ram == 0) {
+		if (max_mb > 0) {
+			dc_printf("BmpMan limited to %i, MB's\n", max_mb);
+			Bm_max_ram = (size_t)max_mb * 1024 * 1024;
+		} else if (max_mb == 0) {
 			dc_printf("!!BmpMan memory is unlimited!!\n");
+			Bm_max_ram = 0;
 		} else {
 			dc_printf("Illegal value. Must be non-negative.");
 		}
+	} else if (dc_optional_string("stats")) {
+		if (dc_optional_string("reset")) {
+			memset(&Bm_residency_total_stats, 0, sizeof(Bm_residency_total_stats));
+			dc_printf("Texture residency stats reset\n");
+			return;
+		}
+
+		auto& stats = Bm_residency_total_stats;
+		uint lookups = stats.hits + stats.misses;
+
+		dc_printf("Texture residency over %u frames:\n", Bm_residency_frame);
+		dc_printf("\tHits:      %u (%.1f%%)\n", stats.hits, (lookups > 0) ? (100.0f * stats.hits / lookups) : 0.0f);
+		dc_printf("\tMisses:    %u\n", stats.misses);
+		dc_printf("\tEvictions: %u (" SIZE_T_ARG " bytes)\n", stats.evictions, stats.evicted_bytes);
+		dc_printf("\tResident:  " SIZE_T_ARG " bytes\n", Bm_resident_bytes);
 	} else {
 		dc_printf("<BmpMan> No argument given\n");
 	}
@@ -499,6 +566,8 @@ DCF(bmpslots, "Writes bitmap slot info to fs2_open.log") {
 // Definition of all functions, in alphabetical order
 void bm_close() {
 	if (bm_inited) {
+		bm_decode_close();
+
 		for (auto& block : bm_blocks) {
 			for (auto& slot : block) {
 				bm_free_data(&slot);            // clears flags, bbp, data, etc
@@ -934,6 +1003,10 @@ void bm_init() {
 	// Allocate one block by default
 	allocate_new_block();
 
+	Bm_max_ram = (size_t)Cmdline_texture_budget * 1024 * 1024;
+
+	bm_decode_init();
+
 	bm_inited = true;
 }
 
@@ -1169,12 +1242,30 @@ int bm_load(const char *real_filename) {
 		return -1;
 	}
 
-	rc = bm_load_info(type, filename, img_cfp, &w, &h, &bpp, &c_type, &mm_lvl, &bm_size);
+	// use a compressed copy from the texture cache if there is one
+	char cache_filename[MAX_FILENAME_LEN] = "";
 
-	if (rc != 0) {
-		if (img_cfp != nullptr)
-			cfclose(img_cfp);
-		return -1;
+	if (((type == BM_TYPE_TGA) || (type == BM_TYPE_PNG) || (type == BM_TYPE_JPG)) && bm_texcache_find(img_cfp, cache_filename)) {
+		CFILE *cache_cfp = cfopen(cache_filename, "rb", CFILE_NORMAL, CF_TYPE_CACHE);
+
+		if ((cache_cfp != nullptr) && (bm_load_info(BM_TYPE_DDS, cache_filename, cache_cfp, &w, &h, &bpp, &c_type, &mm_lvl, &bm_size) == 0)) {
+			type = BM_TYPE_DDS;
+		} else {
+			cache_filename[0] = '\0';
+		}
+
+		if (cache_cfp != nullptr)
+			cfclose(cache_cfp);
+	}
+
+	if (cache_filename[0] == '\0') {
+		rc = bm_load_info(type, filename, img_cfp, &w, &h, &bpp, &c_type, &mm_lvl, &bm_size);
+
+		if (rc != 0) {
+			if (img_cfp != nullptr)
+				cfclose(img_cfp);
+			return -1;
+		}
 	}
 
 	if ((bm_size <= 0) && (w) && (h) && (bpp))
@@ -1191,6 +1282,7 @@ int bm_load(const char *real_filename) {
 	// Mark the slot as filled, because cf_read might load a new bitmap
 	// into this slot.
 	strcpy_s(entry->filename, filename);
+	strcpy_s(entry->cache_filename, cache_filename);
 	entry->type = type;
 	entry->comp_type = c_type;
 	entry->signature = Bm_next_signature++;
@@ -1339,6 +1431,9 @@ static int bm_load_image_data(int handle, int bpp, ubyte flags, bool nodebug)
 		// make sure we use the real graphic type for EFFs
 		if (be->type == BM_TYPE_EFF) {
 			c_type = be->info.ani.eff.type;
+
+			// get the next few frames decoding while this one is loaded
+			bm_decode_queue_frames(handle, BM_DECODE_PREFETCH_FRAMES);
 		}
 		else {
 			c_type = be->type;
@@ -1882,6 +1977,7 @@ bitmap * bm_lock(int handle, int bpp, ubyte flags, bool nodebug) {
 		be->used_this_frame++;
 	}
 #endif
+	be->last_used_frame = Bm_residency_frame;
 
 	// read the file data
 	if (bm_load_image_data(handle, bpp, flags, nodebug) == -1) {
@@ -2131,7 +2227,11 @@ void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ubyte /*
 	// this will populate filename[] whether it's EFF or not
 	EFF_FILENAME_CHECK;
 
-	error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+	if (be->cache_filename[0] != '\0') {
+		error = dds_read_bitmap(be->cache_filename, data, &dds_bpp, CF_TYPE_CACHE);
+	} else {
+		error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+	}
 
 #if BYTE_ORDER == BIG_ENDIAN
 	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
@@ -2188,6 +2288,17 @@ void bm_lock_jpg(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ubyte /*flag
 
 	// allocate bitmap data
 	Assert(be->mem_taken > 0);
+
+	// it may have been decoded in the background already
+	data = bm_take_decoded(handle, be->mem_taken, &bpp);
+
+	if (data != NULL) {
+		bmp->bpp = bpp;
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
+		return;
+	}
+
 	data = (ubyte*)bm_malloc(handle, be->mem_taken);
 
 	if (data == NULL)
@@ -2280,6 +2391,16 @@ void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ubyte /*
 	//if it's not 32-bit, we expand when we read it
 	bmp->bpp = 32;
 	d_size = bmp->bpp >> 3;
+
+	// it may have been decoded in the background already
+	data = bm_take_decoded(handle, (size_t)bmp->w * bmp->h * d_size, &bmp->bpp);
+
+	if (data != NULL) {
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
+		return;
+	}
+
 	//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
 	data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
 	if (data == NULL)
@@ -2331,6 +2452,19 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ubyte flags)
 	Assert(byte_size);
 	Assert(be->mem_taken > 0);
 
+	// it may have been decoded in the background already
+	data = bm_take_decoded(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size), &bpp);
+
+	if (data) {
+		bmp->bpp = bpp;
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
+		bmp->flags = 0;
+
+		bm_convert_format(bmp, flags);
+		return;
+	}
+
 	data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
 
 	if (data) {
@@ -2521,6 +2655,9 @@ void bm_page_in_start() {
 		}
 	}
 
+	// nothing queued for the last level is of any use now
+	bm_decode_flush();
+
 	gr_bm_page_in_start();
 }
 
@@ -2538,6 +2675,21 @@ void bm_page_in_stop() {
 
 	int bm_preloading = 1;
 
+	// the bitmaps are decoded in the background, just ahead of the loop below uploading them
+	SCP_vector<int> decode_ahead;
+	size_t decode_next = 0;
+
+	for (auto& block : bm_blocks) {
+		for (auto& slot : block) {
+			auto& entry = slot.entry;
+
+			if ((entry.type != BM_TYPE_NONE) && (entry.type != BM_TYPE_RENDER_TARGET_DYNAMIC)
+				&& (entry.type != BM_TYPE_RENDER_TARGET_STATIC) && entry.preloaded) {
+				decode_ahead.push_back(entry.handle);
+			}
+		}
+	}
+
 	for (auto& block : bm_blocks) {
 		for (auto& slot : block) {
 			auto& entry = slot.entry;
@@ -2546,6 +2698,10 @@ void bm_page_in_stop() {
 				&& (entry.type != BM_TYPE_RENDER_TARGET_STATIC)) {
 				if (entry.preloaded) {
 					TRACE_SCOPE(tracing::PageInSingleBitmap);
+
+					while ((decode_next < decode_ahead.size()) && bm_decode_queue(decode_ahead[decode_next])) {
+						decode_next++;
+					}
 					if (bm_preloading) {
 						if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
 							mprintf(("Out of VRAM.  Done preloading.\n"));
@@ -2584,6 +2740,9 @@ void bm_page_in_stop() {
 
 	nprintf(("BmpInfo", "BMPMAN: Loaded %d bitmaps that are marked as used for this level.\n", n));
 
+	// drop whatever wasn't picked up, ie if we ran out of VRAM
+	bm_decode_flush();
+
 #ifndef NDEBUG
 	int total_bitmaps = 0;
 	int total_slots = 0;
@@ -2770,6 +2929,7 @@ int bm_release(int handle, int clear_render_targets) {
 		// The graphics system requires that the bitmap information for the whole animation is still valid when the data
 		// is freed so we first free all the data and then clear the bitmaps data
 		for (i = 0; i < total; i++) {
+			bm_decode_discard(first + i);
 			bm_free_data(bm_get_slot(first + i), true);
 		}
 
@@ -2799,6 +2959,7 @@ int bm_release(int handle, int clear_render_targets) {
 		auto slot = bm_get_slot(handle);
 		auto entry = &slot->entry;
 
+		bm_decode_discard(handle);
 		bm_free_data(slot, true);		// clears flags, bbp, data, etc
 
 
@@ -2843,9 +3004,135 @@ int bm_reload(int bitmap_handle, const char* filename) {
 	}
 
 	strcpy_s(entry->filename, filename);
+	entry->cache_filename[0] = '\0';
 	return bitmap_handle;
 }
 
+/**
+ * Frees the least recently used textures until the resident ones fit in the budget
+ *
+ * @details Animations which are texture arrays are evicted as a whole, since the graphics API can only free the array
+ * once all of its frames are gone. Anything used this frame or the last one is left alone, as are locked bitmaps,
+ * user bitmaps and render targets.
+ */
+static void bm_residency_evict(size_t budget)
+{
+	struct eviction_candidate {
+		uint last_used;
+		int first_frame;
+		int num_frames;
+		size_t size;
+	};
+	static SCP_vector<eviction_candidate> candidates;
+
+	candidates.clear();
+
+	for (auto& block : bm_blocks) {
+		for (auto& slot : block) {
+			auto& entry = slot.entry;
+
+			if ((entry.type == BM_TYPE_NONE) || (entry.type == BM_TYPE_USER) ||
+				(entry.type == BM_TYPE_RENDER_TARGET_STATIC) || (entry.type == BM_TYPE_RENDER_TARGET_DYNAMIC)) {
+				continue;
+			}
+
+			int num_frames = 1;
+			auto first_frame = bm_get_base_frame(entry.handle, &num_frames);
+
+			// only look at every animation once
+			if (first_frame != entry.handle) {
+				continue;
+			}
+
+			eviction_candidate candidate = { 0, first_frame, num_frames, 0 };
+			bool locked = false;
+
+			for (int i = 0; i < num_frames; i++) {
+				auto frame_entry = bm_get_entry(first_frame + i);
+
+				candidate.last_used = MAX(candidate.last_used, frame_entry->last_used_frame);
+				candidate.size += frame_entry->resident_size;
+				locked = locked || (frame_entry->ref_count > 0);
+			}
+
+			if (locked || (candidate.size == 0) || (candidate.last_used + 1 >= Bm_residency_frame)) {
+				continue;
+			}
+
+			candidates.push_back(candidate);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](const eviction_candidate& a, const eviction_candidate& b) {
+		return a.last_used < b.last_used;
+	});
+
+	for (auto& candidate : candidates) {
+		if (Bm_resident_bytes <= budget) {
+			break;
+		}
+
+		nprintf(("BmpMan", "Evicting %s (" SIZE_T_ARG " bytes), last used %u frames ago\n",
+			bm_get_entry(candidate.first_frame)->filename, candidate.size, Bm_residency_frame - candidate.last_used));
+
+		for (int i = 0; i < candidate.num_frames; i++) {
+			bm_free_data(bm_get_slot(candidate.first_frame + i));
+		}
+
+		Bm_residency_frame_stats.evictions++;
+		Bm_residency_frame_stats.evicted_bytes += candidate.size;
+	}
+}
+
+void bm_residency_do_frame() {
+	if (!bm_inited) {
+		return;
+	}
+
+	if ((Bm_max_ram > 0) && (Bm_resident_bytes > Bm_max_ram)) {
+		TRACE_SCOPE(tracing::TextureEviction);
+
+		bm_residency_evict(Bm_max_ram);
+	}
+
+	auto& frame = Bm_residency_frame_stats;
+
+	mon_TextureHits = (int)frame.hits;
+	mon_TextureMisses = (int)frame.misses;
+	mon_TextureEvictions = (int)frame.evictions;
+	mon_ResidentTextureKB = (int)(Bm_resident_bytes / 1024);
+
+	Bm_residency_total_stats.hits += frame.hits;
+	Bm_residency_total_stats.misses += frame.misses;
+	Bm_residency_total_stats.evictions += frame.evictions;
+	Bm_residency_total_stats.evicted_bytes += frame.evicted_bytes;
+
+	memset(&frame, 0, sizeof(frame));
+
+	Bm_residency_frame++;
+}
+
+void bm_residency_set_size(int handle, size_t size) {
+	auto entry = bm_get_entry(handle);
+
+	Assert(Bm_resident_bytes >= entry->resident_size);
+
+	Bm_resident_bytes -= entry->resident_size;
+	Bm_resident_bytes += size;
+
+	entry->resident_size = size;
+}
+
+void bm_residency_touch(int handle, bool was_resident) {
+	bm_get_entry(handle)->last_used_frame = Bm_residency_frame;
+
+	if (was_resident) {
+		Bm_residency_frame_stats.hits++;
+	} else {
+		Bm_residency_frame_stats.misses++;
+	}
+}
+
 void BM_SELECT_ALPHA_TEX_FORMAT() {
 	Gr_current_red = &Gr_ta_red;
 	Gr_current_green = &Gr_ta_green;
@@ -398,6 +398,33 @@ void bm_get_palette(int handle, ubyte *pal, char *name);
  */
 void bm_get_frame_usage(int *ntotal, int *nnew);
 
+/**
+ * @brief Records that a bitmap's texture was set for rendering this frame
+ *
+ * @param[in] was_resident true if the graphics API already had the texture, false if it had to be (re)created
+ *
+ * @note Called by the graphics API. bm_lock() also marks bitmaps as used, but doesn't count towards the hit/miss stats
+ */
+void bm_residency_touch(int handle, bool was_resident);
+
+/**
+ * @brief Tells the residency manager how much graphics memory the texture of a bitmap takes up
+ *
+ * @param[in] size The size in bytes, 0 once the texture has been freed
+ *
+ * @note Called by the graphics API
+ */
+void bm_residency_set_size(int handle, size_t size);
+
+/**
+ * @brief Ends a frame of the residency manager
+ *
+ * @details If the resident textures exceed the budget (-texture_budget, or "bmpman ram" in the debug console) the least
+ * recently used ones are evicted until they fit. Also updates the TextureHits, TextureMisses, TextureEvictions and
+ * ResidentTextureKB tracing counters.
+ */
+void bm_residency_do_frame();
+
 /**
  * @brief Reloads an existing bmpman slot with different bitmap
  *
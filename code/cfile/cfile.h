@@ -373,6 +373,7 @@ struct CFileLocation {
 	size_t size          = 0;
 	size_t offset        = 0;
 	const void* data_ptr = nullptr;
+	time_t write_time    = 0; // only known for files in the file list, 0 otherwise
 
 	explicit CFileLocation(bool found_in = false) : found(found_in) {}
 };
@@ -1154,6 +1154,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 					res.size = static_cast<size_t>(f->size);
 					res.offset = (size_t)f->pack_offset;
 					res.data_ptr = f->data;
+					res.write_time = f->write_time;
 
 					if (f->data != nullptr) {
 						// This is an in-memory file so we just copy the pathtype name + file name
@@ -1181,6 +1182,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 			res.size = static_cast<size_t>(f->size);
 			res.offset = (size_t)f->pack_offset;
 			res.data_ptr = f->data;
+			res.write_time = f->write_time;
 
 			if (f->data != nullptr) {
 				// This is an in-memory file so we just copy the pathtype name + file name
@@ -1419,6 +1421,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 						res.size = static_cast<size_t>(f->size);
 						res.offset = (size_t)f->pack_offset;
 						res.data_ptr = f->data;
+						res.write_time = f->write_time;
 
 						if (f->data != nullptr) {
 							// This is an in-memory file so we just copy the pathtype name + file name
@@ -1450,6 +1453,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 				res.size = static_cast<size_t>(f->size);
 				res.offset = (size_t)f->pack_offset;
 				res.data_ptr = f->data;
+				res.write_time = f->write_time;
 
 				if (f->data != nullptr) {
 					// This is an in-memory file so we just copy the pathtype name + file name
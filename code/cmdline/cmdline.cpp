@@ -219,6 +219,11 @@ Flag exe_params[] =
 	{ "-set_cpu_affinity",	"Sets processor affinity to config value",	true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-set_cpu_affinity", },
 	{ "-nograb",			"Disables mouse grabbing",					true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nograb", },
 	{ "-noshadercache",		"Disables the shader cache",				true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-noshadercache", },
+	{ "-texture_cache",		"Use compressed textures from the cache",	true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-texture_cache", },
+	{ "-nomodelcache",		"Disables the cooked model cache",			true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nomodelcache", },
+	{ "-notablecache",		"Disables the processed table cache",		true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-notablecache", },
+	{ "-nomissioncache",	"Disables the validated mission cache",		true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nomissioncache", },
+	{ "-nosoundcache",		"Disables the decoded sound cache",			true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nosoundcache", },
 #ifdef WIN32
 	{ "-fix_registry",	"Use a different registry path",				true,	0,									EASY_DEFAULT,					"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-fix_registry", },
 #endif
@@ -241,6 +246,7 @@ Flag exe_params[] =
 	{ "-output_script_json",	"Output scripting doc to scripting.json",	true,	0,								EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-output_script_json", },
 	{ "-save_render_target",	"Save render targets to file",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-save_render_target", },
 	{ "-verify_vps",		"Spew VP CRCs to vp_crcs.txt",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-verify_vps", },
+	{ "-warm_texture_cache",	"Compress all textures into the cache",	true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-warm_texture_cache", },
 	{ "-reparse_mainhall",	"Reparse mainhall.tbl when loading halls",	false,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-reparse_mainhall", },
 	{ "-noninteractive",	"Disables interactive dialogs",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-noninteractive", },
 	{ "-no_unfocused_pause","Don't pause if the window isn't focused",	true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_unfocused_pause", },
@@ -248,6 +254,7 @@ Flag exe_params[] =
 	{ "-profile_frame_time","Profile frame time",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_frame_time", },
 	{ "-profile_write_file", "Write profiling information to file",		true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_write_file", },
 	{ "-json_profiling",	"Generate JSON profiling output",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-json_profiling", },
+	{ "-binary_profiling",	"Generate binary profiling output",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-binary_profiling", },
 	{ "-debug_window",		"Enable the debug window",					true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-debug_window", },
 	{ "-gr_debug",		"Output graphics debug information",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-gr_debug", },
 };
@@ -435,6 +442,12 @@ cmdline_parm no_geo_sdr_effects("-no_geo_effects", NULL, AT_NONE);
 cmdline_parm set_cpu_affinity("-set_cpu_affinity", NULL, AT_NONE);
 cmdline_parm nograb_arg("-nograb", NULL, AT_NONE);
 cmdline_parm noshadercache_arg("-noshadercache", NULL, AT_NONE);
+cmdline_parm texture_cache_arg("-texture_cache", NULL, AT_NONE);	// Cmdline_texture_cache
+cmdline_parm nomodelcache_arg("-nomodelcache", NULL, AT_NONE);	// Cmdline_nomodelcache
+cmdline_parm notablecache_arg("-notablecache", NULL, AT_NONE);	// Cmdline_notablecache
+cmdline_parm nomissioncache_arg("-nomissioncache", NULL, AT_NONE);	// Cmdline_nomissioncache
+cmdline_parm nosoundcache_arg("-nosoundcache", NULL, AT_NONE);	// Cmdline_nosoundcache
+cmdline_parm texture_budget_arg("-texture_budget", "Limits texture memory to this many MB, evicting the least recently used", AT_INT);	// Cmdline_texture_budget
 #ifdef WIN32
 cmdline_parm fix_registry("-fix_registry", NULL, AT_NONE);
 #endif
@@ -453,6 +466,12 @@ bool Cmdline_no_geo_sdr_effects = false;
 bool Cmdline_set_cpu_affinity = false;
 bool Cmdline_nograb = false;
 bool Cmdline_noshadercache = false;
+bool Cmdline_texture_cache = false;
+bool Cmdline_nomodelcache = false;
+bool Cmdline_notablecache = false;
+bool Cmdline_nomissioncache = false;
+bool Cmdline_nosoundcache = false;
+int Cmdline_texture_budget = 0;
 #ifdef WIN32
 bool Cmdline_alternate_registry_path = false;
 #endif
@@ -473,6 +492,7 @@ cmdline_parm fullscreen_window_arg("-fullscreen_window", "Fullscreen/borderless
 cmdline_parm res_arg("-res", "Resolution, formatted like 1600x900", AT_STRING);
 cmdline_parm center_res_arg("-center_res", "Resolution of center monitor, formatted like 1600x900", AT_STRING);
 cmdline_parm verify_vps_arg("-verify_vps", NULL, AT_NONE);	// Cmdline_verify_vps  -- spew VP crcs to vp_crcs.txt
+cmdline_parm warm_texture_cache_arg("-warm_texture_cache", NULL, AT_NONE);	// Cmdline_warm_texture_cache  -- compress all textures into the texture cache
 cmdline_parm parse_cmdline_only(PARSE_COMMAND_LINE_STRING, "Ignore any cmdline_fso.cfg files", AT_NONE);
 cmdline_parm reparse_mainhall_arg("-reparse_mainhall", NULL, AT_NONE); //Cmdline_reparse_mainhall
 cmdline_parm frame_profile_write_file("-profile_write_file", NULL, AT_NONE); // Cmdline_profile_write_file
@@ -480,6 +500,7 @@ cmdline_parm no_unfocused_pause_arg("-no_unfocused_pause", NULL, AT_NONE); //Cmd
 cmdline_parm benchmark_mode_arg("-benchmark_mode", NULL, AT_NONE); //Cmdline_benchmark_mode
 cmdline_parm noninteractive_arg("-noninteractive", NULL, AT_NONE); //Cmdline_noninteractive
 cmdline_parm json_profiling("-json_profiling", NULL, AT_NONE); //Cmdline_json_profiling
+cmdline_parm binary_profiling("-binary_profiling", NULL, AT_NONE); //Cmdline_binary_profiling
 cmdline_parm show_video_info("-show_video_info", NULL, AT_NONE); //Cmdline_show_video_info
 cmdline_parm frame_profile_arg("-profile_frame_time", NULL, AT_NONE); //Cmdline_frame_profile
 cmdline_parm debug_window_arg("-debug_window", NULL, AT_NONE);	// Cmdline_debug_window
@@ -505,12 +526,14 @@ int Cmdline_fullscreen_window = 0;
 char *Cmdline_res = 0;
 char *Cmdline_center_res = 0;
 int Cmdline_verify_vps = 0;
+bool Cmdline_warm_texture_cache = false;
 int Cmdline_reparse_mainhall = 0;
 bool Cmdline_profile_write_file = false;
 bool Cmdline_no_unfocus_pause = false;
 bool Cmdline_benchmark_mode = false;
 bool Cmdline_noninteractive = false;
 bool Cmdline_json_profiling = false;
+bool Cmdline_binary_profiling = false;
 bool Cmdline_frame_profile = false;
 bool Cmdline_show_video_info = false;
 bool Cmdline_debug_window = false;
@@ -1983,6 +2006,36 @@ bool SetCmdlineParams()
 		Cmdline_noshadercache = true;
 	}
 
+	if (texture_cache_arg.found())
+	{
+		Cmdline_texture_cache = true;
+	}
+
+	if (nomodelcache_arg.found())
+	{
+		Cmdline_nomodelcache = true;
+	}
+
+	if (notablecache_arg.found())
+	{
+		Cmdline_notablecache = true;
+	}
+
+	if (nomissioncache_arg.found())
+	{
+		Cmdline_nomissioncache = true;
+	}
+
+	if (nosoundcache_arg.found())
+	{
+		Cmdline_nosoundcache = true;
+	}
+
+	if (texture_budget_arg.found())
+	{
+		Cmdline_texture_budget = MAX(texture_budget_arg.get_int(), 0);
+	}
+
 	if (portable_mode.found())
 	{
 		Cmdline_portable_mode = true;
@@ -2025,6 +2078,9 @@ bool SetCmdlineParams()
 	if ( verify_vps_arg.found() )
 		Cmdline_verify_vps = 1;
 
+	if ( warm_texture_cache_arg.found() )
+		Cmdline_warm_texture_cache = true;
+
 	if ( no3dsound_arg.found() )
 		Cmdline_no_3d_sound = 1;
 
@@ -2138,6 +2194,11 @@ bool SetCmdlineParams()
 		Cmdline_json_profiling = true;
 	}
 
+	if (binary_profiling.found())
+	{
+		Cmdline_binary_profiling = true;
+	}
+
 	if (frame_profile_arg.found() )
 	{
 		Cmdline_frame_profile = true;
@@ -122,6 +122,12 @@ extern bool Cmdline_no_geo_sdr_effects;
 extern bool Cmdline_set_cpu_affinity;
 extern bool Cmdline_nograb;
 extern bool Cmdline_noshadercache;
+extern bool Cmdline_texture_cache;
+extern bool Cmdline_nomodelcache;
+extern bool Cmdline_notablecache;
+extern bool Cmdline_nomissioncache;
+extern bool Cmdline_nosoundcache;
+extern int Cmdline_texture_budget;
 #ifdef WIN32
 extern bool Cmdline_alternate_registry_path;
 #endif
@@ -138,12 +144,14 @@ extern int Cmdline_show_pos;
 extern int Cmdline_show_stats;
 extern int Cmdline_save_render_targets;
 extern int Cmdline_verify_vps;
+extern bool Cmdline_warm_texture_cache;
 extern int Cmdline_reparse_mainhall;
 extern bool Cmdline_profile_write_file;
 extern bool Cmdline_no_unfocus_pause;
 extern bool Cmdline_benchmark_mode;
 extern bool Cmdline_noninteractive;
 extern bool Cmdline_json_profiling;
+extern bool Cmdline_binary_profiling;
 extern bool Cmdline_frame_profile;
 extern bool Cmdline_show_video_info;
 extern bool Cmdline_debug_window;
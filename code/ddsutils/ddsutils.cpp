@@ -1,5 +1,6 @@
 
 #include "ddsutils/ddsutils.h"
+#include "ddsutils/dxtc.h"
 #include "cfile/cfile.h"
 #include "osapi/osregistry.h"
 
@@ -322,8 +323,8 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 }
 
 // save some image data as a DDS image
-// NOTE: we only support, uncompressed, 24-bit RGB and 32-bit RGBA images here!!
-void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data, int cubemap, const char *filename)
+// NOTE: we only support uncompressed 24-bit RGB and 32-bit RGBA images, or already compressed DXT1/DXT5 data, here!!
+void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data, int cubemap, const char *filename, int compression_type)
 {
 	DDSURFACEDESC2 dds_header;
 	char real_filename[MAX_FILENAME_LEN];
@@ -379,12 +380,22 @@ void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data
 	// we have a filename and file handle, so now lets create our DDS header...
 	memset( &dds_header, 0, sizeof(DDSURFACEDESC2) );
 
-	uint flags = (DDSD_CAPS | DDSD_PITCH | DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT);
+	uint flags = (DDSD_CAPS | DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT);
 	uint pixel_flags = DDPF_RGB;
 	uint caps1 = DDSCAPS_TEXTURE;
 	uint caps2 = 0;
+	bool compressed = (compression_type == DDS_DXT1) || (compression_type == DDS_DXT5);
 
-	if (bpp == 32) {
+	Assert( compressed || (compression_type == DDS_UNCOMPRESSED) );
+
+	if (compressed) {
+		flags |= DDSD_LINEARSIZE;
+		pixel_flags = DDPF_FOURCC;
+	} else {
+		flags |= DDSD_PITCH;
+	}
+
+	if ( !compressed && (bpp == 32) ) {
 		pixel_flags |= DDPF_ALPHAPIXELS;
 	}
 
@@ -408,12 +419,18 @@ void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data
 
 	dds_header.ddpfPixelFormat.dwSize				= 32;
 	dds_header.ddpfPixelFormat.dwFlags				= pixel_flags;
-	dds_header.ddpfPixelFormat.dwFourCC				= 0;
-	dds_header.ddpfPixelFormat.dwRGBBitCount		= bpp;
-	dds_header.ddpfPixelFormat.dwRBitMask			= 0x00ff0000;
-	dds_header.ddpfPixelFormat.dwGBitMask			= 0x0000ff00;
-	dds_header.ddpfPixelFormat.dwBBitMask			= 0x000000ff;
-	dds_header.ddpfPixelFormat.dwRGBAlphaBitMask	= (bpp == 32) ? 0xff000000 : 0x00000000;
+
+	if (compressed) {
+		dds_header.dwPitchOrLinearSize					= (uint)dxtc_compressed_size(width, height, compression_type);
+		dds_header.ddpfPixelFormat.dwFourCC				= (compression_type == DDS_DXT1) ? FOURCC_DXT1 : FOURCC_DXT5;
+	} else {
+		dds_header.ddpfPixelFormat.dwFourCC				= 0;
+		dds_header.ddpfPixelFormat.dwRGBBitCount		= bpp;
+		dds_header.ddpfPixelFormat.dwRBitMask			= 0x00ff0000;
+		dds_header.ddpfPixelFormat.dwGBitMask			= 0x0000ff00;
+		dds_header.ddpfPixelFormat.dwBBitMask			= 0x000000ff;
+		dds_header.ddpfPixelFormat.dwRGBAlphaBitMask	= (bpp == 32) ? 0xff000000 : 0x00000000;
+	}
 
 	dds_header.ddsCaps.dwCaps1		= caps1;
 	dds_header.ddsCaps.dwCaps2		= caps2;
@@ -437,7 +454,11 @@ void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data
 
 	for (int i = 0; i < faces; i++) {
 		for (int j = 0; j < num_mipmaps; j++) {
-			f_size = (f_width * f_height * (bpp >> 3));
+			if (compressed) {
+				f_size = (int)dxtc_compressed_size(f_width, f_height, compression_type);
+			} else {
+				f_size = (f_width * f_height * (bpp >> 3));
+			}
 
 			cfwrite(data + f_offset, 1, f_size, image);
 
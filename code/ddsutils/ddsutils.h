@@ -145,7 +145,8 @@ int dds_read_header(const char *filename, CFILE *img_cfp = NULL, int *width = 0,
 int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp = NULL, int cf_type = CF_TYPE_ANY);
 
 // writes a DDS file using given data
-void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data = NULL, int cubemap = 0, const char *filename = NULL);
+// 'compression_type' is DDS_UNCOMPRESSED, or DDS_DXT1/DDS_DXT5 for data which is already block compressed
+void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data = NULL, int cubemap = 0, const char *filename = NULL, int compression_type = DDS_UNCOMPRESSED);
 
 //returns a string from a DDS error code
 const char *dds_error_string(int code);
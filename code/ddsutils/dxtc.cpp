@@ -0,0 +1,272 @@
+
+#include "ddsutils/dxtc.h"
+#include "ddsutils/ddsutils.h"
+#include "math/floating.h"
+
+#include <climits>
+
+
+/*	Block layout (see the S3TC spec):
+ *		DXT1	color block (8 bytes)
+ *		DXT5	alpha block (8 bytes), followed by a color block (8 bytes)
+ *
+ *	Colour endpoints are picked along the principal axis of the block's colours and inset
+ *	slightly, which is the usual "range fit" used by fast encoders.  It isn't as good as an
+ *	iterative cluster fit, but it's quick enough to run over a whole mod.
+ */
+
+// a 4x4 block of pixels, in BGRA order
+typedef struct dxtc_block {
+	ubyte	px[16][4];
+} dxtc_block;
+
+// gather a 4x4 block, replicating the edge pixels of images which aren't a multiple of 4 in size
+static void dxtc_get_block(const ubyte *bgra, int width, int height, int bx, int by, dxtc_block *block)
+{
+	int x, y, sx, sy;
+
+	for (y = 0; y < 4; y++) {
+		sy = MIN(by + y, height - 1);
+
+		for (x = 0; x < 4; x++) {
+			sx = MIN(bx + x, width - 1);
+
+			memcpy(block->px[y*4 + x], bgra + (sy*width + sx) * 4, 4);
+		}
+	}
+}
+
+// quantize an rgb colour to 5:6:5
+static ushort dxtc_pack_565(const float *rgb)
+{
+	int r = fl2ir(rgb[0] * 31.0f / 255.0f);
+	int g = fl2ir(rgb[1] * 63.0f / 255.0f);
+	int b = fl2ir(rgb[2] * 31.0f / 255.0f);
+
+	CLAMP(r, 0, 31);
+	CLAMP(g, 0, 63);
+	CLAMP(b, 0, 31);
+
+	return (ushort)((r << 11) | (g << 5) | b);
+}
+
+// expand a 5:6:5 colour the same way the hardware does
+static void dxtc_unpack_565(ushort c, int *rgb)
+{
+	int r = (c >> 11) & 31;
+	int g = (c >> 5) & 63;
+	int b = c & 31;
+
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+// 4 colour (opaque) colour block
+static void dxtc_compress_color_block(const dxtc_block *block, ubyte *out)
+{
+	float rgb[16][3];
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	float axis[3];
+	float ends[2][3];
+	float d, min_d, max_d;
+	int palette[4][3];
+	int min_i = 0, max_i = 0;
+	ushort color0, color1;
+	uint indices = 0;
+	int i, k;
+
+	for (i = 0; i < 16; i++) {
+		rgb[i][0] = block->px[i][2];
+		rgb[i][1] = block->px[i][1];
+		rgb[i][2] = block->px[i][0];
+
+		for (k = 0; k < 3; k++) {
+			mean[k] += rgb[i][k];
+		}
+	}
+
+	for (k = 0; k < 3; k++) {
+		mean[k] /= 16.0f;
+	}
+
+	// covariance of the block's colours: rr, rg, rb, gg, gb, bb
+	for (i = 0; i < 16; i++) {
+		float r = rgb[i][0] - mean[0];
+		float g = rgb[i][1] - mean[1];
+		float b = rgb[i][2] - mean[2];
+
+		cov[0] += r*r;
+		cov[1] += r*g;
+		cov[2] += r*b;
+		cov[3] += g*g;
+		cov[4] += g*b;
+		cov[5] += b*b;
+	}
+
+	// start from the covariance column with the biggest variance, since a fixed guess like
+	// (1,1,1) can be exactly perpendicular to the axis we want (ie, a red/blue block)
+	if ( (cov[0] >= cov[3]) && (cov[0] >= cov[5]) ) {
+		axis[0] = cov[0]; axis[1] = cov[1]; axis[2] = cov[2];
+	} else if (cov[3] >= cov[5]) {
+		axis[0] = cov[1]; axis[1] = cov[3]; axis[2] = cov[4];
+	} else {
+		axis[0] = cov[2]; axis[1] = cov[4]; axis[2] = cov[5];
+	}
+
+	// a few rounds of power iteration get us close enough to the principal axis
+	for (k = 0; k < 4; k++) {
+		float x = axis[0]*cov[0] + axis[1]*cov[1] + axis[2]*cov[2];
+		float y = axis[0]*cov[1] + axis[1]*cov[3] + axis[2]*cov[4];
+		float z = axis[0]*cov[2] + axis[1]*cov[4] + axis[2]*cov[5];
+		float len = MAX(fabsf(x), MAX(fabsf(y), fabsf(z)));
+
+		// flat block
+		if (len < 1e-6f) {
+			break;
+		}
+
+		axis[0] = x / len;
+		axis[1] = y / len;
+		axis[2] = z / len;
+	}
+
+	// the endpoints are the pixels furthest apart along the axis
+	min_d = max_d = rgb[0][0]*axis[0] + rgb[0][1]*axis[1] + rgb[0][2]*axis[2];
+
+	for (i = 1; i < 16; i++) {
+		d = rgb[i][0]*axis[0] + rgb[i][1]*axis[1] + rgb[i][2]*axis[2];
+
+		if (d < min_d) {
+			min_d = d;
+			min_i = i;
+		} else if (d > max_d) {
+			max_d = d;
+			max_i = i;
+		}
+	}
+
+	// inset them a little, which lowers the error of the interpolated colours
+	for (k = 0; k < 3; k++) {
+		float inset = (rgb[max_i][k] - rgb[min_i][k]) / 16.0f;
+
+		ends[0][k] = rgb[max_i][k] - inset;
+		ends[1][k] = rgb[min_i][k] + inset;
+	}
+
+	color0 = dxtc_pack_565(ends[0]);
+	color1 = dxtc_pack_565(ends[1]);
+
+	// color0 > color1 selects 4 colour mode
+	if (color0 < color1) {
+		ushort tmp = color0;
+		color0 = color1;
+		color1 = tmp;
+	}
+
+	// with equal endpoints every index can stay 0
+	if (color0 != color1) {
+		dxtc_unpack_565(color0, palette[0]);
+		dxtc_unpack_565(color1, palette[1]);
+
+		for (k = 0; k < 3; k++) {
+			palette[2][k] = (2*palette[0][k] + palette[1][k]) / 3;
+			palette[3][k] = (palette[0][k] + 2*palette[1][k]) / 3;
+		}
+
+		for (i = 0; i < 16; i++) {
+			int best = 0;
+			int best_dist = INT_MAX;
+
+			for (k = 0; k < 4; k++) {
+				int dr = fl2i(rgb[i][0]) - palette[k][0];
+				int dg = fl2i(rgb[i][1]) - palette[k][1];
+				int db = fl2i(rgb[i][2]) - palette[k][2];
+				int dist = dr*dr + dg*dg + db*db;
+
+				if (dist < best_dist) {
+					best_dist = dist;
+					best = k;
+				}
+			}
+
+			indices |= (uint)best << (i * 2);
+		}
+	}
+
+	out[0] = (ubyte)(color0 & 0xff);
+	out[1] = (ubyte)(color0 >> 8);
+	out[2] = (ubyte)(color1 & 0xff);
+	out[3] = (ubyte)(color1 >> 8);
+	out[4] = (ubyte)(indices & 0xff);
+	out[5] = (ubyte)((indices >> 8) & 0xff);
+	out[6] = (ubyte)((indices >> 16) & 0xff);
+	out[7] = (ubyte)(indices >> 24);
+}
+
+// 8 value interpolated alpha block
+static void dxtc_compress_alpha_block(const dxtc_block *block, ubyte *out)
+{
+	int a0 = 0, a1 = 255;
+	std::uint64_t bits = 0;
+	int i;
+
+	for (i = 0; i < 16; i++) {
+		a0 = MAX(a0, (int)block->px[i][3]);
+		a1 = MIN(a1, (int)block->px[i][3]);
+	}
+
+	// a0 > a1 selects 8 value mode, with equal values every index can stay 0
+	if (a0 > a1) {
+		int range = a0 - a1;
+
+		for (i = 0; i < 16; i++) {
+			// nearest step along the ramp, 0 is a0 and 7 is a1
+			int step = ((a0 - block->px[i][3]) * 14 + range) / (range * 2);
+			int code = (step == 0) ? 0 : ((step == 7) ? 1 : step + 1);
+
+			bits |= (std::uint64_t)code << (i * 3);
+		}
+	}
+
+	out[0] = (ubyte)a0;
+	out[1] = (ubyte)a1;
+
+	for (i = 0; i < 6; i++) {
+		out[2 + i] = (ubyte)((bits >> (i * 8)) & 0xff);
+	}
+}
+
+size_t dxtc_compressed_size(int width, int height, int compression_type)
+{
+	Assert( (compression_type == DDS_DXT1) || (compression_type == DDS_DXT5) );
+
+	size_t blocks_w = (size_t)MAX(1, (width + 3) / 4);
+	size_t blocks_h = (size_t)MAX(1, (height + 3) / 4);
+
+	return blocks_w * blocks_h * ((compression_type == DDS_DXT1) ? 8 : 16);
+}
+
+void dxtc_compress_image(const ubyte *bgra, int width, int height, int compression_type, ubyte *out)
+{
+	dxtc_block block;
+	int bx, by;
+
+	Assert( (compression_type == DDS_DXT1) || (compression_type == DDS_DXT5) );
+	Assert( (width > 0) && (height > 0) );
+
+	for (by = 0; by < height; by += 4) {
+		for (bx = 0; bx < width; bx += 4) {
+			dxtc_get_block(bgra, width, height, bx, by, &block);
+
+			if (compression_type == DDS_DXT5) {
+				dxtc_compress_alpha_block(&block, out);
+				out += 8;
+			}
+
+			dxtc_compress_color_block(&block, out);
+			out += 8;
+		}
+	}
+}
@@ -0,0 +1,19 @@
+// CPU side DXT (BC1/BC3) block compression, used to build block compressed
+// copies of textures which only exist as PNG/TGA/JPG
+
+#ifndef __DXTC_H
+#define __DXTC_H
+
+#include "globalincs/pstypes.h"
+
+
+// size in bytes of a single level of a compressed image
+// 'compression_type' is DDS_DXT1 or DDS_DXT5
+size_t dxtc_compressed_size(int width, int height, int compression_type);
+
+// compresses a single level of a 32-bit BGRA image into 'out', which must hold at least
+// dxtc_compressed_size() bytes.  images which aren't a multiple of 4 in size are edge padded
+// 'compression_type' is DDS_DXT1 or DDS_DXT5, alpha is ignored for DXT1
+void dxtc_compress_image(const ubyte *bgra, int width, int height, int compression_type, ubyte *out);
+
+#endif //__DXTC_H
@@ -21,6 +21,7 @@
 #include "render/batching.h"
 #include "ship/ship.h"
 #include "tracing/Monitor.h"
+#include "utils/name_index.h"
 
 #include <cstdlib>
 
@@ -42,6 +43,9 @@ int fireball_used[MAX_FIREBALL_TYPES];
 int Num_fireballs = 0;
 int Num_fireball_types = 0;
 
+static util::name_index Fireball_info_ids([]() { return Num_fireball_types; },
+                                          [](int index) -> const char* { return Fireball_info[index].unique_id; });
+
 bool fireballs_inited = false;
 bool fireballs_parsed = false;
 
@@ -221,11 +225,7 @@ void fireball_info_clear(fireball_info *fb)
 
 int fireball_info_lookup(const char *unique_id)
 {
-	for (int i = 0; i < Num_fireball_types; ++i)
-		if (!stricmp(Fireball_info[i].unique_id, unique_id))
-			return i;
-
-	return -1;
+	return Fireball_info_ids.find(unique_id);
 }
 
 /**
@@ -318,7 +318,11 @@ static void parse_fireball_tbl(const char *table_filename)
 
 			// copy over what we already parsed
 			if (strlen(unique_id) > 0)
+			{
 				strcpy_s(fi->unique_id, unique_id);
+				if (existing_idx >= 0)
+					Fireball_info_ids.add(existing_idx);
+			}
 			strcpy_s(fi->lod[0].filename, fireball_filename);
 
 			// Do we have a LOD num?
@@ -378,6 +382,7 @@ void fireball_parse_tbl()
 	// every newly parsed fireball_info will get cleared before being added
 	// must do this outside of parse_fireball_tbl because it's called twice
 	Num_fireball_types = 0;
+	Fireball_info_ids.invalidate();
 
 	parse_fireball_tbl("fireball.tbl");
 
@@ -797,7 +802,7 @@ int fireball_create(vec3d *pos, int fireball_type, int render_type, int parent_o
 		}
 	}
 
-	if ( (Num_fireballs >= MAX_FIREBALLS) || (Num_objects >= MAX_OBJECTS) )	{
+	if ( (Num_fireballs >= MAX_FIREBALLS) || (Num_objects >= objects_size()) )	{
 
 		// out of slots, so free one up.
 		n = fireball_free_one();
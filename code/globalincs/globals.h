@@ -68,7 +68,7 @@
 #define MAX_COMPLETE_ESCORT_LIST	20
              
 // from weapon.h
-#define MAX_WEAPONS	2000
+#define MAX_WEAPONS	2000		// initial size of the Weapons pool, it grows past this when needed
 
 #define MAX_WEAPON_TYPES				300
 
@@ -80,7 +80,7 @@
 #define MAX_POLYGON_MODELS  300
 
 // object.h
-#define MAX_OBJECTS			3500		
+#define MAX_OBJECTS			3500		// initial size of the Objects pool, it grows past this when needed (except in Fred)
 
 // from weapon.h (and beam.h)
 #define MAX_BEAM_SECTIONS				5
@@ -2636,6 +2636,9 @@ void gr_flip(bool execute_scripting)
 	// Do per frame operations on the matrix state
 	gr_matrix_on_frame();
 
+	// Keep the resident textures within budget
+	bm_residency_do_frame();
+
 	gr_reset_clip();
 
 	mouse_reset_deltas();
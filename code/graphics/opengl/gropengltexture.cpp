@@ -263,6 +263,10 @@ int opengl_free_texture(tcache_slot_opengl *t)
 	// First mark this as unused and then check if all frames are unused. If that's the case we can free the texture array
 	t->used = false;
 
+	if (t->bitmap_handle >= 0) {
+		bm_residency_set_size(t->bitmap_handle, 0);
+	}
+
 	// Check if the bitmap handle is valid
 	if (t->bitmap_handle >= 0) {
 		int num_frames = 0;
@@ -676,6 +680,8 @@ static int opengl_texture_set_level(int bitmap_handle, int bitmap_type, int bmap
 
 	GL_textures_in_frame += tSlot->size;
 
+	bm_residency_set_size(bitmap_handle, (size_t)tSlot->size);
+
 	GL_CHECK_FOR_ERRORS("end of create_texture_sub()");
 
 	return ret_val;
@@ -1056,7 +1062,11 @@ int gr_opengl_tcache_set_internal(int bitmap_handle, int bitmap_type, float *u_s
 	{
 		GL_state.Texture.SetActiveUnit(tex_unit);
 
+		bm_residency_touch(bitmap_handle, false);
+
 		ret_val = opengl_create_texture( bitmap_handle, bitmap_type, t );
+	} else {
+		bm_residency_touch(bitmap_handle, true);
 	}
 
 	// everything went ok
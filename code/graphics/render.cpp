@@ -964,6 +964,21 @@ void gr_circle(int xc, int yc, int d, int resize_mode) {
 
 	endDrawing(path);
 }
+void gr_circles(const int* xc, const int* yc, size_t count, int d, int resize_mode) {
+	if (count == 0) {
+		return;
+	}
+
+	auto path = beginDrawing(resize_mode);
+
+	for (size_t i = 0; i < count; ++i) {
+		path->circle(i2fl(xc[i]), i2fl(yc[i]), d / 2.0f);
+	}
+	path->setFillColor(&gr_screen.current_color);
+	path->fill();
+
+	endDrawing(path);
+}
 void gr_unfilled_circle(int xc, int yc, int d, int resize_mode) {
 	auto path = beginDrawing(resize_mode);
 
@@ -134,6 +134,18 @@ void gr_shade(int x, int y, int w, int h, int resize_mode = GR_RESIZE_FULL);
  * @param resize_mode The mode for translating the screen positions
  */
 void gr_circle(int xc, int yc, int d, int resize_mode = GR_RESIZE_FULL);
+/**
+ * @brief Draws many filled circles of the same size with the current color
+ *
+ * All circles are filled at once, which is a lot cheaper than calling gr_circle() for each of them.
+ *
+ * @param xc The center x-positions of the circles
+ * @param yc The center y-positions of the circles
+ * @param count The number of circles
+ * @param d The diameter of the circles
+ * @param resize_mode The mode for translating the screen positions
+ */
+void gr_circles(const int* xc, const int* yc, size_t count, int d, int resize_mode = GR_RESIZE_FULL);
 /**
  * @brief Draws an unfilled circle with the current color
  * @param xc The center x-position of the circle
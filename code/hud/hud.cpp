@@ -951,6 +951,42 @@ void HudGauge::renderCircle(int x, int y, int diameter, bool filled)
 	gr_reset_screen_scale();
 }
 
+void HudGauge::renderCircles(const int *x, const int *y, size_t count, int diameter)
+{
+	int nx = 0, ny = 0;
+
+	if ( gr_screen.rendering_to_texture != -1 ) {
+		gr_set_screen_scale(canvas_w, canvas_h, -1, -1, target_w, target_h, target_w, target_h, true);
+	} else {
+		if ( reticle_follow ) {
+			nx = HUD_nose_x;
+			ny = HUD_nose_y;
+
+			gr_resize_screen_pos(&nx, &ny);
+			gr_set_screen_scale(base_w, base_h);
+			gr_unsize_screen_pos(&nx, &ny);
+		} else {
+			gr_set_screen_scale(base_w, base_h);
+		}
+	}
+
+	if (nx == 0 && ny == 0) {
+		gr_circles(x, y, count, diameter);
+	} else {
+		SCP_vector<int> offset_x(x, x + count);
+		SCP_vector<int> offset_y(y, y + count);
+
+		for (size_t i = 0; i < count; ++i) {
+			offset_x[i] += nx;
+			offset_y[i] += ny;
+		}
+
+		gr_circles(offset_x.data(), offset_y.data(), count, diameter);
+	}
+
+	gr_reset_screen_scale();
+}
+
 void HudGauge::setClip(int x, int y, int w, int h)
 {
 	int hx = fl2i(HUD_offset_x);
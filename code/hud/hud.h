@@ -319,6 +319,7 @@ public:
 	void renderGradientLine(int x1, int y1, int x2, int y2);
 	void renderRect(int x, int y, int w, int h);
 	void renderCircle(int x, int y, int diameter, bool filled = true);
+	void renderCircles(const int *x, const int *y, size_t count, int diameter);
 
 	void unsize(int *x, int *y);
 	void unsize(float *x, float *y);
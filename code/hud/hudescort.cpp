@@ -339,7 +339,7 @@ void HudGaugeEscort::renderIconDogfight(int x, int y, int index)
 
 	// can we get the player object?
 	objp = NULL;
-	if((Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP)){
+	if((Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < objects_size()) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP)){
 		objp = &Objects[Net_players[np_index].m_player->objnum];
 		if((objp->instance >= 0) && (objp->instance < MAX_SHIPS) && (Ships[objp->instance].ship_info_index >= 0) && (Ships[objp->instance].ship_info_index < MAX_SHIPS)){
 			//
@@ -493,8 +493,8 @@ void hud_create_complete_escort_list(escort_info *escorts, int *num_escorts)
 	// all others 
 	else {
 		for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-			Assert( so->objnum >= 0 && so->objnum < MAX_OBJECTS);
-			if((so->objnum < 0) || (so->objnum >= MAX_OBJECTS)){
+			Assert( so->objnum >= 0 && so->objnum < objects_size());
+			if((so->objnum < 0) || (so->objnum >= objects_size())){
 				continue;
 			}
 			objp = &Objects[so->objnum];
@@ -644,8 +644,8 @@ void merge_escort_lists(escort_info *complete_escorts, int num_complete_escorts)
 			Escort_ships[i] = complete_escorts[i];
 			// check all ships are valid
 			int objnum = Escort_ships[i].objnum;
-			Assert( objnum >=0 && objnum < MAX_OBJECTS );
-			if((objnum < 0) || (objnum >= MAX_OBJECTS)){
+			Assert( objnum >=0 && objnum < objects_size() );
+			if((objnum < 0) || (objnum >= objects_size())){
 				continue;
 			}
 			if ( !valid_hit_info[i] ) {
@@ -725,7 +725,7 @@ void hud_escort_cull_list()
 	else {
 		for ( i = 0; i < Num_escort_ships; i++ ) {
 			int objnum = Escort_ships[i].objnum;
-			Assert( objnum >=0 && objnum < MAX_OBJECTS );
+			Assert( objnum >=0 && objnum < objects_size() );
 
 			if ( Objects[objnum].flags[Object::Object_Flags::Should_be_dead] ) {
 				hud_setup_escort_list(0);
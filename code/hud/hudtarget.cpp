@@ -27,6 +27,7 @@
 #include "hud/hudshield.h"
 #include "hud/hudtarget.h"
 #include "hud/hudtargetbox.h"
+#include "hud/hudtargetcache.h"
 #include "iff_defs/iff_defs.h"
 #include "io/timer.h"
 #include "jumpnode/jumpnode.h"
@@ -488,8 +489,8 @@ ship_subsys *advance_subsys(ship_subsys *cur, int next_flag)
 // select a sorted turret subsystem on a ship if no other subsys has been selected
 void hud_maybe_set_sorted_turret_subsys(ship *shipp)
 {
-	Assert((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS));
-	if (!((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS))) {
+	Assert((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < objects_size()));
+	if (!((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < objects_size()))) {
 		return;
 	}
 	Assert(Objects[Player_ai->target_objnum].type == OBJ_SHIP);
@@ -1031,6 +1032,8 @@ void hud_init_ballistic_index()
 	}
 }
 
+static void hud_reset_live_turret_cache();
+
 // hud_init_targeting() will set the current target to point to the dummy node
 // in the object used list
 //
@@ -1055,6 +1058,9 @@ void hud_init_targeting()
 
 	hud_weapons_init();
 
+	hud_target_cache_invalidate();
+	hud_reset_live_turret_cache();
+
 	Min_warning_missile_dist = 2.5f*Player_obj->radius;
 	Max_warning_missile_dist = 1500.0f;
 
@@ -1255,27 +1261,6 @@ void hud_target_prev(int team_mask)
 	hud_target_common(team_mask, 0);
 }
 
-// -------------------------------------------------------------------
-// advance_missile_obj()
-//
-missile_obj *advance_missile_obj(missile_obj *mo, int next_flag)
-{
-	if (next_flag){
-		return GET_NEXT(mo);
-	}
-
-	return GET_LAST(mo);
-}
-
-ship_obj *advance_ship(ship_obj *so, int next_flag)
-{
-	if (next_flag){
-		return GET_NEXT(so);
-	}
-
-	return GET_LAST(so);
-}
-
 /// \brief Iterates down to and selects the next target in a linked list
 ///        fashion ordered from closest to farthest from the
 ///        attacked_object_number, returning the next valid target.
@@ -1310,6 +1295,25 @@ static object* select_next_target_by_distance(const bool targeting_from_closest_
         filter.set(Ship::Info_Flags::Navbuoy);
     }
 
+    if (attacked_object_number == -1) {
+        // The candidates are already sorted by distance, so this only has to look at the ships right behind the current
+        // target instead of measuring the distance to every ship
+        return hud_target_cache_cycle(hud_target_cache_ships(), Player_ai->target_objnum, targeting_from_closest_to_farthest, [&](object *objp) {
+            ship *shipp = &Ships[objp->instance];
+
+            if (should_be_ignored(shipp) || !iff_matches_mask(shipp->team, valid_team_mask)) {
+                return false;
+            }
+
+            // always ignore navbuoys and cargo
+            if ((Ship_info[shipp->ship_info_index].flags & filter).any_set()) {
+                return false;
+            }
+
+            return !hud_target_invalid_awacs(objp);
+        });
+    }
+
     float nearest_distance;
     if (targeting_from_closest_to_farthest) {
         nearest_distance = 1e20f;
@@ -1341,40 +1345,25 @@ static object* select_next_target_by_distance(const bool targeting_from_closest_
             continue;
         }
 
-
-        if (attacked_object_number == -1) {
-            // always ignore navbuoys and cargo
-            if ((Ship_info[prospective_victim_ship_ptr->ship_info_index].flags & filter).any_set()) {
-                continue;
-            }
-
-            if (hud_target_invalid_awacs(prospective_victim_ptr)) {
-                continue;
-            }
-
-            new_distance = hud_find_target_distance(prospective_victim_ptr, Player_obj);
-        }
-        else {
-            // Filter out any target that is not targeting the player  --Mastadon
-            if ((attacked_object_number == player_object_index) && (Ai_info[prospective_victim_ship_ptr->ai_index].target_objnum != player_object_index)) {
-                continue;
-            }
-            esct eval_ship_as_closest_target_args;
-            eval_ship_as_closest_target_args.attacked_objnum = attacked_object_number;
-            eval_ship_as_closest_target_args.check_all_turrets = (attacked_object_number == player_object_index);
-            eval_ship_as_closest_target_args.check_nearest_turret = FALSE;
-            // We don't ever filter our target selection to just bombers or fighters
-            // because the select next attacker logic doesn't.  --Mastadon
-            eval_ship_as_closest_target_args.filter = 0;
-            eval_ship_as_closest_target_args.team_mask = valid_team_mask;
-            // We always get the turret attacking, since that's how the select next
-            // attacker logic does it.  --Mastadon
-            eval_ship_as_closest_target_args.turret_attacking_target = 1;
-            eval_ship_as_closest_target_args.shipp = prospective_victim_ship_ptr;
-            evaluate_ship_as_closest_target(&eval_ship_as_closest_target_args);
-
-            new_distance = eval_ship_as_closest_target_args.min_distance;
+        // Filter out any target that is not targeting the player  --Mastadon
+        if ((attacked_object_number == player_object_index) && (Ai_info[prospective_victim_ship_ptr->ai_index].target_objnum != player_object_index)) {
+            continue;
         }
+        esct eval_ship_as_closest_target_args;
+        eval_ship_as_closest_target_args.attacked_objnum = attacked_object_number;
+        eval_ship_as_closest_target_args.check_all_turrets = (attacked_object_number == player_object_index);
+        eval_ship_as_closest_target_args.check_nearest_turret = FALSE;
+        // We don't ever filter our target selection to just bombers or fighters
+        // because the select next attacker logic doesn't.  --Mastadon
+        eval_ship_as_closest_target_args.filter = 0;
+        eval_ship_as_closest_target_args.team_mask = valid_team_mask;
+        // We always get the turret attacking, since that's how the select next
+        // attacker logic does it.  --Mastadon
+        eval_ship_as_closest_target_args.turret_attacking_target = 1;
+        eval_ship_as_closest_target_args.shipp = prospective_victim_ship_ptr;
+        evaluate_ship_as_closest_target(&eval_ship_as_closest_target_args);
+
+        new_distance = eval_ship_as_closest_target_args.min_distance;
 
 
         if (new_distance <= minimum_distance) {
@@ -1425,11 +1414,10 @@ static object* select_next_target_by_distance(const bool targeting_from_closest_
     return nearest_object_ptr;
 }
 
-ship_obj *get_ship_obj_ptr_from_index(int index);
 // -------------------------------------------------------------------
 // hud_target_missile()
 //
-// Target the closest locked missile that is locked on locked_obj
+// Target the next closest (or farther) hostile bomb, or bomber if there are no bombs
 //
 //	input:	source_obj	=>		pointer to object that fired weapon
 //				next_flag	=>		0 -> previous 1 -> next
@@ -1437,12 +1425,8 @@ ship_obj *get_ship_obj_ptr_from_index(int index);
 // NOTE: this function is only allows targeting bombs
 void hud_target_missile(object *source_obj, int next_flag)
 {
-	missile_obj	*end, *start, *mo;
-	object		*A, *target_objp;
+	object		*A;
 	ai_info		*aip;
-	weapon		*wp;
-	weapon_info	*wip;
-	int			target_found = 0;
 
 	if ( source_obj->type != OBJ_SHIP )
 		return;
@@ -1450,106 +1434,63 @@ void hud_target_missile(object *source_obj, int next_flag)
 	Assert( Ships[source_obj->instance].ai_index != -1 );
 	aip = &Ai_info[Ships[source_obj->instance].ai_index];
 
-	end = &Missile_obj_list;
+	// cycle through the bombs by distance, starting from the current target if that is a bomb too
+	int current_objnum = -1;
 	if (aip->target_objnum != -1) {
-		target_objp = &Objects[aip->target_objnum];
+		object *target_objp = &Objects[aip->target_objnum];
 		if ( target_objp->type == OBJ_WEAPON && Weapon_info[Weapons[target_objp->instance].weapon_info_index].subtype == WP_MISSILE )	{	// must be a missile
-			end = missile_obj_return_address(Weapons[target_objp->instance].missile_list_index);
+			current_objnum = aip->target_objnum;
 		}
 	}
 
-	start = advance_missile_obj(end, next_flag);
-
-	for ( mo = start; mo != end; mo = advance_missile_obj(mo, next_flag) ) {
-		if ( mo == &Missile_obj_list ){
-			continue;
-		}
-
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
-		A = &Objects[mo->objnum];
-
-		Assert(A->type == OBJ_WEAPON);
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
-		wp = &Weapons[A->instance];
-		wip = &Weapon_info[wp->weapon_info_index];
-
-		// only allow targeting of bombs
-		if ( !(wip->wi_flags[Weapon::Info_Flags::Can_be_targeted]) ) {
-			if ( !(wip->wi_flags[Weapon::Info_Flags::Bomb]) ) {
-				continue;
-			}
-		}
-
-		if (wp->lssm_stage==3){
-			continue;
+	// hud_target_cache_bombs() only has bombs and weapons which can be targeted
+	A = hud_target_cache_cycle(hud_target_cache_bombs(), current_objnum, (next_flag != 0), [](object *objp) {
+		if (Weapons[objp->instance].lssm_stage==3){
+			return false;
 		}
 
 		// only allow targeting of hostile bombs
-		if (!iff_x_attacks_y(Player_ship->team, obj_team(A))) {
-			continue;
-		}
-
-		if(hud_target_invalid_awacs(A)){
-			continue;
+		if (!iff_x_attacks_y(Player_ship->team, obj_team(objp))) {
+			return false;
 		}
 
-		// if we've reached here, got a new target
-		target_found = TRUE;
-		set_target_objnum( aip, OBJ_INDEX(A) );
-		hud_shield_hit_reset(A);
-		break;
-	}	// end for
+		return !hud_target_invalid_awacs(objp);
+	});
 
-	if ( !target_found ) {
+	if ( A == NULL ) {
 	// if no bomb is found, search for bombers
-		ship_obj *startShip, *so;
-
+		current_objnum = -1;
 		if ( (aip->target_objnum != -1)
 			&& (Objects[aip->target_objnum].type == OBJ_SHIP)
 			&& ((Ship_info[Ships[Objects[aip->target_objnum].instance].ship_info_index].flags[Ship::Info_Flags::Bomber])
 				|| (Objects[aip->target_objnum].flags[Object::Object_Flags::Targetable_as_bomb]))) {
-			int index = Ships[Objects[aip->target_objnum].instance].ship_list_index;
-			startShip = get_ship_obj_ptr_from_index(index);
-		} else {
-			startShip = GET_FIRST(&Ship_obj_list);
+			current_objnum = aip->target_objnum;
 		}
 
-		for (so=advance_ship(startShip, next_flag); so!=startShip; so=advance_ship(so, next_flag)) {
-			A = &Objects[so->objnum];
-
-			// don't look at header
-			if (so == &Ship_obj_list) {
-				continue;
-			}
-
+		A = hud_target_cache_cycle(hud_target_cache_ships(), current_objnum, (next_flag != 0), [](object *objp) {
 			// only allow targeting of hostile bombs
-			if (!iff_x_attacks_y(Player_ship->team, obj_team(A))) {
-				continue;
+			if (!iff_x_attacks_y(Player_ship->team, obj_team(objp))) {
+				return false;
 			}
 
-			if(hud_target_invalid_awacs(A)){
-				continue;
+			if(hud_target_invalid_awacs(objp)){
+				return false;
 			}
 
 			// check if ship type is bomber
-			if ( !(Ship_info[Ships[A->instance].ship_info_index].flags[Ship::Info_Flags::Bomber]) && !(A->flags[Object::Object_Flags::Targetable_as_bomb]) ) {
-				continue;
+			if ( !(Ship_info[Ships[objp->instance].ship_info_index].flags[Ship::Info_Flags::Bomber]) && !(objp->flags[Object::Object_Flags::Targetable_as_bomb]) ) {
+				return false;
 			}
 
 			// check if ignore
-			if ( should_be_ignored(&Ships[A->instance]) ){
-				continue;
-			}
-
-			// found a good one
-			target_found = TRUE;
-			set_target_objnum( aip, OBJ_INDEX(A) );
-			hud_shield_hit_reset(A);
-			break;
-		}
+			return !should_be_ignored(&Ships[objp->instance]);
+		});
 	}
 
-	if ( !target_found ) {
+	if ( A != NULL ) {
+		set_target_objnum( aip, OBJ_INDEX(A) );
+		hud_shield_hit_reset(A);
+	} else {
 		snd_play( gamesnd_get_game_sound(GameSounds::TARGET_FAIL), 0.0f );
 	}
 }
@@ -1732,56 +1673,47 @@ int turret_compare_func(const void *e1, const void *e2)
 
 extern bool turret_weapon_has_flags(ship_weapon *swp, Weapon::Info_Flags flags);
 extern bool turret_weapon_has_subtype(ship_weapon *swp, int subtype);
-// target the next/prev live turret on the current target
-// auto_advance from hud_update_closest_turret
-void hud_target_live_turret(int next_flag, int auto_advance, int only_player_target)
-{
-	ship_subsys	*A;
-	ship_subsys	*live_turret=NULL;
-	ship			*target_shipp;
-	object		*objp;
-	eval_next_turret ent[MAX_MODEL_SUBSYSTEMS];
-	int num_live_turrets = 0;
 
-	// make sure we're targeting a ship
-	if (Player_ai->target_objnum == -1 && !auto_advance) {
-		snd_play(gamesnd_get_game_sound(GameSounds::TARGET_FAIL));
-		return;
-	}
+// The live turrets of the player's target, sorted by type and distance. hud_update_closest_turret() asks for these
+// every frame and the targeting keys may ask again in the same frame, so they are only evaluated once per frame.
+typedef struct live_turret_cache {
+	int frame = -1;
+	int objnum = -1;
+	int signature = -1;
+	int only_player_target = 0;
+	vec3d view_pos = vmd_zero_vector;
 
-	// only targeting subsystems on ship
-	if ((Objects[Player_ai->target_objnum].type != OBJ_SHIP) && (!auto_advance)) {
-		snd_play( gamesnd_get_game_sound(GameSounds::TARGET_FAIL));
-		return;
-	}
+	ship_subsys *straight_ahead = NULL;	// first turret within 3 degrees of the player's heading, if !only_player_target
+	SCP_vector<eval_next_turret> turrets;
+} live_turret_cache;
 
-	// set some pointers
-	objp = &Objects[Player_ai->target_objnum];
-	target_shipp = &Ships[objp->instance];
+static live_turret_cache Live_turret_cache;
 
-	// set timestamp
-	int timestamp_val = 0;
-	if (!auto_advance) {
-		timestamp_val = Target_next_turret_timestamp;
-		Target_next_turret_timestamp = timestamp(TURRET_RESET);
-	}
+static void hud_reset_live_turret_cache()
+{
+	Live_turret_cache.frame = -1;
+	Live_turret_cache.turrets.clear();
+}
 
-	// If no target is selected, then simply target the closest (or facing) turret
-	int last_subsys_turret = FALSE;
-	if (Player_ai->targeted_subsys != NULL) {
-		if (Player_ai->targeted_subsys->system_info->type == SUBSYSTEM_TURRET) {
-			if (Player_ai->targeted_subsys->weapons.num_primary_banks > 0 || Player_ai->targeted_subsys->weapons.num_secondary_banks > 0) {
-				last_subsys_turret = TRUE;
-			}
-		}
+static const live_turret_cache &hud_get_live_turrets(object *objp, int only_player_target)
+{
+	live_turret_cache &cache = Live_turret_cache;
+
+	if ( (cache.frame == Framecount) && (cache.objnum == OBJ_INDEX(objp)) && (cache.signature == objp->signature)
+		&& (cache.only_player_target == only_player_target) && vm_vec_same(&cache.view_pos, &View_position) ) {
+		return cache;
 	}
 
-	// do we want the closest turret (or the one our ship is pointing at)
-	int get_closest_turret = (auto_advance || !last_subsys_turret || timestamp_elapsed(timestamp_val));
+	cache.frame = Framecount;
+	cache.objnum = OBJ_INDEX(objp);
+	cache.signature = objp->signature;
+	cache.only_player_target = only_player_target;
+	cache.view_pos = View_position;
+	cache.straight_ahead = NULL;
+	cache.turrets.clear();
 
-	// initialize eval struct
-	memset(ent,0, sizeof(ent));
-	int use_straight_ahead_turret = FALSE;
+	ship *target_shipp = &Ships[objp->instance];
+	ship_subsys *A;
 
 	// go through list of turrets
 	for (A=GET_FIRST(&target_shipp->subsys_list); A!=END_OF_LIST(&target_shipp->subsys_list); A=GET_NEXT(A))  {
@@ -1796,6 +1728,7 @@ void hud_target_live_turret(int next_flag, int auto_advance, int only_player_tar
 				if ( !only_player_target || (A->turret_enemy_objnum == OBJ_INDEX(Player_obj)) ) {
 					vec3d gsubpos, vec_to_subsys;
 					float distance, dot;
+					eval_next_turret ent;
 					// get world pos of subsystem and its distance
 					get_subsystem_world_pos(objp, A, &gsubpos);
 					distance = vm_vec_normalized_dir(&vec_to_subsys, &gsubpos, &View_position);
@@ -1803,25 +1736,24 @@ void hud_target_live_turret(int next_flag, int auto_advance, int only_player_tar
 					// check if facing and in view
 					int facing = ship_subsystem_in_sight(objp, A, &View_position, &gsubpos, 0);
 
-					if (!auto_advance && get_closest_turret && !only_player_target) {
+					if (!only_player_target && (cache.straight_ahead == NULL)) {
 						// if within 3 degrees and not previous subsys, use subsys in front
 						dot = vm_vec_dot(&vec_to_subsys, &Player_obj->orient.vec.fvec);
 						if ((dot > 0.9986) && facing) {
-							use_straight_ahead_turret = TRUE;
-							break;
+							cache.straight_ahead = A;
 						}
 					}
 
 					// set weapon_type to allow sort of ent on type
 					if (turret_weapon_has_flags(&A->weapons, Weapon::Info_Flags::Beam)) {
-						ent[num_live_turrets].type = TYPE_FACING_BEAM;
+						ent.type = TYPE_FACING_BEAM;
 					} else  if (turret_weapon_has_flags(&A->weapons, Weapon::Info_Flags::Flak)) {
-						ent[num_live_turrets].type = TYPE_FACING_FLAK;
+						ent.type = TYPE_FACING_FLAK;
 					} else {
 						if (turret_weapon_has_subtype(&A->weapons, WP_MISSILE)) {
-							ent[num_live_turrets].type = TYPE_FACING_MISSILE;
+							ent.type = TYPE_FACING_MISSILE;
 						} else if (turret_weapon_has_subtype(&A->weapons, WP_LASER)) {
-							ent[num_live_turrets].type = TYPE_FACING_LASER;
+							ent.type = TYPE_FACING_LASER;
 						} else {
 							//Turret not live, bail
 							continue;
@@ -1829,25 +1761,77 @@ void hud_target_live_turret(int next_flag, int auto_advance, int only_player_tar
 					}
 
 					// fill out ent struct
-					ent[num_live_turrets].ss = A;
-					ent[num_live_turrets].dist = distance;
+					ent.ss = A;
+					ent.dist = distance;
 					if (!facing) {
-						ent[num_live_turrets].type += TYPE_NONFACING_INC;
+						ent.type += TYPE_NONFACING_INC;
 					}
-					num_live_turrets++;
+					cache.turrets.push_back(ent);
 				}
 			}
 		}
 	}
 
-	// sort the list if we're not using turret straight ahead of us
-	if (!use_straight_ahead_turret) {
-		insertion_sort(ent, num_live_turrets, sizeof(eval_next_turret), turret_compare_func);
+	if (!cache.turrets.empty()) {
+		insertion_sort(cache.turrets.data(), cache.turrets.size(), sizeof(eval_next_turret), turret_compare_func);
 	}
 
+	return cache;
+}
+
+// target the next/prev live turret on the current target
+// auto_advance from hud_update_closest_turret
+void hud_target_live_turret(int next_flag, int auto_advance, int only_player_target)
+{
+	ship_subsys	*live_turret=NULL;
+	ship			*target_shipp;
+	object		*objp;
+
+	// make sure we're targeting a ship
+	if (Player_ai->target_objnum == -1 && !auto_advance) {
+		snd_play(gamesnd_get_game_sound(GameSounds::TARGET_FAIL));
+		return;
+	}
+
+	// only targeting subsystems on ship
+	if ((Objects[Player_ai->target_objnum].type != OBJ_SHIP) && (!auto_advance)) {
+		snd_play( gamesnd_get_game_sound(GameSounds::TARGET_FAIL));
+		return;
+	}
+
+	// set some pointers
+	objp = &Objects[Player_ai->target_objnum];
+	target_shipp = &Ships[objp->instance];
+
+	// set timestamp
+	int timestamp_val = 0;
+	if (!auto_advance) {
+		timestamp_val = Target_next_turret_timestamp;
+		Target_next_turret_timestamp = timestamp(TURRET_RESET);
+	}
+
+	// If no target is selected, then simply target the closest (or facing) turret
+	int last_subsys_turret = FALSE;
+	if (Player_ai->targeted_subsys != NULL) {
+		if (Player_ai->targeted_subsys->system_info->type == SUBSYSTEM_TURRET) {
+			if (Player_ai->targeted_subsys->weapons.num_primary_banks > 0 || Player_ai->targeted_subsys->weapons.num_secondary_banks > 0) {
+				last_subsys_turret = TRUE;
+			}
+		}
+	}
+
+	// do we want the closest turret (or the one our ship is pointing at)
+	int get_closest_turret = (auto_advance || !last_subsys_turret || timestamp_elapsed(timestamp_val));
+
+	const live_turret_cache &live_turrets = hud_get_live_turrets(objp, only_player_target);
+	const eval_next_turret *ent = live_turrets.turrets.data();
+	int num_live_turrets = static_cast<int>(live_turrets.turrets.size());
+
+	int use_straight_ahead_turret = (!auto_advance && get_closest_turret && !only_player_target && (live_turrets.straight_ahead != NULL));
+
 	if (use_straight_ahead_turret) {
 	// use the straight ahead turret
-		live_turret = A;
+		live_turret = live_turrets.straight_ahead;
 	} else {
 	// check if we have a currently targeted turret and find its position after the sort
 		int i, start_index, next_index;
@@ -2131,11 +2115,10 @@ bool evaluate_ship_as_closest_target(esct *esct_p)
 /// \brief Sets the Players[Player_num].current_target to the closest ship to
 ///        the player that matches the team passed as a paramater.
 ///
-/// The current algorithm is to simply iterate through the objects and
-/// calculate the magnitude of the vector that connects the player to the
-/// target. The smallest magnitude is tracked, and then used to locate the
-/// closest hostile ship. Note only the square of the magnitude is required,
-/// since we are only comparing magnitudes.
+/// The ships are taken from the per-frame target cache, in order of the
+/// closest any part of them could be to the player. Each one is evaluated
+/// with evaluate_ship_as_closest_target() and the search stops as soon as
+/// no remaining ship can be closer than the best one found so far.
 ///
 /// \param[in] team_mask       team of closest ship that should be targeted.
 ///                            Default value is -1, if team doesn't matter.
@@ -2161,7 +2144,6 @@ int hud_target_closest(int team_mask, int attacked_objnum, int play_fail_snd, in
 	object	*A;
 	object	*nearest_obj = &obj_used_list;
 	ship		*shipp;
-	ship_obj	*so;
 	int		check_nearest_turret = FALSE;
 
 	// evaluate ship closest target struct
@@ -2202,9 +2184,18 @@ int hud_target_closest(int team_mask, int attacked_objnum, int play_fail_snd, in
 	eval_ship_as_closest_target_args.attacked_objnum = attacked_objnum;
 	eval_ship_as_closest_target_args.turret_attacking_target = get_closest_turret_attacking_player;
 
-	for ( so=GET_FIRST(&Ship_obj_list); so!=END_OF_LIST(&Ship_obj_list); so=GET_NEXT(so) ) {
+	// Go through the ships in order of the closest any part of them could be, once that is farther away than the best
+	// match so far none of the remaining ships can beat it
+	for (const auto& candidate : hud_target_cache_ships_by_min_dist()) {
+		if (candidate.min_dist >= min_distance) {
+			break;
+		}
+
+		if (!hud_target_candidate_valid(candidate)) {
+			continue;
+		}
 
-		A = &Objects[so->objnum];
+		A = &Objects[candidate.objnum];
 		shipp = &Ships[A->instance];	// get a pointer to the ship information
 
 		// fill in rest of eval_ship_as_closest_target_args
@@ -2338,7 +2329,7 @@ void hud_target_targets_target()
 	object *tt_objp = NULL;
 	int		tt_objnum;
 
-	if ( Player_ai->target_objnum < 0 || Player_ai->target_objnum >= MAX_OBJECTS ) {
+	if ( Player_ai->target_objnum < 0 || Player_ai->target_objnum >= objects_size() ) {
 		goto ttt_fail;
 	}
 
@@ -2348,7 +2339,7 @@ void hud_target_targets_target()
 	}
 
 	tt_objnum = Ai_info[Ships[objp->instance].ai_index].target_objnum;
-	if ( tt_objnum < 0 || tt_objnum >= MAX_OBJECTS ) {
+	if ( tt_objnum < 0 || tt_objnum >= objects_size() ) {
 		goto ttt_fail;
 	}
 
@@ -3058,7 +3049,7 @@ void hud_process_homing_missiles()
 
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
 		A = &Objects[mo->objnum];
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < weapons_size()));
 
 		wp = &Weapons[A->instance];
 
@@ -3122,7 +3113,7 @@ void HudGaugeMissileTriangles::render(float  /*frametime*/)
 
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
 		A = &Objects[mo->objnum];
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < weapons_size()));
 
 		wp = &Weapons[A->instance];
 
@@ -3182,7 +3173,7 @@ void hud_process_remote_detonate_missile()
 
 	// check for currently locked missiles (highest precedence)
 	for ( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < objects_size());
 		mobjp = &Objects[mo->objnum];
 
 		if ((Player_obj != NULL) && (mobjp->parent_sig == Player_obj->parent_sig)) {
@@ -4396,7 +4387,7 @@ void hud_target_change_check()
 		}
 
 		player_stop_cargo_scan_sound();
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < objects_size()) ) {
 			hud_shield_hit_reset(&Objects[Player_ai->target_objnum]);
 		}
 		hud_targetbox_init_flash();
@@ -4421,7 +4412,7 @@ void hud_target_change_check()
 
 		hud_lock_reset();
 
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < objects_size()) ) {
 			if ( Objects[Player_ai->target_objnum].type == OBJ_SHIP ) {
 				hud_restore_subsystem_target(&Ships[Objects[Player_ai->target_objnum].instance]);
 			}
@@ -4436,7 +4427,7 @@ void hud_target_change_check()
 			Player_ai->current_target_dist_trend = NO_CHANGE;
 		}
 
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < objects_size()) ) {
 			current_speed = Objects[Player_ai->target_objnum].phys_info.speed;
 		}
 
@@ -5143,9 +5134,9 @@ void hud_target_last_transmit()
 	// Was just bogus code in the call to hud_restore_subsystem_target(). -- MK, 9/15/99, 1:59 pm.
 	int targeted_objnum;
 	targeted_objnum = Transmit_target_list[transmit_index].objnum;
-	Assert((targeted_objnum >= 0) && (targeted_objnum < MAX_OBJECTS));
+	Assert((targeted_objnum >= 0) && (targeted_objnum < objects_size()));
 
-	if ((targeted_objnum >= 0) && (targeted_objnum < MAX_OBJECTS)) {
+	if ((targeted_objnum >= 0) && (targeted_objnum < objects_size())) {
 		set_target_objnum( Player_ai, Transmit_target_list[transmit_index].objnum );
 		hud_shield_hit_reset(&Objects[Transmit_target_list[transmit_index].objnum]);
 		hud_restore_subsystem_target(&Ships[Objects[Transmit_target_list[transmit_index].objnum].instance]);
@@ -5159,7 +5150,7 @@ void hud_target_last_transmit_add(int ship_num)
 	int		ship_objnum;
 
 	ship_objnum = Ships[ship_num].objnum;
-	Assert(ship_objnum >= 0 && ship_objnum < MAX_OBJECTS);
+	Assert(ship_objnum >= 0 && ship_objnum < objects_size());
 	ship_objp = &Objects[ship_objnum];
 	Assert(ship_objp->type == OBJ_SHIP);
 
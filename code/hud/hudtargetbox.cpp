@@ -2124,21 +2124,21 @@ void HudGaugeTargetBox::showTargetData(float  /*frametime*/)
 						}
 					}
 
-				if (Player_ai->target_objnum == Enemy_attacker - Objects)
+				if (Player_ai->target_objnum == OBJ_INDEX(Enemy_attacker))
 					found = 0;
 
 				if (!found) {
 					int	i;
 
 					Enemy_attacker = NULL;
-					for (i=0; i<MAX_OBJECTS; i++)
+					for (i=0; i<objects_size(); i++)
 						if (Objects[i].type == OBJ_SHIP) {
 							int	enemy;
 
 							if (i != Player_ai->target_objnum) {
 								enemy = Ai_info[Ships[Objects[i].instance].ai_index].target_objnum;
 
-								if (enemy == Player_obj-Objects) {
+								if (enemy == OBJ_INDEX(Player_obj)) {
 									Enemy_attacker = &Objects[i];
 									break;
 								}
@@ -0,0 +1,166 @@
+
+#include "hud/hudtargetcache.h"
+
+#include "globalincs/linklist.h"
+#include "globalincs/systemvars.h"
+#include "hud/hudtarget.h"
+#include "object/object.h"
+#include "playerman/player.h"
+#include "ship/ship.h"
+#include "weapon/weapon.h"
+
+#include <algorithm>
+
+namespace {
+
+// vm_vec_dist_quick() can be up to 10% shorter than the real distance, min_dist has to stay below that
+const float QUICK_DIST_SLACK = 0.85f;
+
+struct target_cache {
+	bool valid = false;
+
+	// what the lists were built for
+	int frame = -1;
+	int next_signature = -1;
+	vec3d player_pos = vmd_zero_vector;
+
+	SCP_vector<hud_target_candidate> ships;
+	SCP_vector<hud_target_candidate> ships_by_min_dist;
+	SCP_vector<hud_target_candidate> bombs;
+};
+target_cache Target_cache;
+
+bool closer(const hud_target_candidate& left, const hud_target_candidate& right) {
+	return left.dist < right.dist;
+}
+
+bool closer_bound(const hud_target_candidate& left, const hud_target_candidate& right) {
+	return left.min_dist < right.min_dist;
+}
+
+hud_target_candidate make_candidate(object* objp) {
+	hud_target_candidate candidate;
+
+	candidate.objnum = OBJ_INDEX(objp);
+	candidate.signature = objp->signature;
+	candidate.dist = hud_find_target_distance(objp, Player_obj);
+	candidate.min_dist = MAX(vm_vec_dist(&objp->pos, &Player_obj->pos) - objp->radius, 0.0f) * QUICK_DIST_SLACK;
+
+	return candidate;
+}
+
+void maybe_rebuild() {
+	if (Player_obj == nullptr) {
+		Target_cache.ships.clear();
+		Target_cache.ships_by_min_dist.clear();
+		Target_cache.bombs.clear();
+		Target_cache.valid = false;
+		return;
+	}
+
+	if (Target_cache.valid && Target_cache.frame == Framecount && Target_cache.next_signature == Object_next_signature
+		&& vm_vec_same(&Target_cache.player_pos, &Player_obj->pos)) {
+		return;
+	}
+
+	Target_cache.valid = true;
+	Target_cache.frame = Framecount;
+	Target_cache.next_signature = Object_next_signature;
+	Target_cache.player_pos = Player_obj->pos;
+
+	Target_cache.ships.clear();
+	for (auto so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+		auto objp = &Objects[so->objnum];
+		if (objp == Player_obj) {
+			continue;
+		}
+
+		Target_cache.ships.push_back(make_candidate(objp));
+	}
+
+	Target_cache.bombs.clear();
+	for (auto mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo)) {
+		auto objp = &Objects[mo->objnum];
+		auto wip = &Weapon_info[Weapons[objp->instance].weapon_info_index];
+
+		if (!(wip->wi_flags[Weapon::Info_Flags::Can_be_targeted]) && !(wip->wi_flags[Weapon::Info_Flags::Bomb])) {
+			continue;
+		}
+
+		Target_cache.bombs.push_back(make_candidate(objp));
+	}
+
+	// stable, so objects at the same distance keep the order of the object lists like the old linear searches did
+	std::stable_sort(Target_cache.ships.begin(), Target_cache.ships.end(), closer);
+	std::stable_sort(Target_cache.bombs.begin(), Target_cache.bombs.end(), closer);
+
+	Target_cache.ships_by_min_dist = Target_cache.ships;
+	std::stable_sort(Target_cache.ships_by_min_dist.begin(), Target_cache.ships_by_min_dist.end(), closer_bound);
+}
+
+}
+
+const SCP_vector<hud_target_candidate>& hud_target_cache_ships() {
+	maybe_rebuild();
+	return Target_cache.ships;
+}
+
+const SCP_vector<hud_target_candidate>& hud_target_cache_ships_by_min_dist() {
+	maybe_rebuild();
+	return Target_cache.ships_by_min_dist;
+}
+
+const SCP_vector<hud_target_candidate>& hud_target_cache_bombs() {
+	maybe_rebuild();
+	return Target_cache.bombs;
+}
+
+bool hud_target_candidate_valid(const hud_target_candidate& candidate) {
+	auto objp = &Objects[candidate.objnum];
+
+	return objp->signature == candidate.signature && objp->type != OBJ_NONE;
+}
+
+object* hud_target_cache_cycle(const SCP_vector<hud_target_candidate>& candidates, int current_objnum, bool farther,
+                               const std::function<bool(object*)>& accept) {
+	int num_candidates = static_cast<int>(candidates.size());
+	int start = -1;
+
+	if (current_objnum >= 0) {
+		hud_target_candidate key;
+		key.dist = hud_find_target_distance(&Objects[current_objnum], Player_obj);
+
+		if (farther) {
+			start = static_cast<int>(std::upper_bound(candidates.begin(), candidates.end(), key, closer) - candidates.begin());
+			if (start >= num_candidates) {
+				start = -1;
+			}
+		} else {
+			start = static_cast<int>(std::lower_bound(candidates.begin(), candidates.end(), key, closer) - candidates.begin()) - 1;
+		}
+	}
+
+	if (start < 0) {
+		start = farther ? 0 : num_candidates - 1;
+	}
+
+	for (int i = 0; i < num_candidates; ++i) {
+		int index = farther ? (start + i) % num_candidates : (start - i + num_candidates) % num_candidates;
+		const auto& candidate = candidates[index];
+
+		if (candidate.objnum == current_objnum || !hud_target_candidate_valid(candidate)) {
+			continue;
+		}
+
+		auto objp = &Objects[candidate.objnum];
+		if (accept(objp)) {
+			return objp;
+		}
+	}
+
+	return nullptr;
+}
+
+void hud_target_cache_invalidate() {
+	Target_cache.valid = false;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <functional>
+
+class object;
+
+/**
+ * @brief Something the player could target, as seen from the player's position this frame
+ */
+struct hud_target_candidate {
+	int objnum;
+	int signature;
+
+	float dist;		// hud_find_target_distance() from the player
+	float min_dist;	// lower bound for vm_vec_dist_quick() from the player to any point of the object, e.g. a turret
+};
+
+/**
+ * @brief All ships except the player, closest first
+ *
+ * The targeting functions used to measure the distance to every ship each time they were called. These lists are built
+ * the first time they are needed in a frame and shared by every targeting query until the player moves or a new
+ * object is created.
+ *
+ * Only the object type is filtered here, everything else (teams, flags, AWACS) can change at any time and has to be
+ * checked by the caller. Objects may have died since the list was built, check that with hud_target_candidate_valid().
+ */
+const SCP_vector<hud_target_candidate>& hud_target_cache_ships();
+
+/**
+ * @brief The same ships as hud_target_cache_ships(), sorted by min_dist
+ *
+ * A search for the closest object can stop as soon as the min_dist of the next candidate is farther away than the best
+ * match so far.
+ */
+const SCP_vector<hud_target_candidate>& hud_target_cache_ships_by_min_dist();
+
+/**
+ * @brief All weapons which may be targeted (bombs and Can_be_targeted weapons), closest first
+ */
+const SCP_vector<hud_target_candidate>& hud_target_cache_bombs();
+
+/**
+ * @brief Checks if the object of a candidate is still the one the cache was built with
+ */
+bool hud_target_candidate_valid(const hud_target_candidate& candidate);
+
+/**
+ * @brief Finds the next candidate from the current target outwards
+ *
+ * Starts with the first candidate farther away (or closer) than the current target and wraps around to the closest (or
+ * farthest) one at the end of the list. The current target itself and candidates which died are skipped.
+ *
+ * @param candidates A list sorted by dist
+ * @param current_objnum The current target, -1 to start at the closest (or farthest) candidate
+ * @param farther Which direction to cycle in
+ * @param accept Filter for the candidates
+ * @return The first accepted object, or nullptr if there is none
+ */
+object* hud_target_cache_cycle(const SCP_vector<hud_target_candidate>& candidates, int current_objnum, bool farther,
+                               const std::function<bool(object*)>& accept);
+
+/**
+ * @brief Forgets the cached lists, called when a mission starts or ends
+ */
+void hud_target_cache_invalidate();
@@ -13,11 +13,13 @@
 #include "mission/missionparse.h"
 #include "parse/parselo.h"
 #include "ship/ship.h"
+#include "utils/name_index.h"
 
 extern int radar_target_id_flags;
 
 int Num_iffs;
 iff_info Iff_info[MAX_IFFS];
+static util::name_index Iff_names([]() { return Num_iffs; }, [](int index) -> const char* { return Iff_info[index].iff_name; });
 
 int Iff_traitor;
 
@@ -302,6 +304,7 @@ void iff_init()
 
 		// begin reading data
 		Num_iffs = 0;
+		Iff_names.invalidate();
 		while (required_string_either("#End", "$IFF Name:"))
 		{
 			iff_info *iff;
@@ -523,11 +526,12 @@ int iff_lookup(const char *iff_name)
 	if(iff_name == NULL)
 		return -1;
 
-	for (int i = 0; i < Num_iffs; i++)
-		if (!stricmp(iff_name, Iff_info[i].iff_name))
-			return i;
+	return Iff_names.find(iff_name);
+}
 
-	return -1;
+void iff_name_changed(int iff)
+{
+	Iff_names.add(iff);
 }
 
 /**
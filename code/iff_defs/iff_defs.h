@@ -71,6 +71,8 @@ extern void iff_init();
 
 // search for iff
 extern int iff_lookup(const char *iff_name);
+// has to be called when the name of an IFF is changed after it was parsed
+extern void iff_name_changed(int iff);
 
 // attack stuff
 // NB: As far as the differences between I attack him and he attacks me, think of a hidden traitor on your own team.
@@ -2564,7 +2564,7 @@ int button_function(int n)
 			// blow myself up, if I'm the server
 			if (Net_player->flags & NETINFO_FLAG_AM_MASTER) {
 				if ( (Net_player->m_player->objnum >= 0) && 
-					(Net_player->m_player->objnum < MAX_OBJECTS) && 
+					(Net_player->m_player->objnum < objects_size()) && 
 					(Objects[Net_player->m_player->objnum].type == OBJ_SHIP) && 
 					(Objects[Net_player->m_player->objnum].instance >= 0) && 
 					(Objects[Net_player->m_player->objnum].instance < MAX_SHIPS) )
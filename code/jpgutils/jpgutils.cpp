@@ -46,19 +46,20 @@ typedef struct {
 } cfile_source_mgr;
 
 typedef cfile_source_mgr *cfile_src_ptr;
-struct jpeg_decompress_struct jpeg_info;
-struct jpeg_error_mgr jpeg_err;
+// thread local, since bmpman decodes images on several threads at once
+static thread_local struct jpeg_decompress_struct jpeg_info;
+static thread_local struct jpeg_error_mgr jpeg_err;
 
 #define INPUT_BUF_SIZE  4096	// choose an efficiently read'able size
 
-static int jpeg_error_code;
+static thread_local int jpeg_error_code;
 
 // set current error
 #define Jpeg_Set_Error(x)	{ jpeg_error_code = x; }
 
 // error handler stuff, rather than the default, which will screw us
 //
-jmp_buf FSJpegError;
+static thread_local jmp_buf FSJpegError;
 
 // error (exit) handler
 void jpg_error_exit(j_common_ptr cinfo)
@@ -164,25 +165,27 @@ int jpeg_read_header(const char *real_filename, CFILE *img_cfp, int *w, int *h,
 // 
 // filename - name of the targa file to load
 // image_data - allocated storage for the bitmap
+// img_cfp - already open file to read from instead, left open when done
 //
 // returns - true if succesful, false otherwise
 //
-int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*palette*/, int dest_size, int cf_type)
+int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*palette*/, int dest_size, int cf_type, CFILE *img_cfp)
 {
 	char filename[MAX_FILENAME_LEN];
-	CFILE *img_cfp = NULL;
+	CFILE *jpeg_file = img_cfp;
 	JSAMPARRAY buffer = NULL;
 
-	strcpy_s( filename, real_filename );
-	char *p = strchr( filename, '.' );
-	if ( p ) *p = 0;
-	strcat_s( filename, ".jpg" );
-
+	if (jpeg_file == NULL) {
+		strcpy_s( filename, real_filename );
+		char *p = strchr( filename, '.' );
+		if ( p ) *p = 0;
+		strcat_s( filename, ".jpg" );
 
-	img_cfp = cfopen(filename, "rb", CFILE_NORMAL, cf_type);
+		jpeg_file = cfopen(filename, "rb", CFILE_NORMAL, cf_type);
 
-	if (img_cfp == NULL)
-		return JPEG_ERROR_READING;
+		if (jpeg_file == NULL)
+			return JPEG_ERROR_READING;
+	}
 
 	// set the basic error code
 	Jpeg_Set_Error(JPEG_ERROR_NONE);
@@ -202,7 +205,7 @@ int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*pal
 		jpeg_create_decompress(&jpeg_info);
 
 		// setup to read data via CFILE
-		jpeg_cfile_src(&jpeg_info, img_cfp);
+		jpeg_cfile_src(&jpeg_info, jpeg_file);
 
 		jpeg_read_header(&jpeg_info, TRUE);
 
@@ -252,7 +255,8 @@ int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*pal
 		jpeg_destroy_decompress(&jpeg_info);
 	}
 
-	cfclose(img_cfp);
+	if (img_cfp == NULL)
+		cfclose(jpeg_file);
 
 
 	return jpeg_error_code;
@@ -22,7 +22,7 @@
 
 // reading
 extern int jpeg_read_header(const char *real_filename, CFILE *img_cfp = NULL, int *w = 0, int *h = 0, int *bpp = 0, ubyte *palette = NULL);
-extern int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte *palette, int dest_size, int cf_type = CF_TYPE_ANY);
+extern int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte *palette, int dest_size, int cf_type = CF_TYPE_ANY, CFILE *img_cfp = nullptr);
 
 
 #endif // _JPEGUTILS_H
@@ -19,6 +19,8 @@
 #include "model/modelrender.h"
 #include "render/3d.h"
 
+#include <climits>
+
 
 SCP_vector<light> Lights;
 SCP_vector<light> Static_light;
@@ -519,82 +521,307 @@ bool light_compare_by_type(const light &a, const light &b)
 	return a.type < b.type;
 }
 
-void scene_lights::addLight(const light *light_ptr)
+// Upper bound for the number of cells along one axis of the light grid
+#define LIGHT_GRID_MAX_DIM		32
+
+// Lights which overlap more than this fraction of all grid cells are kept in the global list
+#define LIGHT_GRID_GLOBAL_FRACTION	0.125f
+
+int Light_grid_min_lights = 32;
+
+DCF_INT2(light_grid_min_lights, Light_grid_min_lights, 0, INT_MAX, "Sets the minimum number of dynamic lights before the light grid is used (default is 32)");
+
+static void light_get_bounds(const light& l, vec3d* min, vec3d* max)
 {
-	Assert(light_ptr != NULL);
+	vec3d radius;
+	radius.xyz.x = radius.xyz.y = radius.xyz.z = l.radb;
 
-	AllLights.push_back(*light_ptr);
+	vm_vec_sub(min, &l.vec, &radius);
+	vm_vec_add(max, &l.vec, &radius);
+}
 
-	if ( light_ptr->type == Light_Type::Directional ) {
-		StaticLightIndices.push_back(AllLights.size() - 1);
+light_grid::light_grid()
+{
+	clear();
+}
+
+void light_grid::clear()
+{
+	vm_vec_zero(&Grid_min);
+	Cell_size.xyz.x = Cell_size.xyz.y = Cell_size.xyz.z = 1.0f;
+	Dim[0] = Dim[1] = Dim[2] = 0;
+
+	Cell_start.clear();
+	Cell_lights.clear();
+	Global_lights.clear();
+	Light_stamps.clear();
+	Current_stamp = 0;
+
+	Valid = false;
+}
+
+void light_grid::getCellRange(const vec3d* min, const vec3d* max, int cell_min[3], int cell_max[3]) const
+{
+	for (int axis = 0; axis < 3; ++axis) {
+		cell_min[axis] = fl2i((min->a1d[axis] - Grid_min.a1d[axis]) / Cell_size.a1d[axis]);
+		cell_max[axis] = fl2i((max->a1d[axis] - Grid_min.a1d[axis]) / Cell_size.a1d[axis]);
+
+		CLAMP(cell_min[axis], 0, Dim[axis] - 1);
+		CLAMP(cell_max[axis], 0, Dim[axis] - 1);
 	}
 }
 
-void scene_lights::setLightFilter(int objnum, const vec3d *pos, float rad)
+void light_grid::build(const SCP_vector<light>& lights)
 {
-	size_t i = 0;
-	// clear out current filtered lights
-	FilteredLights.clear();
+	clear();
+
+	vec3d grid_max;
+	size_t num_binned = 0;
+
+	for (size_t i = 0; i < lights.size(); ++i) {
+		auto& l = lights[i];
+
+		if (l.type == Light_Type::Tube) {
+			// Tube lights are filtered by their distance to the infinite line through both end points so they can
+			// not be bounded
+			Global_lights.push_back(i);
+			continue;
+		}
+
+		if (l.type != Light_Type::Point) {
+			continue;
+		}
 
-	for ( auto& l : AllLights ) {
-		switch ( l.type ) {
-			case Light_Type::Directional:
-				++i;
+		vec3d min, max;
+		light_get_bounds(l, &min, &max);
+
+		if (num_binned == 0) {
+			Grid_min = min;
+			grid_max = max;
+		} else {
+			for (int axis = 0; axis < 3; ++axis) {
+				Grid_min.a1d[axis] = MIN(Grid_min.a1d[axis], min.a1d[axis]);
+				grid_max.a1d[axis] = MAX(grid_max.a1d[axis], max.a1d[axis]);
+			}
+		}
+		++num_binned;
+	}
+
+	if (num_binned == 0) {
+		// An empty grid still returns the global lights
+		Dim[0] = Dim[1] = Dim[2] = 1;
+		Cell_start.assign(2, 0);
+		Valid = true;
+		return;
+	}
+
+	// Aim for a few lights per cell if they were evenly distributed
+	int dim = fl2i(powf((float)num_binned, 1.0f / 3.0f) * 2.0f);
+	CLAMP(dim, 1, LIGHT_GRID_MAX_DIM);
+
+	int num_cells = 1;
+	for (int axis = 0; axis < 3; ++axis) {
+		float extent = grid_max.a1d[axis] - Grid_min.a1d[axis];
+
+		Dim[axis] = extent > 0.0f ? dim : 1;
+		Cell_size.a1d[axis] = extent > 0.0f ? extent / Dim[axis] : 1.0f;
+		num_cells *= Dim[axis];
+	}
+
+	auto max_cells_per_light = MAX(1, fl2i(num_cells * LIGHT_GRID_GLOBAL_FRACTION));
+
+	// First pass counts the lights of every cell, the second pass fills in the light indices
+	Cell_start.assign(num_cells + 1, 0);
+
+	for (int pass = 0; pass < 2; ++pass) {
+		for (size_t i = 0; i < lights.size(); ++i) {
+			auto& l = lights[i];
+
+			if (l.type != Light_Type::Point) {
 				continue;
-			case Light_Type::Point: {
-				// if this is a "unique" light source, it only affects one guy
-				if ( l.affected_objnum >= 0 ) {
-					if ( objnum == l.affected_objnum ) {
-						vec3d to_light;
-						float dist_squared, max_dist_squared;
-						vm_vec_sub( &to_light, &l.vec, pos );
-						dist_squared = vm_vec_mag_squared(&to_light);
-
-						max_dist_squared = l.radb+rad;
-						max_dist_squared *= max_dist_squared;
-
-						if ( dist_squared < max_dist_squared )	{
-							FilteredLights.push_back(i);
-						}
-					}
-				} else { // otherwise check all relevant objects
-					vec3d to_light;
-					float dist_squared, max_dist_squared;
-					vm_vec_sub( &to_light, &l.vec, pos );
-					dist_squared = vm_vec_mag_squared(&to_light);
+			}
+
+			vec3d min, max;
+			int cell_min[3], cell_max[3];
+			light_get_bounds(l, &min, &max);
+			getCellRange(&min, &max, cell_min, cell_max);
+
+			int covered = (cell_max[0] - cell_min[0] + 1) * (cell_max[1] - cell_min[1] + 1) * (cell_max[2] - cell_min[2] + 1);
+			if (covered > max_cells_per_light) {
+				if (pass == 0) {
+					Global_lights.push_back(i);
+				}
+				continue;
+			}
 
-					max_dist_squared = l.radb+rad;
-					max_dist_squared *= max_dist_squared;
+			for (int z = cell_min[2]; z <= cell_max[2]; ++z) {
+				for (int y = cell_min[1]; y <= cell_max[1]; ++y) {
+					for (int x = cell_min[0]; x <= cell_max[0]; ++x) {
+						auto cell = (z * Dim[1] + y) * Dim[0] + x;
 
-					if ( dist_squared < max_dist_squared )	{
-						FilteredLights.push_back(i);
+						if (pass == 0) {
+							++Cell_start[cell + 1];
+						} else {
+							Cell_lights[Cell_start[cell]++] = i;
+						}
 					}
 				}
 			}
-			break;
-			case Light_Type::Tube: {
-				if ( l.light_ignore_objnum != objnum ) {
-					vec3d nearest;
-					float dist_squared, max_dist_squared;
-					vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
+		}
 
-					max_dist_squared = l.radb+rad;
-					max_dist_squared *= max_dist_squared;
+		if (pass == 0) {
+			// Turn the counts into start offsets
+			for (int cell = 0; cell < num_cells; ++cell) {
+				Cell_start[cell + 1] += Cell_start[cell];
+			}
+			Cell_lights.resize(Cell_start[num_cells]);
+		} else {
+			// Filling the cells advanced every start offset to the start of the next cell so shift them back
+			for (int cell = num_cells; cell > 0; --cell) {
+				Cell_start[cell] = Cell_start[cell - 1];
+			}
+			Cell_start[0] = 0;
+		}
+	}
 
-					if ( dist_squared < max_dist_squared ) {
-						FilteredLights.push_back(i);
+	Light_stamps.assign(lights.size(), 0);
+	Current_stamp = 0;
+
+	Valid = true;
+}
+
+void light_grid::gatherCandidates(const vec3d* pos, float rad, SCP_vector<size_t>& out)
+{
+	Assertion(Valid, "Light grid must be built before it can be queried!");
+
+	auto first = out.size();
+
+	out.insert(out.end(), Global_lights.begin(), Global_lights.end());
+
+	vec3d radius, min, max;
+	radius.xyz.x = radius.xyz.y = radius.xyz.z = rad;
+	vm_vec_sub(&min, pos, &radius);
+	vm_vec_add(&max, pos, &radius);
+
+	// Objects completely outside of the grid can only be affected by the global lights
+	for (int axis = 0; axis < 3; ++axis) {
+		if (max.a1d[axis] < Grid_min.a1d[axis] || min.a1d[axis] > Grid_min.a1d[axis] + Cell_size.a1d[axis] * Dim[axis]) {
+			std::sort(out.begin() + first, out.end());
+			return;
+		}
+	}
+
+	if (++Current_stamp == 0) {
+		// The stamp wrapped around so the old stamps are not reliable anymore
+		std::fill(Light_stamps.begin(), Light_stamps.end(), 0);
+		Current_stamp = 1;
+	}
+
+	int cell_min[3], cell_max[3];
+	getCellRange(&min, &max, cell_min, cell_max);
+
+	for (int z = cell_min[2]; z <= cell_max[2]; ++z) {
+		for (int y = cell_min[1]; y <= cell_max[1]; ++y) {
+			for (int x = cell_min[0]; x <= cell_max[0]; ++x) {
+				auto cell = (z * Dim[1] + y) * Dim[0] + x;
+
+				for (auto i = Cell_start[cell]; i < Cell_start[cell + 1]; ++i) {
+					auto light_index = Cell_lights[i];
+
+					if (Light_stamps[light_index] != Current_stamp) {
+						Light_stamps[light_index] = Current_stamp;
+						out.push_back(light_index);
 					}
 				}
 			}
-			break;
+		}
+	}
+
+	// Keep the same light order as a linear search would produce
+	std::sort(out.begin() + first, out.end());
+}
+
+void scene_lights::addLight(const light *light_ptr)
+{
+	Assert(light_ptr != NULL);
+
+	AllLights.push_back(*light_ptr);
+
+	if ( light_ptr->type == Light_Type::Directional ) {
+		StaticLightIndices.push_back(AllLights.size() - 1);
+	}
+
+	LightGridDirty = true;
+}
+
+bool scene_lights::lightAffectsObject(const light& l, int objnum, const vec3d* pos, float rad) const
+{
+	switch ( l.type ) {
+		case Light_Type::Point: {
+			// if this is a "unique" light source, it only affects one guy
+			if ( l.affected_objnum >= 0 && objnum != l.affected_objnum ) {
+				return false;
+			}
+
+			vec3d to_light;
+			float dist_squared, max_dist_squared;
+			vm_vec_sub( &to_light, &l.vec, pos );
+			dist_squared = vm_vec_mag_squared(&to_light);
+
+			max_dist_squared = l.radb+rad;
+			max_dist_squared *= max_dist_squared;
+
+			return dist_squared < max_dist_squared;
+		}
+		case Light_Type::Tube: {
+			if ( l.light_ignore_objnum == objnum ) {
+				return false;
+			}
+
+			vec3d nearest;
+			float dist_squared, max_dist_squared;
+			vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
+
+			max_dist_squared = l.radb+rad;
+			max_dist_squared *= max_dist_squared;
+
+			return dist_squared < max_dist_squared;
+		}
+
+		case Light_Type::Directional:
+		case Light_Type::Cone:
+		default:
+			return false;
+	}
+}
+
+void scene_lights::setLightFilter(int objnum, const vec3d *pos, float rad)
+{
+	// clear out current filtered lights
+	FilteredLights.clear();
+
+	if ( AllLights.size() - StaticLightIndices.size() < (size_t)Light_grid_min_lights ) {
+		// not enough lights for the grid to pay off
+		for ( size_t i = 0; i < AllLights.size(); ++i ) {
+			if ( lightAffectsObject(AllLights[i], objnum, pos, rad) ) {
+				FilteredLights.push_back(i);
+			}
+		}
+		return;
+	}
+
+	if ( LightGridDirty ) {
+		LightGrid.build(AllLights);
+		LightGridDirty = false;
+	}
 
-			case Light_Type::Cone:
-				break;
+	CandidateLights.clear();
+	LightGrid.gatherCandidates(pos, rad, CandidateLights);
 
-			default:
-				break;
+	for ( auto i : CandidateLights ) {
+		if ( lightAffectsObject(AllLights[i], objnum, pos, rad) ) {
+			FilteredLights.push_back(i);
 		}
-		++i;
 	}
 }
 
@@ -61,6 +61,46 @@ struct light_indexing_info
 	size_t num_lights;
 };
 
+/**
+ * @brief Coarse world space grid used to assign point and tube lights to objects
+ *
+ * The grid is built once from all the lights of a scene and then queried with the bounding sphere of every object that
+ * is queued for rendering. Each cell holds the indices of the point lights whose area of effect overlaps it so an object
+ * only has to test the lights of the cells it touches instead of every light in the scene.
+ */
+class light_grid
+{
+	vec3d Grid_min;
+	vec3d Cell_size;
+	int Dim[3];
+
+	// Light lists of all cells, stored contiguously. The lights of cell c are Cell_lights[Cell_start[c]] up to
+	// Cell_lights[Cell_start[c + 1]]
+	SCP_vector<uint> Cell_start;
+	SCP_vector<size_t> Cell_lights;
+
+	// Tube lights and lights which cover a large part of the grid are not binned so they are always considered
+	SCP_vector<size_t> Global_lights;
+
+	// Used for removing duplicates of lights which overlap multiple cells
+	SCP_vector<uint> Light_stamps;
+	uint Current_stamp;
+
+	bool Valid;
+
+	void getCellRange(const vec3d* min, const vec3d* max, int cell_min[3], int cell_max[3]) const;
+  public:
+	light_grid();
+
+	void clear();
+	void build(const SCP_vector<light>& lights);
+
+	bool isValid() const { return Valid; }
+
+	// Appends the indices of all lights which may affect the given sphere in ascending order
+	void gatherCandidates(const vec3d* pos, float rad, SCP_vector<size_t>& out);
+};
+
 class scene_lights
 {
 	SCP_vector<light> AllLights;
@@ -71,11 +111,18 @@ class scene_lights
 
 	SCP_vector<size_t> BufferedLights;
 
+	light_grid LightGrid;
+	bool LightGridDirty;
+	SCP_vector<size_t> CandidateLights;
+
 	size_t current_light_index;
 	size_t current_num_lights;
+
+	bool lightAffectsObject(const light& l, int objnum, const vec3d* pos, float rad) const;
 public:
 	scene_lights()
 	{
+		LightGridDirty = true;
 		resetLightState();
 	}
 	void addLight(const light *light_ptr);
@@ -83,8 +130,13 @@ public:
 	bool setLights(const light_indexing_info *info);
 	void resetLightState();
 	light_indexing_info bufferLights();
+
+	const SCP_vector<size_t>& getFilteredLights() const { return FilteredLights; }
 };
 
+// Minimum number of lights in a scene before the light grid is used instead of testing every light
+extern int Light_grid_min_lights;
+
 extern void light_reset();
 
 // Intensity - how strong the light is.  1.0 will cast light around 5meters or so.
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace localization {
+
+/**
+ * @brief The strings of tstrings.tbl, by their id
+ *
+ * An open-addressing hash which owns copies of its strings, so the strings stay where they are when the table grows.
+ * Ids are never removed one by one, a modular table which redefines an id replaces its string instead.
+ */
+class string_table {
+	struct slot {
+		int id; // -1 if unused
+		char* str;
+	};
+
+	SCP_vector<slot> _slots;
+	size_t _used = 0;
+
+	static std::uint32_t hash(int id)
+	{
+		// ids are mostly consecutive, spread them over the whole table
+		auto value = static_cast<std::uint32_t>(id) * 2654435769u;
+		return value ^ (value >> 16);
+	}
+
+	size_t find_slot(int id) const
+	{
+		auto mask = _slots.size() - 1;
+		auto pos = hash(id) & mask;
+
+		while (_slots[pos].id >= 0 && _slots[pos].id != id) {
+			pos = (pos + 1) & mask;
+		}
+
+		return pos;
+	}
+
+	void grow()
+	{
+		SCP_vector<slot> old;
+		old.swap(_slots);
+
+		slot empty;
+		empty.id = -1;
+		empty.str = nullptr;
+		_slots.assign(old.empty() ? 64 : old.size() * 2, empty);
+
+		for (auto& s : old) {
+			if (s.id >= 0) {
+				_slots[find_slot(s.id)] = s;
+			}
+		}
+	}
+
+  public:
+	string_table() = default;
+	string_table(const string_table&) = delete;
+	string_table& operator=(const string_table&) = delete;
+
+	~string_table() { clear(); }
+
+	/**
+	 * @brief Adds a copy of a string
+	 * @param replace Whether a string which already has this id is replaced, otherwise it is kept
+	 * @return @c false if there already was a string with this id
+	 */
+	bool insert(int id, const char* str, bool replace)
+	{
+		Assertion(id >= 0, "Invalid string id %d!", id);
+
+		// keep the table at most half full
+		if ((_used + 1) * 2 > _slots.size()) {
+			grow();
+		}
+
+		auto& s = _slots[find_slot(id)];
+
+		if (s.id == id) {
+			if (replace) {
+				vm_free(s.str);
+				s.str = vm_strdup(str);
+			}
+			return false;
+		}
+
+		s.id = id;
+		s.str = vm_strdup(str);
+		++_used;
+
+		return true;
+	}
+
+	/**
+	 * @return The string or @c nullptr if there is none with this id
+	 */
+	const char* find(int id) const
+	{
+		if (_slots.empty() || id < 0) {
+			return nullptr;
+		}
+
+		return _slots[find_slot(id)].str;
+	}
+
+	size_t size() const { return _used; }
+
+	void clear()
+	{
+		for (auto& s : _slots) {
+			if (s.str != nullptr) {
+				vm_free(s.str);
+			}
+		}
+		_slots.clear();
+		_used = 0;
+	}
+};
+
+/**
+ * @brief Remembers what was extracted from XSTR("text", id) tags
+ *
+ * Mission and table text is localized over and over while it is displayed, this saves searching the tag for its text
+ * and id every time. Looking up a tag doesn't allocate anything. The cache only holds so many tags, once it is full it
+ * starts over.
+ */
+class xstr_tag_cache {
+  public:
+	struct tag {
+		SCP_string text;
+		int id;
+	};
+
+  private:
+	struct entry {
+		SCP_string in;
+		tag parsed;
+	};
+
+	struct slot {
+		std::uint32_t hash;
+		int entry; // -1 if unused
+	};
+
+	SCP_vector<entry> _entries;
+	SCP_vector<slot> _slots;
+	size_t _max_entries;
+
+	// FNV-1a, tags are compared with their case intact
+	static std::uint32_t hash(const char* str, size_t len)
+	{
+		std::uint32_t value = 2166136261u;
+		for (size_t i = 0; i < len; ++i) {
+			value ^= static_cast<unsigned char>(str[i]);
+			value *= 16777619u;
+		}
+		return value;
+	}
+
+  public:
+	explicit xstr_tag_cache(size_t max_entries) : _max_entries(max_entries)
+	{
+		size_t capacity = 16;
+		while (capacity < max_entries * 2) {
+			capacity *= 2;
+		}
+
+		slot empty;
+		empty.hash = 0;
+		empty.entry = -1;
+		_slots.assign(capacity, empty);
+	}
+
+	/**
+	 * @return What was extracted from this tag before or @c nullptr if it hasn't been seen yet
+	 */
+	const tag* find(const char* in, size_t len) const
+	{
+		auto value = hash(in, len);
+		auto mask = _slots.size() - 1;
+
+		for (auto pos = value & mask; _slots[pos].entry >= 0; pos = (pos + 1) & mask) {
+			if (_slots[pos].hash != value) {
+				continue;
+			}
+
+			auto& e = _entries[_slots[pos].entry];
+			if (e.in.size() == len && !memcmp(e.in.data(), in, len)) {
+				return &e.parsed;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void add(const char* in, size_t len, const SCP_string& text, int id)
+	{
+		if (_entries.size() >= _max_entries) {
+			clear();
+		}
+
+		auto value = hash(in, len);
+		auto mask = _slots.size() - 1;
+		auto pos = value & mask;
+
+		while (_slots[pos].entry >= 0) {
+			pos = (pos + 1) & mask;
+		}
+
+		entry e;
+		e.in.assign(in, len);
+		e.parsed.text = text;
+		e.parsed.id = id;
+		_entries.push_back(std::move(e));
+
+		_slots[pos].hash = value;
+		_slots[pos].entry = static_cast<int>(_entries.size()) - 1;
+	}
+
+	size_t size() const { return _entries.size(); }
+
+	void clear()
+	{
+		_entries.clear();
+		for (auto& s : _slots) {
+			s.entry = -1;
+		}
+	}
+};
+
+} // namespace localization
@@ -12,6 +12,7 @@
 
 #include <cctype>
 #include "cfile/cfile.h"
+#include "localization/lcl_strings.h"
 #include "localization/localize.h"
 #include "osapi/osregistry.h"
 #include "parse/encrypt.h"
@@ -78,7 +79,13 @@ int Xstr_inited = 0;
 #define PARSE_TEXT_BUF_SIZE			PARSE_BUF_SIZE
 #define PARSE_ID_BUF_SIZE			5
 
-SCP_unordered_map<int, char*> Lcl_ext_str;
+localization::string_table Lcl_ext_str;
+
+// XSTR() tags which were already taken apart, separately for both versions of lcl_ext_localize_sub() since they don't
+// accept quite the same tags
+#define LCL_MAX_XSTR_TAGS			2048
+static localization::xstr_tag_cache Lcl_xstr_tags(LCL_MAX_XSTR_TAGS);
+static localization::xstr_tag_cache Lcl_xstr_tags_string(LCL_MAX_XSTR_TAGS);
 
 
 // ------------------------------------------------------------------------------------------------------------
@@ -351,25 +358,21 @@ void parse_stringstbl_common(const char *filename, const bool external)
 			}
 
 			// write into Xstr_table (for strings.tbl) or Lcl_ext_str (for tstrings.tbl)
-			if (Parsing_modular_table) {
-				if ( external && (Lcl_ext_str.find(index) != Lcl_ext_str.end()) ) {
-					vm_free((void *) Lcl_ext_str[index]);
-					Lcl_ext_str.erase(Lcl_ext_str.find(index));
-				} else if ( !external && (Xstr_table[index].str != NULL) ) {
+			// a modular table replaces the string, otherwise the first one is kept
+			if (external) {
+				if (!Lcl_ext_str.insert(index, buf, Parsing_modular_table) && !Parsing_modular_table) {
+					Warning(LOCATION, "Tstrings table index %d used more than once", index);
+				}
+			} else {
+				if (Parsing_modular_table && (Xstr_table[index].str != NULL)) {
 					vm_free((void *) Xstr_table[index].str);
 					Xstr_table[index].str = NULL;
 				}
-			}
 
-			if (external && (Lcl_ext_str.find(index) != Lcl_ext_str.end())) {
-				Warning(LOCATION, "Tstrings table index %d used more than once", index);
-			} else if (!external && (Xstr_table[index].str != NULL)) {
-				Warning(LOCATION, "Strings table index %d used more than once", index);
-			}
+				if (Xstr_table[index].str != NULL) {
+					Warning(LOCATION, "Strings table index %d used more than once", index);
+				}
 
-			if (external) {
-				Lcl_ext_str.insert(std::make_pair(index, vm_strdup(buf)));
-			} else {
 				Xstr_table[index].str = vm_strdup(buf);
 			}
 
@@ -469,12 +472,9 @@ void lcl_xstr_close()
 		}
 	}
 
-	for (const auto& entry : Lcl_ext_str) {
-		if (entry.second != nullptr) {
-			vm_free(entry.second);
-		}
-	}
 	Lcl_ext_str.clear();
+	Lcl_xstr_tags.clear();
+	Lcl_xstr_tags_string.clear();
 }
 
 
@@ -689,28 +689,36 @@ bool lcl_ext_localize_sub(const char *in, char *text_str, char *out, size_t max_
 		return false;
 	}
 
-	// at this point we _know_ its an XSTR() tag, so split off the strings and id sections
-	if (!lcl_ext_get_text(in, text_str)) {
-		if (str_len > max_len && !Lcl_unexpected_tstring_check)
-			error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", in, str_len, max_len);
+	// at this point we _know_ its an XSTR() tag, so split off the strings and id sections, unless we already did
+	auto tag = Lcl_xstr_tags.find(in, str_len);
+	if (tag != nullptr) {
+		strcpy(text_str, tag->text.c_str());
+		str_id = tag->id;
+	} else {
+		if (!lcl_ext_get_text(in, text_str)) {
+			if (str_len > max_len && !Lcl_unexpected_tstring_check)
+				error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", in, str_len, max_len);
 
-		strncpy(out, in, max_len);
+			strncpy(out, in, max_len);
 
-		if (id != NULL)
-			*id = -1;
+			if (id != NULL)
+				*id = -1;
 
-		return false;
-	}
-	if (!lcl_ext_get_id(in, &str_id)) {
-		if (str_len > max_len && !Lcl_unexpected_tstring_check)
-			error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", in, str_len, max_len);
+			return false;
+		}
+		if (!lcl_ext_get_id(in, &str_id)) {
+			if (str_len > max_len && !Lcl_unexpected_tstring_check)
+				error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", in, str_len, max_len);
 
-		strncpy(out, in, max_len);
+			strncpy(out, in, max_len);
 
-		if (id != NULL)
-			*id = -1;
+			if (id != NULL)
+				*id = -1;
 
-		return false;
+			return false;
+		}
+
+		Lcl_xstr_tags.add(in, str_len, text_str, str_id);
 	}
 	
 	// if the localization file is not open, or there's no entry, return the original string
@@ -727,12 +735,13 @@ bool lcl_ext_localize_sub(const char *in, char *text_str, char *out, size_t max_
 	}
 
 	// get the string if it exists
-	if (Lcl_ext_str.find(str_id) != Lcl_ext_str.end()) {
+	auto translated = Lcl_ext_str.find(str_id);
+	if (translated != nullptr) {
 		// copy to the outgoing string
-		if ( strlen(Lcl_ext_str[str_id]) > max_len && !Lcl_unexpected_tstring_check )
-			error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", Lcl_ext_str[str_id], strlen(Lcl_ext_str[str_id]), max_len);
+		if ( strlen(translated) > max_len && !Lcl_unexpected_tstring_check )
+			error_display(0, "Token too long: [%s].  Length = " SIZE_T_ARG ".  Max is " SIZE_T_ARG ".\n", translated, strlen(translated), max_len);
 
-		strncpy(out, Lcl_ext_str[str_id], max_len);
+		strncpy(out, translated, max_len);
 	}
 	// otherwise use what we have - probably should Int3() or assert here
 	else {
@@ -781,22 +790,30 @@ bool lcl_ext_localize_sub(const SCP_string &in, SCP_string &text_str, SCP_string
 		return false;
 	}
 
-	// at this point we _know_ its an XSTR() tag, so split off the strings and id sections		
-	if (!lcl_ext_get_text(in, text_str)) {
-		out = in;
+	// at this point we _know_ its an XSTR() tag, so split off the strings and id sections, unless we already did
+	auto tag = Lcl_xstr_tags_string.find(in.c_str(), in.length());
+	if (tag != nullptr) {
+		text_str = tag->text;
+		str_id = tag->id;
+	} else {
+		if (!lcl_ext_get_text(in, text_str)) {
+			out = in;
 
-		if (id != NULL)
-			*id = -1;
+			if (id != NULL)
+				*id = -1;
 
-		return false;
-	}
-	if (!lcl_ext_get_id(in, &str_id)) {
-		out = in;
+			return false;
+		}
+		if (!lcl_ext_get_id(in, &str_id)) {
+			out = in;
 
-		if (id != NULL)
-			*id = -1;
+			if (id != NULL)
+				*id = -1;
 
-		return false;
+			return false;
+		}
+
+		Lcl_xstr_tags_string.add(in.c_str(), in.length(), text_str, str_id);
 	}
 	
 	// if the localization file is not open, or there's no entry, or we're not translating, return the original string
@@ -810,9 +827,10 @@ bool lcl_ext_localize_sub(const SCP_string &in, SCP_string &text_str, SCP_string
 	}
 
 	// get the string if it exists
-	if (Lcl_ext_str.find(str_id) != Lcl_ext_str.end()) {
+	auto translated = Lcl_ext_str.find(str_id);
+	if (translated != nullptr) {
 		// copy to the outgoing string
-		out = Lcl_ext_str[str_id];
+		out = translated;
 	}
 	// otherwise use what we have - probably should Int3() or assert here
 	else {
@@ -470,9 +470,12 @@ void options_play_voice_clip()
 	auto gs = gamesnd_get_interface_sound(InterfaceSounds::VOICE_SLIDER_CLIP);
 	auto entry = gamesnd_choose_entry(gs);
 
-	auto snd_id = snd_load(entry, gs->flags, 0);
+	// the entry keeps its reference like the other interface sounds, so playing the clip again doesn't take another
+	if (!entry->id.isValid()) {
+		entry->id = snd_load(entry, gs->flags, 0);
+	}
 
-	Voice_vol_handle = snd_play_raw( snd_id, 0.0f, 1.0f, SND_PRIORITY_SINGLE_INSTANCE );
+	Voice_vol_handle = snd_play_raw( entry->id, 0.0f, 1.0f, SND_PRIORITY_SINGLE_INSTANCE );
 }
 
 void options_add_notify(const char *str)
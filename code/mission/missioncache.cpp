@@ -0,0 +1,180 @@
+
+#include "mission/missioncache.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "globalincs/systemvars.h"
+#include "globalincs/version.h"
+#include "localization/localize.h"
+#include "parse/sexp.h"
+#include "parse/tablecache.h"
+
+#include <md5.h>
+
+// bump this whenever check_sexp_syntax() gets stricter
+#define MISSION_CACHE_VERSION		1
+
+#define MISSION_CACHE_MAGIC			0x434d5346	// "FSMC"
+
+#define MISSION_CACHE_LOCATIONS		(CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
+
+typedef struct mission_cache_entry {
+	uint	magic;
+	uint	version;
+	uint	raw_len;
+	int		num_top_level;
+	int		num_nodes;
+} mission_cache_entry;
+
+// name of the cache file of the mission being loaded, empty if it can't be cached
+static SCP_string Mission_cache_name;
+static uint Mission_cache_raw_len = 0;
+
+// missions validated during this session
+static SCP_unordered_map<SCP_string, mission_cache_entry> Mission_cache_validated;
+
+// what check_sexp_syntax() checks against in this build, so another build doesn't trust our results
+static const SCP_string &mission_cache_build_key()
+{
+	static SCP_string key;
+	static size_t num_operators = 0;
+
+	// scripts can add operators, so the key is made again when there are more
+	if (key.empty() || num_operators != Operators.size()) {
+		MD5 md5;
+
+		auto version = gameversion::get_version_string();
+		md5.update(version.c_str(), (MD5::size_type)version.size() + 1);
+
+		for (auto &op : Operators) {
+			int values[4] = { op.value, op.min, op.max, op.type };
+			md5.update(op.text.c_str(), (MD5::size_type)op.text.size() + 1);
+			md5.update(reinterpret_cast<const char*>(values), sizeof(values));
+		}
+
+		md5.finalize();
+		key = md5.hexdigest();
+		num_operators = Operators.size();
+	}
+
+	return key;
+}
+
+void mission_cache_begin(const char *raw_text, int flags)
+{
+	Mission_cache_name.clear();
+
+	if (raw_text == NULL || Fred_running || Cmdline_nomissioncache) {
+		return;
+	}
+
+	auto raw_len = strlen(raw_text);
+
+	// everything besides the text which changes what the sexps are checked against
+	int key[4];
+	key[0] = MISSION_CACHE_VERSION;
+	key[1] = flags;
+	key[2] = (Game_mode & GM_MULTIPLAYER) ? 1 : 0;
+	key[3] = Lcl_pl;
+
+	// the tables aren't all known until game_init() is done
+	auto &tables = table_hash_get();
+	if (tables.empty()) {
+		return;
+	}
+
+	auto &build = mission_cache_build_key();
+
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(key), sizeof(key));
+	md5.update(build.c_str(), (MD5::size_type)build.size());
+	md5.update(tables.c_str(), (MD5::size_type)tables.size());
+	md5.update(raw_text, (MD5::size_type)raw_len);
+	md5.finalize();
+
+	char name[MAX_FILENAME_LEN];
+	sprintf(name, "ms%.20s.bx", md5.hexdigest().c_str());
+
+	Mission_cache_name = name;
+	Mission_cache_raw_len = (uint)raw_len;
+}
+
+static bool mission_cache_read(mission_cache_entry &entry)
+{
+	CFILE *fp = cfopen(Mission_cache_name.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, MISSION_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	bool valid = ((size_t)cfilelength(fp) == sizeof(entry)) && (cfread(&entry, sizeof(entry), 1, fp) == 1);
+
+	cfclose(fp);
+
+	valid = valid && (entry.magic == MISSION_CACHE_MAGIC) && (entry.version == MISSION_CACHE_VERSION)
+		&& (entry.raw_len == Mission_cache_raw_len);
+
+	if ( !valid ) {
+		mprintf(("Mission cache file %s is invalid, ignoring it\n", Mission_cache_name.c_str()));
+	}
+
+	return valid;
+}
+
+bool mission_cache_sexps_valid(int num_top_level, int num_nodes)
+{
+	if (Mission_cache_name.empty()) {
+		return false;
+	}
+
+	mission_cache_entry entry;
+
+	auto it = Mission_cache_validated.find(Mission_cache_name);
+	if (it != Mission_cache_validated.end()) {
+		entry = it->second;
+	} else if (mission_cache_read(entry)) {
+		Mission_cache_validated[Mission_cache_name] = entry;
+	} else {
+		return false;
+	}
+
+	// the same text against the same tables has to give the same sexps, but it doesn't hurt to make sure
+	if (entry.num_top_level != num_top_level || entry.num_nodes != num_nodes) {
+		mprintf(("Mission cache file %s doesn't match the parsed mission, validating sexps again\n", Mission_cache_name.c_str()));
+		return false;
+	}
+
+	mprintf(("Mission cache: the %d sexps of this mission were already validated\n", num_top_level));
+	return true;
+}
+
+void mission_cache_set_sexps_valid(int num_top_level, int num_nodes)
+{
+	if (Mission_cache_name.empty()) {
+		return;
+	}
+
+	mission_cache_entry entry;
+	entry.magic = MISSION_CACHE_MAGIC;
+	entry.version = MISSION_CACHE_VERSION;
+	entry.raw_len = Mission_cache_raw_len;
+	entry.num_top_level = num_top_level;
+	entry.num_nodes = num_nodes;
+
+	Mission_cache_validated[Mission_cache_name] = entry;
+
+	CFILE *fp = cfopen(Mission_cache_name.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, MISSION_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		mprintf(("Could not open mission cache file %s for writing!\n", Mission_cache_name.c_str()));
+		return;
+	}
+
+	bool written = cfwrite(&entry, sizeof(entry), 1, fp) == 1;
+
+	cfclose(fp);
+
+	if ( !written ) {
+		mprintf(("Could not write mission cache file %s!\n", Mission_cache_name.c_str()));
+		cf_delete(Mission_cache_name.c_str(), CF_TYPE_CACHE, MISSION_CACHE_LOCATIONS);
+	}
+}
@@ -0,0 +1,20 @@
+#ifndef _MISSIONCACHE_H
+#define _MISSIONCACHE_H
+
+#include "globalincs/pstypes.h"
+
+// The mission cache remembers which missions had all of their sexps pass check_sexp_syntax(), so loading such a mission
+// again (the next time the game runs, or when a standalone server cycles back to it) can skip validating every sexp in
+// post_process_mission(). Entries are keyed on a hash of the raw mission text, all tables and the parse flags and are
+// kept in memory as well as in CF_TYPE_CACHE. FRED always validates.
+
+// Starts looking up the mission whose raw text was just read, call with NULL for text which can't be cached
+void mission_cache_begin(const char *raw_text, int flags);
+
+// Whether the sexps of the current mission are known to be valid, the counts have to match what was stored
+bool mission_cache_sexps_valid(int num_top_level, int num_nodes);
+
+// Stores that all sexps of the current mission passed validation
+void mission_cache_set_sexps_valid(int num_top_level, int num_nodes);
+
+#endif
@@ -1073,7 +1073,11 @@ bool message_play_wave( message_q *q )
 		if ( q->flags & MQF_CONVERT_TO_COMMAND ) {
 			char *p, new_filename[MAX_FILENAME_LEN];
 
-			Message_waves[index].num = sound_load_id::invalid(); // forces us to reload the message
+			// forces us to reload the message
+			if (Message_waves[index].num.isValid()) {
+				snd_unload(Message_waves[index].num);
+			}
+			Message_waves[index].num = sound_load_id::invalid();
 
 			// bash the filename here. Look for "[1-6]_" at the front of the message.  If found, then
 			// convert to TC_*
@@ -15,6 +15,7 @@
 #include <cassert>
 #include <cstdarg>
 #include <csetjmp>
+#include <queue>
 
 
 #include "ai/aigoals.h"
@@ -37,6 +38,7 @@
 #include "math/fvi.h"
 #include "math/staticrand.h"
 #include "mission/missionbriefcommon.h"
+#include "mission/missioncache.h"
 #include "mission/missioncampaign.h"
 #include "mission/missiongoals.h"
 #include "mission/missionhotkey.h"
@@ -352,6 +354,24 @@ fix Mission_end_time;
 #define ARRIVAL_TIMESTAMP		2000		// every 2 seconds
 #define DEPARTURE_TIMESTAMP	2200		// every 2.2 seconds -- just to be a little different
 
+// Once the arrival cue of a ship or wing is true, nothing happens to it until its arrival delay (or for later waves,
+// its wave delay) is up, so rather than evaluating its cue every frame it sleeps in Arrival_wakeups until then.
+// The sleeping timestamp is also kept per ship and wing; if a sexp changes the delay in the meantime they no longer
+// match and the ship or wing is checked again right away.
+typedef struct arrival_wakeup {
+	int timestamp;
+	int index;			// into Parse_objects or Wings
+	bool is_wing;
+
+	bool operator>(const arrival_wakeup &other) const { return timestamp > other.timestamp; }
+} arrival_wakeup;
+
+static std::priority_queue<arrival_wakeup, SCP_vector<arrival_wakeup>, std::greater<arrival_wakeup>> Arrival_wakeups;
+static SCP_vector<int> Arrival_ship_sleeping;		// timestamp each parse object sleeps until, 0 if awake
+static int Arrival_wing_sleeping[MAX_WINGS];		// same for the wings
+
+int Mission_arrival_checks = 0;
+
 // calculates a "unique" file signature as a ushort (checksum) and an int (file length)
 // the amount of The_mission we're going to checksum
 // WARNING : do NOT call this function on the server - it will overwrite goals, etc
@@ -5834,34 +5854,45 @@ bool post_process_mission()
 	}
 
 	// before doing anything else, we must validate all of the sexpressions that were loaded into the mission.
-	// Loop through the Sexp_nodes array and send the top level functions to the check_sexp_syntax parser
-
+	// Loop through the Sexp_nodes array and send the top level functions to the check_sexp_syntax parser,
+	// unless the mission cache already saw this mission pass with the same tables
+	int num_top_level = 0;
 	for (i = 0; i < Num_sexp_nodes; i++) {
-		if (is_sexp_top_level(i) && (!Fred_running || (i != Sexp_clipboard))) {
-			int result, bad_node, op;
-
-			op = get_operator_index(i);
-			Assert(op != -1);  // need to make sure it is an operator before we treat it like one..
-			result = check_sexp_syntax( i, query_operator_return_type(op), 1, &bad_node);
-
-			// entering this if statement will result in program termination!!!!!
-			// print out an error based on the return value from check_sexp_syntax()
-			// G5K: now entering this statement simply aborts the mission load
-			if ( result ) {
-				SCP_string sexp_str;
-				SCP_string error_msg;
-
-				convert_sexp_to_string(sexp_str, i, SEXP_ERROR_CHECK_MODE);
-				truncate_message_lines(sexp_str, 30);
-				sprintf(error_msg, "%s.\n\nIn sexpression: %s\n(Error appears to be: %s)", sexp_error_message(result), sexp_str.c_str(), Sexp_nodes[bad_node].text);
-				Warning(LOCATION, "%s", error_msg.c_str());
-
-				// syntax errors are recoverable in Fred but not FS
-				if (!Fred_running) {
-					return false;
+		if (is_sexp_top_level(i))
+			num_top_level++;
+	}
+	int num_used_nodes = Num_sexp_nodes - count_free_sexp_nodes();
+
+	if (!mission_cache_sexps_valid(num_top_level, num_used_nodes)) {
+		for (i = 0; i < Num_sexp_nodes; i++) {
+			if (is_sexp_top_level(i) && (!Fred_running || (i != Sexp_clipboard))) {
+				int result, bad_node, op;
+
+				op = get_operator_index(i);
+				Assert(op != -1);  // need to make sure it is an operator before we treat it like one..
+				result = check_sexp_syntax( i, query_operator_return_type(op), 1, &bad_node);
+
+				// entering this if statement will result in program termination!!!!!
+				// print out an error based on the return value from check_sexp_syntax()
+				// G5K: now entering this statement simply aborts the mission load
+				if ( result ) {
+					SCP_string sexp_str;
+					SCP_string error_msg;
+
+					convert_sexp_to_string(sexp_str, i, SEXP_ERROR_CHECK_MODE);
+					truncate_message_lines(sexp_str, 30);
+					sprintf(error_msg, "%s.\n\nIn sexpression: %s\n(Error appears to be: %s)", sexp_error_message(result), sexp_str.c_str(), Sexp_nodes[bad_node].text);
+					Warning(LOCATION, "%s", error_msg.c_str());
+
+					// syntax errors are recoverable in Fred but not FS
+					if (!Fred_running) {
+						return false;
+					}
 				}
 			}
 		}
+
+		mission_cache_set_sexps_valid(num_top_level, num_used_nodes);
 	}
 
 	// multiplayer missions are handled just before mission start
@@ -5939,6 +5970,7 @@ bool post_process_mission()
 	ets_init_ship(Player_obj);	// init ETS data for the player
 
 	// put the timestamp stuff here for now
+	mission_arrival_schedule_reset();
 	Mission_arrival_timestamp = timestamp( ARRIVAL_TIMESTAMP );
 	Mission_departure_timestamp = timestamp( DEPARTURE_TIMESTAMP );
 	Mission_end_time = -1;
@@ -6083,13 +6115,17 @@ bool parse_main(const char *mission_name, int flags)
 			if (flags & MPF_IMPORT_FSM) {
 				read_file_text(mission_name, CF_TYPE_ANY);
 				convertFSMtoFS2();
+				mission_cache_begin(NULL, flags);
 			}
 			else {
 				read_file_text(mission_name, CF_TYPE_MISSIONS);
+				mission_cache_begin(Parse_text_raw, flags);
 			}
 
 			The_mission.Reset();
+			sexp_report_memory("before parsing mission");
 			rval = parse_mission(&The_mission, flags);
+			sexp_report_memory("after parsing mission");
 			display_parse_diagnostics();
 		}
 		catch (const parse::ParseException& e)
@@ -6843,7 +6879,7 @@ int mission_did_ship_arrive(p_object *objp)
 
 		// since this ship is not in a wing, create a SHIP_ARRIVE entry
 		//mission_log_add_entry( LOG_SHIP_ARRIVE, objp->name, NULL );
-		Assert(object_num >= 0 && object_num < MAX_OBJECTS);
+		Assert(object_num >= 0 && object_num < objects_size());
 		
 		// Play the music track for an arrival
 		if ( !(Ships[Objects[object_num].instance].flags[Ship::Ship_Flags::No_arrival_music]) )
@@ -6952,6 +6988,55 @@ int parse_object_on_arrival_list(p_object *pobjp)
 	return (pobjp->next != NULL) && (pobjp->prev != NULL);
 }
 
+void mission_arrival_schedule_reset()
+{
+	Arrival_wakeups = decltype(Arrival_wakeups)();
+	Arrival_ship_sleeping.assign(Parse_objects.size(), 0);
+	memset(Arrival_wing_sleeping, 0, sizeof(Arrival_wing_sleeping));
+	Mission_arrival_checks = 0;
+}
+
+static void mission_arrival_sleep(int index, bool is_wing, int stamp)
+{
+	arrival_wakeup wakeup;
+	wakeup.timestamp = stamp;
+	wakeup.index = index;
+	wakeup.is_wing = is_wing;
+	Arrival_wakeups.push(wakeup);
+
+	if (is_wing)
+		Arrival_wing_sleeping[index] = stamp;
+	else
+		Arrival_ship_sleeping[index] = stamp;
+}
+
+// wakes everything whose delay is up
+static void mission_arrival_wake_up()
+{
+	while (!Arrival_wakeups.empty() && timestamp_elapsed(Arrival_wakeups.top().timestamp))
+	{
+		auto &wakeup = Arrival_wakeups.top();
+		int &sleeping = wakeup.is_wing ? Arrival_wing_sleeping[wakeup.index] : Arrival_ship_sleeping[wakeup.index];
+
+		// it may have been put to sleep again for a different time since
+		if (sleeping == wakeup.timestamp)
+			sleeping = 0;
+
+		Arrival_wakeups.pop();
+	}
+}
+
+static bool mission_arrival_is_asleep(const p_object *pobjp, int index)
+{
+	return Arrival_ship_sleeping[index] != 0 && Arrival_ship_sleeping[index] == pobjp->arrival_delay;
+}
+
+static bool mission_arrival_is_asleep(const wing *wingp, int index)
+{
+	return Arrival_wing_sleeping[index] != 0
+		&& (Arrival_wing_sleeping[index] == wingp->arrival_delay || Arrival_wing_sleeping[index] == wingp->wave_delay_timestamp);
+}
+
 /**
  * Check the lists of arriving ships and wings, creating new ships/wings if the arrival criteria have been met
  */
@@ -6961,6 +7046,12 @@ void mission_eval_arrivals()
 	int rship = -1;
 	wing *wingp;
 
+	if (Arrival_ship_sleeping.size() < Parse_objects.size())
+		Arrival_ship_sleeping.resize(Parse_objects.size(), 0);
+
+	mission_arrival_wake_up();
+	Mission_arrival_checks = 0;
+
 	// before checking arrivals, check to see if we should play a message concerning arrivals
 	// of other wings.  We use the timestamps to delay the arrival message slightly for
 	// better effect
@@ -6995,8 +7086,18 @@ void mission_eval_arrivals()
 		if (pobjp->wingnum >= 0)
 			continue;
 
+		int index = (int)std::distance(Parse_objects.begin(), ii);
+		if (mission_arrival_is_asleep(pobjp, index))
+			continue;
+
 		// make it arrive
+		Mission_arrival_checks++;
 		mission_maybe_make_ship_arrive(pobjp);
+
+		// if its cue is true but the delay is still running, there's no need to look at it before the delay is up
+		if (parse_object_on_arrival_list(pobjp) && !pobjp->flags[Mission::Parse_Object_Flags::SF_Reinforcement]
+			&& pobjp->arrival_delay > 0 && !timestamp_elapsed(pobjp->arrival_delay))
+			mission_arrival_sleep(index, false, pobjp->arrival_delay);
 	}
 
 	// check the support ship arrival list
@@ -7042,13 +7143,27 @@ void mission_eval_arrivals()
 		// If the threshold of the wing has been reached, then we need to create more ships.
 		if ((wingp->current_wave == 0) || (wingp->current_count <= wingp->threshold))
 		{
+			if (mission_arrival_is_asleep(wingp, i))
+				continue;
+
 			// Call parse_wing_create_ships to try and create it.  That function will eval the arrival
 			// cue of the wing and create the ships if necessary.
+			Mission_arrival_checks++;
 			int created = parse_wing_create_ships(wingp, wingp->wave_count);
 
 			// if we didn't create any ships, nothing more to do for this wing
 			if (created <= 0)
+			{
+				// but if it's only waiting for its arrival or wave delay, it can sleep until then
+				if (!wingp->flags[Ship::Wing_Flags::Gone])
+				{
+					if (wingp->arrival_delay > 0 && !timestamp_elapsed(wingp->arrival_delay))
+						mission_arrival_sleep(i, true, wingp->arrival_delay);
+					else if (timestamp_valid(wingp->wave_delay_timestamp) && !timestamp_elapsed(wingp->wave_delay_timestamp))
+						mission_arrival_sleep(i, true, wingp->wave_delay_timestamp);
+				}
 				continue;
+			}
 
 			// If this wing was a reinforcement wing, then we need to reset the reinforcement flag for the wing
 			// so the user can call in another set if need be.
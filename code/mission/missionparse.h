@@ -464,6 +464,7 @@ extern vec3d Parse_viewer_pos;
 extern matrix Parse_viewer_orient;
 
 extern int Mission_arrival_timestamp;
+extern int Mission_arrival_checks;		// arrival cues evaluated by the last mission_eval_arrivals()
 extern int Mission_departure_timestamp;
 extern fix Mission_end_time;
 
@@ -513,6 +514,7 @@ int get_parse_name_index(const char *name);
 
 // called from freespace game level loop
 void mission_parse_eval_stuff();
+void mission_arrival_schedule_reset();
 
 // function to set the ramaing time left in the mission
 void mission_parse_set_end_time( int seconds );
@@ -0,0 +1,358 @@
+
+#include "model/modelcache.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "graphics/tmapper.h"
+#include "io/timer.h"
+#include "model/model.h"
+
+#include <md5.h>
+
+// bump this whenever the cooked layout or the way the collision trees are built changes
+#define MODEL_CACHE_VERSION		1
+
+#define MODEL_CACHE_MAGIC		0x434d5346	// "FSMC"
+
+// every array in a cache file starts at a multiple of this
+#define MODEL_CACHE_ALIGNMENT	16
+
+#define MODEL_CACHE_LOCATIONS	(CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
+
+// A cache file starts with this header, followed by one cooked_tree per submodel and then the arrays they point to.
+// Everything is stored in the native byte order, the sizes of the structures catch builds with a different layout.
+typedef struct cooked_header {
+	uint	magic;
+	uint	version;
+	uint	node_size;
+	uint	leaf_size;
+	uint	vert_size;
+	uint	point_size;
+	int		n_models;
+	int		pad;
+	std::uint64_t	parse_us;		// how long building the trees took when the file was written
+} cooked_header;
+
+typedef struct cooked_tree {
+	int		has_tree;
+	int		n_verts;
+	int		n_nodes;
+	int		n_leaves;
+	int		n_tmap_verts;
+	int		pad;
+
+	// from the start of the file
+	std::uint64_t	points_offset;
+	std::uint64_t	nodes_offset;
+	std::uint64_t	leaves_offset;
+	std::uint64_t	tmap_verts_offset;
+} cooked_tree;
+
+static bool model_cache_enabled()
+{
+	return !Cmdline_nomodelcache;
+}
+
+static bool model_cache_has_tree(const polymodel *pm, int submodel)
+{
+	return !(pm->submodel[submodel].nocollide_this_only || pm->submodel[submodel].no_collisions);
+}
+
+// the tree doesn't keep the length of its vert list, but every vert belongs to a leaf
+static int model_cache_count_tmap_verts(const bsp_collision_tree *tree)
+{
+	int count = 0;
+
+	for (int i = 0; i < tree->n_leaves; i++) {
+		count = MAX(count, tree->leaf_list[i].vert_start + tree->leaf_list[i].num_verts);
+	}
+
+	return count;
+}
+
+static std::uint64_t model_cache_align(std::uint64_t offset)
+{
+	return (offset + MODEL_CACHE_ALIGNMENT - 1) & ~std::uint64_t(MODEL_CACHE_ALIGNMENT - 1);
+}
+
+static bool model_cache_array_valid(std::uint64_t offset, int count, size_t elem_size, size_t file_size)
+{
+	if (count < 0) {
+		return false;
+	}
+
+	if (count == 0) {
+		return true;
+	}
+
+	return (offset % MODEL_CACHE_ALIGNMENT) == 0 && offset <= file_size && (file_size - offset) / elem_size >= (size_t)count;
+}
+
+// a child or list index has to be -1 or come after the entry it belongs to, that is how the trees are built and it means
+// a broken file can't send the collision code around in circles
+static bool model_cache_next_valid(int next, int current, int count)
+{
+	return next < 0 || (next > current && next < count);
+}
+
+// checks that every index in a tree stays inside the arrays it refers to
+static bool model_cache_tree_valid(const ubyte *data, const cooked_tree *ct)
+{
+	auto nodes = reinterpret_cast<const bsp_collision_node*>(data + ct->nodes_offset);
+	auto leaves = reinterpret_cast<const bsp_collision_leaf*>(data + ct->leaves_offset);
+	auto tmap_verts = reinterpret_cast<const model_tmap_vert*>(data + ct->tmap_verts_offset);
+
+	for (int i = 0; i < ct->n_nodes; i++) {
+		if ( !model_cache_next_valid(nodes[i].back, i, ct->n_nodes) || !model_cache_next_valid(nodes[i].front, i, ct->n_nodes)
+			|| nodes[i].leaf >= ct->n_leaves ) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < ct->n_leaves; i++) {
+		if ( !model_cache_next_valid(leaves[i].next, i, ct->n_leaves) || leaves[i].vert_start < 0
+			|| leaves[i].num_verts > TMAP_MAX_VERTS || leaves[i].vert_start + leaves[i].num_verts > ct->n_tmap_verts ) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < ct->n_tmap_verts; i++) {
+		if (tmap_verts[i].vertnum >= ct->n_verts) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename T>
+static T *model_cache_copy_array(const ubyte *data, std::uint64_t offset, int count)
+{
+	if (count <= 0) {
+		return nullptr;
+	}
+
+	auto array = reinterpret_cast<T*>(vm_malloc(sizeof(T) * count));
+	memcpy(array, data + offset, sizeof(T) * count);
+
+	return array;
+}
+
+bool model_cache_get_name(const char *pof_filename, uint pof_checksum, int pof_size, SCP_string &cache_name)
+{
+	if ( !model_cache_enabled() || pof_size <= 0 ) {
+		return false;
+	}
+
+	int key[3];
+	key[0] = MODEL_CACHE_VERSION;
+	key[1] = (int)pof_checksum;
+	key[2] = pof_size;
+
+	// the checksum was computed while the POF was loaded anyway, hashing it again would mean reading it twice
+	SCP_string name_key = pof_filename;
+	for (auto &c : name_key) {
+		c = (char)tolower((unsigned char)c);
+	}
+
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(key), sizeof(key));
+	md5.update(name_key.c_str(), (MD5::size_type)name_key.size());
+	md5.finalize();
+
+	// 80 bits of the hash is plenty, and keeps us inside MAX_FILENAME_LEN
+	char name[MAX_FILENAME_LEN];
+	sprintf(name, "mc%.20s.bx", md5.hexdigest().c_str());
+	cache_name = name;
+
+	return true;
+}
+
+bool model_cache_load_collision_trees(polymodel *pm, const SCP_string &cache_name)
+{
+	auto start = timer_get_microseconds();
+
+	// prefer a mapping of the file, but fall back to reading it if the file can't be mapped
+	SCP_vector<ubyte> buffer;
+	const ubyte *data = nullptr;
+	size_t size = 0;
+
+	CFILE *fp = cfopen(cache_name.c_str(), "rb", CFILE_MEMORY_MAPPED, CF_TYPE_CACHE, false, MODEL_CACHE_LOCATIONS);
+
+	if (fp != nullptr) {
+		data = reinterpret_cast<const ubyte*>(cf_returndata(fp));
+		size = (size_t)cfilelength(fp);
+	} else {
+		fp = cfopen(cache_name.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, MODEL_CACHE_LOCATIONS);
+
+		if (fp == nullptr) {
+			return false;
+		}
+
+		int len = cfilelength(fp);
+
+		if (len > 0) {
+			buffer.resize((size_t)len);
+
+			if (cfread(buffer.data(), 1, len, fp) == len) {
+				data = buffer.data();
+				size = buffer.size();
+			}
+		}
+	}
+
+	// make sure everything in the file makes sense before touching the model
+	bool valid = (data != nullptr) && (size >= sizeof(cooked_header));
+	cooked_header header;
+	const cooked_tree *trees = nullptr;
+
+	if (valid) {
+		memcpy(&header, data, sizeof(header));
+
+		valid = (header.magic == MODEL_CACHE_MAGIC) && (header.version == MODEL_CACHE_VERSION)
+			&& (header.node_size == sizeof(bsp_collision_node)) && (header.leaf_size == sizeof(bsp_collision_leaf))
+			&& (header.vert_size == sizeof(model_tmap_vert)) && (header.point_size == sizeof(vec3d))
+			&& (header.n_models == pm->n_models)
+			&& ((size - sizeof(cooked_header)) / sizeof(cooked_tree) >= (size_t)pm->n_models);
+	}
+
+	if (valid) {
+		trees = reinterpret_cast<const cooked_tree*>(data + sizeof(cooked_header));
+
+		for (int i = 0; i < pm->n_models && valid; i++) {
+			const cooked_tree *ct = &trees[i];
+
+			if ((ct->has_tree != 0) != model_cache_has_tree(pm, i)) {
+				valid = false;
+			} else if (ct->has_tree) {
+				valid = model_cache_array_valid(ct->points_offset, ct->n_verts, sizeof(vec3d), size)
+					&& model_cache_array_valid(ct->nodes_offset, ct->n_nodes, sizeof(bsp_collision_node), size)
+					&& model_cache_array_valid(ct->leaves_offset, ct->n_leaves, sizeof(bsp_collision_leaf), size)
+					&& model_cache_array_valid(ct->tmap_verts_offset, ct->n_tmap_verts, sizeof(model_tmap_vert), size)
+					&& model_cache_tree_valid(data, ct);
+			}
+		}
+	}
+
+	if ( !valid ) {
+		mprintf(("Model cache file %s for %s is invalid, parsing the model instead\n", cache_name.c_str(), pm->filename));
+		cfclose(fp);
+		return false;
+	}
+
+	for (int i = 0; i < pm->n_models; i++) {
+		const cooked_tree *ct = &trees[i];
+
+		if ( !ct->has_tree ) {
+			continue;
+		}
+
+		// the tree list owns its arrays and frees them one by one, so they are copied out of the file
+		pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
+		bsp_collision_tree *tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		tree->n_verts = ct->n_verts;
+		tree->point_list = model_cache_copy_array<vec3d>(data, ct->points_offset, ct->n_verts);
+		tree->n_nodes = ct->n_nodes;
+		tree->node_list = model_cache_copy_array<bsp_collision_node>(data, ct->nodes_offset, ct->n_nodes);
+		tree->n_leaves = ct->n_leaves;
+		tree->leaf_list = model_cache_copy_array<bsp_collision_leaf>(data, ct->leaves_offset, ct->n_leaves);
+		tree->vert_list = model_cache_copy_array<model_tmap_vert>(data, ct->tmap_verts_offset, ct->n_tmap_verts);
+	}
+
+	cfclose(fp);
+
+	mprintf(("Loaded cooked collision trees of %s in %.2f ms, parsing them took %.2f ms\n", pm->filename,
+		(timer_get_microseconds() - start) / 1000.0f, header.parse_us / 1000.0f));
+
+	return true;
+}
+
+void model_cache_save_collision_trees(const polymodel *pm, const SCP_string &cache_name, std::uint64_t parse_us)
+{
+	SCP_vector<cooked_tree> trees((size_t)pm->n_models);
+	std::uint64_t offset = model_cache_align(sizeof(cooked_header) + sizeof(cooked_tree) * trees.size());
+
+	// lay out the arrays first...
+	for (int i = 0; i < pm->n_models; i++) {
+		cooked_tree *ct = &trees[i];
+		memset(ct, 0, sizeof(*ct));
+
+		if ( !model_cache_has_tree(pm, i) || (pm->submodel[i].collision_tree_index < 0) ) {
+			continue;
+		}
+
+		const bsp_collision_tree *tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		ct->has_tree = 1;
+		ct->n_verts = tree->n_verts;
+		ct->n_nodes = tree->n_nodes;
+		ct->n_leaves = tree->n_leaves;
+		ct->n_tmap_verts = model_cache_count_tmap_verts(tree);
+
+		ct->points_offset = offset;
+		offset = model_cache_align(offset + sizeof(vec3d) * ct->n_verts);
+		ct->nodes_offset = offset;
+		offset = model_cache_align(offset + sizeof(bsp_collision_node) * ct->n_nodes);
+		ct->leaves_offset = offset;
+		offset = model_cache_align(offset + sizeof(bsp_collision_leaf) * ct->n_leaves);
+		ct->tmap_verts_offset = offset;
+		offset = model_cache_align(offset + sizeof(model_tmap_vert) * ct->n_tmap_verts);
+	}
+
+	// ...then build the whole file in memory
+	SCP_vector<ubyte> file((size_t)offset, 0);
+
+	cooked_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = MODEL_CACHE_MAGIC;
+	header.version = MODEL_CACHE_VERSION;
+	header.node_size = sizeof(bsp_collision_node);
+	header.leaf_size = sizeof(bsp_collision_leaf);
+	header.vert_size = sizeof(model_tmap_vert);
+	header.point_size = sizeof(vec3d);
+	header.n_models = pm->n_models;
+	header.parse_us = parse_us;
+
+	memcpy(file.data(), &header, sizeof(header));
+	if ( !trees.empty() ) {
+		memcpy(file.data() + sizeof(header), trees.data(), sizeof(cooked_tree) * trees.size());
+	}
+
+	for (int i = 0; i < pm->n_models; i++) {
+		const cooked_tree *ct = &trees[i];
+
+		if ( !ct->has_tree ) {
+			continue;
+		}
+
+		const bsp_collision_tree *tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		if (ct->n_verts > 0) {
+			memcpy(file.data() + ct->points_offset, tree->point_list, sizeof(vec3d) * ct->n_verts);
+		}
+		if (ct->n_nodes > 0) {
+			memcpy(file.data() + ct->nodes_offset, tree->node_list, sizeof(bsp_collision_node) * ct->n_nodes);
+		}
+		if (ct->n_leaves > 0) {
+			memcpy(file.data() + ct->leaves_offset, tree->leaf_list, sizeof(bsp_collision_leaf) * ct->n_leaves);
+		}
+		if (ct->n_tmap_verts > 0) {
+			memcpy(file.data() + ct->tmap_verts_offset, tree->vert_list, sizeof(model_tmap_vert) * ct->n_tmap_verts);
+		}
+	}
+
+	CFILE *fp = cfopen(cache_name.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, MODEL_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		mprintf(("Could not open model cache file %s for writing!\n", cache_name.c_str()));
+		return;
+	}
+
+	bool written = cfwrite(file.data(), 1, (int)file.size(), fp) == (int)file.size();
+	cfclose(fp);
+
+	if ( !written ) {
+		mprintf(("Could not write model cache file %s!\n", cache_name.c_str()));
+		cf_delete(cache_name.c_str(), CF_TYPE_CACHE, MODEL_CACHE_LOCATIONS);
+	}
+}
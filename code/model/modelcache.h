@@ -0,0 +1,26 @@
+#ifndef _MODELCACHE_H
+#define _MODELCACHE_H
+
+#include "globalincs/pstypes.h"
+
+class polymodel;
+
+// The cooked model cache keeps the structures model_load() derives from a POF in CF_TYPE_CACHE, so they don't have to
+// be rebuilt every time a mission is loaded. Cache files are named after the name, size and checksum of the POF and the
+// cache format version, a changed POF or a new build with a different layout simply misses the cache. Everything read
+// from a cache file is checked, a file which doesn't fit the model is ignored.
+//
+// Currently only the BSP collision trees are cooked. They are stored as flat arrays which only refer to each other by
+// index, so a cache file can be used straight from a memory mapping without fixing up any pointers.
+
+// Gets the name of the cache file for a POF from the checksum read_model_file() already computed
+// returns false if the cache is disabled
+bool model_cache_get_name(const char *pof_filename, uint pof_checksum, int pof_size, SCP_string &cache_name);
+
+// Sets up the collision trees of all submodels from the cache, returns false if they have to be parsed instead
+bool model_cache_load_collision_trees(polymodel *pm, const SCP_string &cache_name);
+
+// Writes the collision trees of a model to the cache, parse_us is how long it took to build them
+void model_cache_save_collision_trees(const polymodel *pm, const SCP_string &cache_name, std::uint64_t parse_us);
+
+#endif
@@ -31,12 +31,14 @@
 #include "math/fvi.h"
 #include "math/vecmat.h"
 #include "model/model.h"
+#include "model/modelcache.h"
 #include "model/modelsinc.h"
 #include "parse/parselo.h"
 #include "render/3dinternal.h"
 #include "ship/ship.h"
 #include "weapon/weapon.h"
 #include "tracing/tracing.h"
+#include "utils/name_index.h"
 
 #include <algorithm>
 
@@ -57,6 +59,11 @@ int model_render_flags_size = sizeof(model_render_flags)/sizeof(flag_def_list);
 // info for special polygon lists
 
 polymodel *Polygon_models[MAX_POLYGON_MODELS];
+// the filenames of the loaded models, so model_load() doesn't have to compare against every slot
+static util::name_index Polygon_model_names([]() { return MAX_POLYGON_MODELS; },
+                                            [](int index) -> const char* {
+	                                            return Polygon_models[index] ? Polygon_models[index]->filename : nullptr;
+                                            });
 SCP_vector<polymodel_instance*> Polygon_model_instances;
 
 SCP_vector<bsp_collision_tree> Bsp_collision_tree_list;
@@ -70,7 +77,9 @@ char	debug_name[_MAX_PATH];
 int ss_warning_shown = 0;		// have we shown the warning dialog concerning the subsystems?
 #endif
 
-static uint Global_checksum = 0;
+// CRC32 and size of the POF read last, they identify it in the model cache
+static uint Pof_checksum = 0;
+static int Pof_size = 0;
 
 // Anything less than this is considered incompatible.
 #define PM_COMPATIBLE_VERSION 1900
@@ -1066,7 +1075,9 @@ int read_model_file(polymodel * pm, const char *filename, int n_subsystems, mode
 
 	// generate checksum for the POF
 	cfseek(fp, 0, SEEK_SET);	
-	cf_chksum_long(fp, &Global_checksum);
+	Pof_checksum = 0;
+	cf_chksum_long(fp, &Pof_checksum);
+	Pof_size = cfilelength(fp);
 	cfseek(fp, 0, SEEK_SET);
 
 
@@ -2640,18 +2651,22 @@ int model_load(const  char *filename, int n_subsystems, model_subsystem *subsyst
 	if ( !model_initted )
 		model_init();
 
+	if ( !duplicate )	{
+		i = Polygon_model_names.find(filename);
+		if ( i >= 0 )	{
+			// Model already loaded; just return.
+			Polygon_models[i]->used_this_mission++;
+			return Polygon_models[i]->id;
+		}
+	}
+
 	num = -1;
 
 	for (i=0; i< MAX_POLYGON_MODELS; i++)	{
-		if ( Polygon_models[i] )	{
-			if (!stricmp(filename, Polygon_models[i]->filename) && !duplicate)		{
-				// Model already loaded; just return.
-				Polygon_models[i]->used_this_mission++;
-				return Polygon_models[i]->id;
-			}
-		} else if ( num == -1 )	{
+		if ( !Polygon_models[i] )	{
 			// This is the first empty slot
 			num = i;
+			break;
 		}
 	}
 
@@ -2705,6 +2720,8 @@ int model_load(const  char *filename, int n_subsystems, model_subsystem *subsyst
 		return -1;
 	}
 
+	Polygon_model_names.add(num);
+
 	pm->used_this_mission++;
 
 #ifdef _DEBUG
@@ -2871,11 +2888,25 @@ int model_load(const  char *filename, int n_subsystems, model_subsystem *subsyst
 
 	TRACE_SCOPE(tracing::ModelParseAllBSPTrees);
 
-	for (i = 0; i < pm->n_models; ++i) {
-		if (!(pm->submodel[i].nocollide_this_only || pm->submodel[i].no_collisions)) {
-			pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
-			bsp_collision_tree* tree             = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
-			model_collide_parse_bsp(tree, pm->submodel[i].bsp_data, pm->version);
+	SCP_string cache_name;
+	bool use_cache = model_cache_get_name(filename, Pof_checksum, Pof_size, cache_name);
+
+	if (!use_cache || !model_cache_load_collision_trees(pm, cache_name)) {
+		auto parse_start = timer_get_microseconds();
+
+		for (i = 0; i < pm->n_models; ++i) {
+			if (!(pm->submodel[i].nocollide_this_only || pm->submodel[i].no_collisions)) {
+				pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
+				bsp_collision_tree* tree             = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+				model_collide_parse_bsp(tree, pm->submodel[i].bsp_data, pm->version);
+			}
+		}
+
+		if (use_cache) {
+			auto parse_us = timer_get_microseconds() - parse_start;
+
+			mprintf(("Parsed collision trees of %s in %.2f ms, adding them to the model cache\n", filename, parse_us / 1000.0f));
+			model_cache_save_collision_trees(pm, cache_name, parse_us);
 		}
 	}
 
@@ -61,9 +61,10 @@ class player;
 // version 47 - 11/11/2003 (FS2OpenPXO, FS2 Open Changes - FS2Open 3.6)
 // revert  46 - 9/7/2006 (the 47 bump wasn't needed, reverting to retail version for compatibility reasons)
 // version 48 - 8/15/2016 Multiple changes to the packet format for multi sexps
+// version 49 - 10/18/2026 Object updates delta compressed against acknowledged snapshots
 // STANDALONE_ONLY
 
-#define MULTI_FS_SERVER_VERSION							148
+#define MULTI_FS_SERVER_VERSION							149
 
 #define MULTI_FS_SERVER_COMPATIBLE_VERSION			MULTI_FS_SERVER_VERSION
 
@@ -424,6 +425,12 @@ typedef struct net_player_server_info {
 	int				rate_stamp;							// rate limiting timestamp
 	int				rate_bytes;							// bytes sent this "second"
 
+	// object update delta information
+	ushort			oo_frame;							// id of the next object update packet sent to this player
+	int				oo_bytes;							// object update bytes sent in the current second
+	int				oo_bandwidth;						// object update bytes sent in the last full second
+	int				oo_bandwidth_stamp;				// timestamp for rolling over oo_bytes
+
 	// firing info (1<<0) for primary fire, (1<<1) for secondary fired, (1<<2) for countermeasure fired, (1<<3) for afterburner on
 	// basically, we set these bits if necessary between control info sends from the client. once sent, these values are
 	// cleared until the next send time
@@ -558,6 +565,7 @@ typedef struct server_item {
 // sent to the server on a join request with various data
 #define JOIN_FLAG_AS_OBSERVER			(1<<0)	// wants to join as an aboserver
 #define JOIN_FLAG_HAXOR					(1<<2)	// if the player has hacked data
+#define JOIN_FLAG_XFER_WINDOWED			(1<<3)	// the player can receive windowed (and compressed) file xfers
 
 typedef struct join_request {
 	char passwd[MAX_PASSWD_LEN+1];				// password for a password protected game
@@ -615,6 +623,7 @@ typedef struct network_buffer {
 #define NETINFO_FLAG_MT_SEND_FAILED			(1<<24)		// set during MT stats update process indicating we didn't properly send his stats
 #define NETINFO_FLAG_MT_DONE				(1<<25)		// set when a player has been processed for stats (fail, succeed, or otherwise)
 #define NETINFO_FLAG_HAXOR					(1<<26)		// the player has some form of hacked client data
+#define NETINFO_FLAG_XFER_WINDOWED			(1<<27)		// the player can receive windowed (and compressed) file xfers
 
 #define NETPLAYER_IS_OBSERVER(player)		(player->flags & (NETINFO_FLAG_OBSERVER|NETINFO_FLAG_OBS_PLAYER))
 #define NETPLAYER_IS_DEAD(player)			(player->flags & (NETINFO_FLAG_LIMBO|NETINFO_FLAG_RESPAWNING))
@@ -988,7 +988,7 @@ void process_ingame_ships_packet( ubyte *data, header *hinfo )
 
 		// delete all ships
 		for(idx=0; idx<MAX_SHIPS; idx++){
-			if((Ships[idx].objnum >= 0) && (Ships[idx].objnum < MAX_OBJECTS)){
+			if((Ships[idx].objnum >= 0) && (Ships[idx].objnum < objects_size())){
 				obj_delete(Ships[idx].objnum);
 			}
 		}
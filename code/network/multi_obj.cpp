@@ -28,6 +28,7 @@
 #include "math/spline.h"
 #include "physics/physics.h"
 #include "ship/afterburner.h"
+#include "ship/awacs.h"
 #include "cfile/cfile.h"
 #include "debugconsole/console.h"
 
@@ -56,6 +57,46 @@ bool Multi_oo_afterburn_hack = false;
 // tolerance for bashing position
 #define OO_POS_UPDATE_TOLERANCE	100.0f
 
+// position encodings for server updates. the first byte of a position holds the encoding in the
+// high nibble and the age (in sequence #s) of the baseline a delta is relative to in the low nibble
+#define OO_POS_FULL					0			// full 24 bit position
+#define OO_POS_DELTA_8				1			// 8 bit per axis delta
+#define OO_POS_DELTA_12				2			// 12 bit per axis delta
+#define OO_POS_DELTA_16				3			// 16 bit per axis delta
+
+// must match the scale used by multi_pack_unpack_position()
+#define OO_POS_SCALE					105.0f
+
+// how many packets worth of sent ship updates the server remembers while waiting for acks
+#define OO_FRAME_LOG_SIZE			64
+
+// a ship update carried by an object update packet
+typedef struct oo_frame_entry {
+	short		ship_index;
+	ubyte		seq;
+	int		obj_signature;
+} oo_frame_entry;
+
+// all ship updates carried by a single object update packet
+typedef struct oo_frame_record {
+	ushort	frame;							// packet id, 0 if unused or already acked
+	SCP_vector<oo_frame_entry> entries;
+} oo_frame_record;
+
+oo_frame_record Oo_frame_log[MAX_PLAYERS][OO_FRAME_LOG_SIZE];
+SCP_vector<oo_frame_entry> Oo_frame_pending;	// updates in the packet currently being built
+
+// client side - newest object update packet we've fully processed, and which of the 32 before it we got
+ushort Oo_ack_frame = 0;
+uint Oo_ack_bits = 0;
+bool Oo_frame_unackable = false;				// set if the packet being processed had data we couldn't use
+
+// delta compression stats (server)
+int Oo_pos_full_count = 0;
+int Oo_pos_delta_count = 0;
+int Oo_pos_bytes_saved = 0;
+int Oo_status_skip_count = 0;
+
 // new improved - more compacted info type
 #define OO_POS_NEW					(1<<0)		// 
 #define OO_ORIENT_NEW				(1<<1)		// 
@@ -156,115 +197,484 @@ int OO_update_index = -1;							// index into OO_update_records for displaying u
 // OBJECT UPDATE FUNCTIONS
 //
 
-object *OO_player_obj;
 int OO_sort = 1;
 
-bool multi_oo_sort_func(const short &index1, const short &index2)
+// interest management. ships are binned into a coarse grid once a frame, so each player only has to
+// look at the cells around him to find the ships he cares about. everything further out than
+// OO_INTEREST_RADIUS is merely kept alive.
+#define OO_INTEREST_RADIUS			OO_FAR_DIST
+
+// relevance of a ship to a player, accumulated every frame until the ship gets sent
+#define OO_PRIORITY_TARGET			16.0f		// the player's target
+#define OO_PRIORITY_ATTACKER		8.0f		// ships targeting the player
+#define OO_PRIORITY_NEAR			8.0f
+#define OO_PRIORITY_MIDRANGE		4.0f
+#define OO_PRIORITY_FAR				2.0f
+#define OO_PRIORITY_OUTSIDE		0.5f		// beyond OO_INTEREST_RADIUS
+#define OO_PRIORITY_CONE_SCALE	2.0f		// in front of the player
+#define OO_PRIORITY_HIDDEN_SCALE	0.25f		// not visible to the player's team
+
+typedef struct oo_grid_entry {
+	int		cell[3];
+	short		ship_index;
+} oo_grid_entry;
+
+SCP_vector<oo_grid_entry> Oo_interest_grid;		// all updatable ships, sorted by cell
+float Oo_relevance[MAX_SHIPS];						// scratch, relevance to the player being processed
+int Oo_deferred_count = 0;								// ship updates pushed back by the datarate cap
+
+bool multi_oo_grid_cell_less(const oo_grid_entry &e1, const oo_grid_entry &e2)
 {
-	object *obj1, *obj2;
-	float dist1, dist2;
-	float dot1, dot2;
-	vec3d v1, v2;
-	vec3d vn1, vn2;
-
-	// if the indices are bogus, or the objnums are bogus, return ">"
-	if((index1 < 0) || (index2 < 0) || (Ships[index1].objnum < 0) || (Ships[index2].objnum < 0)){
-		return false;
+	if(e1.cell[0] != e2.cell[0]){
+		return e1.cell[0] < e2.cell[0];
 	}
-
-	// get the 2 objects
-	obj1 = &Objects[Ships[index1].objnum];
-	obj2 = &Objects[Ships[index2].objnum];
-
-	// get the distance and dot product to the player obj for both
-	vm_vec_sub(&v1, &OO_player_obj->pos, &obj1->pos);
-	dist1 = vm_vec_copy_normalize(&vn1, &v1);
-	vm_vec_sub(&v2, &OO_player_obj->pos, &obj2->pos);
-	dist2 = vm_vec_copy_normalize(&vn2, &v2);
-	dot1 = vm_vec_dot(&OO_player_obj->orient.vec.fvec, &vn1);
-	dot2 = vm_vec_dot(&OO_player_obj->orient.vec.fvec, &vn2);
-
-	// objects in front take precedence
-	if((dot1 < 0.0f) && (dot2 >= 0.0f)){
-		return false;
-	} else if((dot2 < 0.0f) && (dot1 >= 0.0f)){
-		return true;
+	if(e1.cell[1] != e2.cell[1]){
+		return e1.cell[1] < e2.cell[1];
 	}
+	return e1.cell[2] < e2.cell[2];
+}
 
-	// otherwise go by distance
-	return (dist1 < dist2);
+void multi_oo_grid_cell(const vec3d *pos, int *cell)
+{
+	cell[0] = (int)floorf(pos->xyz.x / OO_INTEREST_RADIUS);
+	cell[1] = (int)floorf(pos->xyz.y / OO_INTEREST_RADIUS);
+	cell[2] = (int)floorf(pos->xyz.z / OO_INTEREST_RADIUS);
 }
 
-// build the list of ship indices to use when updating for this player
-void multi_oo_build_ship_list(net_player *pl)
+// bin all ships which can get object updates into the interest grid (once a frame, for all players)
+void multi_oo_build_interest_grid()
 {
-	int ship_index;
-	int idx;
 	ship_obj *moveup;
-	object *player_obj;
+	object *objp;
+	oo_grid_entry entry;
 
-	// set all indices to be -1
-	for(idx = 0;idx<MAX_SHIPS; idx++){
-		OO_ship_index[idx] = -1;
-	}
-
-	// get the player object
-	if(pl->m_player->objnum < 0){
-		return;
-	}
-	player_obj = &Objects[pl->m_player->objnum];
-	
-	// go through all other relevant objects
-	ship_index = 0;
+	Oo_interest_grid.clear();
 	for ( moveup = GET_FIRST(&Ship_obj_list); moveup != END_OF_LIST(&Ship_obj_list); moveup = GET_NEXT(moveup) ) {
 		// if it is an invalid ship object, skip it
 		if((moveup->objnum < 0) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].type != OBJ_SHIP)){
 			continue;
 		}
+		objp = &Objects[moveup->objnum];
 
 		// if we're a standalone server, don't send any data regarding its pseudo-ship
-		if((Game_mode & GM_STANDALONE_SERVER) && ((&Objects[moveup->objnum] == Player_obj) || (Objects[moveup->objnum].net_signature == STANDALONE_SHIP_SIG)) ){
+		if((Game_mode & GM_STANDALONE_SERVER) && ((objp == Player_obj) || (objp->net_signature == STANDALONE_SHIP_SIG)) ){
 			continue;
 		}		
 			
 		// must be a ship, a weapon, and _not_ an observer
-		if (Objects[moveup->objnum].flags[Object::Object_Flags::Should_be_dead]){
+		if (objp->flags[Object::Object_Flags::Should_be_dead]){
 			continue;
 		}
 
 		// don't send info for dying ships
-		if (Ships[Objects[moveup->objnum].instance].flags[Ship::Ship_Flags::Dying]){
+		if (Ships[objp->instance].flags[Ship::Ship_Flags::Dying]){
 			continue;
 		}		
 
 		// never update the knossos device
-		if ((Ships[Objects[moveup->objnum].instance].ship_info_index >= 0) && (Ships[Objects[moveup->objnum].instance].ship_info_index < ship_info_size()) && (Ship_info[Ships[Objects[moveup->objnum].instance].ship_info_index].flags[Ship::Info_Flags::Knossos_device])){
+		if ((Ships[objp->instance].ship_info_index >= 0) && (Ships[objp->instance].ship_info_index < ship_info_size()) && (Ship_info[Ships[objp->instance].ship_info_index].flags[Ship::Info_Flags::Knossos_device])){
 			continue;
 		}
-				
+
+		multi_oo_grid_cell(&objp->pos, entry.cell);
+		entry.ship_index = (short)objp->instance;
+		Oo_interest_grid.push_back(entry);
+	}
+
+	std::sort(Oo_interest_grid.begin(), Oo_interest_grid.end(), multi_oo_grid_cell_less);
+}
+
+// figure out how relevant every ship is to this player, using the grid to find the ones near him
+void multi_oo_calc_relevance(net_player *pl, object *player_obj)
+{
+	oo_grid_entry key;
+	int center[3];
+	int x, y, z;
+	vec3d eye_to_obj;
+	float dist, priority;
+	object *objp;
+	ship *shipp;
+	ship *viewer = NULL;
+
+	if(player_obj->type == OBJ_SHIP){
+		viewer = &Ships[player_obj->instance];
+	}
+
+	// everything starts out as merely being kept alive
+	for(auto &entry : Oo_interest_grid){
+		shipp = &Ships[entry.ship_index];
+		Oo_relevance[entry.ship_index] = OO_PRIORITY_OUTSIDE;
+
+		// ships going after the player matter no matter where they are
+		if((shipp->ai_index >= 0) && (Ai_info[shipp->ai_index].target_objnum == OBJ_INDEX(player_obj))){
+			Oo_relevance[entry.ship_index] = OO_PRIORITY_ATTACKER;
+		}
+	}
+
+	// now look at the cells around the player's eye
+	multi_oo_grid_cell(&pl->s_info.eye_pos, center);
+	for(x = center[0] - 1; x <= center[0] + 1; x++){
+		for(y = center[1] - 1; y <= center[1] + 1; y++){
+			for(z = center[2] - 1; z <= center[2] + 1; z++){
+				key.cell[0] = x;
+				key.cell[1] = y;
+				key.cell[2] = z;
+
+				auto range = std::equal_range(Oo_interest_grid.begin(), Oo_interest_grid.end(), key, multi_oo_grid_cell_less);
+				for(auto it = range.first; it != range.second; ++it){
+					shipp = &Ships[it->ship_index];
+					objp = &Objects[shipp->objnum];
+
+					vm_vec_sub(&eye_to_obj, &objp->pos, &pl->s_info.eye_pos);
+					dist = vm_vec_mag(&eye_to_obj);
+					if(dist >= OO_INTEREST_RADIUS){
+						continue;
+					}
+
+					if(dist < OO_NEAR_DIST){
+						priority = OO_PRIORITY_NEAR;
+					} else if(dist < OO_MIDRANGE_DIST){
+						priority = OO_PRIORITY_MIDRANGE;
+					} else {
+						priority = OO_PRIORITY_FAR;
+					}
+
+					if((dist > 0.0f) && ((vm_vec_dot(&eye_to_obj, &pl->s_info.eye_orient.vec.fvec) / dist) >= OO_VIEW_CONE_DOT)){
+						priority *= OO_PRIORITY_CONE_SCALE;
+					}
+
+					if((viewer != NULL) && !ship_is_visible_by_team(objp, viewer)){
+						priority *= OO_PRIORITY_HIDDEN_SCALE;
+					}
+
+					Oo_relevance[it->ship_index] = MAX(Oo_relevance[it->ship_index], priority);
+				}
+			}
+		}
+	}
+
+	// and the player's target, which gets sent first anyway
+	if((pl->s_info.target_objnum != -1) && (Objects[pl->s_info.target_objnum].type == OBJ_SHIP)){
+		Oo_relevance[Objects[pl->s_info.target_objnum].instance] = OO_PRIORITY_TARGET;
+	}
+}
+
+int OO_player_index;
+
+// most accumulated priority first
+bool multi_oo_sort_func(const short &index1, const short &index2)
+{
+	return Ships[index1].np_updates[OO_player_index].priority > Ships[index2].np_updates[OO_player_index].priority;
+}
+
+// build the list of ship indices to use when updating for this player, most relevant first
+void multi_oo_build_ship_list(net_player *pl)
+{
+	int ship_index;
+	int idx;
+	object *player_obj;
+	np_update *npu;
+
+	// set all indices to be -1
+	for(idx = 0;idx<MAX_SHIPS; idx++){
+		OO_ship_index[idx] = -1;
+	}
+
+	// get the player object
+	if(pl->m_player->objnum < 0){
+		return;
+	}
+	player_obj = &Objects[pl->m_player->objnum];
+
+	multi_oo_calc_relevance(pl, player_obj);
+	
+	// go through all other relevant objects
+	ship_index = 0;
+	for(auto &entry : Oo_interest_grid){
 		// don't send him info for himself
-		if ( &Objects[moveup->objnum] == player_obj ){
+		if ( Ships[entry.ship_index].objnum == OBJ_INDEX(player_obj) ){
 			continue;
 		}
 
+		// accumulate priority until the ship actually gets sent, so nothing starves under the datarate cap
+		npu = &Ships[entry.ship_index].np_updates[NET_PLAYER_NUM(pl)];
+		npu->priority += Oo_relevance[entry.ship_index];
+
 		// don't send info for his targeted ship here, since its always done first
-		if((pl->s_info.target_objnum != -1) && (moveup->objnum == pl->s_info.target_objnum)){
+		if((pl->s_info.target_objnum != -1) && (Ships[entry.ship_index].objnum == pl->s_info.target_objnum)){
 			continue;
 		}
 
 		// add the ship 
 		if(ship_index < MAX_SHIPS){
-			OO_ship_index[ship_index++] = (short)Objects[moveup->objnum].instance;
+			OO_ship_index[ship_index++] = entry.ship_index;
 		}
 	}
 
 	// maybe sort the thing here
-	OO_player_obj = player_obj;
+	OO_player_index = NET_PLAYER_NUM(pl);
 	if (OO_sort) {
 		std::sort(OO_ship_index, OO_ship_index + ship_index, multi_oo_sort_func);
 	}
 }
 
+// forget all delta baselines for this update record
+void multi_oo_clear_snapshots(np_update *npu)
+{
+	int idx;
+
+	for(idx=0; idx<OO_SNAPSHOT_COUNT; idx++){
+		npu->snapshots[idx].flags = 0;
+	}
+}
+
+// quantize a position the same way multi_pack_unpack_position() does
+void multi_oo_quantize_pos(const vec3d *pos, int *q)
+{
+	q[0] = (int)std::lround(pos->xyz.x * OO_POS_SCALE);
+	q[1] = (int)std::lround(pos->xyz.y * OO_POS_SCALE);
+	q[2] = (int)std::lround(pos->xyz.z * OO_POS_SCALE);
+	CAP(q[0], -8388608, 8388607);
+	CAP(q[1], -8388608, 8388607);
+	CAP(q[2], -8388608, 8388607);
+}
+
+// get the snapshot for the given sequence #, or NULL if we don't have it anymore
+oo_snapshot *multi_oo_get_snapshot(np_update *npu, ubyte seq)
+{
+	oo_snapshot *snap = &npu->snapshots[seq % OO_SNAPSHOT_COUNT];
+
+	if((snap->flags == 0) || (snap->seq != seq)){
+		return NULL;
+	}
+
+	return snap;
+}
+
+// find the newest snapshot older than the update about to be sent which has all the passed flags set
+oo_snapshot *multi_oo_find_baseline(np_update *npu, ubyte flags)
+{
+	oo_snapshot *snap;
+	int age;
+
+	for(age=1; age<OO_SNAPSHOT_COUNT; age++){
+		snap = multi_oo_get_snapshot(npu, (ubyte)(npu->seq - age));
+		if((snap != NULL) && ((snap->flags & flags) == flags)){
+			return snap;
+		}
+	}
+
+	return NULL;
+}
+
+// pack a ship position for a client, as a delta against the newest acked position if there is one.
+// fills in the position of the passed snapshot and returns bytes added
+int multi_oo_pack_position(np_update *npu, vec3d *pos, ubyte *data, oo_snapshot *snap)
+{
+	oo_snapshot *base;
+	int q[3], delta[3];
+	int max_delta, bits, idx;
+	ubyte mode = OO_POS_FULL;
+	vec3d sent_pos;
+	int size;
+
+	multi_oo_quantize_pos(pos, q);
+
+	// see how big a delta against the baseline would be
+	bits = 0;
+	base = multi_oo_find_baseline(npu, OO_SNAP_ACKED | OO_SNAP_POS);
+	if(base != NULL){
+		max_delta = 0;
+		for(idx=0; idx<3; idx++){
+			delta[idx] = q[idx] - base->pos[idx];
+			max_delta = MAX(max_delta, abs(delta[idx]));
+		}
+
+		if(max_delta < (1<<7)){
+			mode = OO_POS_DELTA_8;
+			bits = 8;
+		} else if(max_delta < (1<<11)){
+			mode = OO_POS_DELTA_12;
+			bits = 12;
+		} else if(max_delta < (1<<15)){
+			mode = OO_POS_DELTA_16;
+			bits = 16;
+		}
+	}
+
+	if(bits > 0){
+		data[0] = (ubyte)((mode << 4) | (ubyte)(npu->seq - base->seq));
+		size = 1 + multi_pack_unpack_position_delta(1, data + 1, delta, bits);
+		memcpy(snap->pos, q, sizeof(q));
+
+		Oo_pos_delta_count++;
+		Oo_pos_bytes_saved += OO_POS_RET_SIZE - size;
+	} else {
+		data[0] = (ubyte)(OO_POS_FULL << 4);
+		size = 1 + multi_pack_unpack_position(1, data + 1, pos);
+
+		// store exactly what the client will end up with
+		multi_pack_unpack_position(0, data + 1, &sent_pos);
+		multi_oo_quantize_pos(&sent_pos, snap->pos);
+
+		Oo_pos_full_count++;
+	}
+
+	snap->flags |= OO_SNAP_POS;
+
+	return size;
+}
+
+// unpack a ship position from the server and remember it as a baseline, return bytes processed.
+// pos_valid is set to false if this is a delta against a baseline we don't have
+int multi_oo_unpack_position(np_update *npu, ubyte seq, ubyte *data, vec3d *pos, bool *pos_valid)
+{
+	oo_snapshot *base, *snap;
+	int q[3], delta[3];
+	int bits, idx;
+	ubyte mode = data[0] >> 4;
+	int size;
+
+	if(mode == OO_POS_FULL){
+		size = 1 + multi_pack_unpack_position(0, data + 1, pos);
+		multi_oo_quantize_pos(pos, q);
+	} else {
+		bits = (mode == OO_POS_DELTA_8) ? 8 : ((mode == OO_POS_DELTA_12) ? 12 : 16);
+		size = 1 + multi_pack_unpack_position_delta(0, data + 1, delta, bits);
+
+		base = multi_oo_get_snapshot(npu, (ubyte)(seq - (data[0] & 0x0f)));
+		if((base == NULL) || !(base->flags & OO_SNAP_POS)){
+			*pos_valid = false;
+			return size;
+		}
+
+		for(idx=0; idx<3; idx++){
+			q[idx] = base->pos[idx] + delta[idx];
+		}
+		pos->xyz.x = i2fl(q[0]) / OO_POS_SCALE;
+		pos->xyz.y = i2fl(q[1]) / OO_POS_SCALE;
+		pos->xyz.z = i2fl(q[2]) / OO_POS_SCALE;
+	}
+	*pos_valid = true;
+
+	// don't let a late packet clobber a newer baseline
+	snap = &npu->snapshots[seq % OO_SNAPSHOT_COUNT];
+	if((snap->flags != 0) && (snap->seq != seq) && ((ubyte)(snap->seq - seq) < 128)){
+		return size;
+	}
+	snap->seq = seq;
+	snap->flags = OO_SNAP_POS;
+	memcpy(snap->pos, q, sizeof(q));
+
+	return size;
+}
+
+// remember that this ship update is going out in the packet currently being built
+void multi_oo_add_pending(object *objp, ubyte seq)
+{
+	oo_frame_entry entry;
+
+	entry.ship_index = (short)objp->instance;
+	entry.seq = seq;
+	entry.obj_signature = objp->signature;
+	Oo_frame_pending.push_back(entry);
+}
+
+// send an object update packet to a player and log which ship updates it carried
+void multi_oo_send_update_packet(net_player *pl, ubyte *data, int packet_size)
+{
+	oo_frame_record *rec;
+
+	multi_io_send(pl, data, packet_size);
+	pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+	pl->s_info.oo_bytes += packet_size + UDP_HEADER_SIZE;
+
+	// swap so neither vector gives up its memory
+	rec = &Oo_frame_log[NET_PLAYER_NUM(pl)][pl->s_info.oo_frame % OO_FRAME_LOG_SIZE];
+	rec->frame = pl->s_info.oo_frame;
+	rec->entries.swap(Oo_frame_pending);
+	Oo_frame_pending.clear();
+
+	// never use frame 0, clients use it to mean "nothing received yet"
+	pl->s_info.oo_frame++;
+	if(pl->s_info.oo_frame == 0){
+		pl->s_info.oo_frame = 1;
+	}
+}
+
+// mark all ship updates carried by the given packet as acked by the player
+void multi_oo_ack_frame(net_player *pl, ushort frame)
+{
+	oo_frame_record *rec;
+	oo_snapshot *snap;
+	ship *shipp;
+
+	rec = &Oo_frame_log[NET_PLAYER_NUM(pl)][frame % OO_FRAME_LOG_SIZE];
+	if((frame == 0) || (rec->frame != frame)){
+		return;
+	}
+
+	for(auto &entry : rec->entries){
+		// make sure the ship slot hasn't been reused since
+		shipp = &Ships[entry.ship_index];
+		if((shipp->objnum < 0) || (Objects[shipp->objnum].signature != entry.obj_signature)){
+			continue;
+		}
+
+		snap = multi_oo_get_snapshot(&shipp->np_updates[NET_PLAYER_NUM(pl)], entry.seq);
+		if(snap != NULL){
+			snap->flags |= OO_SNAP_ACKED;
+		}
+	}
+
+	rec->frame = 0;
+	rec->entries.clear();
+}
+
+// process an ack from a client (the newest packet it got, plus a bit for each of the 32 before it)
+void multi_oo_process_ack(net_player *pl, ushort ack_frame, uint ack_bits)
+{
+	int idx;
+
+	if(ack_frame == 0){
+		return;
+	}
+
+	multi_oo_ack_frame(pl, ack_frame);
+	for(idx=0; idx<32; idx++){
+		if(ack_bits & (1u << idx)){
+			multi_oo_ack_frame(pl, (ushort)(ack_frame - 1 - idx));
+		}
+	}
+}
+
+// note that we've received and processed an object update packet from the server
+void multi_oo_client_ack(ushort frame)
+{
+	int diff;
+
+	if(frame == 0){
+		return;
+	}
+
+	if(Oo_ack_frame == 0){
+		Oo_ack_frame = frame;
+		Oo_ack_bits = 0;
+		return;
+	}
+
+	diff = (short)(frame - Oo_ack_frame);
+	if(diff > 0){
+		Oo_ack_bits = (diff < 32) ? (Oo_ack_bits << diff) : 0;
+		if(diff <= 32){
+			Oo_ack_bits |= (1u << (diff - 1));
+		}
+		Oo_ack_frame = frame;
+	} else if((diff < 0) && (diff >= -32)){
+		Oo_ack_bits |= (1u << (-diff - 1));
+	}
+}
+
 // pack information for a client (myself), return bytes added
 int multi_oo_pack_client_data(ubyte *data)
 {
@@ -341,6 +751,10 @@ int multi_oo_pack_client_data(ubyte *data)
 	ADD_DATA( t_subsys );
 	ADD_DATA( l_subsys );
 
+	// let the server know which of its object update packets we've gotten
+	ADD_USHORT( Oo_ack_frame );
+	ADD_UINT( Oo_ack_bits );
+
 	return packet_size;
 }
 
@@ -351,6 +765,105 @@ int multi_oo_pack_client_data(ubyte *data)
 #define PACK_USHORT(v) { std::uint16_t swap = INTEL_SHORT(v); memcpy( data + packet_size + header_bytes, &swap, sizeof(std::uint16_t) ); packet_size += sizeof(std::uint16_t); }
 #define PACK_INT(v) { std::int32_t swap = INTEL_INT(v); memcpy( data + packet_size + header_bytes, &swap, sizeof(std::int32_t) ); packet_size += sizeof(std::int32_t); }
 #define PACK_ULONG(v) { std::uint64_t swap = INTEL_LONG(v); memcpy( data + packet_size + header_bytes, &swap, sizeof(std::uint64_t) ); packet_size += sizeof(std::uint64_t); }
+
+// pack the hull and shield info for a ship, return bytes added
+int multi_oo_pack_hull(object *objp, ubyte *data)
+{
+	float temp;
+	int header_bytes = 0;
+	int packet_size = 0;
+
+	// add the hull value for this guy		
+	temp = get_hull_pct(objp);
+	if ( (temp < 0.004f) && (temp > 0.0f) ) {
+		temp = 0.004f;		// 0.004 is the lowest positive value we can have before we zero out when packing
+	}
+	PACK_PERCENT(temp);				
+
+	float quad = shield_get_max_quad(objp);
+
+	for (int i = 0; i < objp->n_quadrants; i++) {
+		temp = (objp->shield_quadrant[i] / quad);
+		PACK_PERCENT(temp);
+	}
+
+	return packet_size;
+}
+
+// multi_oo_pack_subsys() follows the subsystems with the ai mode (byte), submode (short) and target signature (ushort),
+// then the primary weapon energy (percent byte)
+#define OO_SUBSYS_AI_BYTES			5
+#define OO_SUBSYS_TRAILER_BYTES		(OO_SUBSYS_AI_BYTES + 1)
+
+// pack the subsystem, ai and weapon energy info for a ship, return bytes added
+int multi_oo_pack_subsys(ship *shipp, ubyte *data)
+{
+	ubyte ns;		
+	ship_subsys *subsysp;
+	float temp;
+	int header_bytes = 0;
+	int packet_size = 0;
+				
+	// just in case we have some kind of invalid data (should've been taken care of earlier in this function)
+	if(shipp->ship_info_index < 0){
+		ns = 0;
+		PACK_BYTE( ns );
+	}
+	// add the # of subsystems, and their data
+	else {
+		ns = (ubyte)Ship_info[shipp->ship_info_index].n_subsystems;
+		PACK_BYTE( ns );
+
+		// now the subsystems.
+		for ( subsysp = GET_FIRST(&shipp->subsys_list); subsysp != END_OF_LIST(&shipp->subsys_list); subsysp = GET_NEXT(subsysp) ) {
+			temp = (float)subsysp->current_hits / (float)subsysp->max_hits;
+			PACK_PERCENT(temp);
+		}
+	}
+
+	// ai mode info
+	ubyte umode = (ubyte)(Ai_info[shipp->ai_index].mode);
+	short submode = (short)(Ai_info[shipp->ai_index].submode);
+	ushort target_signature;
+
+	target_signature = 0;
+	if ( Ai_info[shipp->ai_index].target_objnum != -1 ){
+		target_signature = Objects[Ai_info[shipp->ai_index].target_objnum].net_signature;
+	}
+
+	PACK_BYTE( umode );
+	PACK_SHORT( submode );
+	PACK_USHORT( target_signature );	
+
+	// primary weapon energy
+	temp = shipp->weapon_energy / Ship_info[shipp->ship_info_index].max_weapon_reserve;
+	PACK_PERCENT(temp);
+
+	return packet_size;
+}
+
+// if the newest hull (or subsystem) info the client acked matches what we'd send now
+bool multi_oo_status_acked(np_update *npu, object *objp, ubyte what)
+{
+	ubyte data[MAX_PACKET_SIZE];
+	oo_snapshot *base;
+	ushort chksum;
+
+	base = multi_oo_find_baseline(npu, OO_SNAP_ACKED | what);
+	if(base == NULL){
+		return false;
+	}
+
+	if(what == OO_SNAP_HULL){
+		chksum = cf_add_chksum_short(0, data, multi_oo_pack_hull(objp, data));
+		return chksum == base->hull_chksum;
+	}
+
+	chksum = cf_add_chksum_short(0, data, multi_oo_pack_subsys(&Ships[objp->instance], data));
+	return chksum == base->subsys_chksum;
+}
+
+// pack the appropriate info for a ship into the data, return bytes added
 int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data_out)
 {	
 	ubyte data[255];
@@ -359,9 +872,10 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 	ship *shipp;	
 	ship_info *sip;
 	ubyte ret;
-	float temp;	
 	int header_bytes;
 	int packet_size = 0;
+	np_update *npu;
+	oo_snapshot snap;
 
 	// make sure we have a valid ship
 	Assert(objp->type == OBJ_SHIP);
@@ -382,6 +896,13 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 		return 0;
 	}
 
+	// what this update carries, for use as a delta baseline later on
+	npu = &shipp->np_updates[NET_PLAYER_NUM(pl)];
+	snap.seq = npu->seq;
+	snap.flags = 0;
+	snap.hull_chksum = 0;
+	snap.subsys_chksum = 0;
+
 	// if i'm the client, make sure I only send certain things	
 	if(!MULTIPLAYER_MASTER){
 		Assert(oo_flags & (OO_POS_NEW | OO_ORIENT_NEW));
@@ -406,7 +927,11 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 		
 	// position, velocity
 	if ( oo_flags & OO_POS_NEW ) {		
-		ret = (ubyte)multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos );
+		if(MULTIPLAYER_MASTER){
+			ret = (ubyte)multi_oo_pack_position( npu, &objp->pos, data + packet_size + header_bytes, &snap );
+		} else {
+			ret = (ubyte)multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos );
+		}
 		packet_size += ret;
 		
 		// global records
@@ -444,71 +969,25 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 
 	// hull info
 	if ( oo_flags & OO_HULL_NEW ){
-		// add the hull value for this guy		
-		temp = get_hull_pct(objp);
-		if ( (temp < 0.004f) && (temp > 0.0f) ) {
-			temp = 0.004f;		// 0.004 is the lowest positive value we can have before we zero out when packing
-		}
-		PACK_PERCENT(temp);				
-		multi_rate_add(NET_PLAYER_NUM(pl), "hul", 1);	
-
-		float quad = shield_get_max_quad(objp);
+		ret = (ubyte)multi_oo_pack_hull( objp, data + packet_size + header_bytes );
+		snap.hull_chksum = cf_add_chksum_short( 0, data + packet_size + header_bytes, ret );
+		snap.flags |= OO_SNAP_HULL;
+		packet_size += ret;
 
-		for (int i = 0; i < objp->n_quadrants; i++) {
-			temp = (objp->shield_quadrant[i] / quad);
-			PACK_PERCENT(temp);
-		}
-				
+		multi_rate_add(NET_PLAYER_NUM(pl), "hul", 1);	
 		multi_rate_add(NET_PLAYER_NUM(pl), "shl", objp->n_quadrants);	
 	}	
 
 	// subsystem info
 	if( oo_flags & OO_SUBSYSTEMS_AND_AI_NEW ){
-		ubyte ns;		
-		ship_subsys *subsysp;
-				
-		// just in case we have some kind of invalid data (should've been taken care of earlier in this function)
-		if(shipp->ship_info_index < 0){
-			ns = 0;
-			PACK_BYTE( ns );
-
-			multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);	
-		}
-		// add the # of subsystems, and their data
-		else {
-			ns = (ubyte)Ship_info[shipp->ship_info_index].n_subsystems;
-			PACK_BYTE( ns );
-
-			multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);	
-
-			// now the subsystems.
-			for ( subsysp = GET_FIRST(&shipp->subsys_list); subsysp != END_OF_LIST(&shipp->subsys_list); subsysp = GET_NEXT(subsysp) ) {
-				temp = (float)subsysp->current_hits / (float)subsysp->max_hits;
-				PACK_PERCENT(temp);
-				
-				multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);
-			}
-		}
-
-		// ai mode info
-		ubyte umode = (ubyte)(Ai_info[shipp->ai_index].mode);
-		short submode = (short)(Ai_info[shipp->ai_index].submode);
-		ushort target_signature;
-
-		target_signature = 0;
-		if ( Ai_info[shipp->ai_index].target_objnum != -1 ){
-			target_signature = Objects[Ai_info[shipp->ai_index].target_objnum].net_signature;
-		}
-
-		PACK_BYTE( umode );
-		PACK_SHORT( submode );
-		PACK_USHORT( target_signature );	
-
-		multi_rate_add(NET_PLAYER_NUM(pl), "aim", 5);
+		ret = (ubyte)multi_oo_pack_subsys( shipp, data + packet_size + header_bytes );
+		snap.subsys_chksum = cf_add_chksum_short( 0, data + packet_size + header_bytes, ret );
+		snap.flags |= OO_SNAP_SUBSYS;
+		packet_size += ret;
 
-		// primary weapon energy
-		temp = shipp->weapon_energy / sip->max_weapon_reserve;
-		PACK_PERCENT(temp);
+		// subsystem count and values, then ai mode, submode, target and weapon energy
+		multi_rate_add(NET_PLAYER_NUM(pl), "sub", ret - OO_SUBSYS_TRAILER_BYTES);
+		multi_rate_add(NET_PLAYER_NUM(pl), "aim", OO_SUBSYS_AI_BYTES);
 	}		
 
 	// afterburner info
@@ -529,7 +1008,7 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 		PACK_INT( Ai_info[shipp->ai_index].mode );
 		PACK_INT( Ai_info[shipp->ai_index].submode );
 
-		if((Ai_info[shipp->ai_index].support_ship_objnum < 0) || (Ai_info[shipp->ai_index].support_ship_objnum >= MAX_OBJECTS)){
+		if((Ai_info[shipp->ai_index].support_ship_objnum < 0) || (Ai_info[shipp->ai_index].support_ship_objnum >= objects_size())){
 			dock_sig = 0;
 		} else {
 			dock_sig = Objects[Ai_info[shipp->ai_index].support_ship_objnum].net_signature;
@@ -569,6 +1048,11 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 
 	packet_size += data_size;
 
+	// the server remembers what it sent, so it can delta against it once the client acks it
+	if(MULTIPLAYER_MASTER && (snap.flags != 0)){
+		npu->snapshots[snap.seq % OO_SNAPSHOT_COUNT] = snap;
+	}
+
 	// copy to the outgoing data
 	memcpy(data_out, data, packet_size);	
 	
@@ -658,6 +1142,14 @@ int multi_oo_unpack_client_data(net_player *pl, ubyte *data)
 	GET_DATA(t_subsys);
 	GET_DATA(l_subsys);
 
+	// object update packets the client has gotten
+	ushort ack_frame;
+	uint ack_bits;
+
+	GET_USHORT(ack_frame);
+	GET_UINT(ack_bits);
+	multi_oo_process_ack(pl, ack_frame, ack_bits);
+
 	// try and find the targeted object
 	tobj = NULL;
 	if(tnet_sig != 0){
@@ -703,6 +1195,8 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	float fpct;
 	ship *shipp;
 	ship_info *sip;
+	int data_start;
+	bool pos_valid = true;
 
 	// add the object's net signature, type and oo_flags
 	if(!(Net_player->flags & NETINFO_FLAG_AM_MASTER)){
@@ -715,6 +1209,7 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	}
 	GET_DATA( data_size );	
 	GET_DATA( seq_num );
+	data_start = offset;
 
 	// try and find the object
 	if(!(Net_player->flags & NETINFO_FLAG_AM_MASTER)){
@@ -730,6 +1225,9 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	// if we can't find the object, set pointer to bogus object to continue reading the data
 	// ignore out of sequence packets here as well
 	if ( (pobjp == nullptr) || (pobjp->type != OBJ_SHIP) || (pobjp->instance < 0) || (pobjp->instance >= MAX_SHIPS) || (Ships[pobjp->instance].ship_info_index < 0) || (Ships[pobjp->instance].ship_info_index >= ship_info_size())) {
+		// the server must not use this update as a baseline, since we never saw it
+		Oo_frame_unackable = true;
+
 		offset += data_size;
 		return offset;
 	}
@@ -738,6 +1236,17 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	shipp = &Ships[pobjp->instance];
 	sip = &Ship_info[shipp->ship_info_index];
 
+	// new position
+	vec3d new_pos = pobjp->pos;
+
+	// server positions come first, and are always read so that even out of order ones can serve as baselines
+	if(!MULTIPLAYER_MASTER && (oo_flags & OO_POS_NEW)){
+		offset += multi_oo_unpack_position(&shipp->np_updates[NET_PLAYER_NUM(pl)], seq_num, data + offset, &new_pos, &pos_valid);
+		if(!pos_valid){
+			Oo_frame_unackable = true;
+		}
+	}
+
 	// ---------------------------------------------------------------------------------------------------------------
 	// CRITICAL OBJECT UPDATE SHIZ
 	// ---------------------------------------------------------------------------------------------------------------
@@ -746,7 +1255,7 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	if(seq_num < shipp->np_updates[NET_PLAYER_NUM(pl)].seq){
 		// non-wraparound case
 		if((shipp->np_updates[NET_PLAYER_NUM(pl)].seq - seq_num) <= 100){
-			offset += data_size;
+			offset = data_start + data_size;
 			return offset;
 		}
 	}	
@@ -760,7 +1269,6 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	}	
 
 	// new info
-	vec3d new_pos = pobjp->pos;
 	physics_info new_phys_info = pobjp->phys_info;
 	matrix new_orient = pobjp->orient;
 	
@@ -785,8 +1293,11 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 		}
 
 		// int r1 = multi_pack_unpack_position( 0, data + offset, &pobjp->pos );
-		int r1 = multi_pack_unpack_position( 0, data + offset, &new_pos );
-		offset += r1;				
+		// (positions from the server were already read above)
+		if(MULTIPLAYER_MASTER){
+			int r1 = multi_pack_unpack_position( 0, data + offset, &new_pos );
+			offset += r1;				
+		}
 
 		// int r3 = multi_pack_unpack_vel( 0, data + offset, &pobjp->orient, &pobjp->pos, &pobjp->phys_info );
 		int r3 = multi_pack_unpack_vel( 0, data + offset, &pobjp->orient, &new_pos, &new_phys_info );
@@ -816,7 +1327,7 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	GET_DATA(percent);		
 
 	// now stuff all this new info
-	if(oo_flags & OO_POS_NEW){
+	if((oo_flags & OO_POS_NEW) && pos_valid){
 		// if we're past the position update tolerance, bash.
 		// this should cause our 2 interpolation splines to be exactly the same. so we'll see a jump,
 		// but it should be nice and smooth immediately afterwards
@@ -1162,17 +1673,26 @@ int multi_oo_maybe_update(net_player *pl, object *obj, ubyte *data)
 		}
 	}	
 		
-	// if the object's hull/shield timestamp has expired
+	// if the object's hull/shield timestamp has expired, send it unless the client already acked the same values.
+	// once the acked update falls out of the snapshot history it gets sent again anyway, to correct any drift
 	if((Ships[obj->instance].np_updates[player_index].status_update_stamp == -1) || timestamp_elapsed_safe(Ships[obj->instance].np_updates[player_index].status_update_stamp, OO_MAX_TIMESTAMP)){
-		oo_flags |= (OO_HULL_NEW);
+		if(multi_oo_status_acked(&shipp->np_updates[player_index], obj, OO_SNAP_HULL)){
+			Oo_status_skip_count++;
+		} else {
+			oo_flags |= (OO_HULL_NEW);
+		}
 
 		// reset the timestamp
 		multi_oo_reset_status_timestamp(obj, player_index);			
 	}
 
-	// if the object's hull/shield timestamp has expired
+	// if the object's subsystem timestamp has expired
 	if((Ships[obj->instance].np_updates[player_index].subsys_update_stamp == -1) || timestamp_elapsed_safe(Ships[obj->instance].np_updates[player_index].subsys_update_stamp, OO_MAX_TIMESTAMP)){
-		oo_flags |= OO_SUBSYSTEMS_AND_AI_NEW;
+		if(multi_oo_status_acked(&shipp->np_updates[player_index], obj, OO_SNAP_SUBSYS)){
+			Oo_status_skip_count++;
+		} else {
+			oo_flags |= OO_SUBSYSTEMS_AND_AI_NEW;
+		}
 
 		// reset the timestamp
 		multi_oo_reset_subsys_timestamp(obj, player_index);
@@ -1220,6 +1740,7 @@ void multi_oo_process_all(net_player *pl)
 	ubyte data[MAX_PACKET_SIZE];
 	ubyte data_add[MAX_PACKET_SIZE];
 	ubyte stop;
+	ubyte seq;
 	int add_size;	
 	int packet_size = 0;
 	int idx;
@@ -1236,15 +1757,20 @@ void multi_oo_process_all(net_player *pl)
 	// build the list of ships to check against
 	multi_oo_build_ship_list(pl);
 
+	// nothing from a previous player should be left over
+	Oo_frame_pending.clear();
+
 	// do nothing if he has no object targeted, or if he has a weapon targeted
 	if((pl->s_info.target_objnum != -1) && (Objects[pl->s_info.target_objnum].type == OBJ_SHIP)){
 		// build the header
 		BUILD_HEADER(OBJECT_UPDATE);		
+		ADD_USHORT(pl->s_info.oo_frame);
 	
 		// get a pointer to the object
 		targ_obj = &Objects[pl->s_info.target_objnum];
 	
 		// run through the maybe_update function
+		seq = Ships[targ_obj->instance].np_updates[NET_PLAYER_NUM(pl)].seq;
 		add_size = multi_oo_maybe_update(pl, targ_obj, data_add);
 
 		// copy in any relevant data
@@ -1255,27 +1781,34 @@ void multi_oo_process_all(net_player *pl)
 
 			memcpy(data + packet_size, data_add, add_size);
 			packet_size += add_size;		
+			multi_oo_add_pending(targ_obj, seq);
+			Ships[targ_obj->instance].np_updates[NET_PLAYER_NUM(pl)].priority = 0.0f;
 		}
 	} else {
 		// just build the header for the rest of the function
 		BUILD_HEADER(OBJECT_UPDATE);		
+		ADD_USHORT(pl->s_info.oo_frame);
 	}
 		
 	idx = 0;
 	// rely on logical-AND shortcut evaluation to prevent array out-of-bounds read of OO_ship_index[idx]
 	while((idx < MAX_SHIPS) && (OO_ship_index[idx] >= 0)){
-		// if this guy is over his datarate limit, do nothing
+		// if this guy is over his datarate limit, the rest keep their accumulated priority for next time
 		if(multi_oo_rate_exceeded(pl)){
 			nprintf(("Network","Capping client\n"));
-			idx++;
+			while((idx < MAX_SHIPS) && (OO_ship_index[idx] >= 0)){
+				Oo_deferred_count++;
+				idx++;
+			}
 
-			continue;
+			break;
 		}			
 
 		// get the object
 		moveup = &Objects[Ships[OO_ship_index[idx]].objnum];
 
 		// maybe send some info		
+		seq = Ships[moveup->instance].np_updates[NET_PLAYER_NUM(pl)].seq;
 		add_size = multi_oo_maybe_update(pl, moveup, data_add);
 
 		// if this data is too much for the packet, send off what we currently have and start over
@@ -1284,11 +1817,11 @@ void multi_oo_process_all(net_player *pl)
 			multi_rate_add(NET_PLAYER_NUM(pl), "stp", 1);
 			ADD_DATA(stop);
 									
-			multi_io_send(pl, data, packet_size);
-			pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+			multi_oo_send_update_packet(pl, data, packet_size);
 
 			packet_size = 0;
 			BUILD_HEADER(OBJECT_UPDATE);			
+			ADD_USHORT(pl->s_info.oo_frame);
 		}
 
 		if(add_size){
@@ -1299,20 +1832,21 @@ void multi_oo_process_all(net_player *pl)
 			// copy in the data
 			memcpy(data + packet_size,data_add,add_size);
 			packet_size += add_size;
+			multi_oo_add_pending(moveup, seq);
+			Ships[moveup->instance].np_updates[NET_PLAYER_NUM(pl)].priority = 0.0f;
 		}
 
 		// next ship
 		idx++;
 	}
 
-	// if we have anything more than 3 byte in the packet, send the last one off
+	// if we have anything more than the header and frame id in the packet, send the last one off
 	if(packet_size > 3){
 		stop = 0x00;		
 		multi_rate_add(NET_PLAYER_NUM(pl), "stp", 1);
 		ADD_DATA(stop);
 								
-		multi_io_send(pl, data, packet_size);
-		pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+		multi_oo_send_update_packet(pl, data, packet_size);
 	}
 }
 
@@ -1320,6 +1854,9 @@ void multi_oo_process_all(net_player *pl)
 void multi_oo_process()
 {
 	int idx;	
+
+	// find out where all the ships are once, for all players
+	multi_oo_build_interest_grid();
 	
 	// process each player
 	for(idx=0; idx<MAX_PLAYERS; idx++){
@@ -1341,6 +1878,7 @@ void multi_oo_process()
 void multi_oo_process_update(ubyte *data, header *hinfo)
 {	
 	ubyte stop;	
+	ushort frame = 0;
 	int player_index;	
 	int offset = HEADER_LENGTH;
 	net_player *pl = NULL;	
@@ -1355,6 +1893,12 @@ void multi_oo_process_update(ubyte *data, header *hinfo)
 		pl = Net_player;
 	}
 
+	// packets from the server carry an id for acking
+	if(!MULTIPLAYER_MASTER){
+		GET_USHORT(frame);
+		Oo_frame_unackable = false;
+	}
+
 	GET_DATA(stop);
 	
 	while(stop == 0xff){
@@ -1364,6 +1908,11 @@ void multi_oo_process_update(ubyte *data, header *hinfo)
 		GET_DATA(stop);
 	}
 	PACKET_SET_SIZE();
+
+	// only ack it if we could use everything in it
+	if(!MULTIPLAYER_MASTER && !Oo_frame_unackable){
+		multi_oo_client_ack(frame);
+	}
 }
 
 // initialize all object update timestamps (call whenever entering gameplay state)
@@ -1399,6 +1948,8 @@ void multi_oo_gameplay_init()
 				shipp->np_updates[idx].seq = 0;		
 				shipp->np_updates[idx].pos_chksum = 0;
 				shipp->np_updates[idx].orient_chksum = 0;
+				shipp->np_updates[idx].priority = 0.0f;
+				multi_oo_clear_snapshots(&shipp->np_updates[idx]);
 			} 
 			
 			oo_arrive_time_count[shipp - Ships] = 0;			
@@ -1414,6 +1965,42 @@ void multi_oo_gameplay_init()
 	for(idx=0; idx<MAX_PLAYERS; idx++){
 		Net_players[idx].s_info.rate_stamp = timestamp( (int)(1000.0f / (float)OO_gran) );
 	}
+
+	// reset delta compression state
+	multi_oo_player_reset_all();
+	Oo_ack_frame = 0;
+	Oo_ack_bits = 0;
+	Oo_pos_full_count = 0;
+	Oo_pos_delta_count = 0;
+	Oo_pos_bytes_saved = 0;
+	Oo_status_skip_count = 0;
+	Oo_deferred_count = 0;
+}
+
+// notify of a player join
+void multi_oo_player_reset_all(net_player *pl)
+{
+	int p_idx, s_idx, idx;
+
+	for(p_idx=0; p_idx<MAX_PLAYERS; p_idx++){
+		if((pl != NULL) && (pl != &Net_players[p_idx])){
+			continue;
+		}
+
+		// forget what we sent
+		for(s_idx=0; s_idx<MAX_SHIPS; s_idx++){
+			multi_oo_clear_snapshots(&Ships[s_idx].np_updates[p_idx]);
+		}
+		for(idx=0; idx<OO_FRAME_LOG_SIZE; idx++){
+			Oo_frame_log[p_idx][idx].frame = 0;
+			Oo_frame_log[p_idx][idx].entries.clear();
+		}
+
+		Net_players[p_idx].s_info.oo_frame = 1;
+		Net_players[p_idx].s_info.oo_bytes = 0;
+		Net_players[p_idx].s_info.oo_bandwidth = 0;
+		Net_players[p_idx].s_info.oo_bandwidth_stamp = -1;
+	}
 }
 
 // send control info for a client (which is basically a "reverse" object update)
@@ -1489,8 +2076,10 @@ void multi_oo_send_changed_object(object *changedobj)
 	if( idx >= MAX_PLAYERS ) {
 		return;
 	}
-	// build the header
+	// build the header, with a frame id of 0 since this isn't worth acking
 	BUILD_HEADER(OBJECT_UPDATE);		
+	ushort frame = 0;
+	ADD_USHORT(frame);
 
 	// pos and orient always
 	oo_flags = (OO_POS_NEW | OO_ORIENT_NEW);
@@ -1570,6 +2159,27 @@ DCF(oog, "Sets bandwidth granularity (Multiplayer)")
 	dc_printf("Ganularity set to %i", OO_gran);
 }
 
+DCF(oo_bandwidth, "Shows object update bandwidth per player and delta compression stats (Multiplayer)")
+{
+	int idx;
+
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: oo_bandwidth\n");
+		dc_printf("Shows the object update bytes/sec sent to each player, and how well deltas are working\n");
+		return;
+	}
+
+	for(idx=0; idx<MAX_PLAYERS; idx++){
+		if(MULTI_CONNECTED(Net_players[idx]) && !MULTI_SERVER(Net_players[idx]) && (Net_players[idx].m_player != NULL)){
+			dc_printf("%s : %d bytes/sec\n", Net_players[idx].m_player->callsign, Net_players[idx].s_info.oo_bandwidth);
+		}
+	}
+
+	dc_printf("Positions : %d full, %d delta (%d bytes saved)\n", Oo_pos_full_count, Oo_pos_delta_count, Oo_pos_bytes_saved);
+	dc_printf("Status updates skipped as already acked : %d\n", Oo_status_skip_count);
+	dc_printf("Ship updates deferred by the datarate cap : %d\n", Oo_deferred_count);
+}
+
 // process datarate limiting stuff for the server
 void multi_oo_server_process();
 
@@ -1620,6 +2230,13 @@ void multi_oo_server_process()
 				Net_players[idx].s_info.rate_stamp = timestamp( (int)(1000.0f / (float)OO_gran) );
 				Net_players[idx].s_info.rate_bytes = 0;
 			}
+
+			// roll over his object update bandwidth counter once a second
+			if((Net_players[idx].s_info.oo_bandwidth_stamp == -1) || timestamp_elapsed_safe(Net_players[idx].s_info.oo_bandwidth_stamp, OO_MAX_TIMESTAMP)){
+				Net_players[idx].s_info.oo_bandwidth_stamp = timestamp(1000);
+				Net_players[idx].s_info.oo_bandwidth = Net_players[idx].s_info.oo_bytes;
+				Net_players[idx].s_info.oo_bytes = 0;
+			}
 		}
 	}
 
@@ -1682,6 +2299,9 @@ void multi_oo_rate_init(net_player *pl)
 	// reinitialize his datarate timestamp
 	pl->s_info.rate_stamp = -1;
 	pl->s_info.rate_bytes = 0;
+	pl->s_info.oo_bytes = 0;
+	pl->s_info.oo_bandwidth = 0;
+	pl->s_info.oo_bandwidth_stamp = -1;
 }
 
 // if the given net-player has exceeded his datarate limit
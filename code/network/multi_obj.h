@@ -34,6 +34,24 @@ struct net_player;
 #define OOC_AFTERBURNER_ON			(1<<7)
 // NOTE: no additional flags here unless it's sent in an extra data byte
 
+// number of recent updates remembered per ship per player, for use as delta baselines
+#define OO_SNAPSHOT_COUNT			8
+
+// snapshot flags
+#define OO_SNAP_ACKED				(1<<0)		// the client acknowledged the packet carrying this update
+#define OO_SNAP_POS					(1<<1)		// pos holds a valid position
+#define OO_SNAP_HULL					(1<<2)		// hull_chksum holds a valid checksum
+#define OO_SNAP_SUBSYS				(1<<3)		// subsys_chksum holds a valid checksum
+
+// what a single update carried (server: what was sent, client: what was received)
+typedef struct oo_snapshot {
+	ubyte		seq;							// sequence # of the update
+	ubyte		flags;						// OO_SNAP_* flags, 0 if unused
+	int		pos[3];						// quantized position
+	ushort	hull_chksum;				// checksum of the packed hull/shield data
+	ushort	subsys_chksum;				// checksum of the packed subsystem/ai data
+} oo_snapshot;
+
 // update info
 typedef struct np_update {	
 	ubyte		seq;							// sequence #
@@ -42,6 +60,8 @@ typedef struct np_update {
 	int		subsys_update_stamp;
 	ushort	pos_chksum;					// positional checksum
 	ushort	orient_chksum;				// orient checksum
+	float		priority;					// accumulated relevance, reset when sent
+	oo_snapshot	snapshots[OO_SNAPSHOT_COUNT];	// recent updates, indexed by seq
 } np_update;
 
 // ---------------------------------------------------------------------------------------------------
@@ -67,6 +87,9 @@ int multi_oo_is_interp_object(object *objp);
 // interp
 void multi_oo_interp(object *objp);
 
+// forget all delta baselines for this update record
+void multi_oo_clear_snapshots(np_update *npu);
+
 
 // ---------------------------------------------------------------------------------------------------
 // DATARATE DEFINES/VARS
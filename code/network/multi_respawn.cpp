@@ -347,6 +347,8 @@ int multi_respawn_common_stuff(p_object *pobjp)
 		shipp->np_updates[idx].status_update_stamp = -1;
 		shipp->np_updates[idx].subsys_update_stamp = -1;
 		shipp->np_updates[idx].update_stamp = -1;
+		shipp->np_updates[idx].priority = 0.0f;
+		multi_oo_clear_snapshots(&shipp->np_updates[idx]);
 	}
 
 	// change the ship type and the weapons
@@ -787,7 +789,7 @@ void multi_respawn_place(object *new_obj, int team)
 		if((Multi_respawn_priority_ships[idx].team == team) || !(Netgame.type_flags & NG_TYPE_TEAM)){
 
 			lookup = ship_name_lookup(Multi_respawn_priority_ships[idx].ship_name);
-			if( (lookup >= 0) && ((pri == NULL) || (Ships[lookup].respawn_priority > pri->respawn_priority)) && (Ships[lookup].objnum >= 0) && (Ships[lookup].objnum < MAX_OBJECTS)){
+			if( (lookup >= 0) && ((pri == NULL) || (Ships[lookup].respawn_priority > pri->respawn_priority)) && (Ships[lookup].objnum >= 0) && (Ships[lookup].objnum < objects_size())){
 				pri = &Ships[lookup];
 				pri_obj = &Objects[Ships[lookup].objnum];
 			}
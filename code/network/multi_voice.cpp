@@ -328,6 +328,9 @@ void multi_voice_init()
 			} else {
 				Multi_voice_pre_sound_size = 0;
 			}
+
+			// the data has been copied, give back the reference snd_load() took
+			snd_unload(pre_sound);
 		} else {
 			Multi_voice_pre_sound_size = 0;
 		}
@@ -1438,6 +1441,11 @@ int multi_voice_mix(gamesnd_id post_sound,char *data,int cur_size,int max_size)
 		}
 	}
 
+	// give back the reference snd_load() took
+	if (post_sound_handle.isValid()) {
+		snd_unload(post_sound_handle);
+	}
+
 	// return the size of the new buffer
 	return cur_size;
 }
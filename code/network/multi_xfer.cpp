@@ -13,13 +13,16 @@
 #include "network/multi_xfer.h"
 #include "network/multi.h"
 #include "network/multimsgs.h"
+#include "network/multiutil.h"
 #include "network/psnet2.h"
 #include "io/timer.h"
 #include "cfile/cfile.h"
+#include "debugconsole/console.h"
+
+#include <zlib.h>
 
 #ifndef NDEBUG
 #include "playerman/player.h"
-#include "network/multiutil.h"
 #include "network/multi_log.h"
 #endif
 
@@ -40,6 +43,12 @@
 #define MULTI_XFER_CODE_HEADER				2				// file xfer header information follows, requires a HEADER_RESPONSE
 #define MULTI_XFER_CODE_DATA					3				// data block follows, requires an ack
 #define MULTI_XFER_CODE_FINAL					4				// indication from sender that xfer is complete, requires an ack
+#define MULTI_XFER_CODE_HEADER_WINDOWED		5				// header for a windowed xfer, only sent to peers which announced support for it
+#define MULTI_XFER_CODE_DATA_WINDOWED			6				// data block of a windowed xfer, tagged with its stream offset
+#define MULTI_XFER_CODE_ACK_WINDOWED			7				// cumulative ack for a windowed xfer (total stream bytes received)
+
+// flags sent along with a windowed header
+#define MULTI_XFER_HEADER_COMPRESSED			(1<<0)		// the stream is the zlib compressed file
 
 // entry flags
 #define MULTI_XFER_FLAG_USED					(1<<0)		// this entry is in use	
@@ -53,6 +62,9 @@
 #define MULTI_XFER_FLAG_FAIL					(1<<8)		// xfer failed
 #define MULTI_XFER_FLAG_TIMEOUT				(1<<9)		// xfer has timed-out
 #define MULTI_XFER_FLAG_QUEUE_CURRENT		(1<<10)		// for a set of XFER_FLAG_QUEUE'd files, this is the current one sending
+#define MULTI_XFER_FLAG_WINDOWED				(1<<11)		// this entry keeps multiple data blocks in flight instead of waiting for an ack after each one
+#define MULTI_XFER_FLAG_COMPRESSED			(1<<12)		// the stream of this (windowed) entry is zlib compressed
+#define MULTI_XFER_FLAG_WINDOW_BLOCKED		(1<<13)		// the reliable socket was full while filling the window, try again next frame
 
 // packet size for file xfer
 #define MULTI_XFER_MAX_DATA_SIZE				490			// this will keep us within the MULTI_XFER_MAX_SIZE_LIMIT
@@ -60,6 +72,9 @@
 // timeout for a given xfer operation
 #define MULTI_XFER_TIMEOUT						10000		
 
+// default # of unacknowledged data blocks a windowed xfer may have in flight
+#define MULTI_XFER_DEFAULT_WINDOW				16
+
 //XSTR:OFF
 
 // temp filename header for xferring files
@@ -81,6 +96,13 @@ typedef struct xfer_entry {
 	int xfer_stamp;												// timestamp for the current operation		
 	int force_dir;													// force the file to go to this directory on receive (will override Multi_xfer_force_dir)	
 	ushort sig;														// identifying sig - sender specifies this
+
+	// windowed xfers only
+	ubyte *stream;													// file contents (possibly compressed) being sent, or compressed data being received
+	int stream_size;												// # of bytes actually sent over the wire
+	int stream_sent;												// sender - # of stream bytes sent so far
+	int stream_acked;												// sender - # of stream bytes acked, receiver - # of stream bytes received
+	int start_time;												// timer_get_milliseconds() when the xfer started
 } xfer_entry;
 xfer_entry Multi_xfer_entry[MAX_XFER_ENTRIES];			// the file xfer entries themselves
 
@@ -96,6 +118,15 @@ int Multi_xfer_force_dir;
 // unique file signature - this along with a socket # is enough to identify all xfers
 ushort Multi_xfer_sig = 0;
 
+// # of unacknowledged data blocks a windowed xfer may have in flight
+int Multi_xfer_window = MULTI_XFER_DEFAULT_WINDOW;
+
+// whether windowed xfers should try to compress the file
+bool Multi_xfer_compress = true;
+
+DCF_INT2(xfer_window, Multi_xfer_window, 1, 64, "Sets the # of data blocks a windowed file xfer keeps in flight (Multiplayer)");
+DCF_BOOL(xfer_compress, Multi_xfer_compress);
+
 
 // ------------------------------------------------------------------------------------------
 // MULTI XFER FORWARD DECLARATIONS
@@ -121,13 +152,25 @@ void multi_xfer_process_final(xfer_entry *xe);
 
 // process a data packet
 void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size);
+
+// process a windowed data packet
+void multi_xfer_process_data_windowed(xfer_entry *xe, int stream_offset, ubyte *data, int data_size);
+
+// process a windowed ack for this entry
+void multi_xfer_process_ack_windowed(xfer_entry *xe, int stream_acked);
 	
 // process a header
-void multi_xfer_process_header(ubyte *data, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum);		
+void multi_xfer_process_header(ubyte *data, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum, int header_flags = 0, int stream_size = -1);
 
 // send the next block of outgoing data or a "final" packet if we're done
 void multi_xfer_send_next(xfer_entry *xe);
 
+// fill the send window of a windowed xfer or send a "final" packet if everything was acked
+void multi_xfer_send_next_windowed(xfer_entry *xe);
+
+// send a windowed ack to the sender
+void multi_xfer_send_ack_windowed(PSNET_SOCKET_RELIABLE socket, ushort sig, int stream_acked);
+
 // send an ack to the sender
 void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig);
 
@@ -146,6 +189,15 @@ void multi_xfer_conv_prefix(char *filename, char *ex_filename);
 // get a new xfer sig
 ushort multi_xfer_get_sig();
 
+// free the stream buffer of a windowed xfer
+void multi_xfer_free_stream(xfer_entry *xe);
+
+// determine if the peer on the other end of the socket can receive windowed xfers
+bool multi_xfer_peer_supports_windowed(PSNET_SOCKET_RELIABLE who);
+
+// read (and possibly compress) the file of a send entry into its stream buffer
+bool multi_xfer_build_stream(xfer_entry *xe);
+
 // ------------------------------------------------------------------------------------------
 // MULTI XFER FUNCTIONS
 //
@@ -262,6 +314,16 @@ int multi_xfer_send_file(PSNET_SOCKET_RELIABLE who, char *filename, int cfile_fl
 	// set the socket	
 	temp_entry.file_socket = who;		
 
+	// if the other end can take them, send the whole file (compressed if it helps) with multiple blocks in flight
+	if(multi_xfer_peer_supports_windowed(who)){
+		if(multi_xfer_build_stream(&temp_entry)){
+			temp_entry.flags |= MULTI_XFER_FLAG_WINDOWED;
+		} else {
+			// fall back to the regular block by block xfer
+			cfseek(temp_entry.file,0,CF_SEEK_SET);
+		}
+	}
+
 	// set the signature
 	temp_entry.sig = multi_xfer_get_sig();
 
@@ -317,6 +379,9 @@ void multi_xfer_abort(int handle)
 	// get e handle to the entry
 	xe = &Multi_xfer_entry[handle];
 
+	// free any windowed xfer data
+	multi_xfer_free_stream(xe);
+
 	// close any open file and delete it 
 	if(xe->file != NULL){
 		cfclose(xe->file);
@@ -348,6 +413,9 @@ void multi_xfer_release_handle(int handle)
 	// get e handle to the entry
 	xe = &Multi_xfer_entry[handle];
 
+	// free any windowed xfer data
+	multi_xfer_free_stream(xe);
+
 	// close any open file and delete it 
 	if(xe->file != NULL){
 		cfclose(xe->file);
@@ -561,6 +629,11 @@ void multi_xfer_eval_entry(xfer_entry *xe)
 		xe->flags |= MULTI_XFER_FLAG_WAIT_ACK;
 	}
 	
+	// if the window couldn't be filled last time, try again - there may be no acks coming to do it for us
+	if(xe->flags & MULTI_XFER_FLAG_WINDOW_BLOCKED){
+		multi_xfer_send_next_windowed(xe);
+	}
+
 	// see if the entry has timed-out for one reason or another
 	if((xe->xfer_stamp != -1) && timestamp_elapsed(xe->xfer_stamp)){
 		xe->flags |= MULTI_XFER_FLAG_TIMEOUT;			
@@ -604,6 +677,9 @@ void multi_xfer_fail_entry(xfer_entry *xe)
 	xe->flags &= ~(MULTI_XFER_FLAG_WAIT_ACK | MULTI_XFER_FLAG_WAIT_DATA | MULTI_XFER_FLAG_UNKNOWN);
 	xe->flags |= MULTI_XFER_FLAG_FAIL;
 
+	// free any windowed xfer data
+	multi_xfer_free_stream(xe);
+
 	// close the file pointer
 	if(xe->file != NULL){
 		cfclose(xe->file);
@@ -661,6 +737,9 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 	ubyte xfer_data[600];
 	ushort sig;
 	int sender_side = 1;
+	ubyte header_flags = 0;
+	int stream_size = -1;
+	int stream_offset = 0;
 
 	// read in all packet data
 	GET_DATA(val);	
@@ -682,11 +761,35 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 		sender_side = 0;
 		break;
 
+	// RECV side
+	case MULTI_XFER_CODE_DATA_WINDOWED:
+		GET_INT(stream_offset);
+		GET_USHORT(data_size);
+		memcpy(xfer_data, data + offset, data_size);
+		offset += data_size;
+		sender_side = 0;
+		break;
+
+	// RECV side
+	case MULTI_XFER_CODE_HEADER_WINDOWED:
+		GET_STRING(filename);
+		GET_INT(file_size);
+		GET_USHORT(file_checksum);
+		GET_DATA(header_flags);
+		GET_INT(stream_size);
+		sender_side = 0;
+		break;
+
 	// SEND side
 	case MULTI_XFER_CODE_ACK:
 	case MULTI_XFER_CODE_NAK:
 		break;
 
+	// SEND side
+	case MULTI_XFER_CODE_ACK_WINDOWED:
+		GET_INT(stream_offset);
+		break;
+
 	// RECV side
 	case MULTI_XFER_CODE_FINAL:
 		sender_side = 0;
@@ -700,7 +803,7 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 
 	// at this point, we should process code-specific data	
 	xe = NULL;
-	if(val != MULTI_XFER_CODE_HEADER){		
+	if((val != MULTI_XFER_CODE_HEADER) && (val != MULTI_XFER_CODE_HEADER_WINDOWED)){		
 		// if the code is not a request or a header, we need to look up the existing xfer_entry
 		xe = NULL;
 			
@@ -761,6 +864,23 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 		// send on my reliable socket
 		multi_xfer_process_header(xfer_data, who, sig, filename, file_size, file_checksum);
 		break;
+
+	// process a windowed ack for this entry
+	case MULTI_XFER_CODE_ACK_WINDOWED :
+		Assert(xe != NULL);
+		multi_xfer_process_ack_windowed(xe, stream_offset);
+		break;
+
+	// process a windowed data packet
+	case MULTI_XFER_CODE_DATA_WINDOWED :
+		Assert(xe != NULL);
+		multi_xfer_process_data_windowed(xe, stream_offset, xfer_data, data_size);
+		break;
+
+	// process a windowed header
+	case MULTI_XFER_CODE_HEADER_WINDOWED :
+		multi_xfer_process_header(xfer_data, who, sig, filename, file_size, file_checksum, header_flags, stream_size);
+		break;
 	}		
 	return offset;
 }
@@ -779,6 +899,13 @@ void multi_xfer_process_ack(xfer_entry *xe)
 			nprintf(("Network", "MULTI XFER : Successfully sent file %s\n", xe->filename));
 #endif
 
+			// log the throughput of this xfer
+			if(xe->flags & MULTI_XFER_FLAG_WINDOWED){
+				int elapsed = MAX(timer_get_milliseconds() - xe->start_time, 1);
+				nprintf(("Network", "MULTI XFER : Sent %d bytes (%d on the wire%s) in %d ms, %.1f KB/s\n", xe->file_size, xe->stream_size,
+					(xe->flags & MULTI_XFER_FLAG_COMPRESSED) ? ", compressed" : "", elapsed, (float)xe->file_size / (float)elapsed * 1000.0f / 1024.0f));
+			}
+
 			// if we should be auto-destroying this entry, do so
 			if(xe->flags & MULTI_XFER_FLAG_AUTODESTROY){
 				multi_xfer_release_handle((int)std::distance(Multi_xfer_entry, xe));
@@ -791,6 +918,26 @@ void multi_xfer_process_ack(xfer_entry *xe)
 	}
 }
 
+// process a windowed ack for this entry
+void multi_xfer_process_ack_windowed(xfer_entry *xe, int stream_acked)
+{
+	// only senders of windowed xfers should ever get these
+	if(!(xe->flags & MULTI_XFER_FLAG_SEND) || !(xe->flags & MULTI_XFER_FLAG_WINDOWED)){
+		return;
+	}
+
+	// acks are cumulative so anything not moving forward is stale
+	if((stream_acked <= xe->stream_acked) || (stream_acked > xe->stream_sent)){
+		return;
+	}
+
+	xe->stream_acked = stream_acked;
+	xe->file_ptr = (int)(((int64_t)xe->stream_acked * xe->file_size) / MAX(xe->stream_size, 1));
+
+	// refill the window
+	multi_xfer_send_next(xe);
+}
+
 // process a nak for this entry
 void multi_xfer_process_nak(xfer_entry *xe)
 {		
@@ -805,6 +952,30 @@ void multi_xfer_process_final(xfer_entry *xe)
 
 	// make sure we skip a line
 	nprintf(("Network","\n"));
+
+	// a compressed windowed xfer is kept in memory until all of it has arrived
+	if((xe->flags & MULTI_XFER_FLAG_COMPRESSED) && (xe->stream != NULL)){
+		ubyte *file_data = (ubyte*)vm_malloc(MAX(xe->file_size, 1));
+		uLongf file_data_size = (uLongf)xe->file_size;
+
+		int ret = uncompress(file_data, &file_data_size, xe->stream, (uLong)xe->stream_acked);
+		if((ret != Z_OK) || (file_data_size != (uLongf)xe->file_size) || (xe->file == NULL) || ((xe->file_size > 0) && !cfwrite(file_data, xe->file_size, 1, xe->file))){
+#ifdef MULTI_XFER_VERBOSE
+			nprintf(("Network","MULTI XFER : could not decompress file %s (zlib error %d)!\n", xe->filename, ret));
+#endif
+			vm_free(file_data);
+
+			// inform the sender we had a problem
+			multi_xfer_send_nak(xe->file_socket, xe->sig);
+
+			// fail this entry
+			multi_xfer_fail_entry(xe);
+			return;
+		}
+
+		vm_free(file_data);
+		multi_xfer_free_stream(xe);
+	}
 	
 	// close the file
 	if(xe->file != NULL){
@@ -887,9 +1058,51 @@ void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size)
 	// set the timestmp
 	xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);	
 }
+
+// process a windowed data packet
+void multi_xfer_process_data_windowed(xfer_entry *xe, int stream_offset, ubyte *data, int data_size)
+{
+	int write_ok;
+
+	// print out a crude progress indicator
+	nprintf(("Network","."));
+
+	// the reliable socket keeps blocks in order, so anything else means the stream is broken
+	if(!(xe->flags & MULTI_XFER_FLAG_WINDOWED) || (stream_offset != xe->stream_acked) || (xe->stream_acked + data_size > xe->stream_size)){
+		write_ok = 0;
+	}
+	// compressed data is collected in memory and decompressed once the final packet comes in
+	else if(xe->flags & MULTI_XFER_FLAG_COMPRESSED){
+		write_ok = (xe->stream != NULL);
+		if(write_ok){
+			memcpy(xe->stream + xe->stream_acked, data, data_size);
+		}
+	} else {
+		write_ok = (xe->file != NULL) && cfwrite(data, data_size, 1, xe->file);
+	}
+
+	if(!write_ok){
+		// inform the sender we had a problem
+		multi_xfer_send_nak(xe->file_socket, xe->sig);
+
+		// fail this entry
+		multi_xfer_fail_entry(xe);
+		return;
+	}
+
+	// increment the stream pointer
+	xe->stream_acked += data_size;
+	xe->file_ptr = (int)(((int64_t)xe->stream_acked * xe->file_size) / MAX(xe->stream_size, 1));
+
+	// let the sender know how far along we are so it can keep the window full
+	multi_xfer_send_ack_windowed(xe->file_socket, xe->sig, xe->stream_acked);
+
+	// set the timestmp
+	xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
+}
 	
 // process a header, return bytes processed
-void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum)
+void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum, int header_flags, int stream_size)
 {		
 	xfer_entry *xe;		
 	int handle;	
@@ -928,6 +1141,15 @@ void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, usho
 	// set the sig
 	xe->sig = sig;
 
+	// windowed xfers tell us how much data will actually come over the wire
+	if(stream_size >= 0){
+		xe->flags |= MULTI_XFER_FLAG_WINDOWED;
+		xe->stream_size = stream_size;
+		if(header_flags & MULTI_XFER_HEADER_COMPRESSED){
+			xe->flags |= MULTI_XFER_FLAG_COMPRESSED;
+		}
+	}
+
 	// copy the filename and get the prefixed xfer filename
 	strcpy_s(xe->filename, filename);
 	multi_xfer_conv_prefix(xe->filename, xe->ex_filename);
@@ -965,6 +1187,11 @@ void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, usho
 		memset(xe, 0, sizeof(xfer_entry));
 		return;
 	}
+
+	// compressed data has to be buffered until the whole stream has arrived
+	if(xe->flags & MULTI_XFER_FLAG_COMPRESSED){
+		xe->stream = (ubyte*)vm_malloc(MAX(xe->stream_size, 1));
+	}
 	
 	// set the waiting for data flag
 	xe->flags |= MULTI_XFER_FLAG_WAIT_DATA;		
@@ -984,6 +1211,12 @@ void multi_xfer_send_next(xfer_entry *xe)
 	ushort data_size;
 	int packet_size = 0;	
 
+	// windowed xfers keep multiple blocks in flight
+	if(xe->flags & MULTI_XFER_FLAG_WINDOWED){
+		multi_xfer_send_next_windowed(xe);
+		return;
+	}
+
 	// print out a crude progress indicator
 	nprintf(("Network", "+"));		
 
@@ -1046,6 +1279,79 @@ void multi_xfer_send_next(xfer_entry *xe)
 	psnet_rel_send(xe->file_socket, data, packet_size);
 }
 
+// fill the send window of a windowed xfer or send a "final" packet if everything was acked
+void multi_xfer_send_next_windowed(xfer_entry *xe)
+{
+	ubyte data[MAX_PACKET_SIZE],code;
+	ushort data_size;
+	int packet_size;
+
+	// once the receiver has everything, we should send a "final" packet
+	if(xe->stream_acked >= xe->stream_size){
+		// only send it once
+		if(xe->flags & MULTI_XFER_FLAG_UNKNOWN){
+			return;
+		}
+
+		// mark the entry as unknown 
+		xe->flags |= MULTI_XFER_FLAG_UNKNOWN;
+
+		// set the timestmp
+		xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
+
+		// send the packet
+		multi_xfer_send_final(xe);
+		return;
+	}
+
+	// length of the added string (keep the same block size as regular xfers) plus the stream offset
+	auto flen = strlen(xe->filename) + 4 + sizeof(int);
+	auto block_size = (int)(MULTI_XFER_MAX_DATA_SIZE - flen);
+
+	xe->flags &= ~(MULTI_XFER_FLAG_WINDOW_BLOCKED);
+
+	// send blocks until the window is full or we run out of data
+	while((xe->stream_sent < xe->stream_size) && (xe->stream_sent - xe->stream_acked < block_size * Multi_xfer_window)){
+		// print out a crude progress indicator
+		nprintf(("Network", "+"));
+
+		data_size = (ushort)MIN(block_size, xe->stream_size - xe->stream_sent);
+
+		// build the header
+		packet_size = 0;
+		BUILD_HEADER(XFER_PACKET);
+
+		// add the opcode
+		code = MULTI_XFER_CODE_DATA_WINDOWED;
+		ADD_DATA(code);
+
+		// add the sig
+		ADD_USHORT(xe->sig);
+
+		// add where this block goes in the stream
+		ADD_INT(xe->stream_sent);
+
+		// add in the size of the rest of the packet
+		ADD_USHORT(data_size);
+
+		// copy in the data
+		memcpy(data + packet_size, xe->stream + xe->stream_sent, data_size);
+		packet_size += (int)data_size;
+
+		// send it - 0 means the reliable buffers are full and the block wasn't queued, so it and the rest of the window
+		// wait for the next frame (a SOCKET_ERROR after queueing is resent by the reliable socket itself)
+		if(psnet_rel_send(xe->file_socket, data, packet_size) == 0){
+			xe->flags |= MULTI_XFER_FLAG_WINDOW_BLOCKED;
+			break;
+		}
+
+		xe->stream_sent += (int)data_size;
+	}
+
+	// set the timestmp
+	xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
+}
+
 // send an ack to the sender
 void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig)
 {
@@ -1066,6 +1372,29 @@ void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig)
 	psnet_rel_send(socket, data, packet_size);
 }
 
+// send a windowed ack to the sender
+void multi_xfer_send_ack_windowed(PSNET_SOCKET_RELIABLE socket, ushort sig, int stream_acked)
+{
+	ubyte data[MAX_PACKET_SIZE],code;
+	int packet_size = 0;
+
+	// build the header and add
+	BUILD_HEADER(XFER_PACKET);
+
+	// add the opcode
+	code = MULTI_XFER_CODE_ACK_WINDOWED;
+	ADD_DATA(code);
+
+	// add the sig
+	ADD_USHORT(sig);
+
+	// add the total # of stream bytes we've got
+	ADD_INT(stream_acked);
+
+	// send the data
+	psnet_rel_send(socket, data, packet_size);
+}
+
 // send a nak to the sender
 void multi_xfer_send_nak(PSNET_SOCKET_RELIABLE socket, ushort sig)
 {
@@ -1114,7 +1443,7 @@ void multi_xfer_send_header(xfer_entry *xe)
 
 	// build the header and add the opcode
 	BUILD_HEADER(XFER_PACKET);	
-	code = MULTI_XFER_CODE_HEADER;
+	code = (xe->flags & MULTI_XFER_FLAG_WINDOWED) ? MULTI_XFER_CODE_HEADER_WINDOWED : MULTI_XFER_CODE_HEADER;
 	ADD_DATA(code);
 
 	// add the sig
@@ -1129,6 +1458,18 @@ void multi_xfer_send_header(xfer_entry *xe)
 	// add the file checksum
 	ADD_USHORT(xe->file_chksum);
 
+	// windowed xfers also say how the stream is encoded and how big it is
+	if(xe->flags & MULTI_XFER_FLAG_WINDOWED){
+		ubyte header_flags = 0;
+		if(xe->flags & MULTI_XFER_FLAG_COMPRESSED){
+			header_flags |= MULTI_XFER_HEADER_COMPRESSED;
+		}
+		ADD_DATA(header_flags);
+		ADD_INT(xe->stream_size);
+
+		xe->start_time = timer_get_milliseconds();
+	}
+
 	// send the packet	
 	psnet_rel_send(xe->file_socket, data, packet_size);
 }
@@ -1165,3 +1506,71 @@ ushort multi_xfer_get_sig()
 
 	return ret;
 }
+
+// free the stream buffer of a windowed xfer
+void multi_xfer_free_stream(xfer_entry *xe)
+{
+	if(xe->stream != NULL){
+		vm_free(xe->stream);
+		xe->stream = NULL;
+	}
+}
+
+// determine if the peer on the other end of the socket can receive windowed xfers
+bool multi_xfer_peer_supports_windowed(PSNET_SOCKET_RELIABLE who)
+{
+	// only the server knows what its clients announced when they joined
+	if(!MULTIPLAYER_MASTER){
+		return false;
+	}
+
+	int np_index = find_player_socket(who);
+	if(np_index < 0){
+		return false;
+	}
+
+	return (Net_players[np_index].flags & NETINFO_FLAG_XFER_WINDOWED) != 0;
+}
+
+// read (and possibly compress) the file of a send entry into its stream buffer
+bool multi_xfer_build_stream(xfer_entry *xe)
+{
+	ubyte *file_data = (ubyte*)vm_malloc(MAX(xe->file_size, 1));
+
+	if((xe->file_size > 0) && (cfread(file_data, xe->file_size, 1, xe->file) != 1)){
+#ifdef MULTI_XFER_VERBOSE
+		nprintf(("Network","MULTI XFER : Could not read file %s for windowed xfer\n",xe->filename));
+#endif
+		vm_free(file_data);
+		return false;
+	}
+
+	xe->stream = file_data;
+	xe->stream_size = xe->file_size;
+
+	// use the compressed data only if it actually saves something
+	if(Multi_xfer_compress && (xe->file_size > 0)){
+		uLongf compressed_size = compressBound((uLong)xe->file_size);
+		ubyte *compressed = (ubyte*)vm_malloc(compressed_size);
+
+		if((compress2(compressed, &compressed_size, file_data, (uLong)xe->file_size, Z_BEST_COMPRESSION) == Z_OK) && (compressed_size < (uLongf)xe->file_size)){
+			vm_free(file_data);
+
+			xe->stream = compressed;
+			xe->stream_size = (int)compressed_size;
+			xe->flags |= MULTI_XFER_FLAG_COMPRESSED;
+		} else {
+			vm_free(compressed);
+		}
+	}
+
+	// everything we need is in memory now
+	cfclose(xe->file);
+	xe->file = NULL;
+
+#ifdef MULTI_XFER_VERBOSE
+	nprintf(("Network","MULTI XFER : Windowed xfer of %s, %d bytes on the wire for %d bytes of file\n",xe->filename,xe->stream_size,xe->file_size));
+#endif
+
+	return true;
+}
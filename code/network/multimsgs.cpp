@@ -584,6 +584,9 @@ void multi_io_send_buffered_packets()
 			Net_player->s_info.reliable_buffer_size = 0;
 		}
 	}
+
+	// hand all of the unreliable data to the socket in as few calls as possible
+	psnet_send_flush();
 }
 
 //*********************************************************************************************************
@@ -8474,7 +8477,7 @@ void process_self_destruct_packet(ubyte *data, header *hinfo)
 	if(Net_players[np_index].m_player == NULL){
 		return;
 	}
-	if((Net_players[np_index].m_player->objnum < 0) || (Net_players[np_index].m_player->objnum >= MAX_OBJECTS)){
+	if((Net_players[np_index].m_player->objnum < 0) || (Net_players[np_index].m_player->objnum >= objects_size())){
 		return;
 	}
 	if(Objects[Net_players[np_index].m_player->objnum].net_signature != net_sig){
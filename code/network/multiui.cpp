@@ -1915,6 +1915,9 @@ void multi_join_send_join_request(int as_observer)
 	if(game_hacked_data()){
 		Multi_join_request.flags |= JOIN_FLAG_HAXOR;
 	}
+
+	// let the server know it can push files to us with the windowed xfer protocol
+	Multi_join_request.flags |= JOIN_FLAG_XFER_WINDOWED;
 	
 	// pxo squad info
 	strcpy_s(Multi_join_request.pxo_squad_name, Multi_tracker_squad_name);
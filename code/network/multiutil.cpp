@@ -585,7 +585,7 @@ int multi_find_player_by_ship_name(const char *ship_name, bool inc_respawning)
 	}
 
 	for(idx=0; idx<MAX_PLAYERS; idx++){
-		if(MULTI_CONNECTED(Net_players[idx]) && !MULTI_OBSERVER(Net_players[idx]) && (Net_players[idx].m_player != nullptr) && (Net_players[idx].m_player->objnum >= 0) && (Net_players[idx].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[idx].m_player->objnum].type == OBJ_SHIP) && 
+		if(MULTI_CONNECTED(Net_players[idx]) && !MULTI_OBSERVER(Net_players[idx]) && (Net_players[idx].m_player != nullptr) && (Net_players[idx].m_player->objnum >= 0) && (Net_players[idx].m_player->objnum < objects_size()) && (Objects[Net_players[idx].m_player->objnum].type == OBJ_SHIP) && 
 			(Objects[Net_players[idx].m_player->objnum].instance >= 0) && (Objects[Net_players[idx].m_player->objnum].instance < MAX_SHIPS) && !stricmp(ship_name, Ships[Objects[Net_players[idx].m_player->objnum].instance].ship_name) ){
 			return idx;
 		}
@@ -612,7 +612,7 @@ int multi_get_player_ship(int np_index)
 
 	// cool?
 	if(MULTI_CONNECTED(Net_players[np_index]) && !MULTI_OBSERVER(Net_players[np_index]) && !MULTI_STANDALONE(Net_players[np_index]) && 
-		(Net_players[np_index].m_player != nullptr) && (Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP) && 
+		(Net_players[np_index].m_player != nullptr) && (Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < objects_size()) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP) && 
 		(Objects[Net_players[np_index].m_player->objnum].instance >= 0) && (Objects[Net_players[np_index].m_player->objnum].instance < MAX_SHIPS) ){
 
 		return Objects[Net_players[np_index].m_player->objnum].instance;
@@ -724,6 +724,8 @@ void multi_assign_player_ship( int net_player_num, object *objp,int ship_class )
 		shipp->np_updates[idx].status_update_stamp = -1;
 		shipp->np_updates[idx].subsys_update_stamp = -1;
 		shipp->np_updates[idx].update_stamp = -1;
+		shipp->np_updates[idx].priority = 0.0f;
+		multi_oo_clear_snapshots(&shipp->np_updates[idx]);
 	}
 }
 
@@ -814,6 +816,9 @@ void multi_create_player( int net_player_num, player *pl, const char* name, net_
 	Net_players[net_player_num].s_info.rate_stamp = -1;
 	Net_players[net_player_num].s_info.rate_bytes = 0;
 
+	// forget any object update baselines left over from the previous occupant of this slot
+	multi_oo_player_reset_all(&Net_players[net_player_num]);
+
 	// nil packet buffer stuff
 	Net_players[net_player_num].s_info.unreliable_buffer_size = 0;
 	Net_players[net_player_num].s_info.reliable_buffer_size = 0;
@@ -953,7 +958,7 @@ void delete_player(int player_num,int kicked_reason)
 		}
 	} else {
 		// otherwise mark it so that he can return to it later if possible
-		if ( (Net_players[player_num].m_player->objnum >= 0) && (Net_players[player_num].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[player_num].m_player->objnum].type == OBJ_SHIP) && (Objects[Net_players[player_num].m_player->objnum].instance >= 0) && (Objects[Net_players[player_num].m_player->objnum].instance < MAX_SHIPS)) {
+		if ( (Net_players[player_num].m_player->objnum >= 0) && (Net_players[player_num].m_player->objnum < objects_size()) && (Objects[Net_players[player_num].m_player->objnum].type == OBJ_SHIP) && (Objects[Net_players[player_num].m_player->objnum].instance >= 0) && (Objects[Net_players[player_num].m_player->objnum].instance < MAX_SHIPS)) {
 			multi_make_player_ai( &Objects[Net_players[player_num].m_player->objnum] );
 		} else {
 			multi_respawn_player_leave(&Net_players[player_num]);
@@ -2447,6 +2452,11 @@ void multi_process_valid_join_request(join_request *jr, net_addr *who_from, int
 			Net_players[net_player_num].flags |= NETINFO_FLAG_HAXOR;
 		}
 
+		// if he can receive windowed file xfers
+		if(jr->flags & JOIN_FLAG_XFER_WINDOWED){
+			Net_players[net_player_num].flags |= NETINFO_FLAG_XFER_WINDOWED;
+		}
+
 		// set his reliable connect time
 		Net_players[net_player_num].s_info.reliable_connect_time = (int) time(nullptr);
 
@@ -2490,6 +2500,11 @@ void multi_process_valid_join_request(join_request *jr, net_addr *who_from, int
 		if(jr->flags & JOIN_FLAG_HAXOR){
 			Net_players[net_player_num].flags |= NETINFO_FLAG_HAXOR;
 		}
+
+		// if he can receive windowed file xfers
+		if(jr->flags & JOIN_FLAG_XFER_WINDOWED){
+			Net_players[net_player_num].flags |= NETINFO_FLAG_XFER_WINDOWED;
+		}
 		
 		// flag him appropriately if he's doing an ingame join
 		if(MULTI_IN_MISSION){
@@ -3474,6 +3489,31 @@ int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos)
 	}
 }
 
+// Packs/unpacks a quantized position delta, using bit_count bits per axis.
+// Returns number of bytes read or written.
+int multi_pack_unpack_position_delta( int write, ubyte *data, int *delta, int bit_count)
+{
+	bitbuffer buf;
+	int idx;
+
+	Assert((bit_count > 1) && (bit_count <= 24));
+	bitbuffer_init(&buf,data);
+
+	if ( write )	{
+		for(idx=0; idx<3; idx++){
+			bitbuffer_put( &buf, (uint)delta[idx], bit_count );
+		}
+
+		return bitbuffer_write_flush(&buf);
+	} else {
+		for(idx=0; idx<3; idx++){
+			delta[idx] = bitbuffer_get_signed(&buf, bit_count);
+		}
+
+		return bitbuffer_read_flush(&buf);
+	}
+}
+
 // Packs/unpacks an orientation matrix.
 // Returns number of bytes read or written.
 int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient)
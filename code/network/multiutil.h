@@ -188,6 +188,10 @@ void multi_get_mission_checksum(const char *filename);
 #define OO_POS_RET_SIZE							9
 int multi_pack_unpack_position(int write, ubyte *data, vec3d *pos);
 
+// Packs/unpacks a quantized position delta, using bit_count bits per axis.
+// Returns number of bytes read or written.
+int multi_pack_unpack_position_delta(int write, ubyte *data, int *delta, int bit_count);
+
 // Packs/unpacks an orientation matrix.
 // Returns number of bytes read or written.
 #define OO_ORIENT_RET_SIZE						6
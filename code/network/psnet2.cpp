@@ -40,6 +40,7 @@
 #include "network/multi_log.h"
 #include "network/multi_rate.h"
 #include "cmdline/cmdline.h"
+#include "platformChecks.h"
 
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 DEFINES/VARS
@@ -121,6 +122,28 @@ typedef struct network_packet_buffer_list {
 
 #pragma pack(pop)
 
+// buffer sequence #'s wrap at a multiple of the buffer count, so they never go negative and the ring index stays in order
+#define PSNET_SEQ_WRAP			(MAX_PACKET_BUFFERS * 1000000)
+
+static int psnet_buffer_index(int id)
+{
+	Assert((id >= 0) && (id < PSNET_SEQ_WRAP));
+	return id % MAX_PACKET_BUFFERS;
+}
+
+static int psnet_buffer_next_id(int id)
+{
+	return (id + 1) % PSNET_SEQ_WRAP;
+}
+
+/**
+ * The lowest id# stays in its ring slot until it is read, so there is nothing to read if it isn't there
+ */
+static bool psnet_buffer_empty(network_packet_buffer_list *l)
+{
+	return (l->psnet_lowest_id == -1) || (l->psnet_buffers[psnet_buffer_index(l->psnet_lowest_id)].sequence_number != l->psnet_lowest_id);
+}
+
 
 #define MAXHOSTNAME			128
 
@@ -217,6 +240,36 @@ unsigned int Serverconn = 0xffffffff;
 // top layer buffers
 network_packet_buffer_list Psnet_top_buffers[PSNET_NUM_TYPES];
 
+// socket i/o counters for the unreliable socket
+psnet_stats Psnet_stats;
+
+// how many datagrams we move per recvmmsg()/sendmmsg() call
+#define PSNET_MMSG_BATCH			32
+
+#if SCP_HAVE_RECVMMSG
+// preallocated ring the kernel reads incoming datagrams into
+network_naked_packet Psnet_recv_ring[PSNET_MMSG_BATCH];
+SOCKADDR_IN Psnet_recv_addrs[PSNET_MMSG_BATCH];
+struct iovec Psnet_recv_iovs[PSNET_MMSG_BATCH];
+struct mmsghdr Psnet_recv_msgs[PSNET_MMSG_BATCH];
+#endif
+
+#if SCP_HAVE_SENDMMSG
+/**
+ * An outgoing datagram waiting for psnet_send_flush()
+ */
+typedef struct psnet_send_packet {
+	SOCKADDR_IN	addr;
+	ubyte		data[MAX_TOP_LAYER_PACKET_SIZE + 1];
+} psnet_send_packet;
+
+// preallocated ring of outgoing unreliable datagrams
+psnet_send_packet Psnet_send_ring[PSNET_MMSG_BATCH];
+struct iovec Psnet_send_iovs[PSNET_MMSG_BATCH];
+struct mmsghdr Psnet_send_msgs[PSNET_MMSG_BATCH];
+int Psnet_send_count = 0;
+#endif
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 FORWARD DECLARATIONS
 //
@@ -257,6 +310,9 @@ void psnet_buffer_packet(network_packet_buffer_list *l, ubyte *data, int length,
 // get the index of the next packet in order!
 int psnet_buffer_get_next(network_packet_buffer_list *l, ubyte *data, int *length, net_addr *from);
 
+// point the batched i/o headers at their ring buffers
+void psnet_mmsg_init();
+
 
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 TOP LAYER FUNCTIONS - these functions simply buffer and store packets based upon type (see PSNET_TYPE_* defines)
@@ -324,7 +380,7 @@ int SELECT(int nfds, fd_set * readfds, fd_set * writefds, fd_set * exceptfds, st
 	l = &Psnet_top_buffers[psnet_type];	
 
 	// do we have any buffers in here?	
-	if((l->psnet_lowest_id == -1) || (l->psnet_lowest_id > l->psnet_highest_id)){
+	if(psnet_buffer_empty(l)){
 		return 0;
 	}
 
@@ -347,28 +403,92 @@ int SENDTO(SOCKET s, char * buf, int len, int flags, sockaddr *to, int tolen, in
 	return sendto(s, outbuf, len + 1, flags, (SOCKADDR*)to, tolen);
 }
 
+/**
+ * Stuff a datagram read off of our socket into the buffer list for its packet type
+ */
+void psnet_top_layer_buffer(ubyte *data, int read_len, SOCKADDR_IN *ip_addr)
+{
+	net_addr	from_addr;
+
+	// need at least the packet type
+	if ( read_len < 1 ) {
+		return;
+	}
+
+	// set the from_addr for storage into the packet buffer structure
+	from_addr.type = Socket_type;
+	from_addr.port = ntohs( ip_addr->sin_port );			
+	memset(from_addr.addr, 0x00, 6);
+	memcpy(from_addr.addr, &ip_addr->sin_addr.s_addr, 4); //-V512
+
+	// determine the packet type
+	int packet_type = data[0];	
+	Assertion(((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)), "Invalid packet_type found. Packet type %d does not exist", packet_type);
+	if((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)){
+		// buffer the packet
+		psnet_buffer_packet(&Psnet_top_buffers[packet_type], data + 1, read_len - 1, &from_addr);
+	}
+}
+
 /**
  * Call this once per frame to read everything off of our socket
  */
 void PSNET_TOP_LAYER_PROCESS()
 {
+	if ( Network_status != NETWORK_STATUS_RUNNING ) {
+		ml_string("Network ==> socket not inited in PSNET_TOP_LAYER_PROCESS");
+		return;
+	}
+
+	Assert(Socket_type == NET_TCP);
+	if ( Socket_type != NET_TCP ) {
+		return;
+	}
+
+	// get anything still queued up out the door first
+	psnet_send_flush();
+
+#if SCP_HAVE_RECVMMSG
+	int idx, count;
+
+	while ( 1 ) {
+		// the kernel overwrites these with the real address lengths
+		for ( idx = 0; idx < PSNET_MMSG_BATCH; idx++ ) {
+			Psnet_recv_msgs[idx].msg_hdr.msg_namelen = sizeof(SOCKADDR_IN);
+		}
+
+		count = recvmmsg( Unreliable_socket, Psnet_recv_msgs, PSNET_MMSG_BATCH, MSG_DONTWAIT, nullptr );
+		Psnet_stats.recv_syscalls++;
+
+		if ( count == SOCKET_ERROR ) {
+			if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) ) {
+				ml_printf("Error %d doing a batched socket read", errno);
+			}
+			return;
+		}
+
+		for ( idx = 0; idx < count; idx++ ) {
+			psnet_top_layer_buffer( Psnet_recv_ring[idx].data, (int)Psnet_recv_msgs[idx].msg_len, &Psnet_recv_addrs[idx] );
+		}
+		Psnet_stats.recv_packets += count;
+
+		// a partial batch means the socket is drained
+		if ( count < PSNET_MMSG_BATCH ) {
+			return;
+		}
+	}
+#else
 	// read socket stuff
 	SOCKADDR_IN ip_addr;				// UDP/TCP socket structure
 	fd_set	rfds;
 	timeval	timeout;
 	int		read_len;
    socklen_t from_len;
-	net_addr	from_addr;	
 	network_naked_packet packet_read;		
 
 	// clear the addresses to remove compiler warnings
 	memset(&ip_addr, 0, sizeof(SOCKADDR_IN));
 
-	if ( Network_status != NETWORK_STATUS_RUNNING ) {
-		ml_string("Network ==> socket not inited in PSNET_TOP_LAYER_PROCESS");
-		return;
-	}
-
 	while ( 1 ) {		
 		// check if there is any data on the socket to be read.  The amount of data that can be 
 		// atomically read is stored in len.
@@ -378,6 +498,7 @@ void PSNET_TOP_LAYER_PROCESS()
 		timeout.tv_sec = 0;
 		timeout.tv_usec = 0;
 
+		Psnet_stats.recv_syscalls++;
 		if ( select( static_cast<int>(Unreliable_socket + 1), &rfds, nullptr, nullptr, &timeout) == SOCKET_ERROR ) {
 			ml_printf("Error %d doing a socket select on read", WSAGetLastError());
 			break;
@@ -389,47 +510,19 @@ void PSNET_TOP_LAYER_PROCESS()
 		}
 
 		// get data off the socket and process
-		read_len = SOCKET_ERROR;
-		switch ( Socket_type ) {
-		case NET_TCP:
-			from_len = sizeof(SOCKADDR_IN);			
-			read_len = recvfrom( Unreliable_socket, (char*)packet_read.data, MAX_TOP_LAYER_PACKET_SIZE, 0,  (SOCKADDR*)&ip_addr, &from_len);
-			break;
-		
-		default:
-			Assert(0);
-			return;
-		}
-
-		// set the from_addr for storage into the packet buffer structure
-		from_addr.type = Socket_type;
-
-		switch ( Socket_type ) {
-		case NET_TCP:			
-			from_addr.port = ntohs( ip_addr.sin_port );			
-			memset(from_addr.addr, 0x00, 6);
-			memcpy(from_addr.addr, &ip_addr.sin_addr.s_addr, 4); //-V512
-			break;
-
-		default:
-			Assert(0);
-			return;
-			// break;
-		}
+		from_len = sizeof(SOCKADDR_IN);			
+		read_len = recvfrom( Unreliable_socket, (char*)packet_read.data, MAX_TOP_LAYER_PACKET_SIZE, 0,  (SOCKADDR*)&ip_addr, &from_len);
+		Psnet_stats.recv_syscalls++;
 
 		if ( read_len == SOCKET_ERROR ) {
 			ml_string("Socket error on socket_get_data()");
 			break;
 		}		
 
-		// determine the packet type
-		int packet_type = packet_read.data[0];	
-		Assertion(((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)), "Invalid packet_type found. Packet type %d does not exist", packet_type);
-		if((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)){
-			// buffer the packet
-			psnet_buffer_packet(&Psnet_top_buffers[packet_type], packet_read.data + 1, read_len - 1, &from_addr);
-		}
+		psnet_top_layer_buffer( packet_read.data, read_len, &ip_addr );
+		Psnet_stats.recv_packets++;
 	}
+#endif
 }
 
 
@@ -539,6 +632,8 @@ void psnet_init( int  /*protocol*/, int port_num )
 		for(idx=0; idx<PSNET_NUM_TYPES; idx++){
 			psnet_buffer_init(&Psnet_top_buffers[idx]);
 		}
+
+		psnet_mmsg_init();
 	}
 }
 
@@ -551,6 +646,9 @@ void psnet_close()
 		return;
 	}
 
+	// get out anything (ie, a leave game packet) still queued up
+	psnet_send_flush();
+
 #ifdef _WIN32
 	WSACancelBlockingCall();		
 
@@ -768,6 +866,104 @@ int psnet_same( net_addr * a1, net_addr * a2 )
 	return !memcmp(a1->addr, a2->addr, 6) && a1->port == a2->port;
 }
 
+#if SCP_HAVE_SENDMMSG
+/**
+ * Queue up an unreliable datagram for the next psnet_send_flush()
+ */
+int psnet_send_queue( SOCKADDR_IN *to, ubyte *data, int len )
+{
+	psnet_send_packet *packet;
+
+	Assert( (len > 0) && (len <= MAX_TOP_LAYER_PACKET_SIZE) );
+	if ( (len <= 0) || (len > MAX_TOP_LAYER_PACKET_SIZE) ) {
+		return SOCKET_ERROR;
+	}
+
+	// make room if we have to
+	if ( Psnet_send_count >= PSNET_MMSG_BATCH ) {
+		psnet_send_flush();
+	}
+
+	packet = &Psnet_send_ring[Psnet_send_count];
+	packet->addr = *to;
+	packet->data[0] = PSNET_TYPE_UNRELIABLE;
+	memcpy( &packet->data[1], data, len );
+	Psnet_send_iovs[Psnet_send_count].iov_len = len + 1;
+	Psnet_send_count++;
+
+	return len + 1;
+}
+#endif
+
+/**
+ * Send everything queued up by psnet_send()
+ */
+void psnet_send_flush()
+{
+#if SCP_HAVE_SENDMMSG
+	int sent = 0;
+	int ret;
+
+	if ( Network_status != NETWORK_STATUS_RUNNING ) {
+		Psnet_send_count = 0;
+		return;
+	}
+
+	while ( sent < Psnet_send_count ) {
+		ret = sendmmsg( Unreliable_socket, &Psnet_send_msgs[sent], Psnet_send_count - sent, MSG_DONTWAIT );
+		Psnet_stats.send_syscalls++;
+
+		// this is all unreliable data, so whatever doesn't fit into the socket buffer right now gets dropped
+		if ( ret == SOCKET_ERROR ) {
+			if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) ) {
+				ml_printf("Error %d doing a batched socket send", errno);
+			}
+			break;
+		}
+
+		Psnet_stats.send_packets += ret;
+		sent += ret;
+	}
+
+	Psnet_send_count = 0;
+#endif
+}
+
+/**
+ * Point the batched i/o headers at their ring buffers
+ */
+void psnet_mmsg_init()
+{
+#if SCP_HAVE_RECVMMSG || SCP_HAVE_SENDMMSG
+	int idx;
+#endif
+
+#if SCP_HAVE_RECVMMSG
+	memset(Psnet_recv_msgs, 0, sizeof(Psnet_recv_msgs));
+	for ( idx = 0; idx < PSNET_MMSG_BATCH; idx++ ) {
+		Psnet_recv_iovs[idx].iov_base = Psnet_recv_ring[idx].data;
+		Psnet_recv_iovs[idx].iov_len = MAX_TOP_LAYER_PACKET_SIZE;
+		Psnet_recv_msgs[idx].msg_hdr.msg_name = &Psnet_recv_addrs[idx];
+		Psnet_recv_msgs[idx].msg_hdr.msg_namelen = sizeof(SOCKADDR_IN);
+		Psnet_recv_msgs[idx].msg_hdr.msg_iov = &Psnet_recv_iovs[idx];
+		Psnet_recv_msgs[idx].msg_hdr.msg_iovlen = 1;
+	}
+#endif
+
+#if SCP_HAVE_SENDMMSG
+	memset(Psnet_send_msgs, 0, sizeof(Psnet_send_msgs));
+	for ( idx = 0; idx < PSNET_MMSG_BATCH; idx++ ) {
+		Psnet_send_iovs[idx].iov_base = Psnet_send_ring[idx].data;
+		Psnet_send_iovs[idx].iov_len = 0;
+		Psnet_send_msgs[idx].msg_hdr.msg_name = &Psnet_send_ring[idx].addr;
+		Psnet_send_msgs[idx].msg_hdr.msg_namelen = sizeof(SOCKADDR_IN);
+		Psnet_send_msgs[idx].msg_hdr.msg_iov = &Psnet_send_iovs[idx];
+		Psnet_send_msgs[idx].msg_hdr.msg_iovlen = 1;
+	}
+	Psnet_send_count = 0;
+#endif
+}
+
 /**
  * Send data unreliably
  */
@@ -813,11 +1009,18 @@ int psnet_send( net_addr * who_to, void * data, int len, int np_index )
 	send_data = (ubyte*)data;
 	send_len = len;
 
+#if SCP_HAVE_SENDMMSG
+	// queued sends go out through psnet_send_flush(), which doesn't need the socket to be writable right now
+	(void)send_sock;
+	(void)wfds;
+	(void)timeout;
+#else
 	FD_ZERO(&wfds);
 	FD_SET( send_sock, &wfds );
 	timeout.tv_sec = 0;
 	timeout.tv_usec = 0;
 
+	Psnet_stats.send_syscalls++;
 	if ( SELECT( static_cast<int>(send_sock+1), nullptr, &wfds, nullptr, &timeout, PSNET_TYPE_UNRELIABLE) == SOCKET_ERROR ) {
 		ml_printf("Error on blocking select for write %d", WSAGetLastError() );
 		return 0;
@@ -827,6 +1030,7 @@ int psnet_send( net_addr * who_to, void * data, int len, int np_index )
 	if ( !FD_ISSET(send_sock, &wfds ) ){
 		return 0;
 	}
+#endif
 
 	ret = SOCKET_ERROR;
 	switch ( who_to->type ) {
@@ -837,7 +1041,15 @@ int psnet_send( net_addr * who_to, void * data, int len, int np_index )
 
 			multi_rate_add(np_index, "udp(h)", send_len + UDP_HEADER_SIZE);
 			multi_rate_add(np_index, "udp", send_len);
+#if SCP_HAVE_SENDMMSG
+			ret = psnet_send_queue( &sockaddr, send_data, send_len );
+#else
 			ret = SENDTO( send_sock, (char *)send_data, send_len, 0, (SOCKADDR*)&sockaddr, sizeof(sockaddr), PSNET_TYPE_UNRELIABLE );
+			Psnet_stats.send_syscalls++;
+			if ( ret != SOCKET_ERROR ) {
+				Psnet_stats.send_packets++;
+			}
+#endif
 			break;
 
 		default:
@@ -1785,19 +1997,11 @@ void psnet_buffer_init(network_packet_buffer_list *l)
  */
 void psnet_buffer_packet(network_packet_buffer_list *l, ubyte *data, int length, net_addr *from)
 {
-	int idx;
-	int found_buf = 0;
-	
-	// find the first empty packet
-	for(idx=0;idx<MAX_PACKET_BUFFERS;idx++){
-		if(l->psnet_buffers[idx].sequence_number == -1){
-			found_buf = 1;
-			break;
-		}
-	}
+	// buffers are used as a ring in sequence # order, so the next one is free unless all of them are in use
+	int idx = psnet_buffer_index(l->psnet_seq_number);
 
 	// if we didn't find the buffer, report an overrun
-	if(!found_buf){
+	if(l->psnet_buffers[idx].sequence_number != -1){
 		ml_string("WARNING - Buffer overrun in psnet");
 	} else {
 		// copy in the data
@@ -1807,7 +2011,8 @@ void psnet_buffer_packet(network_packet_buffer_list *l, ubyte *data, int length,
 		l->psnet_buffers[idx].sequence_number = l->psnet_seq_number;
 		
 		// keep track of the highest id#
-		l->psnet_highest_id = l->psnet_seq_number++;
+		l->psnet_highest_id = l->psnet_seq_number;
+		l->psnet_seq_number = psnet_buffer_next_id(l->psnet_seq_number);
 
 		// set the lowest id# for the first time
 		if(l->psnet_lowest_id == -1){
@@ -1822,24 +2027,14 @@ void psnet_buffer_packet(network_packet_buffer_list *l, ubyte *data, int length,
 int psnet_buffer_get_next(network_packet_buffer_list *l, ubyte *data, int *length, net_addr *from)
 {	
 	int idx;
-	int found_buf = 0;
 
 	// if there are no buffers, do nothing
-	if((l->psnet_lowest_id == -1) || (l->psnet_lowest_id > l->psnet_highest_id)){
+	if(psnet_buffer_empty(l)){
 		return 0;
 	}
 
-	// search until we find the lowest packet index id#
-	for(idx=0;idx<MAX_PACKET_BUFFERS;idx++){
-		// if we found the buffer
-		if(l->psnet_buffers[idx].sequence_number == l->psnet_lowest_id){
-			found_buf = 1;
-			break;
-		}
-	}
-
-	// at this point, we should _always_ have found the buffer
-	Assert(found_buf);	
+	// the lowest packet index id# is always where the ring puts it
+	idx = psnet_buffer_index(l->psnet_lowest_id);
 	
 	// copy out the buffer data
 	memcpy(data, l->psnet_buffers[idx].data, l->psnet_buffers[idx].len);
@@ -1850,7 +2045,7 @@ int psnet_buffer_get_next(network_packet_buffer_list *l, ubyte *data, int *lengt
 
 	// mark the buffer as free
 	l->psnet_buffers[idx].sequence_number = -1;
-	l->psnet_lowest_id++;
+	l->psnet_lowest_id = psnet_buffer_next_id(l->psnet_lowest_id);
 
 	return 1;
 }
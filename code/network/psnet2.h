@@ -104,6 +104,16 @@ extern ushort Psnet_default_port;
 
 extern SOCKET Unreliable_socket;	// all PXO API modules should use this to send and receive on
 
+// socket i/o counters for the unreliable socket
+typedef struct psnet_stats {
+	uint	recv_syscalls;				// syscalls made reading (or polling) the socket
+	uint	recv_packets;				// datagrams read
+	uint	send_syscalls;				// syscalls made writing (or polling) the socket
+	uint	send_packets;				// datagrams written
+} psnet_stats;
+
+extern psnet_stats Psnet_stats;
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 TOP LAYER FUNCTIONS - these functions simply buffer and store packets based upon type (see PSNET_TYPE_* defines)
 //
@@ -153,6 +163,9 @@ int psnet_same( net_addr * a1, net_addr * a2 );
 // send data unreliably
 int psnet_send( net_addr * who_to, void * data, int len, int np_index = -1 );
 
+// push out any unreliable data psnet_send() has queued up
+void psnet_send_flush();
+
 // get data from the unreliable socket
 int psnet_get( void * data, net_addr * from_addr );
 
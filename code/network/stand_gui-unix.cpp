@@ -362,6 +362,7 @@ struct LogResource {
 
 SDL_mutex *webapi_dataMutex = SDL_CreateMutex();
 netgame_info webapi_netgameInfo;
+psnet_stats webapi_netStats;
 std::map<short, net_player> webapiNetPlayers;
 float webui_fps;
 float webui_missiontime;
@@ -498,6 +499,16 @@ json_t* netgameInfoGet(ResourceContext * /*context*/) {
     return obj;
 }
 
+json_t* netstatsGet(ResourceContext * /*context*/) {
+    json_t *obj = json_object();
+
+    json_object_set_new(obj, "recvSyscalls", json_integer(webapi_netStats.recv_syscalls));
+    json_object_set_new(obj, "recvPackets", json_integer(webapi_netStats.recv_packets));
+    json_object_set_new(obj, "sendSyscalls", json_integer(webapi_netStats.send_syscalls));
+    json_object_set_new(obj, "sendPackets", json_integer(webapi_netStats.send_packets));
+    return obj;
+}
+
 json_t* missionGet(ResourceContext * /*context*/) {
     json_t *fpsEntity = json_object();
 
@@ -576,6 +587,7 @@ json_t* playerGet(ResourceContext * /*context*/) {
         json_object_set(obj, "id", json_integer(p.player_id));
         json_object_set(obj, "address", json_string(address));
         json_object_set(obj, "ping", json_integer(p.s_info.ping.ping_avg));
+        json_object_set(obj, "bandwidth", json_integer(p.s_info.oo_bandwidth));
         json_object_set(obj, "host", (MULTI_HOST(p)) ? json_true() : json_false());
         json_object_set(obj, "observer", (MULTI_OBSERVER(p)) ? json_true() : json_false());
         json_object_set(obj, "callsign", json_string(p.m_player->callsign));
@@ -690,6 +702,7 @@ struct Resource resources[] = {
     { "api/1/server/refreshMissions", "GET", &refreshMissions },
     { "api/1/server/resetGame", "GET", &serverResetGame },
     { "api/1/netgameInfo", "GET", &netgameInfoGet },
+    { "api/1/netstats", "GET", &netstatsGet },
     { "api/1/mission", "GET", &missionGet },
     { "api/1/mission/goals", "GET", &missionGoalsGet },
     { "api/1/player", "GET", &playerGet },
@@ -892,6 +905,7 @@ void std_do_gui_frame() {
     SDL_mutexP(webapi_dataMutex);
 
     webapi_netgameInfo = Netgame;
+    webapi_netStats = Psnet_stats;
 
     // Update player data
     webapiNetPlayers.clear();
@@ -372,10 +372,10 @@ int ship_ship_check_collision(collision_info_struct *ship_ship_hit_info, vec3d *
 #endif
 
 		// Update ai to deal with collisions
-		if (heavy_obj-Objects == Ai_info[light_shipp->ai_index].target_objnum) {
+		if (OBJ_INDEX(heavy_obj) == Ai_info[light_shipp->ai_index].target_objnum) {
 			Ai_info[light_shipp->ai_index].ai_flags.set(AI::AI_Flags::Target_collision);
 		}
-		if (light_obj-Objects == Ai_info[heavy_shipp->ai_index].target_objnum) {
+		if (OBJ_INDEX(light_obj) == Ai_info[heavy_shipp->ai_index].target_objnum) {
 			Ai_info[heavy_shipp->ai_index].ai_flags.set(AI::AI_Flags::Target_collision);
 		}
 
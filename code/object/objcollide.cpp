@@ -44,10 +44,10 @@ public:
 	{}
 };
 
-SCP_unordered_map<uint, collider_pair> Collision_cached_pairs;
+SCP_unordered_map<uint64_t, collider_pair> Collision_cached_pairs;
 
 class checkobject;
-extern checkobject CheckObjects[MAX_OBJECTS];
+extern SCP_vector<checkobject> CheckObjects;
 
 // returns true if we should reject object pair if one is child of other.
 int reject_obj_pair_on_parent(object *A, object *B)
@@ -466,7 +466,7 @@ int collide_predict_large_ship(object *objp, float distance)
 
 #define CRW_MAX_TO_DELETE	4
 
-char crw_status[MAX_WEAPONS];
+static SCP_vector<char> crw_status;
 
 void crw_check_weapon( int weapon_num, int collide_next_check )
 {
@@ -482,7 +482,8 @@ void crw_check_weapon( int weapon_num, int collide_next_check )
 int collide_remove_weapons( )
 {
 	// setup remove_weapon array.  assume we can remove it.
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	crw_status.resize(Weapons.size());
+	for (int i = 0; i < weapons_size(); i++ ) {
 		if ( Weapons[i].objnum == -1 )
 			crw_status[i] = CRW_NO_OBJECT;
 		else
@@ -516,7 +517,7 @@ int collide_remove_weapons( )
 
 	// for each weapon which could be removed, delete the object
 	int num_deleted = 0;
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	for (int i = 0; i < weapons_size(); i++ ) {
 		if ( crw_status[i] == CRW_CAN_DELETE ) {
 			Assert( Weapons[i].objnum != -1 );
 			obj_delete( Weapons[i].objnum );
@@ -535,7 +536,7 @@ int collide_remove_weapons( )
 		for (int j = 0; j < CRW_MAX_TO_DELETE; j++ ) {
 			float oldest_time = 1000.0f;
 			int oldest_index = -1;
-			for (int i = 0; i < MAX_WEAPONS; i++ ) {
+			for (int i = 0; i < weapons_size(); i++ ) {
 				if ( Weapons[i].objnum == -1 )			// shouldn't happen, but this is the safe thing to do.
 					continue;
 				if ( ((loop_count || crw_status[i] == CRW_NO_PAIR)) && (Weapons[i].lifeleft < oldest_time) ) {
@@ -864,14 +865,17 @@ void obj_collide_pair(object *A, object *B)
     }
 
     bool valid = false;
-    uint key = (OBJ_INDEX(A) << 12) + OBJ_INDEX(B);
+    // the object pool can grow past MAX_OBJECTS, so both indices get their own 32 bits
+    uint64_t key = (static_cast<uint64_t>(OBJ_INDEX(A)) << 32) | static_cast<uint32_t>(OBJ_INDEX(B));
 
     collider_pair* collision_info = &Collision_cached_pairs[key];
 
     if ( collision_info->initialized ) {
-        // make sure we're referring to the correct objects in case the original pair was deleted
-        if ( collision_info->signature_a == collision_info->a->signature &&
-             collision_info->signature_b == collision_info->b->signature ) {
+        // make sure the entry belongs to this pair and we're referring to the correct objects in case the original
+        // pair was deleted
+        if ( collision_info->a == A && collision_info->b == B &&
+             collision_info->signature_a == A->signature &&
+             collision_info->signature_b == B->signature ) {
             valid = true;
         } else {
             collision_info->a = A;
@@ -29,6 +29,7 @@
 #include "object/object.h"
 #include "object/objectdock.h"
 #include "object/objectshield.h"
+#include "object/objectsnapshot.h"
 #include "object/objectsnd.h"
 #include "observer/observer.h"
 #include "scripting/scripting.h"
@@ -60,10 +61,13 @@ object *Player_obj = NULL;
 object *Viewer_obj = NULL;
 
 //Data for objects
-object Objects[MAX_OBJECTS];
+util::chunked_pool<object, OBJ_POOL_CHUNK_SIZE> Objects;
+
+// how many slots of Objects are linked into the free and used lists, Fred only gets the first MAX_OBJECTS
+static int Obj_num_slots = 0;
 
 #ifdef OBJECT_CHECK 
-checkobject CheckObjects[MAX_OBJECTS];
+SCP_vector<checkobject> CheckObjects;
 #endif
 
 int Num_objects=-1;
@@ -164,10 +168,10 @@ void object::clear()
 int free_object_slots(int num_used)
 {
 	int	i, olind, deleted_weapons;
-	int	obj_list[MAX_OBJECTS];
 	int	num_already_free, num_to_free, original_num_to_free;
 	object *objp;
 
+	SCP_vector<int> obj_list(Obj_num_slots);
 	olind = 0;
 
 	// calc num_already_free by walking the obj_free_list
@@ -175,19 +179,19 @@ int free_object_slots(int num_used)
 	for ( objp = GET_FIRST(&obj_free_list); objp != END_OF_LIST(&obj_free_list); objp = GET_NEXT(objp) )
 		num_already_free++;
 
-	if (MAX_OBJECTS - num_already_free < num_used)
+	if (Obj_num_slots - num_already_free < num_used)
 		return 0;
 
 	for ( objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
 		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
 			num_already_free++;
-			if (MAX_OBJECTS - num_already_free < num_used)
+			if (Obj_num_slots - num_already_free < num_used)
 				return num_already_free;
 		} else
 			switch (objp->type) {
 				case OBJ_NONE:
 					num_already_free++;
-					if (MAX_OBJECTS - num_already_free < num_used)
+					if (Obj_num_slots - num_already_free < num_used)
 						return 0;
 					break;
 				case OBJ_FIREBALL:
@@ -216,7 +220,7 @@ int free_object_slots(int num_used)
 
 	}
 
-	num_to_free = MAX_OBJECTS - num_used - num_already_free;
+	num_to_free = Obj_num_slots - num_used - num_already_free;
 	original_num_to_free = num_to_free;
 
 	if (num_to_free > olind) {
@@ -324,9 +328,9 @@ float get_shield_pct(object *objp)
 
 static void on_script_state_destroy(lua_State*) {
 	// Since events are mostly used for scripting, we clear the event handlers when the Lua state is destroyed
-	for (auto& obj : Objects) {
-		obj.pre_move_event.clear();
-		obj.post_move_event.clear();
+	for (int i = 0; i < Objects.size(); ++i) {
+		Objects[i].pre_move_event.clear();
+		Objects[i].post_move_event.clear();
 	}
 }
 
@@ -336,22 +340,34 @@ static void on_script_state_destroy(lua_State*) {
 void obj_init()
 {
 	int i;
-	object *objp;
 	
 	Object_inited = 1;
-	for (i = 0; i < MAX_OBJECTS; ++i)
+
+	// start out with room for MAX_OBJECTS, the pool keeps whatever it grew to in earlier missions
+	while (Objects.size() < MAX_OBJECTS) {
+		Objects.grow();
+	}
+
+	// Fred's dialogs have arrays of MAX_OBJECTS, so it can't use any more than that
+	Obj_num_slots = (Fred_running) ? MAX_OBJECTS : Objects.size();
+
+	for (i = 0; i < Objects.size(); ++i)
 		Objects[i].clear();
 	Viewer_obj = NULL;
 
+	obj_snapshot_clear();
+
+#ifdef OBJECT_CHECK
+	CheckObjects.resize(Objects.size());
+#endif
+
 	list_init( &obj_free_list );
 	list_init( &obj_used_list );
 	list_init( &obj_create_list );
 
 	// Link all object slots into the free list
-	objp = Objects;
-	for (i=0; i<MAX_OBJECTS; i++)	{
-		list_append(&obj_free_list, objp);
-		objp++;
+	for (i=0; i<Obj_num_slots; i++)	{
+		list_append(&obj_free_list, &Objects[i]);
 	}
 
 	Object_next_signature = 1;	//0 is invalid, others start at 1
@@ -365,13 +381,46 @@ void obj_init()
 
 void obj_shutdown()
 {
-	for (auto& obj : Objects) {
-		obj.clear();
+	for (int i = 0; i < Objects.size(); ++i) {
+		Objects[i].clear();
 	}
 }
 
 static int num_objects_hwm = 0;
 
+/**
+ * Adds another chunk of slots to Objects and links them into the free list
+ *
+ * @return false if the pool can't grow, which is always the case in Fred
+ */
+static bool obj_grow_slots()
+{
+	if (Fred_running) {
+		return false;
+	}
+
+	int first = Objects.grow();
+
+	if (first < 0) {
+		return false;
+	}
+
+	for (int i = first; i < Objects.size(); ++i) {
+		Objects[i].clear();
+		list_append(&obj_free_list, &Objects[i]);
+	}
+
+	Obj_num_slots = Objects.size();
+
+#ifdef OBJECT_CHECK
+	CheckObjects.resize(Objects.size());
+#endif
+
+	nprintf(("Objects", "Grew the object pool to %d slots\n", Obj_num_slots));
+
+	return true;
+}
+
 /** 
  * Allocates an object
  *
@@ -391,14 +440,15 @@ int obj_allocate(void)
 		obj_init();
 	}
 
-	if ( Num_objects >= MAX_OBJECTS-10 ) {
+	// running low on slots, make some more.  only if that's not possible do we start getting rid of things
+	if ( (Num_objects >= Obj_num_slots-10) && !obj_grow_slots() ) {
 		int	num_freed;
 
-		num_freed = free_object_slots(MAX_OBJECTS-10);
+		num_freed = free_object_slots(Obj_num_slots-10);
 		nprintf(("warning", " *** Freed %i objects\n", num_freed));
 	}
 
-	if (Num_objects >= MAX_OBJECTS) {
+	if (Num_objects >= Obj_num_slots) {
 		#ifndef NDEBUG
 		mprintf(("Object creation failed - too many objects!\n" ));
 		#endif
@@ -534,7 +584,7 @@ int obj_create(ubyte type,int parent_obj,int instance, matrix * orient,
 void obj_delete_all() 
 {
 	int counter = 0;
-	for (int i = 0; i < MAX_OBJECTS; ++i) 
+	for (int i = 0; i < Objects.size(); ++i) 
 	{
 		if (Objects[i].type == OBJ_NONE)
 			continue;
@@ -543,6 +593,8 @@ void obj_delete_all()
 	}
 
 	mprintf(("Cleanup: Deleted %i objects\n", counter));
+
+	obj_snapshot_clear();
 }
 
 /**
@@ -555,7 +607,7 @@ void obj_delete(int objnum)
 {
 	object *objp;
 
-	Assert(objnum >= 0 && objnum < MAX_OBJECTS);
+	Assert(objnum >= 0 && objnum < Objects.size());
 	objp = &Objects[objnum];
 	if (objp->type == OBJ_NONE) {
 		mprintf(("obj_delete() called for already deleted object %d.\n", objnum));
@@ -1578,6 +1630,9 @@ void obj_move_all(float frametime)
 	// update artillery locking info now
 	ship_update_artillery_lock();
 
+	// everything has moved, the next read-only consumer gets a fresh copy
+	obj_snapshot_invalidate();
+
 //	mprintf(("moved all objects\n"));
 }
 
@@ -1632,7 +1687,7 @@ void obj_queue_render(object* obj, model_draw_list* scene)
 	switch ( obj->type ) {
 	case OBJ_NONE:
 #ifndef NDEBUG
-		mprintf(( "ERROR!!!! Bogus obj " PTRDIFF_T_ARG " is rendering!\n", obj-Objects ));
+		mprintf(( "ERROR!!!! Bogus obj %d is rendering!\n", OBJ_INDEX(obj) ));
 		Int3();
 #endif
 		break;
@@ -1832,7 +1887,7 @@ int obj_team(object *objp)
 			break;
 */
 		case OBJ_WEAPON:
-			Assert( objp->instance >= 0 && objp->instance < MAX_WEAPONS );
+			Assert( objp->instance >= 0 && objp->instance < weapons_size() );
 			team = Weapons[objp->instance].team;
 			break;
 
@@ -1876,8 +1931,8 @@ void obj_reset_all_collisions()
 {
 	// clear checkobjects
 #ifndef NDEBUG
-    for (int i = 0; i < MAX_OBJECTS; ++i) {
-        CheckObjects[i] = checkobject();
+    for (auto& check : CheckObjects) {
+        check = checkobject();
     }
 #endif
 
@@ -17,6 +17,7 @@
 #include "math/vecmat.h"
 #include "object/object_flags.h"
 #include "physics/physics.h"
+#include "utils/chunked_pool.h"
 #include "utils/event.h"
 
 #include <functional>
@@ -198,7 +199,10 @@ extern int Show_waypoints;
 extern int Object_next_signature;		
 extern int Num_objects;
 
-extern object Objects[];
+// slots are added in chunks, so pointers to objects stay valid when the pool grows
+#define OBJ_POOL_CHUNK_SIZE		1024
+
+extern util::chunked_pool<object, OBJ_POOL_CHUNK_SIZE> Objects;
 extern int Highest_object_index;		//highest objnum
 extern int Highest_ever_object_index;
 extern object obj_free_list;
@@ -206,16 +210,23 @@ extern object obj_used_list;
 extern object obj_create_list;
 
 extern int render_total;
-extern int render_order[MAX_OBJECTS];
 
 extern object *Viewer_obj;	// Which object is the viewer. Can be NULL.
 extern object *Player_obj;	// Which object is the player. Has to be valid.
 
 // Use this instead of "objp - Objects" to get an object number
-// given it's pointer.  This way, we can replace it with a macro
-// to check that the pointer is valid for debugging.
-// This code will break in 64 bit builds when we have more than 2^31 objects but that will probably never happen
-#define OBJ_INDEX(objp) (int)(objp-Objects)
+// given it's pointer.  Objects isn't one contiguous array anymore,
+// so pointer arithmetic doesn't work; this returns -1 for a pointer
+// which isn't a slot of Objects.
+#define OBJ_INDEX(objp) Objects.index_of(objp)
+
+/**
+ * @brief The number of object slots, every valid object number is less than this
+ */
+inline int objects_size()
+{
+	return Objects.size();
+}
 
 /*
  *		FUNCTIONS
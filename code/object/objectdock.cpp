@@ -392,10 +392,10 @@ void dock_evaluate_all_docked_objects(object *objp, dock_function_info *infop, v
 	else
 	{
 		// create a bit array to mark the objects we check
-		ubyte *visited_bitstring = (ubyte *) vm_malloc(calculate_num_bytes(MAX_OBJECTS));
+		ubyte *visited_bitstring = (ubyte *) vm_malloc(calculate_num_bytes(objects_size()));
 
 		// clear it
-		memset(visited_bitstring, 0, calculate_num_bytes(MAX_OBJECTS));
+		memset(visited_bitstring, 0, calculate_num_bytes(objects_size()));
 
 		// start evaluating the tree
 		dock_evaluate_tree(objp, infop, function, visited_bitstring);
@@ -0,0 +1,228 @@
+
+#include "object/objectsnapshot.h"
+
+#include "debris/debris.h"
+#include "globalincs/linklist.h"
+#include "globalincs/systemvars.h"
+#include "iff_defs/iff_defs.h"
+#include "object/object.h"
+#include "ship/ship.h"
+#include "tracing/tracing.h"
+#include "weapon/weapon.h"
+
+#include <algorithm>
+
+const float object_snapshot::CELL_SIZE = 1000.0f;
+
+namespace {
+
+object_snapshot Object_snapshot;
+
+// set when objects have moved since the snapshot was taken
+bool Object_snapshot_stale = true;
+
+// Cell coordinates are packed into 21 bits each. Cells which are 2^21 cells apart share a key, which only means that a
+// query looks at a few more objects than it has to.
+const int CELL_BITS = 21;
+const uint64_t CELL_MASK = (uint64_t(1) << CELL_BITS) - 1;
+
+inline int cell_coord(float value) {
+	return static_cast<int>(floorf(value / object_snapshot::CELL_SIZE));
+}
+
+inline uint64_t cell_key(int x, int y, int z) {
+	return ((static_cast<uint64_t>(x) & CELL_MASK) << (2 * CELL_BITS)) |
+	       ((static_cast<uint64_t>(y) & CELL_MASK) << CELL_BITS) | (static_cast<uint64_t>(z) & CELL_MASK);
+}
+
+// same as obj_team() but without the assertions, not every object in the list has a team
+int snapshot_team(object* objp) {
+	switch (objp->type) {
+	case OBJ_SHIP:
+		return Ships[objp->instance].team;
+	case OBJ_WEAPON:
+		return Weapons[objp->instance].team;
+	case OBJ_DEBRIS:
+		return debris_get_team(objp);
+	case OBJ_ASTEROID:
+		return Iff_traitor;
+	default:
+		return -1;
+	}
+}
+
+}
+
+void object_snapshot::clear() {
+	_objnum.clear();
+	_signature.clear();
+	_type.clear();
+	_flags.clear();
+	_team.clear();
+
+	_pos_x.clear();
+	_pos_y.clear();
+	_pos_z.clear();
+	_vel_x.clear();
+	_vel_y.clear();
+	_vel_z.clear();
+	_radius.clear();
+	_hull_pct.clear();
+
+	_cells.clear();
+	_large.clear();
+
+	_frame = -1;
+}
+
+size_t object_snapshot::add(int objnum, int signature, int type, const flagset<Object::Object_Flags>& flags, int team,
+                            const vec3d& pos, const vec3d& vel, float radius, float hull_pct) {
+	_objnum.push_back(objnum);
+	_signature.push_back(signature);
+	_type.push_back(type);
+	_flags.push_back(flags);
+	_team.push_back(team);
+
+	_pos_x.push_back(pos.xyz.x);
+	_pos_y.push_back(pos.xyz.y);
+	_pos_z.push_back(pos.xyz.z);
+	_vel_x.push_back(vel.xyz.x);
+	_vel_y.push_back(vel.xyz.y);
+	_vel_z.push_back(vel.xyz.z);
+	_radius.push_back(radius);
+	_hull_pct.push_back(hull_pct);
+
+	return _objnum.size() - 1;
+}
+
+void object_snapshot::build_index() {
+	_cells.clear();
+	_large.clear();
+
+	for (size_t i = 0; i < size(); ++i) {
+		// an object in the grid may reach at most half a cell into its neighbors, see query_sphere()
+		if (_radius[i] > CELL_SIZE * 0.5f) {
+			_large.push_back(static_cast<int>(i));
+			continue;
+		}
+
+		cell_entry entry;
+		entry.cell = cell_key(cell_coord(_pos_x[i]), cell_coord(_pos_y[i]), cell_coord(_pos_z[i]));
+		entry.index = static_cast<int>(i);
+		_cells.push_back(entry);
+	}
+
+	std::sort(_cells.begin(), _cells.end(), [](const cell_entry& left, const cell_entry& right) {
+		return left.cell < right.cell || (left.cell == right.cell && left.index < right.index);
+	});
+}
+
+void object_snapshot::query_sphere(const vec3d& center, float radius, SCP_vector<int>& out) const {
+	auto overlaps = [&](int i) {
+		float dx = _pos_x[i] - center.xyz.x;
+		float dy = _pos_y[i] - center.xyz.y;
+		float dz = _pos_z[i] - center.xyz.z;
+		float max_dist = radius + _radius[i];
+
+		return dx * dx + dy * dy + dz * dz <= max_dist * max_dist;
+	};
+
+	for (auto i : _large) {
+		if (overlaps(i)) {
+			out.push_back(i);
+		}
+	}
+
+	float reach = radius + CELL_SIZE * 0.5f;
+
+	int min_x = cell_coord(center.xyz.x - reach);
+	int min_y = cell_coord(center.xyz.y - reach);
+	int min_z = cell_coord(center.xyz.z - reach);
+	int max_x = cell_coord(center.xyz.x + reach);
+	int max_y = cell_coord(center.xyz.y + reach);
+	int max_z = cell_coord(center.xyz.z + reach);
+
+	double num_cells = double(max_x - min_x + 1) * double(max_y - min_y + 1) * double(max_z - min_z + 1);
+
+	// looking up that many cells would be slower than checking every object
+	if (num_cells > double(_cells.size())) {
+		for (const auto& entry : _cells) {
+			if (overlaps(entry.index)) {
+				out.push_back(entry.index);
+			}
+		}
+		return;
+	}
+
+	for (int x = min_x; x <= max_x; ++x) {
+		for (int y = min_y; y <= max_y; ++y) {
+			for (int z = min_z; z <= max_z; ++z) {
+				auto key = cell_key(x, y, z);
+				auto iter = std::lower_bound(_cells.begin(), _cells.end(), key,
+				                             [](const cell_entry& entry, uint64_t value) { return entry.cell < value; });
+
+				for (; iter != _cells.end() && iter->cell == key; ++iter) {
+					if (overlaps(iter->index)) {
+						out.push_back(iter->index);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool object_snapshot::valid(size_t i) const {
+	int objnum = _objnum[i];
+
+	if (objnum < 0 || objnum >= objects_size()) {
+		return false;
+	}
+
+	return Objects[objnum].signature == _signature[i] && Objects[objnum].type != OBJ_NONE;
+}
+
+namespace {
+
+void obj_snapshot_build() {
+	TRACE_SCOPE(tracing::ObjectSnapshot);
+
+	Object_snapshot.clear();
+
+	for (auto objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
+			continue;
+		}
+
+		float hull_pct = 0.0f;
+		if (objp->type == OBJ_SHIP) {
+			hull_pct = get_hull_pct(objp);
+		}
+
+		Object_snapshot.add(OBJ_INDEX(objp), objp->signature, objp->type, objp->flags, snapshot_team(objp), objp->pos,
+		                    objp->phys_info.vel, objp->radius, hull_pct);
+	}
+
+	Object_snapshot.build_index();
+	Object_snapshot.set_frame(Framecount);
+}
+
+}
+
+void obj_snapshot_invalidate() {
+	Object_snapshot_stale = true;
+}
+
+void obj_snapshot_clear() {
+	Object_snapshot.clear();
+	Object_snapshot_stale = true;
+}
+
+const object_snapshot& obj_snapshot() {
+	// most frames nobody asks for it, so it's only taken once it's needed
+	if (Object_snapshot_stale) {
+		obj_snapshot_build();
+		Object_snapshot_stale = false;
+	}
+
+	return Object_snapshot;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "object/object_flags.h"
+
+class object;
+
+/**
+ * @brief A read-only copy of the state of all objects, taken at most once per frame
+ *
+ * Every field is stored in its own array so code which only needs a few of them (e.g. positions and teams) can scan
+ * all objects without touching Objects, Ships or Ship_info. The snapshot is only taken when it is first asked for after
+ * obj_move_all(), so during obj_move_all() some objects may already have moved further. The object of an entry may have
+ * died or been replaced since the snapshot was taken, check that with valid() before touching Objects.
+ *
+ * Objects are also sorted into a coarse grid, query_sphere() uses that to only look at the objects near a point.
+ */
+class object_snapshot {
+	SCP_vector<int> _objnum;
+	SCP_vector<int> _signature;
+	SCP_vector<int> _type;
+	SCP_vector<flagset<Object::Object_Flags>> _flags;
+	SCP_vector<int> _team;
+
+	SCP_vector<float> _pos_x;
+	SCP_vector<float> _pos_y;
+	SCP_vector<float> _pos_z;
+	SCP_vector<float> _vel_x;
+	SCP_vector<float> _vel_y;
+	SCP_vector<float> _vel_z;
+	SCP_vector<float> _radius;
+	SCP_vector<float> _hull_pct;
+
+	// spatial index, sorted by cell so the entries of one cell are next to each other
+	struct cell_entry {
+		uint64_t cell;
+		int index;
+	};
+	SCP_vector<cell_entry> _cells;
+	// objects too large to be found through the cell of their center
+	SCP_vector<int> _large;
+
+	int _frame = -1;
+
+ public:
+	// size of the grid cells of the spatial index
+	static const float CELL_SIZE;
+
+	void clear();
+
+	/**
+	 * @brief Adds an object, the spatial index has to be rebuilt afterwards
+	 * @return The index of the new entry
+	 */
+	size_t add(int objnum, int signature, int type, const flagset<Object::Object_Flags>& flags, int team,
+	           const vec3d& pos, const vec3d& vel, float radius, float hull_pct);
+
+	void build_index();
+
+	/**
+	 * @brief Finds all objects which overlap a sphere
+	 *
+	 * @param center The center of the sphere
+	 * @param radius The radius of the sphere, the radius of the objects is added to this
+	 * @param out Receives the indices of the matching entries, in no particular order. Not cleared before adding.
+	 */
+	void query_sphere(const vec3d& center, float radius, SCP_vector<int>& out) const;
+
+	/**
+	 * @brief Checks if the object of an entry is still the one which was copied
+	 */
+	bool valid(size_t i) const;
+
+	inline size_t size() const { return _objnum.size(); }
+	inline int frame() const { return _frame; }
+	inline void set_frame(int frame) { _frame = frame; }
+
+	inline int objnum(size_t i) const { return _objnum[i]; }
+	inline int signature(size_t i) const { return _signature[i]; }
+	inline int type(size_t i) const { return _type[i]; }
+	inline const flagset<Object::Object_Flags>& flags(size_t i) const { return _flags[i]; }
+	// -1 for objects without a team
+	inline int team(size_t i) const { return _team[i]; }
+	inline float radius(size_t i) const { return _radius[i]; }
+	// only valid for ships, 0 for everything else
+	inline float hull_pct(size_t i) const { return _hull_pct[i]; }
+
+	inline vec3d pos(size_t i) const {
+		vec3d pos;
+		pos.xyz.x = _pos_x[i];
+		pos.xyz.y = _pos_y[i];
+		pos.xyz.z = _pos_z[i];
+		return pos;
+	}
+	inline vec3d vel(size_t i) const {
+		vec3d vel;
+		vel.xyz.x = _vel_x[i];
+		vel.xyz.y = _vel_y[i];
+		vel.xyz.z = _vel_z[i];
+		return vel;
+	}
+};
+
+/**
+ * @brief Marks the snapshot as out of date, called by obj_move_all() once everything has moved
+ */
+void obj_snapshot_invalidate();
+
+/**
+ * @brief Empties the snapshot, e.g. when a mission ends
+ */
+void obj_snapshot_clear();
+
+/**
+ * @brief The snapshot of the objects, copied from them on the first call after they moved
+ */
+const object_snapshot& obj_snapshot();
@@ -22,6 +22,7 @@
 #include "ship/ship.h"
 #include "sound/ds.h"
 #include "sound/ds3d.h"
+#include "sound/voicemanager.h"
 #include "species_defs/species_defs.h"
 
 
@@ -58,6 +59,18 @@ static	int		Doppler_enabled = TRUE;
 #define	MAX_OBJ_SNDS	256
 obj_snd	Objsnds[MAX_OBJ_SNDS];
 
+// where each sound is during the current update, filled in by obj_snd_do_frame()
+typedef struct obj_snd_frame_info {
+	vec3d	source_pos;
+	float	add_distance;
+} obj_snd_frame_info;
+
+static obj_snd_frame_info Objsnd_frame_info[MAX_OBJ_SNDS];
+
+// the 3 loudest playing sounds are updated every time, the others every second time
+// sounds quieter than 0.1 don't start, but keep playing until they are out of range
+static sound::VoiceManager Obj_snd_voices(3, 2, 0.1f);
+
 int		Obj_snd_enabled = TRUE;
 int		Obj_snd_last_update;							// timer used to run object sound updates at fixed time intervals
 int		Obj_snd_level_inited=0;
@@ -136,6 +149,7 @@ DCF(objsnd, "Persistent sound stuff" )
 		} // end for
 
 		dc_printf("Number object-linked sounds playing: %d\n", Num_obj_sounds_playing);
+		dc_printf("Number object-linked sounds updated last time: %d\n", Obj_snd_voices.numUpdated());
 		return;
 	}
 
@@ -299,58 +313,6 @@ void obj_snd_stop_all()
 	}
 }
 
-/**
- * Stop a playing object sound, if it is quieter than sound at new_distance
- *
- * @param new_vol Volume of requested sound to play
- *
- * @return 1 A sound was stopped 
- * @return 0 A sound was not stopped
- */
-int obj_snd_stop_lowest_vol(float new_vol)
-{
-	obj_snd			*osp;
-	object			*objp = NULL;
-	obj_snd			*lowest_vol_osp = NULL;
-	float				lowest_vol;
-	int obj_snd_index = -1;
-	
-	lowest_vol = 1000.0f;
-	for ( osp = GET_FIRST(&obj_snd_list); osp !=END_OF_LIST(&obj_snd_list); osp = GET_NEXT(osp) ) {
-		Assert(osp->objnum != -1);
-		objp = &Objects[osp->objnum];
-
-		if ((osp->instance.isValid()) && (osp->vol < lowest_vol)) {
-			lowest_vol = osp->vol;
-			lowest_vol_osp = osp;
-		}
-	}
-
-	if (lowest_vol_osp != NULL)
-        objp = &Objects[lowest_vol_osp->objnum];
-
-	if ( (lowest_vol < new_vol) && (objp != NULL) ) {
-		int idx = 0;
-		// determine what index in this guy the sound is
-		for(SCP_vector<int>::iterator iter = objp->objsnd_num.begin(); iter != objp->objsnd_num.end(); ++iter, ++idx){
-			if(*iter == (lowest_vol_osp - Objsnds)){
-				obj_snd_index = idx;
-				break;
-			}
-		}
-
-		if((obj_snd_index == -1) || (obj_snd_index >= (int) objp->objsnd_num.size())){
-			Int3();		// get dave
-		} else {
-			obj_snd_stop(objp, obj_snd_index);
-		}
-
-		return TRUE;
-	}
-	
-	return FALSE;
-}
-
 //int Debug_1 = 0, Debug_2 = 0;
 
 // ---------------------------------------------------------------------------------------
@@ -427,21 +389,203 @@ void maybe_play_flyby_snd(float closest_dist, object *closest_objp, object *list
 	}
 }
 
+// ---------------------------------------------------------------------------------------
+// obj_snd_update()
+//
+// Set volume, position and velocity of a playing persistent sound
+//
+static void obj_snd_update(obj_snd *osp)
+{
+	float				speed_vol_multiplier, rot_vol_mult, percent_max, alive_vol_mult;
+	object			*objp;
+	game_snd			*gs;
+	ship				*sp;
+	int				channel;
+	obj_snd_frame_info *info = &Objsnd_frame_info[osp - Objsnds];
+
+	objp = &Objects[osp->objnum];
+	gs = gamesnd_get_game_sound(osp->id);
+
+	// If the object is a ship, we don't want to start the engine sound unless the ship is
+	// moving (unless flag SIF_BIG_SHIP is set)
+	speed_vol_multiplier = 1.0f;
+	rot_vol_mult = 1.0f;
+	alive_vol_mult = 1.0f;
+	if ( objp->type == OBJ_SHIP ) {
+		ship_info *sip = &Ship_info[Ships[objp->instance].ship_info_index];
+		if ( !(sip->is_big_or_huge()) ) {
+			if ( objp->phys_info.max_vel.xyz.z <= 0.0f ) {
+				percent_max = 0.0f;
+			}
+			else
+				percent_max = objp->phys_info.fspeed / objp->phys_info.max_vel.xyz.z;
+
+			if ( sip->min_engine_vol == -1.0f) {
+				// Retail behavior: volume ramps from 0.5 (when stationary) to 1.0 (when at half speed)
+				if ( percent_max >= 0.5f ) {
+					speed_vol_multiplier = 1.0f;
+				} else {
+					speed_vol_multiplier = 0.5f + (percent_max);	// linear interp: 0.5->1.0 when 0.0->0.5
+				}
+			} else {
+				// Volume ramps from min_engine_vol (when stationary) to 1.0 (when at full speed)
+				speed_vol_multiplier = sip->min_engine_vol + ((1.0f - sip->min_engine_vol) * percent_max);
+			}
+		}
+		if (osp->ss != NULL)
+		{
+			if (osp->flags & OS_TURRET_BASE_ROTATION)
+			{
+				if (osp->ss->base_rotation_rate_pct > 0.0f)
+					rot_vol_mult = ((0.25f + (0.75f * osp->ss->base_rotation_rate_pct)) * osp->ss->system_info->turret_base_rotation_snd_mult);
+				else
+					rot_vol_mult = 0.0f;
+			}
+			if (osp->flags & OS_TURRET_GUN_ROTATION)
+			{
+				if (osp->ss->gun_rotation_rate_pct > 0.0f)
+					rot_vol_mult = ((0.25f + (0.75f * osp->ss->gun_rotation_rate_pct)) * osp->ss->system_info->turret_gun_rotation_snd_mult);
+				else
+					rot_vol_mult = 0.0f;
+			}
+			if (osp->flags & OS_SUBSYS_ROTATION )
+			{
+				if (osp->ss->flags[Ship::Subsystem_Flags::Rotates]) {
+					rot_vol_mult = 1.0f;
+				} else {
+					rot_vol_mult = 0.0f;
+				}
+			}
+			if (osp->flags & OS_SUBSYS_ALIVE)
+			{
+				if (osp->ss->current_hits > 0.0f) {
+					alive_vol_mult = 1.0f;
+				} else {
+					alive_vol_mult = 0.0f;
+				}
+			}
+			if (osp->flags & OS_SUBSYS_DEAD)
+			{
+				if (osp->ss->current_hits <= 0.0f) {
+					alive_vol_mult = 1.0f;
+				} else {
+					alive_vol_mult = 0.0f;
+				}
+			}
+			if (osp->flags & OS_SUBSYS_DAMAGED)
+			{
+				alive_vol_mult = osp->ss->current_hits / osp->ss->max_hits;
+				CLAMP(alive_vol_mult, 0.0f, 1.0f);
+			}
+
+		}
+	}
+
+	sp = NULL;
+	if ( objp->type == OBJ_SHIP )
+		sp = &Ships[objp->instance];
+
+
+	channel = ds_get_channel(osp->instance);
+	// for DirectSound3D sounds, re-establish the maximum speed based on the
+	//	speed_vol_multiplier
+	if ( sp == NULL || ( (sp != NULL) && (sp->flags[Ship::Ship_Flags::Engines_on]) ) ) {
+		snd_set_volume( osp->instance, gs->volume_range.next() *speed_vol_multiplier*rot_vol_mult*alive_vol_mult );
+	}
+	else {
+		// engine sound is disabled
+		snd_set_volume( osp->instance, 0.0f );
+	}
+
+	vec3d vel = objp->phys_info.vel;
+
+	// Don't play doppler effect for cruisers or capitals
+	if ( sp ) {
+		if ( Ship_info[sp->ship_info_index].is_big_or_huge() ) {
+			vel = vmd_zero_vector;
+		}
+	}
+
+	ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), &info->source_pos, &vel);
+	snd_get_3d_vol_and_pan(gs, &info->source_pos, &osp->vol, &osp->pan, info->add_distance);
+}
+
+// Lets Obj_snd_voices start, stop and update the persistent sounds, which are identified by their index in Objsnds[]
+class ObjSndVoiceBackend : public sound::IVoiceBackend {
+  public:
+	bool startVoice(int id) override
+	{
+		obj_snd *osp = &Objsnds[id];
+		object *objp = &Objects[osp->objnum];
+		obj_snd_frame_info *info = &Objsnd_frame_info[id];
+
+		switch( objp->type ) {
+			case OBJ_SHIP:
+			case OBJ_DEBRIS:
+			case OBJ_ASTEROID:
+				break;
+
+			default:
+				Int3();	// get Alan
+				return false;
+		} // end switch
+
+		osp->instance = snd_play_3d(gamesnd_get_game_sound(osp->id), &info->source_pos, &View_position, info->add_distance, &objp->phys_info.vel, 1, 1.0f, SND_PRIORITY_TRIPLE_INSTANCE, NULL, 1.0f, 0, true);
+		if (!osp->instance.isValid()) {
+			return false;
+		}
+
+		Num_obj_sounds_playing++;
+		Assert(Num_obj_sounds_playing <= MAX_OBJ_SOUNDS_PLAYING);
+		return true;
+	}
+
+	void stopVoice(int id) override
+	{
+		obj_snd *osp = &Objsnds[id];
+		object *objp = &Objects[osp->objnum];
+		int sound_index = -1;
+		int idx = 0;
+
+		// determine which sound index it is for this guy
+		for(SCP_vector<int>::iterator iter = objp->objsnd_num.begin(); iter != objp->objsnd_num.end(); ++iter, ++idx){
+			if(*iter == id){
+				sound_index = idx;
+				break;
+			}
+		}
+
+		if (sound_index == -1) {
+			Int3();		// get dave
+			return;
+		}
+
+		obj_snd_stop(objp, sound_index);
+	}
+
+	void updateVoice(int id) override
+	{
+		obj_snd_update(&Objsnds[id]);
+	}
+};
+
 // ---------------------------------------------------------------------------------------
 // obj_snd_do_frame()
 //
 // Called once per frame to process the persistent sound objects
 //
+// Every sound in range is handed to Obj_snd_voices with its volume at the current distance, which picks the loudest
+// ones to play and stops the others.
+//
 void obj_snd_do_frame()
 {
-	float				closest_dist, distance, speed_vol_multiplier, rot_vol_mult, percent_max, alive_vol_mult;
+	float				closest_dist, distance;
 	obj_snd			*osp;
 	object			*objp, *closest_objp;
 	game_snd			*gs;
-	ship				*sp;
-	int				channel, go_ahead_flag;
-	vec3d			source_pos;
 	float				add_distance;
+	int				playing_added;
+	ObjSndVoiceBackend	backend;
 
 	if ( Obj_snd_enabled == FALSE )
 		return;
@@ -466,6 +610,9 @@ void obj_snd_do_frame()
 		observer_obj = Player_obj;
 	}
 
+	Obj_snd_voices.begin();
+	playing_added = 0;
+
 	for ( osp = GET_FIRST(&obj_snd_list); osp !=END_OF_LIST(&obj_snd_list); osp = GET_NEXT(osp) ) {
 		Assert(osp != NULL);
 		objp = &Objects[osp->objnum];
@@ -475,15 +622,17 @@ void obj_snd_do_frame()
 		}
 
 		gs = gamesnd_get_game_sound(osp->id);
+		obj_snd_frame_info *info = &Objsnd_frame_info[osp - Objsnds];
 
-		obj_snd_source_pos(&source_pos, osp);
-		distance = vm_vec_dist_quick( &source_pos, &View_position );
+		obj_snd_source_pos(&info->source_pos, osp);
+		distance = vm_vec_dist_quick( &info->source_pos, &View_position );
 
 		// how much extra distance do we add before attentuation?
 		add_distance = 0.0f;
 		if(osp->flags & OS_MAIN){
 			add_distance = objp->radius;
 		}
+		info->add_distance = add_distance;
 
 		distance -= add_distance;
 		if ( distance < 0.0f ) {
@@ -498,172 +647,33 @@ void obj_snd_do_frame()
 			}
 		}
 
-		// If the object is a ship, we don't want to start the engine sound unless the ship is
-		// moving (unless flag SIF_BIG_SHIP is set)
-		speed_vol_multiplier = 1.0f;
-		rot_vol_mult = 1.0f;
-		alive_vol_mult = 1.0f;
-		if ( objp->type == OBJ_SHIP ) {
-			ship_info *sip = &Ship_info[Ships[objp->instance].ship_info_index];
-			if ( !(sip->is_big_or_huge()) ) {
-				if ( objp->phys_info.max_vel.xyz.z <= 0.0f ) {
-					percent_max = 0.0f;
-				}
-				else
-					percent_max = objp->phys_info.fspeed / objp->phys_info.max_vel.xyz.z;
-
-				if ( sip->min_engine_vol == -1.0f) {
-					// Retail behavior: volume ramps from 0.5 (when stationary) to 1.0 (when at half speed)
-					if ( percent_max >= 0.5f ) {
-						speed_vol_multiplier = 1.0f;
-					} else {
-						speed_vol_multiplier = 0.5f + (percent_max);	// linear interp: 0.5->1.0 when 0.0->0.5
-					}
-				} else {
-					// Volume ramps from min_engine_vol (when stationary) to 1.0 (when at full speed)
-					speed_vol_multiplier = sip->min_engine_vol + ((1.0f - sip->min_engine_vol) * percent_max);
-				}
-			}
-			if (osp->ss != NULL)
-			{
-				if (osp->flags & OS_TURRET_BASE_ROTATION)
-				{
-					if (osp->ss->base_rotation_rate_pct > 0.0f)
-						rot_vol_mult = ((0.25f + (0.75f * osp->ss->base_rotation_rate_pct)) * osp->ss->system_info->turret_base_rotation_snd_mult);
-					else
-						rot_vol_mult = 0.0f;
-				}
-				if (osp->flags & OS_TURRET_GUN_ROTATION)
-				{
-					if (osp->ss->gun_rotation_rate_pct > 0.0f)
-						rot_vol_mult = ((0.25f + (0.75f * osp->ss->gun_rotation_rate_pct)) * osp->ss->system_info->turret_gun_rotation_snd_mult);
-					else
-						rot_vol_mult = 0.0f;
-				}
-				if (osp->flags & OS_SUBSYS_ROTATION )
-				{
-					if (osp->ss->flags[Ship::Subsystem_Flags::Rotates]) {
-						rot_vol_mult = 1.0f;
-					} else {
-						rot_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_ALIVE)
-				{
-					if (osp->ss->current_hits > 0.0f) {
-						alive_vol_mult = 1.0f;
-					} else {
-						alive_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_DEAD)
-				{
-					if (osp->ss->current_hits <= 0.0f) {
-						alive_vol_mult = 1.0f;
-					} else {
-						alive_vol_mult = 0.0f;
-					}
-				}
-				if (osp->flags & OS_SUBSYS_DAMAGED)
-				{
-					alive_vol_mult = osp->ss->current_hits / osp->ss->max_hits;
-					CLAMP(alive_vol_mult, 0.0f, 1.0f);
-				}
+		bool playing = osp->instance.isValid();
+		float new_vol;
 
+		// a sound which isn't playing yet starts inside its max range, one which plays stops once it is past it
+		if ( (!playing && distance >= gs->max) || (playing && distance > gs->max) ) {
+			new_vol = -1.0f;
+		} else {
+			float max_vol = gs->volume_range.max();
+			if ( distance <= gs->min ) {
+				new_vol = max_vol;
 			}
-		}
-
-		go_ahead_flag = TRUE;
-		float max_vol,new_vol;
-		if (!osp->instance.isValid()) {
-			if ( distance < gs->max ) {
-				max_vol = gs->volume_range.max();
-				if ( distance <= gs->min ) {
-					new_vol = max_vol;
-				}
-				else {
-					new_vol = max_vol - (distance - gs->min) * max_vol
-						/ (gs->max - gs->min);
-				}
-
-				if ( new_vol < 0.1f ) {
-					continue;
-				}
-
-				switch( objp->type ) {
-					case OBJ_SHIP:
-					case OBJ_DEBRIS:
-					case OBJ_ASTEROID:
-						if ( Num_obj_sounds_playing >= MAX_OBJ_SOUNDS_PLAYING ) {
-							go_ahead_flag = obj_snd_stop_lowest_vol(new_vol);
-						}
-						break;
-
-					default:
-						Int3();	// get Alan
-						break;
-				} // end switch
-
-				if ( go_ahead_flag ) {
-					osp->instance = snd_play_3d(gs, &source_pos, &View_position, add_distance, &objp->phys_info.vel, 1, 1.0f, SND_PRIORITY_TRIPLE_INSTANCE, NULL, 1.0f, 0, true);
-					if (osp->instance.isValid()) {
-						Num_obj_sounds_playing++;
-					}
-				}
-				Assert(Num_obj_sounds_playing <= MAX_OBJ_SOUNDS_PLAYING);
-
-			} // 		end if ( distance < Snds[osp->id].max )
-		} // 		if ( osp->instance == -1 )
-		else {
-			if ( distance > gamesnd_get_game_sound(osp->id)->max ) {
-				int sound_index = -1;
-				int idx = 0;
-
-				// determine which sound index it is for this guy
-				for(SCP_vector<int>::iterator iter = objp->objsnd_num.begin(); iter != objp->objsnd_num.end(); ++iter, ++idx){
-					if(*iter == (osp - Objsnds)){
-						sound_index = idx;
-						break;
-					}
-				}
-
-				Assert(sound_index != -1);
-				obj_snd_stop(objp, sound_index);						// currently playing sound has gone past maximum
+			else {
+				new_vol = max_vol - (distance - gs->min) * max_vol
+					/ (gs->max - gs->min);
 			}
 		}
 
-		if (!osp->instance.isValid())
-			continue;
-
-		sp = NULL;
-		if ( objp->type == OBJ_SHIP )
-			sp = &Ships[objp->instance];
-
-
-		channel = ds_get_channel(osp->instance);
-		// for DirectSound3D sounds, re-establish the maximum speed based on the
-		//	speed_vol_multiplier
-		if ( sp == NULL || ( (sp != NULL) && (sp->flags[Ship::Ship_Flags::Engines_on]) ) ) {
-			snd_set_volume( osp->instance, gs->volume_range.next() *speed_vol_multiplier*rot_vol_mult*alive_vol_mult );
-		}
-		else {
-			// engine sound is disabled
-			snd_set_volume( osp->instance, 0.0f );
-		}
-
-		vec3d vel = objp->phys_info.vel;
+		Obj_snd_voices.add((int)(osp - Objsnds), new_vol, playing);
 
-		// Don't play doppler effect for cruisers or capitals
-		if ( sp ) {
-			if ( Ship_info[sp->ship_info_index].is_big_or_huge() ) {
-				vel = vmd_zero_vector;
-			}
+		if ( playing ) {
+			playing_added++;
 		}
-
-		ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), &source_pos, &vel);
-		snd_get_3d_vol_and_pan(gs, &source_pos, &osp->vol, &osp->pan, add_distance);
 	}	// end for
 
+	// sounds which weren't added above keep their voices
+	Obj_snd_voices.run(backend, MAX(0, MAX_OBJ_SOUNDS_PLAYING - (Num_obj_sounds_playing - playing_added)));
+
 	// see if we want to play a flyby sound
 	maybe_play_flyby_snd(closest_dist, closest_objp, observer_obj);
 }
@@ -683,7 +693,7 @@ void obj_snd_do_frame()
 //
 int obj_snd_assign(int objnum, gamesnd_id sndnum, vec3d *pos, int main, int flags, ship_subsys *associated_sub)
 {
-	if(objnum < 0 || objnum > MAX_OBJECTS)
+	if(objnum < 0 || objnum >= objects_size())
 		return -1;
 
 	if(!sndnum.isValid())
@@ -759,7 +769,7 @@ int obj_snd_assign(int objnum, gamesnd_id sndnum, vec3d *pos, int main, int flag
 void obj_snd_delete(int objnum, int index)
 {
 	//Sanity checking
-	Assert(objnum > -1 && objnum < MAX_OBJECTS);
+	Assert(objnum > -1 && objnum < objects_size());
 
 	object *objp = &Objects[objnum];
 	
@@ -793,7 +803,7 @@ void	obj_snd_delete_type(int objnum, gamesnd_id sndnum, ship_subsys *ss)
 	object	*objp;
 	obj_snd	*osp;
 
-	if(objnum < 0 || objnum >= MAX_OBJECTS)
+	if(objnum < 0 || objnum >= objects_size())
 		return;
 
 	objp = &Objects[objnum];
@@ -180,9 +180,8 @@ void obj_render_all(const std::function<void(object*)>& render_function, bool *d
 	int i;
 	float fog_near, fog_far;
 
-	objp = Objects;
-
-	for (i=0;i<=Highest_object_index;i++,objp++) {
+	for (i=0;i<=Highest_object_index;i++) {
+		objp = &Objects[i];
 		if ( (objp->type != OBJ_NONE) && (objp->flags[Object::Object_Flags::Renders]) )	{
             objp->flags.remove(Object::Object_Flags::Was_rendered);
 
@@ -307,15 +306,14 @@ void obj_render_queue_all()
 	int i;
 	model_draw_list scene;
 
-	objp = Objects;
-
 	gr_deferred_lighting_begin();
 
 	scene.init();
 
 	bool full_neb = is_full_nebula();
 
-	for ( i = 0; i <= Highest_object_index; i++,objp++ ) {
+	for ( i = 0; i <= Highest_object_index; i++ ) {
+		objp = &Objects[i];
 		if ( (objp->type != OBJ_NONE) && ( objp->flags [Object::Object_Flags::Renders] ) )	{
             objp->flags.remove(Object::Object_Flags::Was_rendered);
 
@@ -16,12 +16,14 @@
 
 #include <cctype>
 #include "globalincs/version.h"
+#include "io/timer.h"
 #include "localization/fhash.h"
 #include "localization/localize.h"
 #include "mission/missionparse.h"
 #include "parse/encrypt.h"
 #include "parse/parselo.h"
 #include "parse/sexp.h"
+#include "parse/tablecache.h"
 #include "ship/ship.h"
 #include "weapon/weapon.h"
 #include "mod_table/mod_table.h"
@@ -31,6 +33,9 @@
 
 #include <utf8.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace parse;
 
 
@@ -59,6 +64,24 @@ SCP_vector<Bookmark> Bookmarks;	// Stack of all our previously paused parsing
 void allocate_parse_text(size_t size);
 static size_t Parse_text_size = 0;
 
+// upper limit on the threads processing tables, reading the files on the main thread can't keep up with more
+#define PARSE_PREPARE_MAX_THREADS	8
+
+// A table read and processed by parse_prepare_tables(), read_file_text() hands this out instead of reading the file.
+// Each one has its own buffers so the workers never touch Parse_text or any other parse state.
+typedef struct prepared_table {
+	SCP_string			filename;
+	SCP_vector<char>	raw_text;
+	SCP_vector<char>	processed_text;
+	bool				cached;
+	std::uint64_t		read_us;
+	std::uint64_t		process_us;
+} prepared_table;
+
+static SCP_vector<prepared_table> Prepared_tables;
+
+static bool read_prepared_table(const char *filename);
+
 
 //	Return true if this character is white space, else false.
 int is_white_space(char ch)
@@ -2033,17 +2056,166 @@ void read_file_text(const char *filename, int mode, char *processed_text, char *
 		Error(LOCATION, "ERROR: Neither processed_text nor raw_text may be NULL when parsing is paused!!\n");
 	}
 
+	// the cache only knows how big the default buffers are
+	bool use_cache = (processed_text == NULL) && (raw_text == NULL);
+
+	if (use_cache && (mode == CF_TYPE_TABLES) && read_prepared_table(filename))
+		return;
+
+	auto start = timer_get_microseconds();
+
 	// read the raw text
 	read_raw_file_text(filename, mode, raw_text);
 
+	auto read_done = timer_get_microseconds();
+
 	if (processed_text == NULL)
 		processed_text = Parse_text;
 
 	if (raw_text == NULL)
 		raw_text = Parse_text_raw;
 
+	if (mode == CF_TYPE_TABLES)
+		table_hash_add(filename, raw_text);
+
 	// process it (strip comments)
-	process_raw_file_text(processed_text, raw_text);
+	bool cached = use_cache && table_cache_load(raw_text, processed_text, Parse_text_size);
+	if (!cached) {
+		process_raw_file_text(processed_text, raw_text);
+
+		if (use_cache)
+			table_cache_save(raw_text, processed_text);
+	}
+
+	table_report_add_read(filename, read_done - start, timer_get_microseconds() - read_done, cached);
+}
+
+static void prepare_table(const SCP_string &filename, prepared_table &table)
+{
+	auto start = timer_get_microseconds();
+
+	// the raw text is read through the normal path since cfile and the encoding warnings belong to the main thread
+	read_raw_file_text(filename.c_str(), CF_TYPE_TABLES);
+
+	auto raw_len = strlen(Parse_text_raw);
+
+	table.filename = filename;
+	table.raw_text.assign(Parse_text_raw, Parse_text_raw + raw_len + 1);
+	// converting foreign characters may make the text a bit longer, as may terminating the last line
+	auto sharp_s = std::count(table.raw_text.begin(), table.raw_text.end(), SHARP_S);
+	table.processed_text.assign(raw_len + sharp_s + 2, '\0');
+	table.cached = table_cache_load(table.raw_text.data(), table.processed_text.data(), table.processed_text.size());
+	table.read_us = timer_get_microseconds() - start;
+	table.process_us = 0;
+}
+
+void parse_prepare_tables()
+{
+	SCP_vector<SCP_string> filenames;
+	SCP_vector<SCP_string> list;
+
+	for (auto ext : { ".tbl", ".tbm" }) {
+		SCP_string filter = "*";
+		filter += ext;
+
+		list.clear();
+		cf_get_file_list(list, CF_TYPE_TABLES, filter.c_str());
+
+		for (auto &name : list) {
+			filenames.push_back(name + ext);
+		}
+	}
+
+	auto start = timer_get_microseconds();
+
+	parse_release_prepared_tables();
+	Prepared_tables.reserve(filenames.size());
+
+	for (auto &filename : filenames) {
+		prepared_table table;
+
+		try {
+			prepare_table(filename, table);
+		} catch (const parse::ParseException &) {
+			// read_file_text() will run into the same error and report it properly
+			continue;
+		}
+
+		Prepared_tables.push_back(std::move(table));
+	}
+
+	auto read_done = timer_get_microseconds();
+
+	// the workers take the next table which isn't cached and process it into its own buffers
+	std::atomic<size_t> next(0);
+
+	auto worker = [&next]() {
+		size_t i;
+		while ((i = next++) < Prepared_tables.size()) {
+			auto &table = Prepared_tables[i];
+
+			if (table.cached)
+				continue;
+
+			auto process_start = timer_get_microseconds();
+			process_raw_file_text(table.processed_text.data(), table.raw_text.data());
+			table.process_us = timer_get_microseconds() - process_start;
+		}
+	};
+
+	int num_threads = (int)std::thread::hardware_concurrency() - 1;
+	CLAMP(num_threads, 0, PARSE_PREPARE_MAX_THREADS - 1);
+
+	SCP_vector<std::thread> threads;
+	for (int i = 0; i < num_threads; i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (auto &thread : threads)
+		thread.join();
+
+	for (auto &table : Prepared_tables) {
+		if (!table.cached)
+			table_cache_save(table.raw_text.data(), table.processed_text.data());
+	}
+
+	mprintf(("Prepared %d tables in %.2f ms (reading %.2f ms, processing on %d threads %.2f ms)\n", (int)Prepared_tables.size(),
+		(timer_get_microseconds() - start) / 1000.0, (read_done - start) / 1000.0, num_threads + 1,
+		(timer_get_microseconds() - read_done) / 1000.0));
+}
+
+void parse_release_prepared_tables()
+{
+	Prepared_tables.clear();
+	Prepared_tables.shrink_to_fit();
+}
+
+// copies a prepared table into Parse_text, every table is only handed out once
+static bool read_prepared_table(const char *filename)
+{
+	auto it = std::find_if(Prepared_tables.begin(), Prepared_tables.end(), [filename](const prepared_table &table) {
+		return !stricmp(table.filename.c_str(), filename);
+	});
+
+	if (it == Prepared_tables.end())
+		return false;
+
+	auto start = timer_get_microseconds();
+
+	auto raw_len = strlen(it->raw_text.data());
+	auto processed_len = strlen(it->processed_text.data());
+
+	allocate_parse_text(MAX(raw_len, processed_len) + 1);
+	memcpy(Parse_text_raw, it->raw_text.data(), raw_len + 1);
+	memcpy(Parse_text, it->processed_text.data(), processed_len + 1);
+
+	table_hash_add(filename, Parse_text_raw);
+	table_report_add_read(filename, it->read_us + (timer_get_microseconds() - start), it->process_us, it->cached);
+
+	Prepared_tables.erase(it);
+
+	return true;
 }
 
 // Goober5000
@@ -4316,7 +4488,10 @@ int parse_modular_table(const char *name_check, void (*parse_callback)(const cha
 			tbl_file_names[i] += ext;
 		}
 		mprintf(("TBM  =>  Starting parse of '%s' ...\n", tbl_file_names[i].c_str()));
+
+		auto start = timer_get_microseconds();
 		(*parse_callback)(tbl_file_names[i].c_str());
+		table_report_add_parse(tbl_file_names[i].c_str(), timer_get_microseconds() - start);
 	}
 
 	Parsing_modular_table = false;
@@ -263,6 +263,10 @@ extern void read_file_text(const char *filename, int mode = CF_TYPE_ANY, char *p
 extern void read_file_text_from_default(const default_file& file, char *processed_text = NULL, char *raw_text = NULL);
 extern void read_raw_file_text(const char *filename, int mode = CF_TYPE_ANY, char *raw_text = NULL);
 extern void process_raw_file_text(char *processed_text = NULL, char *raw_text = NULL);
+// reads and processes all tables up front, using worker threads for the processing, see read_file_text()
+extern void parse_prepare_tables();
+// frees the prepared tables which haven't been parsed
+extern void parse_release_prepared_tables();
 extern void debug_show_mission_text();
 extern void convert_sexp_to_string(SCP_string &dest, int cur_node, int mode);
 extern size_t maybe_convert_foreign_characters(const char *in, char *out, bool add_null = true);
@@ -862,9 +862,11 @@ int Training_context_goal_waypoint;
 int Training_context_at_waypoint;
 float	Training_context_distance;
 
-#define SEXP_NODE_INCREMENT	250
 int Num_sexp_nodes = 0;
-sexp_node *Sexp_nodes = NULL;
+util::chunked_pool<sexp_node, SEXP_NODE_INCREMENT> Sexp_nodes;
+
+// no node below this one is free, so find_free_sexp() doesn't have to start at the beginning every time
+static int First_free_sexp_hint = 0;
 
 sexp_variable Sexp_variables[MAX_SEXP_VARIABLES];
 sexp_variable Block_variables[MAX_SEXP_VARIABLES];			// used for compatibility with retail. 
@@ -1098,7 +1100,9 @@ int arg_item::is_empty()
 
 void sexp_nodes_init()
 {
-	if (Num_sexp_nodes == 0 || Sexp_nodes == NULL)
+	First_free_sexp_hint = 0;
+
+	if (Num_sexp_nodes == 0)
 		return;
 
 	nprintf(("SEXP", "Reinitializing sexp nodes...\n"));
@@ -1116,11 +1120,7 @@ void sexp_nodes_init()
 			Sexp_nodes[i].type = SEXP_NOT_USED;			// it's not needed
 
 		// free anything cached
-		if (Sexp_nodes[i].cache)
-		{
-			delete Sexp_nodes[i].cache;
-			Sexp_nodes[i].cache = nullptr;
-		}
+		Sexp_nodes[i].cache.clear();
 	}
 
 	nprintf(("SEXP", "Last persistent node index is %d.\n", last_persistent_node));
@@ -1128,19 +1128,15 @@ void sexp_nodes_init()
 	// if all the persistent nodes are gone, free all the nodes
 	if (last_persistent_node == -1)
 	{
-		vm_free(Sexp_nodes);
-		Sexp_nodes = NULL;
+		Sexp_nodes.shrink(0);
 		Num_sexp_nodes = 0;
 	}
 	// if there's enough of a difference to make it worthwhile, free some nodes
 	else if (Num_sexp_nodes - (last_persistent_node + 1) > 2 * SEXP_NODE_INCREMENT)
 	{
-		// round it up to the next evenly divisible size
-		Num_sexp_nodes = (last_persistent_node + 1);
-		Num_sexp_nodes += SEXP_NODE_INCREMENT - (Num_sexp_nodes % SEXP_NODE_INCREMENT);
-
-		Sexp_nodes = (sexp_node *) vm_realloc(Sexp_nodes, sizeof(sexp_node) * Num_sexp_nodes);
-		Verify(Sexp_nodes != NULL);
+		// the arena rounds it up to the next evenly divisible size
+		Sexp_nodes.shrink(last_persistent_node + 1);
+		Num_sexp_nodes = Sexp_nodes.size();
 	}
 
 	nprintf(("SEXP", "Exited function with %d nodes.\n", Num_sexp_nodes));
@@ -1149,22 +1145,9 @@ void sexp_nodes_init()
 static void sexp_nodes_close()
 {
 	// free all sexp nodes... should only be done on game shutdown
-	if (Sexp_nodes != NULL)
-	{
-		// free anything cached
-		for (int i = 0; i < Num_sexp_nodes; i++)
-		{
-			if (Sexp_nodes[i].cache)
-			{
-				delete Sexp_nodes[i].cache;
-				Sexp_nodes[i].cache = nullptr;
-			}
-		}
-
-		vm_free(Sexp_nodes);
-		Sexp_nodes = NULL;
-		Num_sexp_nodes = 0;
-	}
+	Sexp_nodes.shrink(0);
+	Num_sexp_nodes = 0;
+	First_free_sexp_hint = 0;
 }
 
 void init_sexp()
@@ -1219,20 +1202,17 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 
 		Assert(SEXP_NODE_INCREMENT > 0);
 
-		// allocate in blocks of SEXP_NODE_INCREMENT
-		Num_sexp_nodes += SEXP_NODE_INCREMENT;
-		Sexp_nodes = (sexp_node *) vm_realloc(Sexp_nodes, sizeof(sexp_node) * Num_sexp_nodes);
+		// allocate in blocks of SEXP_NODE_INCREMENT, the new nodes come zeroed and the old ones stay where they are
+		node = Sexp_nodes.grow();
+		Verify(node == old_size);
+		Num_sexp_nodes = Sexp_nodes.size();
 
-		Verify(Sexp_nodes != NULL);
 		nprintf(("SEXP", "Bumping dynamic sexp node limit from %d to %d...\n", old_size, Num_sexp_nodes));
-
-		// clear all the new sexp nodes we just allocated
-		memset(&Sexp_nodes[old_size], 0, sizeof(sexp_node) * SEXP_NODE_INCREMENT); //-V512
-
-		// our new sexp is the first out of the ones we just created
-		node = old_size;
 	}
 
+	// everything up to this node is used now
+	First_free_sexp_hint = node + 1;
+
 	Assert(node != Locked_sexp_true);
 	Assert(node != Locked_sexp_false);
 	Assert(strlen(text) < TOKEN_LENGTH);
@@ -1246,7 +1226,7 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 	Sexp_nodes[node].value = SEXP_UNKNOWN;
 	Sexp_nodes[node].flags = SNF_DEFAULT_VALUE;
 	Sexp_nodes[node].op_index = NO_OPERATOR_INDEX_DEFINED;
-	Sexp_nodes[node].cache = nullptr;
+	Sexp_nodes[node].cache.clear();
 	Sexp_nodes[node].cached_variable_index = -1;
 
 	// special-arg?
@@ -1279,6 +1259,14 @@ int count_free_sexp_nodes()
 	return f;
 }
 
+void sexp_report_memory(const char *label)
+{
+	int used = Num_sexp_nodes - count_free_sexp_nodes();
+
+	mprintf(("SEXP nodes %s: %d used of %d allocated, %d KB (%d bytes per node)\n", label, used, Num_sexp_nodes,
+		(int)((sizeof(sexp_node) * Num_sexp_nodes) / 1024), (int)sizeof(sexp_node)));
+}
+
 /**
  * Find the next free sexp and return its index.
  */
@@ -1287,10 +1275,10 @@ int find_free_sexp()
 	int i;
 
 	// sanity
-	if (Num_sexp_nodes == 0 || Sexp_nodes == NULL)
+	if (Num_sexp_nodes == 0)
 		return -1;
 
-	for (i = 0; i < Num_sexp_nodes; i++)
+	for (i = First_free_sexp_hint; i < Num_sexp_nodes; i++)
 	{
 		if (Sexp_nodes[i].type == SEXP_NOT_USED)
 			return i;
@@ -1355,11 +1343,8 @@ int free_one_sexp(int num)
 		return 0;
 
 	Sexp_nodes[num].type = SEXP_NOT_USED;
-	if (Sexp_nodes[num].cache)
-	{
-		delete Sexp_nodes[num].cache;
-		Sexp_nodes[num].cache = nullptr;
-	}
+	Sexp_nodes[num].cache.clear();
+	First_free_sexp_hint = MIN(First_free_sexp_hint, num);
 	return 1;
 }
 
@@ -1381,11 +1366,8 @@ int free_sexp(int num)
 		return 0;
 
 	Sexp_nodes[num].type = SEXP_NOT_USED;
-	if (Sexp_nodes[num].cache)
-	{
-		delete Sexp_nodes[num].cache;
-		Sexp_nodes[num].cache = nullptr;
-	}
+	Sexp_nodes[num].cache.clear();
+	First_free_sexp_hint = MIN(First_free_sexp_hint, num);
 	count++;
 
 	i = Sexp_nodes[num].first;
@@ -1442,11 +1424,7 @@ void flush_sexp_tree(int node)
 	}
 
 	Sexp_nodes[node].value = SEXP_UNKNOWN;
-	if (Sexp_nodes[node].cache)
-	{
-		delete Sexp_nodes[node].cache;
-		Sexp_nodes[node].cache = nullptr;
-	}
+	Sexp_nodes[node].cache.clear();
 	Sexp_nodes[node].cached_variable_index = -1;
 
 	flush_sexp_tree(Sexp_nodes[node].first);
@@ -4306,13 +4284,13 @@ player *get_player_from_ship_node(int node, bool test_respawns = false, int *net
 const ship_registry_entry *eval_ship(int node)
 {
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_nodes[node].cache.is_set())
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_SHIP)
+		if (Sexp_nodes[node].cache.sexp_node_data_type != OPF_SHIP)
 			return nullptr;
 
-		return &Ship_registry[Sexp_nodes[node].cache->ship_registry_index];
+		return &Ship_registry[Sexp_nodes[node].cache.ship_registry_index];
 	}
 
 	// maybe forward to a special-arg node
@@ -4330,7 +4308,7 @@ const ship_registry_entry *eval_ship(int node)
 	{
 		// cache the value, unless this node is a variable or argument because the value may change
 		if (!(Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) && !(Sexp_nodes[node].flags & SNF_SPECIAL_ARG_IN_NODE))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_SHIP, -1, ship_it->second);
+			Sexp_nodes[node].cache.set_ship(ship_it->second);
 
 		return &Ship_registry[ship_it->second];
 	}
@@ -4345,13 +4323,13 @@ const ship_registry_entry *eval_ship(int node)
 wing *eval_wing(int node)
 {
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_nodes[node].cache.is_set())
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_WING)
+		if (Sexp_nodes[node].cache.sexp_node_data_type != OPF_WING)
 			return nullptr;
 
-		return static_cast<wing*>(Sexp_nodes[node].cache->pointer);
+		return static_cast<wing*>(Sexp_nodes[node].cache.pointer);
 	}
 
 	// maybe forward to a special-arg node
@@ -4371,7 +4349,7 @@ wing *eval_wing(int node)
 
 		// cache the value, unless this node is a variable or argument because the value may change
 		if (!(Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) && !(Sexp_nodes[node].flags & SNF_SPECIAL_ARG_IN_NODE))
-			Sexp_nodes[node].cache = new sexp_cached_data(OPF_WING, wingp);
+			Sexp_nodes[node].cache.set_pointer(OPF_WING, wingp);
 
 		return wingp;
 	}
@@ -4389,13 +4367,13 @@ int sexp_atoi(int node)
 	Assertion(!Fred_running, "This function relies on SEXP caching which is not set up to work in FRED!");
 
 	// check cache
-	if (Sexp_nodes[node].cache)
+	if (Sexp_nodes[node].cache.is_set())
 	{
 		// have we cached something else?
-		if (Sexp_nodes[node].cache->sexp_node_data_type != OPF_NUMBER)
+		if (Sexp_nodes[node].cache.sexp_node_data_type != OPF_NUMBER)
 			return 0;
 
-		return Sexp_nodes[node].cache->numeric_literal;
+		return Sexp_nodes[node].cache.numeric_literal;
 	}
 
 	// maybe forward to a special-arg node
@@ -4412,7 +4390,7 @@ int sexp_atoi(int node)
 
 	// cache the value, unless this node is a variable or argument because the value may change
 	if (!(Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) && !(Sexp_nodes[node].flags & SNF_SPECIAL_ARG_IN_NODE))
-		Sexp_nodes[node].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
+		Sexp_nodes[node].cache.set_number(num);
 
 	return num;
 }
@@ -4424,7 +4402,7 @@ bool sexp_can_construe_as_integer(int node)
 {
 	Assertion(!Fred_running, "This function relies on SEXP caching which is not set up to work in FRED!");
 
-	if (Sexp_nodes[node].cache && Sexp_nodes[node].cache->sexp_node_data_type == OPF_NUMBER)
+	if (Sexp_nodes[node].cache.sexp_node_data_type == OPF_NUMBER)
 		return true;
 
 	// maybe forward to a special-arg node
@@ -5481,15 +5459,15 @@ void eval_object_ship_wing_point_team(object_ship_wing_point_team *oswpt, int no
 		}
 	}
 	// check caching
-	else if (Sexp_nodes[node].cache)
+	else if (Sexp_nodes[node].cache.is_set())
 	{
-		if (Sexp_nodes[node].cache->sexp_node_data_type == OPF_SHIP)
+		if (Sexp_nodes[node].cache.sexp_node_data_type == OPF_SHIP)
 		{
-			ship_entry = &Ship_registry[Sexp_nodes[node].cache->ship_registry_index];
+			ship_entry = &Ship_registry[Sexp_nodes[node].cache.ship_registry_index];
 		}
-		else if (Sexp_nodes[node].cache->sexp_node_data_type == OPF_WING)
+		else if (Sexp_nodes[node].cache.sexp_node_data_type == OPF_WING)
 		{
-			wingp = static_cast<wing*>(Sexp_nodes[node].cache->pointer);
+			wingp = static_cast<wing*>(Sexp_nodes[node].cache.pointer);
 		}
 		// TODO: other caching
 		else
@@ -6400,7 +6378,7 @@ int sexp_special_warp_dist( int n)
 	auto shipp = ship_entry->shipp;
 
 	// check that ship has warpout_objnum
-	if (shipp->special_warpout_objnum < 0 || shipp->special_warpout_objnum >= MAX_OBJECTS) {
+	if (shipp->special_warpout_objnum < 0 || shipp->special_warpout_objnum >= objects_size()) {
 		return SEXP_NAN;
 	}
 
@@ -20289,8 +20267,8 @@ int sexp_string_to_int(int n)
 	char *buf_ch, buf[TOKEN_LENGTH];
 	Assert (n != -1);
 
-	if (Sexp_nodes[n].cache)
-		return Sexp_nodes[n].cache->numeric_literal;
+	if (Sexp_nodes[n].cache.is_set())
+		return (Sexp_nodes[n].cache.sexp_node_data_type == OPF_NUMBER) ? Sexp_nodes[n].cache.numeric_literal : 0;
 
 	// maybe forward to a special-arg node
 	if (Sexp_nodes[n].flags & SNF_SPECIAL_ARG_IN_NODE)
@@ -20327,7 +20305,7 @@ int sexp_string_to_int(int n)
 
 	// cache the value, unless this node is a variable or argument because the value may change
 	if (!(Sexp_nodes[n].type & SEXP_FLAG_VARIABLE) && !(Sexp_nodes[n].flags & SNF_SPECIAL_ARG_IN_NODE))
-		Sexp_nodes[n].cache = new sexp_cached_data(OPF_NUMBER, num, -1);
+		Sexp_nodes[n].cache.set_number(num);
 
 	return num;
 }
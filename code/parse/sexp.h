@@ -12,6 +12,7 @@
 
 #include "globalincs/globals.h"
 #include "globalincs/pstypes.h"	// for NULL
+#include "utils/chunked_pool.h"
 
 class ship_subsys;
 class ship;
@@ -1067,26 +1068,45 @@ typedef struct sexp_oper {
 } sexp_oper;
 
 // Goober5000
+// Kept inside the node so caching a value doesn't need an allocation, only one of the values is used at a time
 struct sexp_cached_data
 {
-	int sexp_node_data_type = OPF_NONE;		// an OPF_ #define
-	int numeric_literal = 0;				// i.e. a number
-	int ship_registry_index = -1;			// because ship status is pretty common
-	void *pointer = nullptr;				// could be an IFF, a wing, a goal, or other unchanging reference
-
-	sexp_cached_data() = default;
-
-	sexp_cached_data(int _sexp_node_data_type)
-		: sexp_node_data_type(_sexp_node_data_type)
-	{}
-
-	sexp_cached_data(int _sexp_node_data_type, void *_pointer)
-		: sexp_node_data_type(_sexp_node_data_type), pointer(_pointer)
-	{}
-
-	sexp_cached_data(int _sexp_node_data_type, int _numeric_literal, int _ship_registry_index)
-		: sexp_node_data_type(_sexp_node_data_type), numeric_literal(_numeric_literal), ship_registry_index(_ship_registry_index)
-	{}
+	int sexp_node_data_type = OPF_NONE;		// an OPF_ #define, OPF_NONE if nothing is cached
+	union {
+		int numeric_literal;				// OPF_NUMBER, i.e. a number
+		int ship_registry_index;			// OPF_SHIP, because ship status is pretty common
+		void *pointer;						// could be an IFF, a wing, a goal, or other unchanging reference
+	};
+
+	sexp_cached_data() : pointer(nullptr) {}
+
+	bool is_set() const { return sexp_node_data_type != OPF_NONE; }
+
+	void clear()
+	{
+		sexp_node_data_type = OPF_NONE;
+		pointer = nullptr;
+	}
+
+	void set_number(int _numeric_literal)
+	{
+		clear();
+		sexp_node_data_type = OPF_NUMBER;
+		numeric_literal = _numeric_literal;
+	}
+
+	void set_ship(int _ship_registry_index)
+	{
+		clear();
+		sexp_node_data_type = OPF_SHIP;
+		ship_registry_index = _ship_registry_index;
+	}
+
+	void set_pointer(int _sexp_node_data_type, void *_pointer)
+	{
+		sexp_node_data_type = _sexp_node_data_type;
+		pointer = _pointer;
+	}
 };
 
 typedef struct sexp_node {
@@ -1098,9 +1118,9 @@ typedef struct sexp_node {
 	int	rest;						// index into Sexp_nodes of rest of parameters
 	int	value;					// known to be true, known to be false, or not known
 	int flags;					// Goober5000
-
-	sexp_cached_data *cache;	// Goober5000
 	int cached_variable_index;	// Goober5000
+
+	sexp_cached_data cache;		// Goober5000
 } sexp_node;
 
 // Goober5000
@@ -1125,8 +1145,11 @@ typedef struct sexp_variable {
 // Goober5000 - it's dynamic now
 //extern sexp_node Sexp_nodes[MAX_SEXP_NODES];
 
+// nodes are allocated in chunks of this many, growing never moves the existing ones
+#define SEXP_NODE_INCREMENT	256
+
 extern int Num_sexp_nodes;
-extern sexp_node *Sexp_nodes;
+extern util::chunked_pool<sexp_node, SEXP_NODE_INCREMENT> Sexp_nodes;
 
 extern sexp_variable Sexp_variables[MAX_SEXP_VARIABLES];
 extern sexp_variable Block_variables[MAX_SEXP_VARIABLES];
@@ -1195,6 +1218,7 @@ extern int build_sexp_string(SCP_string &accumulator, int cur_node, int level, i
 extern int sexp_query_type_match(int opf, int opr);
 extern const char *sexp_error_message(int num);
 extern int count_free_sexp_nodes();
+extern void sexp_report_memory(const char *label);
 
 struct ship_registry_entry;
 struct wing;
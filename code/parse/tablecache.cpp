@@ -0,0 +1,259 @@
+
+#include "parse/tablecache.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "localization/localize.h"
+#include "mod_table/mod_table.h"
+
+#include <md5.h>
+
+#include <algorithm>
+
+// bump this whenever process_raw_file_text() changes what it produces
+#define TABLE_CACHE_VERSION		1
+
+#define TABLE_CACHE_MAGIC		0x43545346	// "FSTC"
+
+// processing a file smaller than this is about as fast as finding and reading its cache file
+#define TABLE_CACHE_MIN_SIZE	(16 * 1024)
+
+#define TABLE_CACHE_LOCATIONS	(CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
+
+typedef struct table_cache_header {
+	uint	magic;
+	uint	version;
+	uint	raw_len;
+	uint	processed_len;
+} table_cache_header;
+
+typedef struct table_times {
+	SCP_string		filename;
+	int				reads;
+	int				cached_reads;
+	std::uint64_t	read_us;
+	std::uint64_t	process_us;
+	std::uint64_t	parse_us;
+} table_times;
+
+static SCP_vector<table_times> Table_report;
+
+// set once the report has been printed, nothing is recorded after that
+static bool Table_report_done = false;
+
+// fed with every table read during game_init(), never finalized itself
+static MD5 Table_hash;
+
+// what table_hash_get() returns, empty until table_hash_finish() is called
+static SCP_string Table_hash_snapshot;
+
+static bool table_cache_enabled(size_t raw_len)
+{
+	return !Cmdline_notablecache && raw_len >= TABLE_CACHE_MIN_SIZE;
+}
+
+static SCP_string table_cache_get_name(const char *raw_text, size_t raw_len)
+{
+	// everything besides the text which changes the output of process_raw_file_text()
+	int key[4];
+	key[0] = TABLE_CACHE_VERSION;
+	key[1] = Fred_running;
+	key[2] = Unicode_text_mode ? 1 : 0;
+	key[3] = Lcl_pl;
+
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(key), sizeof(key));
+	md5.update(raw_text, (MD5::size_type)raw_len);
+	md5.finalize();
+
+	char name[MAX_FILENAME_LEN];
+	sprintf(name, "pt%.20s.bx", md5.hexdigest().c_str());
+
+	return name;
+}
+
+bool table_cache_load(const char *raw_text, char *processed_text, size_t processed_size)
+{
+	auto raw_len = strlen(raw_text);
+
+	if ( !table_cache_enabled(raw_len) ) {
+		return false;
+	}
+
+	auto cache_name = table_cache_get_name(raw_text, raw_len);
+
+	CFILE *fp = cfopen(cache_name.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, TABLE_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	table_cache_header header;
+	bool valid = false;
+
+	if (cfread(&header, sizeof(header), 1, fp) == 1) {
+		valid = (header.magic == TABLE_CACHE_MAGIC) && (header.version == TABLE_CACHE_VERSION) && (header.raw_len == raw_len)
+			&& (header.processed_len < processed_size)
+			&& ((size_t)cfilelength(fp) == sizeof(header) + header.processed_len);
+	}
+
+	if (valid && header.processed_len > 0) {
+		valid = cfread(processed_text, header.processed_len, 1, fp) == 1;
+	}
+
+	cfclose(fp);
+
+	if ( !valid ) {
+		mprintf(("Table cache file %s is invalid, ignoring it\n", cache_name.c_str()));
+		return false;
+	}
+
+	processed_text[header.processed_len] = '\0';
+
+	return true;
+}
+
+void table_cache_save(const char *raw_text, const char *processed_text)
+{
+	auto raw_len = strlen(raw_text);
+
+	if ( !table_cache_enabled(raw_len) ) {
+		return;
+	}
+
+	auto cache_name = table_cache_get_name(raw_text, raw_len);
+
+	table_cache_header header;
+	header.magic = TABLE_CACHE_MAGIC;
+	header.version = TABLE_CACHE_VERSION;
+	header.raw_len = (uint)raw_len;
+	header.processed_len = (uint)strlen(processed_text);
+
+	CFILE *fp = cfopen(cache_name.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, TABLE_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		mprintf(("Could not open table cache file %s for writing!\n", cache_name.c_str()));
+		return;
+	}
+
+	bool written = cfwrite(&header, sizeof(header), 1, fp) == 1;
+	if (written && header.processed_len > 0) {
+		written = cfwrite(processed_text, header.processed_len, 1, fp) == 1;
+	}
+
+	cfclose(fp);
+
+	if ( !written ) {
+		mprintf(("Could not write table cache file %s!\n", cache_name.c_str()));
+		cf_delete(cache_name.c_str(), CF_TYPE_CACHE, TABLE_CACHE_LOCATIONS);
+	}
+}
+
+void table_hash_add(const char *filename, const char *raw_text)
+{
+	// tables read later on depend on what the player did, they would give the same data a different hash
+	if (!Table_hash_snapshot.empty()) {
+		return;
+	}
+
+	// the name is hashed with its terminator so a name and the text after it can't run together
+	Table_hash.update(filename, (MD5::size_type)strlen(filename) + 1);
+	Table_hash.update(raw_text, (MD5::size_type)strlen(raw_text));
+}
+
+void table_hash_finish()
+{
+	if (!Table_hash_snapshot.empty()) {
+		return;
+	}
+
+	MD5 md5 = Table_hash;
+	md5.finalize();
+
+	Table_hash_snapshot = md5.hexdigest();
+}
+
+const SCP_string &table_hash_get()
+{
+	return Table_hash_snapshot;
+}
+
+static table_times *table_report_get(const char *filename)
+{
+	for (auto &times : Table_report) {
+		if ( !stricmp(times.filename.c_str(), filename) ) {
+			return &times;
+		}
+	}
+
+	table_times times;
+	times.filename = filename;
+	times.reads = 0;
+	times.cached_reads = 0;
+	times.read_us = 0;
+	times.process_us = 0;
+	times.parse_us = 0;
+	Table_report.push_back(times);
+
+	return &Table_report.back();
+}
+
+void table_report_add_read(const char *filename, std::uint64_t read_us, std::uint64_t process_us, bool cached)
+{
+	if (Table_report_done) {
+		return;
+	}
+
+	auto times = table_report_get(filename);
+
+	times->reads++;
+	if (cached) {
+		times->cached_reads++;
+	}
+	times->read_us += read_us;
+	times->process_us += process_us;
+}
+
+void table_report_add_parse(const char *filename, std::uint64_t parse_us)
+{
+	if (Table_report_done) {
+		return;
+	}
+
+	table_report_get(filename)->parse_us += parse_us;
+}
+
+void table_report_print()
+{
+	Table_report_done = true;
+
+	if (Table_report.empty()) {
+		return;
+	}
+
+	// the slowest tables are the interesting ones
+	SCP_vector<table_times> sorted;
+	sorted.swap(Table_report);
+	std::sort(sorted.begin(), sorted.end(), [](const table_times &left, const table_times &right) {
+		return std::max(left.parse_us, left.read_us + left.process_us) > std::max(right.parse_us, right.read_us + right.process_us);
+	});
+
+	std::uint64_t read_us = 0, process_us = 0, parse_us = 0;
+	int reads = 0, cached_reads = 0;
+
+	mprintf(("Table report (times in ms, parse includes reading and is only known for modular tables):\n"));
+	mprintf(("  %-40s %5s %6s %9s %9s %9s\n", "file", "reads", "cached", "read", "process", "parse"));
+
+	for (const auto &times : sorted) {
+		mprintf(("  %-40s %5d %6d %9.2f %9.2f %9.2f\n", times.filename.c_str(), times.reads, times.cached_reads,
+			times.read_us / 1000.0, times.process_us / 1000.0, times.parse_us / 1000.0));
+
+		reads += times.reads;
+		cached_reads += times.cached_reads;
+		read_us += times.read_us;
+		process_us += times.process_us;
+		parse_us += times.parse_us;
+	}
+
+	mprintf(("  %-40s %5d %6d %9.2f %9.2f %9.2f\n", "total", reads, cached_reads, read_us / 1000.0, process_us / 1000.0,
+		parse_us / 1000.0));
+}
@@ -0,0 +1,41 @@
+#ifndef _TABLECACHE_H
+#define _TABLECACHE_H
+
+#include "globalincs/pstypes.h"
+
+// The table cache keeps the comment-stripped text read_file_text() produces in CF_TYPE_CACHE, so big tables don't have
+// to be run through process_raw_file_text() on every startup. Cache files are named after a hash of the raw text and
+// everything else that changes the processed text, an edited table simply misses the cache.
+//
+// The table hash covers the raw text of every table read during game_init(), so caches of things which depend on the
+// tables can tell when a table changed. It is fixed once game_init() is done, tables read later don't change it.
+//
+// The table report collects how long reading and parsing each table took during game_init(), table_report_print() writes
+// that to the log at the end of it. Files read after that aren't recorded.
+
+// Fills processed_text (with room for processed_size chars) from the cache, returns false if the text has to be processed
+bool table_cache_load(const char *raw_text, char *processed_text, size_t processed_size);
+
+// Writes the processed text of a file to the cache, small files are skipped since processing them is cheaper
+void table_cache_save(const char *raw_text, const char *processed_text);
+
+// Adds the raw text of a table to the hash of all tables read so far, does nothing once the hash is finished
+void table_hash_add(const char *filename, const char *raw_text);
+
+// Fixes the hash of the tables read so far, called at the end of game_init()
+void table_hash_finish();
+
+// Returns the hash of the tables read during game_init(), anything built from the table data can be keyed on it
+// Empty until table_hash_finish() was called
+const SCP_string &table_hash_get();
+
+// Records reading a file through read_file_text()
+void table_report_add_read(const char *filename, std::uint64_t read_us, std::uint64_t process_us, bool cached);
+
+// Records the time a parse callback of parse_modular_table() took for a file, reading included
+void table_report_add_parse(const char *filename, std::uint64_t parse_us);
+
+// Writes the times of all tables read so far to the log and stops recording
+void table_report_print();
+
+#endif
@@ -295,7 +295,7 @@ namespace particle
 		if (part->attached_objnum >= 0)
 		{
 			// if the signature has changed, or it's bogus, kill it
-			if ((part->attached_objnum >= MAX_OBJECTS) ||
+			if ((part->attached_objnum >= objects_size()) ||
 				(part->attached_sig != Objects[part->attached_objnum].signature))
 			{
 				remove_particle = true;
@@ -25,6 +25,7 @@
 #include "object/object.h"
 #include "playerman/player.h"
 #include "radar/radar.h"
+#include "radar/radarcontacts.h"
 #include "ship/awacs.h"
 #include "ship/ship.h"
 #include "ship/subsysdamage.h"
@@ -33,6 +34,33 @@
 
 extern int radar_target_id_flags;
 
+namespace {
+struct blip_circle {
+	color *blip_color;
+	int x, y;
+};
+
+// scratch space for drawing the blips of one type, kept around so it doesn't have to be allocated every frame
+struct blip_batch {
+	SCP_vector<blip*> blips;
+	SCP_vector<float> eye_x, eye_y, eye_z, dist;
+	SCP_vector<float> radar_x, radar_y;
+
+	SCP_vector<blip_circle> circles;
+	SCP_vector<int> circle_x, circle_y;
+
+	void clear() {
+		blips.clear();
+		eye_x.clear();
+		eye_y.clear();
+		eye_z.clear();
+		dist.clear();
+		circles.clear();
+	}
+};
+blip_batch Blip_batch;
+}
+
 HudGaugeRadarStd::HudGaugeRadarStd():
 HudGaugeRadar(HUD_OBJECT_RADAR_STD, 255, 255, 255)
 {
@@ -74,7 +102,7 @@ void HudGaugeRadarStd::blipDrawFlicker(blip *b, int x, int y)
 {
 	int xdiff=0, ydiff=0, flicker_index;
 
-	if ( (b-Blips) & 1 ) {
+	if ( (b-Blips.data()) & 1 ) {
 		flicker_index=0;
 	} else {
 		flicker_index=1;
@@ -120,11 +148,32 @@ void HudGaugeRadarStd::drawBlips(int blip_type, int bright, int distort)
 		blip_head = &Blip_dim_list[blip_type];
 
 
-	// draw all blips of this type
+	// project all blips of this type in one go
+	Blip_batch.clear();
 	for (b = GET_FIRST(blip_head); b != END_OF_LIST(blip_head); b = GET_NEXT(b))
 	{
-		gr_set_color_fast(b->blip_color);
-		plotBlip(b, &x, &y);
+		Blip_batch.blips.push_back(b);
+		Blip_batch.eye_x.push_back(b->position.xyz.x);
+		Blip_batch.eye_y.push_back(b->position.xyz.y);
+		Blip_batch.eye_z.push_back(b->position.xyz.z);
+		Blip_batch.dist.push_back(b->dist);
+	}
+
+	size_t num_blips = Blip_batch.blips.size();
+	if (num_blips == 0) {
+		return;
+	}
+
+	Blip_batch.radar_x.resize(num_blips);
+	Blip_batch.radar_y.resize(num_blips);
+	radar::project_flat(Blip_batch.eye_x.data(), Blip_batch.eye_y.data(), Blip_batch.eye_z.data(), Blip_batch.dist.data(),
+		num_blips, Blip_batch.radar_x.data(), Blip_batch.radar_y.data());
+
+	// draw all blips of this type, plain circles are only collected here and drawn together below
+	for (size_t i = 0; i < num_blips; ++i)
+	{
+		b = Blip_batch.blips[i];
+		toScreen(Blip_batch.radar_x[i], Blip_batch.radar_y[i], &x, &y);
 
 		// maybe draw cool blip to indicate current target
 		if (b->flags & BLIP_CURRENT_TARGET)
@@ -141,23 +190,58 @@ void HudGaugeRadarStd::drawBlips(int blip_type, int bright, int distort)
 		// maybe distort blip
 		if (distort)
 		{
+			gr_set_color_fast(b->blip_color);
 			blipDrawDistorted(b, x, y);
 		}
 		else if (b->flags & BLIP_DRAW_DISTORTED)
 		{
+			gr_set_color_fast(b->blip_color);
 			blipDrawFlicker(b, x, y);
 		}
+		else if (b->radar_image_2d != -1 || b->radar_color_image_2d != -1)
+		{
+			gr_set_color_fast(b->blip_color);
+			drawContactImage(x, y, b->rad, b->radar_image_2d, b->radar_color_image_2d, b->radar_image_size);
+		}
+		else if (b->rad == Radar_blip_radius_target)
+		{
+			gr_set_color_fast(b->blip_color);
+			drawContactCircle(x, y, b->rad);
+		}
 		else
 		{
-			if (b->radar_image_2d == -1 && b->radar_color_image_2d == -1)
-				drawContactCircle(x, y, b->rad);
-			else
-				drawContactImage(x, y, b->rad, b->radar_image_2d, b->radar_color_image_2d, b->radar_image_size);
+			Blip_batch.circles.push_back({ b->blip_color, x, y });
+		}
+	}
+
+	// one draw per color instead of one per blip
+	std::stable_sort(Blip_batch.circles.begin(), Blip_batch.circles.end(),
+		[](const blip_circle& left, const blip_circle& right) { return left.blip_color < right.blip_color; });
+
+	size_t start = 0;
+	while (start < Blip_batch.circles.size())
+	{
+		size_t end = start;
+
+		Blip_batch.circle_x.clear();
+		Blip_batch.circle_y.clear();
+		while (end < Blip_batch.circles.size() && Blip_batch.circles[end].blip_color == Blip_batch.circles[start].blip_color)
+		{
+			Blip_batch.circle_x.push_back(Blip_batch.circles[end].x);
+			Blip_batch.circle_y.push_back(Blip_batch.circles[end].y);
+			++end;
 		}
+
+		gr_set_color_fast(Blip_batch.circles[start].blip_color);
+		renderCircles(Blip_batch.circle_x.data(), Blip_batch.circle_y.data(), Blip_batch.circle_x.size(), 4);
+
+		start = end;
 	}
 }
 void HudGaugeRadarStd::drawBlipsSorted(int distort)
 {
+	radar_build_blips();
+
 	current_target_x = 0;
 	current_target_y = 0;
 	// draw dim blips first, then bright blips
@@ -381,26 +465,14 @@ void HudGaugeRadarStd::clampBlip(vec3d* b)
 	b->xyz.y *= (i2fl(Radar_radius[1]) / i2fl(Radar_radius[0]));
 }
 
-void HudGaugeRadarStd::plotBlip(blip *b, int *x, int *y)
+void HudGaugeRadarStd::toScreen(float radar_x, float radar_y, int *x, int *y)
 {
-	float zdist, rscale;
-	vec3d *pos = &b->position;
-
-	if (b->dist < pos->xyz.z) {
-		rscale = 0.0f;
-	} else {
-		rscale = (float) acosf(pos->xyz.z / b->dist) / PI;
-	}
-
-	zdist = hypotf(pos->xyz.x, pos->xyz.y);
+	vec3d new_pos = vmd_zero_vector;
 
-	vec3d new_pos = {};
-
-	if (zdist >= 0.01f)
+	if (radar_x != 0.0f || radar_y != 0.0f)
 	{
-		new_pos = *pos;
-		new_pos.xyz.z = 0.0f;
-		vm_vec_scale(&new_pos, rscale / zdist);		// Values are within +/- 1.0f
+		new_pos.xyz.x = radar_x;
+		new_pos.xyz.y = radar_y;
 		clampBlip(&new_pos);
 	}
 
@@ -408,6 +480,14 @@ void HudGaugeRadarStd::plotBlip(blip *b, int *x, int *y)
 	*y = fl2i(position[1] + Radar_center_offsets[1] - new_pos.xyz.y);
 }
 
+void HudGaugeRadarStd::plotBlip(blip *b, int *x, int *y)
+{
+	float radar_x, radar_y;
+
+	radar::project_flat(&b->position.xyz.x, &b->position.xyz.y, &b->position.xyz.z, &b->dist, 1, &radar_x, &radar_y);
+	toScreen(radar_x, radar_y, x, y);
+}
+
 void HudGaugeRadarStd::drawCrosshairs(int x, int y)
 {
 	int i,j,m;
@@ -51,6 +51,11 @@ protected:
 	 * @param[in] b The blip coordinates (only x and y are nonzero)
 	 */
 	virtual void clampBlip(vec3d* b);
+
+	/**
+	 * @brief Converts a position from radar::project_flat() to screen coordinates
+	 */
+	void toScreen(float radar_x, float radar_y, int *x, int *y);
 public:
 	HudGaugeRadarStd();
 	void initCenterOffsets(float x, float y);
@@ -0,0 +1,80 @@
+
+#include "radar/radarcontacts.h"
+
+#include <cmath>
+
+namespace radar {
+
+void contact_list::clear() {
+	_objnum.clear();
+	_signature.clear();
+	_world_x.clear();
+	_world_y.clear();
+	_world_z.clear();
+
+	_eye_x.clear();
+	_eye_y.clear();
+	_eye_z.clear();
+	_dist.clear();
+}
+
+void contact_list::add(int objnum, int signature, const vec3d& world_pos) {
+	_objnum.push_back(objnum);
+	_signature.push_back(signature);
+	_world_x.push_back(world_pos.xyz.x);
+	_world_y.push_back(world_pos.xyz.y);
+	_world_z.push_back(world_pos.xyz.z);
+}
+
+void contact_list::project(const vec3d& origin, const matrix& eye_orient) {
+	auto count = _objnum.size();
+
+	_eye_x.resize(count);
+	_eye_y.resize(count);
+	_eye_z.resize(count);
+	_dist.resize(count);
+
+	const auto& rvec = eye_orient.vec.rvec.xyz;
+	const auto& uvec = eye_orient.vec.uvec.xyz;
+	const auto& fvec = eye_orient.vec.fvec.xyz;
+
+	const float* world_x = _world_x.data();
+	const float* world_y = _world_y.data();
+	const float* world_z = _world_z.data();
+	float* eye_x = _eye_x.data();
+	float* eye_y = _eye_y.data();
+	float* eye_z = _eye_z.data();
+	float* dist = _dist.data();
+
+	// Same as vm_vec_sub(), vm_vec_rotate() and vm_vec_dist() per contact, written so the compiler can vectorize it
+	for (size_t i = 0; i < count; ++i) {
+		float dx = world_x[i] - origin.xyz.x;
+		float dy = world_y[i] - origin.xyz.y;
+		float dz = world_z[i] - origin.xyz.z;
+
+		eye_x[i] = dx * rvec.x + dy * rvec.y + dz * rvec.z;
+		eye_y[i] = dx * uvec.x + dy * uvec.y + dz * uvec.z;
+		eye_z[i] = dx * fvec.x + dy * fvec.y + dz * fvec.z;
+		dist[i] = sqrtf(dx * dx + dy * dy + dz * dz);
+	}
+}
+
+void project_flat(const float* x, const float* y, const float* z, const float* dist, size_t count, float* out_x,
+                  float* out_y) {
+	for (size_t i = 0; i < count; ++i) {
+		float zdist = hypotf(x[i], y[i]);
+
+		if (zdist < 0.01f) {
+			out_x[i] = 0.0f;
+			out_y[i] = 0.0f;
+			continue;
+		}
+
+		float rscale = (dist[i] < z[i]) ? 0.0f : acosf(z[i] / dist[i]) / PI;
+
+		out_x[i] = x[i] * rscale / zdist;
+		out_y[i] = y[i] * rscale / zdist;
+	}
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace radar {
+
+/**
+ * @brief The objects which may show up on the radar this frame, stored as separate arrays per field
+ *
+ * Objects are added while they are moved. Once everything has moved, project() transforms all of them into the
+ * player's eye space in one pass over the arrays instead of doing the vector math object by object.
+ */
+class contact_list {
+	SCP_vector<int> _objnum;
+	SCP_vector<int> _signature;
+
+	// world position
+	SCP_vector<float> _world_x;
+	SCP_vector<float> _world_y;
+	SCP_vector<float> _world_z;
+
+	// position relative to the player in eye coordinates and distance to the player, set by project()
+	SCP_vector<float> _eye_x;
+	SCP_vector<float> _eye_y;
+	SCP_vector<float> _eye_z;
+	SCP_vector<float> _dist;
+
+ public:
+	void clear();
+
+	void add(int objnum, int signature, const vec3d& world_pos);
+
+	/**
+	 * @brief Computes the eye space positions and distances of all contacts
+	 *
+	 * @param origin The position of the player, positions and distances are relative to this
+	 * @param eye_orient The orientation the radar is drawn from
+	 */
+	void project(const vec3d& origin, const matrix& eye_orient);
+
+	inline size_t size() const { return _objnum.size(); }
+
+	inline int objnum(size_t i) const { return _objnum[i]; }
+	inline int signature(size_t i) const { return _signature[i]; }
+	inline float dist(size_t i) const { return _dist[i]; }
+
+	inline vec3d world_pos(size_t i) const {
+		vec3d pos;
+		pos.xyz.x = _world_x[i];
+		pos.xyz.y = _world_y[i];
+		pos.xyz.z = _world_z[i];
+		return pos;
+	}
+	inline vec3d eye_pos(size_t i) const {
+		vec3d pos;
+		pos.xyz.x = _eye_x[i];
+		pos.xyz.y = _eye_y[i];
+		pos.xyz.z = _eye_z[i];
+		return pos;
+	}
+};
+
+/**
+ * @brief Projects eye space positions onto a flat, round radar like HudGaugeRadarStd
+ *
+ * Objects straight ahead end up in the center and objects right behind the player on the unit circle. This is the
+ * expensive part of plotting a blip, the gauges only have to clamp and scale the results to their size.
+ *
+ * @param x, y, z Eye space positions
+ * @param dist Distances to the player
+ * @param count How many positions there are
+ * @param out_x, out_y The radar positions, within +/- 1
+ */
+void project_flat(const float* x, const float* y, const float* z, const float* dist, size_t count, float* out_x,
+                  float* out_y);
+
+}
@@ -31,8 +31,19 @@
 #include "weapon/emp.h"
 #include "weapon/weapon.h"
 
+#include <algorithm>
+
 #define RADIANS_PER_DEGREE (PI / 180.0f)
 
+namespace {
+// contacts collected by queueContact(), two triangles per contact and one list per texture
+struct contact_batch {
+	int texture;
+	SCP_vector<vertex> verts;
+};
+SCP_vector<contact_batch> Contact_batches;
+}
+
 HudGaugeRadarDradis::HudGaugeRadarDradis():
 HudGaugeRadar(HUD_OBJECT_RADAR_BSG, 255, 255, 255), 
 xy_plane(-1), xz_yz_plane(-1), sweep_plane(-1), target_brackets(-1), unknown_contact_icon(-1), sweep_duration(6.0), sweep_percent(0.0), scale(1.20f), sub_y_clip(false)
@@ -193,6 +204,83 @@ void HudGaugeRadarDradis::drawContact(vec3d *pnt, int idx, int clr_idx, float  /
     }
 }
 
+void HudGaugeRadarDradis::queueContact(vec3d *pnt, int clr_idx, float alpha, float scale_factor)
+{
+	int h, w;
+	float aspect_mp;
+
+	if (clr_idx < 0)
+		return;
+
+	if ((sub_y_clip && (pnt->xyz.y > 0)) || ((!sub_y_clip) && (pnt->xyz.y <= 0)))
+		return;
+
+	float sizef = fl_sqrt(vm_vec_dist(&Orb_eye_position, pnt) * 8.0f) * scale_factor;
+
+	bm_get_info(clr_idx, &w, &h);
+
+	if (h == w) {
+		aspect_mp = 1.0f;
+	} else {
+		aspect_mp = (((float) h) / ((float) w));
+	}
+
+	float width = sizef / 35.0f;
+	float height = aspect_mp * sizef / 35.0f;
+
+	auto batch = std::find_if(Contact_batches.begin(), Contact_batches.end(),
+		[clr_idx](const contact_batch& cb) { return cb.texture == clr_idx; });
+	if (batch == Contact_batches.end()) {
+		Contact_batches.push_back(contact_batch());
+		batch = Contact_batches.end() - 1;
+		batch->texture = clr_idx;
+	}
+
+	// the quad g3_render_rect_oriented() draws with the identity matrix, with the alpha moved into the vertex colors
+	vertex corners[4];
+	memset(corners, 0, sizeof(corners));
+
+	const float corner_x[4] = { width, -width, -width, width };
+	const float corner_y[4] = { height, height, -height, -height };
+	const float corner_u[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+	const float corner_v[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	ubyte vert_alpha = (ubyte) fl2i(alpha * 255.0f);
+
+	for (int i = 0; i < 4; i++) {
+		vec3d corner = *pnt;
+		corner.xyz.x += corner_x[i];
+		corner.xyz.y += corner_y[i];
+
+		g3_transfer_vertex(&corners[i], &corner);
+		corners[i].texture_position.u = corner_u[i];
+		corners[i].texture_position.v = corner_v[i];
+		corners[i].r = corners[i].g = corners[i].b = 255;
+		corners[i].a = vert_alpha;
+	}
+
+	batch->verts.push_back(corners[0]);
+	batch->verts.push_back(corners[1]);
+	batch->verts.push_back(corners[2]);
+	batch->verts.push_back(corners[0]);
+	batch->verts.push_back(corners[2]);
+	batch->verts.push_back(corners[3]);
+}
+
+void HudGaugeRadarDradis::flushContacts()
+{
+	for (auto& batch : Contact_batches) {
+		if (batch.verts.empty())
+			continue;
+
+		material mat_params;
+		material_set_unlit_color(&mat_params, batch.texture, &Color_bright_white, true, false);
+		g3_render_primitives_colored_textured(&mat_params, batch.verts.data(), (int) batch.verts.size(), PRIM_TYPE_TRIS, false);
+
+		batch.verts.clear();
+	}
+}
+
 // radar is damaged, so make blips dance around
 void HudGaugeRadarDradis::blipDrawDistorted(blip *b, vec3d *pos, float alpha)
 {
@@ -227,7 +315,7 @@ void HudGaugeRadarDradis::blipDrawFlicker(blip *b, vec3d *pos, float alpha)
 	vec3d out;
 	float distortion_angle=10;
 
-	if ((b-Blips) & 1)
+	if ((b-Blips.data()) & 1)
 		flicker_index=0;
 	else
 		flicker_index=1;
@@ -315,13 +403,17 @@ void HudGaugeRadarDradis::drawBlips(int blip_type, int bright, int distort)
 		} else {
 			if (b->flags & BLIP_DRAW_DISTORTED) {
 				blipDrawFlicker(b, &pos, alpha);
-			} else if (b->radar_image_2d >= 0 || b->radar_color_image_2d >= 0) {
+			} else if (b->radar_image_2d >= 0) {
 				drawContact(&pos, b->radar_image_2d, b->radar_color_image_2d, b->dist, alpha, scale_factor);
+			} else if (b->radar_color_image_2d >= 0) {
+				queueContact(&pos, b->radar_color_image_2d, alpha, scale_factor);
 			} else {
-				drawContact(&pos, -1, unknown_contact_icon, b->dist, alpha, scale_factor);
+				queueContact(&pos, unknown_contact_icon, alpha, scale_factor);
 			}
 		}
 	}
+
+	flushContacts();
 }
 
 void HudGaugeRadarDradis::setupViewHtl()
@@ -454,6 +546,8 @@ void HudGaugeRadarDradis::drawBlipsSorted(int distort)
 {
 	GR_DEBUG_SCOPE("Draw Dradis blips");
 
+	radar_build_blips();
+
 	matrix base_tilt = vmd_identity_matrix;
 	
 	vm_angle_2_matrix(&base_tilt, -PI/6, 0);
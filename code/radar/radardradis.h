@@ -75,6 +75,9 @@ public:
 	void drawBlips(int blip_type, int bright, int distort);
 	void drawBlipsSorted(int distort);
 	void drawContact(vec3d *pnt, int idx, int clr_idx, float dist, float alpha, float scale_factor);
+	// Same as drawContact() with idx == -1, but only collects the contact until flushContacts() draws all of them at once
+	void queueContact(vec3d *pnt, int clr_idx, float alpha, float scale_factor);
+	void flushContacts();
 	void drawSweeps();
 	void doneDrawingHtl();
 	void drawOutlinesHtl();
@@ -202,7 +202,7 @@ void HudGaugeRadarOrb::blipDrawFlicker(blip *b, vec3d *pos)
 	vec3d out;
 	float distortion_angle=10;
 
-	if ( (b-Blips) & 1 ) {
+	if ( (b-Blips.data()) & 1 ) {
 		flicker_index=0;
 	} else {
 		flicker_index=1;
@@ -295,6 +295,8 @@ void HudGaugeRadarOrb::drawBlips(int blip_type, int bright, int distort)
 
 void HudGaugeRadarOrb::drawBlipsSorted(int distort)
 {
+	radar_build_blips();
+
 	g3_start_instance_matrix(&vmd_zero_vector, &view_perturb, false);
 
 	vm_vec_zero(&target_position);
@@ -23,6 +23,7 @@
 #include "object/object.h"
 #include "playerman/player.h"
 #include "radar/radar.h"
+#include "radar/radarcontacts.h"
 #include "radar/radarorb.h"
 #include "radar/radarsetup.h"
 #include "ship/awacs.h"
@@ -74,9 +75,12 @@ color Radar_colors[MAX_RADAR_COLORS][MAX_RADAR_LEVELS];
 blip	Blip_bright_list[MAX_BLIP_TYPES];		// linked list of bright blips
 blip	Blip_dim_list[MAX_BLIP_TYPES];			// linked list of dim blips
 
-blip	Blips[MAX_BLIPS];								// blips pool
+SCP_vector<blip> Blips;								// blips pool
 int	N_blips;											// next blip index to take from pool
 
+static radar::contact_list Radar_contacts;		// everything plotted this frame
+static bool Radar_blips_built = false;			// have the blips been made from Radar_contacts yet?
+
 float	Radar_bright_range;					// range at which we start dimming the radar blips
 int		Radar_calc_bright_dist_timer;		// timestamp at which we recalc Radar_bright_range
 
@@ -144,10 +148,20 @@ void radar_stuff_blip_info(object *objp, int is_bright, color **blip_color, int
 	}
 }
 
+void radar_null_nblips()
+{
+	int i;
+
+	N_blips=0;
+
+	for (i=0; i<MAX_BLIP_TYPES; i++) {
+		list_init(&Blip_bright_list[i]);
+		list_init(&Blip_dim_list[i]);
+	}
+}
+
 void radar_plot_object( object *objp )
 {
-	vec3d pos, tempv;
-	float awacs_level, dist, max_radar_dist;
 	vec3d world_pos = objp->pos;
 	SCP_list<CJumpNode>::iterator jnp;
 
@@ -167,27 +181,6 @@ void radar_plot_object( object *objp )
 		return;
 	}
 
-	// get team-wide awacs level for the object if not ship
-	int ship_is_visible = 0;
-	if (objp->type == OBJ_SHIP) {
-		if (Player_ship != NULL) {
-			if (ship_is_visible_by_team(objp, Player_ship)) {
-				ship_is_visible = 1;
-			}
-		}
-	}
-
-	// only check awacs level if ship is not visible by team
-	awacs_level = 1.5f;
-	if (Player_ship != NULL && !ship_is_visible) {
-		awacs_level = awacs_get_level(objp, Player_ship);
-	}
-
-	// if the awacs level is unviewable - bail
-	if(awacs_level < 0.0f && !See_all){
-		return;
-	}
-
 	// Apply object type filters	
 	switch (objp->type)
 	{
@@ -241,44 +234,40 @@ void radar_plot_object( object *objp )
 			return;
 	}
 
-	// Retrieve the eye orientation so we can position the blips relative to it
-	matrix eye_orient;
+	// The rest (range, AWACS, blip type) is done for all contacts at once when the radar is drawn
+	Radar_contacts.add(OBJ_INDEX(objp), objp->signature, world_pos);
+	Radar_blips_built = false;
+}
 
-	if (Player_obj->type == OBJ_SHIP) 
-		ship_get_eye(&tempv, &eye_orient, Player_obj, false , false);
-	else
-		eye_orient = Player_obj->orient;
+static void radar_add_blip(object *objp, const vec3d *pos, float dist)
+{
+	float awacs_level;
 
-	// JAS -- new way of getting the rotated point that doesn't require this to be
-	// in a g3_start_frame/end_frame block.
-	vm_vec_sub(&tempv, &world_pos, &Player_obj->pos);
-	vm_vec_rotate(&pos, &tempv, &eye_orient);
+	// get team-wide awacs level for the object if not ship
+	int ship_is_visible = 0;
+	if (objp->type == OBJ_SHIP) {
+		if (Player_ship != NULL) {
+			if (ship_is_visible_by_team(objp, Player_ship)) {
+				ship_is_visible = 1;
+			}
+		}
+	}
 
-	// Apply range filter
-	dist = vm_vec_dist(&world_pos, &Player_obj->pos);
-	max_radar_dist = Radar_ranges[HUD_config.rp_dist];
-	if (dist > max_radar_dist) {
-		return;
+	// only check awacs level if ship is not visible by team
+	awacs_level = 1.5f;
+	if (Player_ship != NULL && !ship_is_visible) {
+		awacs_level = awacs_get_level(objp, Player_ship);
 	}
 
-	// determine the range within which the radar blip is bright
-	if (timestamp_elapsed(Radar_calc_bright_dist_timer))
-	{
-		Radar_calc_bright_dist_timer = timestamp(1000);
-		Radar_bright_range = player_farthest_weapon_range();
-		if (Radar_bright_range <= 0)
-			Radar_bright_range = 1500.0f;
+	// if the awacs level is unviewable - bail
+	if(awacs_level < 0.0f && !See_all){
+		return;
 	}
 
 	blip *b;
 	int blip_bright = 0;
 	int blip_type = 0;
 
-	if (N_blips >= MAX_BLIPS)
-	{
-		return;
-	}
-
 	b = &Blips[N_blips];
 	b->flags = 0;
 
@@ -299,7 +288,7 @@ void radar_plot_object( object *objp )
 	else
 		list_append(&Blip_dim_list[blip_type], b);
 
-	b->position = pos;
+	b->position = *pos;
 	b->dist = dist;
 	b->objp = objp;
 	b->radar_image_2d = -1;
@@ -341,6 +330,65 @@ void radar_plot_object( object *objp )
 	N_blips++;
 }
 
+void radar_build_blips()
+{
+	if (Radar_blips_built) {
+		return;
+	}
+	Radar_blips_built = true;
+
+	radar_null_nblips();
+
+	if (Radar_contacts.size() == 0 || Player_obj == NULL) {
+		return;
+	}
+
+	// Retrieve the eye orientation so we can position the blips relative to it
+	matrix eye_orient;
+
+	if (Player_obj->type == OBJ_SHIP) {
+		vec3d eye_pos;
+		ship_get_eye(&eye_pos, &eye_orient, Player_obj, false , false);
+	} else {
+		eye_orient = Player_obj->orient;
+	}
+
+	Radar_contacts.project(Player_obj->pos, eye_orient);
+
+	// determine the range within which the radar blip is bright
+	if (timestamp_elapsed(Radar_calc_bright_dist_timer))
+	{
+		Radar_calc_bright_dist_timer = timestamp(1000);
+		Radar_bright_range = player_farthest_weapon_range();
+		if (Radar_bright_range <= 0)
+			Radar_bright_range = 1500.0f;
+	}
+
+	// The blips are linked into lists so the pool can't move once the first one has been added. Slots are reused from
+	// frame to frame since DRADIS keeps the sweep fade of a blip in it.
+	if (Blips.size() < Radar_contacts.size()) {
+		Blips.resize(Radar_contacts.size());
+	}
+
+	float max_radar_dist = Radar_ranges[HUD_config.rp_dist];
+
+	for (size_t i = 0; i < Radar_contacts.size(); ++i) {
+		// Apply range filter
+		if (Radar_contacts.dist(i) > max_radar_dist) {
+			continue;
+		}
+
+		// the object may have died since it was plotted
+		object *objp = &Objects[Radar_contacts.objnum(i)];
+		if ((objp->type == OBJ_NONE) || (objp->signature != Radar_contacts.signature(i))) {
+			continue;
+		}
+
+		vec3d pos = Radar_contacts.eye_pos(i);
+		radar_add_blip(objp, &pos, Radar_contacts.dist(i));
+	}
+}
+
 void radar_mission_init()
 {
 	for (int i=0; i<MAX_RADAR_COLORS; i++ )	{
@@ -356,21 +404,12 @@ void radar_mission_init()
 	Radar_calc_bright_dist_timer = timestamp(0);
 }
 
-void radar_null_nblips()
-{
-	int i;
-
-	N_blips=0;
-
-	for (i=0; i<MAX_BLIP_TYPES; i++) {
-		list_init(&Blip_bright_list[i]);
-		list_init(&Blip_dim_list[i]);
-	}
-}
-
 void radar_frame_init()
 {
 	radar_null_nblips();
+
+	Radar_contacts.clear();
+	Radar_blips_built = false;
 }
 
 HudGaugeRadar::HudGaugeRadar():
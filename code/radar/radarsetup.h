@@ -42,9 +42,6 @@ typedef struct blip	{
 	object* objp;
 } blip;
 
-
-#define MAX_BLIPS 150
-
 #define	MAX_RADAR_COLORS		5
 #define MAX_RADAR_LEVELS		2		// bright and dim radar dots are allowed
 
@@ -68,7 +65,7 @@ extern rcol Radar_color_rgb[MAX_RADAR_COLORS][MAX_RADAR_LEVELS];
 extern blip	Blip_bright_list[MAX_BLIP_TYPES];		// linked list of bright blips
 extern blip	Blip_dim_list[MAX_BLIP_TYPES];			// linked list of dim blips
 
-extern blip	Blips[MAX_BLIPS];								// blips pool
+extern SCP_vector<blip> Blips;								// blips pool
 extern int	N_blips;										// next blip index to take from pool
 
 // blip flags
@@ -91,6 +88,10 @@ enum RadarVisibility
 void radar_frame_init();
 void radar_mission_init();
 void radar_plot_object( object *objp );
+
+// Turns everything radar_plot_object() collected this frame into blips, only does the work once per frame
+void radar_build_blips();
+
 RadarVisibility radar_is_visible( object *objp );
 
 extern sound_handle Radar_static_looping;
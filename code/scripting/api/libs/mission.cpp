@@ -381,7 +381,7 @@ ADE_INDEXER(l_Mission_Waypoints, "number Index", "Array of waypoints in the curr
 ADE_FUNC(__len, l_Mission_Waypoints, NULL, "Gets number of waypoints in mission. Note that this is only accurate for one frame.", "number", "Number of waypoints in the mission")
 {
 	uint count=0;
-	for(uint i = 0; i < MAX_OBJECTS; i++)
+	for(int i = 0; i < objects_size(); i++)
 	{
 		if (Objects[i].type == OBJ_WAYPOINT)
 			count++;
@@ -435,7 +435,7 @@ ADE_INDEXER(l_Mission_Weapons, "number Index", "Gets handle to a weapon object i
 	//Remember, Lua indices start at 0.
 	int count=1;
 
-	for(int i = 0; i < MAX_WEAPONS; i++)
+	for(int i = 0; i < weapons_size(); i++)
 	{
 		if (Weapons[i].weapon_info_index < 0 || Weapons[i].objnum < 0 || Objects[Weapons[i].objnum].type != OBJ_WEAPON)
 			continue;
@@ -32,7 +32,7 @@ ADE_VIRTVAR(Target, l_Asteroid, "object", "Asteroid target object; may be object
 			asp->target_objnum = -1;
 	}
 
-	if(asp->target_objnum > 0 && asp->target_objnum < MAX_OBJECTS)
+	if(asp->target_objnum > 0 && asp->target_objnum < objects_size())
 		return ade_set_object_with_breed(L, asp->target_objnum);
 	else
 		return ade_set_error(L, "o", l_Object.Set(object_h()));
@@ -58,6 +58,7 @@ ADE_VIRTVAR(Name, l_Shipclass, "string", "Ship class name", "string", "Ship clas
 
 	if(ADE_SETTING_VAR && s != NULL) {
 		strncpy(Ship_info[idx].name, s, sizeof(Ship_info[idx].name)-1);
+		ship_info_name_changed(idx);
 	}
 
 	return ade_set_args(L, "s", Ship_info[idx].name);
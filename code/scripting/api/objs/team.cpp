@@ -32,6 +32,7 @@ ADE_VIRTVAR(Name, l_Team, "string", "Team name", "string", "Team name, or empty
 
 	if(ADE_SETTING_VAR && s != NULL) {
 		strncpy(Iff_info[tdx].iff_name, s, NAME_LENGTH-1);
+		iff_name_changed(tdx);
 	}
 
 	return ade_set_args(L, "s", Iff_info[tdx].iff_name);
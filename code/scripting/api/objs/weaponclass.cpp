@@ -52,6 +52,7 @@ ADE_VIRTVAR(Name, l_Weaponclass, "string", "Weapon class name. This is the possi
 
 	if(ADE_SETTING_VAR && s != NULL) {
 		strncpy(Weapon_info[idx].name, s, sizeof(Weapon_info[idx].name)-1);
+		weapon_info_name_changed(idx);
 	}
 
 	return ade_set_args(L, "s", Weapon_info[idx].name);
@@ -87,6 +87,7 @@
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/name_index.h"
 
 
 using namespace Ship;
@@ -123,6 +124,9 @@ int	Num_wings = 0;
 int	Num_reinforcements = 0;
 ship	Ships[MAX_SHIPS];
 
+// Ships[] slots which aren't in use, so that ship_create() doesn't have to search for one
+static SCP_vector<int> Ship_free_slots;
+
 ship	*Player_ship;
 int		*Player_cockpit_textures;
 SCP_vector<cockpit_display> Player_displays;
@@ -189,6 +193,8 @@ ship_obj		Ship_objs[MAX_SHIP_OBJS];		// array used to store ship object indexes
 ship_obj		Ship_obj_list;							// head of linked list of ship_obj structs
 
 SCP_vector<ship_info>	Ship_info;
+static util::name_index Ship_info_names([]() { return ship_info_size(); },
+                                        [](int index) -> const char* { return Ship_info[index].name; });
 reinforcements	Reinforcements[MAX_REINFORCEMENTS];
 SCP_vector<ship_info>	Ship_templates;
 
@@ -1848,6 +1854,7 @@ static void parse_ship(const char *filename, bool replace)
 		if (ship_id >= 0) {
 			mprintf(("Removing previously parsed ship '%s'\n", fname));
 			Ship_info.erase(Ship_info.begin() + ship_id);
+			Ship_info_names.invalidate();
 		}
 
 		if (!skip_to_start_of_string_either("$Name:", "#End")) {
@@ -5384,6 +5391,7 @@ void ship_init()
 			//Parse main TBL first
 			Removed_ships.clear();
 			Ship_info.clear();
+			Ship_info_names.invalidate();
 			parse_shiptbl("ships.tbl");
 
 			//Then other ones
@@ -5469,10 +5477,12 @@ void ship_level_init()
 	// Reset everything between levels
 	Ships_exited.clear(); 
 	Ships_exited.reserve(100);
-	for (i=0; i<MAX_SHIPS; i++ )
+	Ship_free_slots.clear();
+	for (i=MAX_SHIPS-1; i>=0; i-- )
 	{
 		Ships[i].ship_name[0] = '\0';
 		Ships[i].objnum = -1;
+		Ship_free_slots.push_back(i);
 	}
 
 	Num_wings = 0;
@@ -5972,6 +5982,8 @@ void ship::clear()
 		np_updates[i].subsys_update_stamp = -1;
 		np_updates[i].pos_chksum = 0;
 		np_updates[i].orient_chksum = 0;
+		np_updates[i].priority = 0.0f;
+		multi_oo_clear_snapshots(&np_updates[i]);
 	}
 
 	lightning_stamp = timestamp(-1);
@@ -7265,6 +7277,7 @@ void ship_delete( object * obj )
 	// on ship back to the free list for other ships to use.
 	ship_subsystems_delete(&Ships[num]);
 	shipp->objnum = -1;
+	Ship_free_slots.push_back(num);
 
 	if (shipp->shield_integrity != NULL) {
 		vm_free(shipp->shield_integrity);
@@ -9432,16 +9445,14 @@ int ship_create(matrix* orient, vec3d* pos, int ship_type, const char* ship_name
 		}
 	}
 
-	for (n=0; n<MAX_SHIPS; n++){
-		if (Ships[n].objnum == -1){
-			break;
-		}
-	}
-
-	if (n == MAX_SHIPS){
+	if (Ship_free_slots.empty()){
 		return -1;
 	}
 
+	n = Ship_free_slots.back();
+	Ship_free_slots.pop_back();
+	Assert(Ships[n].objnum == -1);
+
 	Assertion((ship_type >= 0) && (ship_type < ship_info_size()), "Invalid ship_type %d passed to ship_create() (expected value in the range 0-%d)\n", ship_type, ship_info_size()-1);
 	sip = &(Ship_info[ship_type]);
 	shipp = &Ships[n];
@@ -9805,7 +9816,7 @@ void change_ship_type(int n, int ship_type, int by_sexp)
 			}
 		}
 
-		for (i = 0; i < MAX_WEAPONS; i++) {
+		for (i = 0; i < weapons_size(); i++) {
 			if (Weapons[i].objnum == -1) {
 				continue;
 			}
@@ -11686,7 +11697,7 @@ static int maybe_detonate_weapon(ship_weapon *swp, object* /*src*/)
 	object		*objp;
 	weapon_info	*wip;
 
-	if ((objnum < 0) || (objnum >= MAX_OBJECTS)) {
+	if ((objnum < 0) || (objnum >= objects_size())) {
 		return 0;
 	}
 	
@@ -11696,7 +11707,7 @@ static int maybe_detonate_weapon(ship_weapon *swp, object* /*src*/)
 		return 0;
 	}
 
-	if ((objp->instance < 0) || (objp->instance >= MAX_WEAPONS)){
+	if ((objp->instance < 0) || (objp->instance >= weapons_size())){
 		return 0;
 	}
 
@@ -11741,7 +11752,7 @@ static int ship_fire_secondary_detonate(object *obj, ship_weapon *swp)
 				// check for currently locked missiles (highest precedence)
 				for ( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
 					object	*mobjp;
-					Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+					Assert(mo->objnum >= 0 && mo->objnum < objects_size());
 					mobjp = &Objects[mo->objnum];
 					if ((mobjp != first_objp) && (mobjp->parent_sig == obj->parent_sig)) {
 						if (Weapon_info[Weapons[mobjp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Remote]) {
@@ -12736,11 +12747,12 @@ static int ship_info_lookup_sub(const char *token)
 {
 	Assertion(token != nullptr, "NULL token passed to ship_info_lookup_sub");
 
-	for (auto it = Ship_info.cbegin(); it != Ship_info.cend(); ++it)
-		if (!stricmp(token, it->name))
-			return (int)std::distance(Ship_info.cbegin(), it);
+	return Ship_info_names.find(token);
+}
 
-	return -1;
+void ship_info_name_changed(int ship_info_index)
+{
+	Ship_info_names.add(ship_info_index);
 }
 
 /**
@@ -14119,6 +14131,7 @@ void ship_close()
 
 	// free info from parsed table data
 	Ship_info.clear();
+	Ship_info_names.invalidate();
 
 	for (i = 0; i < (int)Ship_types.size(); i++) {
 		Ship_types[i].ai_actively_pursues.clear();
@@ -15051,18 +15064,18 @@ static int ship_has_homing_missile_locked(ship *shipp)
 	weapon_info	*wip;
 	missile_obj	*mo;
 
-	Assert(shipp->objnum >= 0 && shipp->objnum < MAX_OBJECTS);
+	Assert(shipp->objnum >= 0 && shipp->objnum < objects_size());
 	locked_objp = &Objects[shipp->objnum];
 
 	// check for currently locked missiles (highest precedence)
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < objects_size());
 		A = &Objects[mo->objnum];
 
 		if (A->type != OBJ_WEAPON)
 			continue;
 
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < weapons_size()));
 		wp = &Weapons[A->instance];
 		wip = &Weapon_info[wp->weapon_info_index];
 
@@ -1467,6 +1467,8 @@ extern void physics_ship_init(object *objp);
 extern int get_subsystem_pos(vec3d *pos, object *objp, ship_subsys *subsysp);
 
 extern int ship_info_lookup(const char *name);
+// has to be called when the name of a ship class is changed after it was parsed
+extern void ship_info_name_changed(int ship_info_index);
 extern int ship_name_lookup(const char *name, int inc_players = 0);	// returns the index into Ship array of name
 extern int ship_type_name_lookup(const char *name);
 
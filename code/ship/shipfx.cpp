@@ -503,7 +503,7 @@ static int shipfx_special_warp_objnum_valid(int objnum)
 	object *special_objp;
 
 	// must be a valid object
-	if ((objnum < 0) || (objnum >= MAX_OBJECTS))
+	if ((objnum < 0) || (objnum >= objects_size()))
 		return 0;
 
 	special_objp = &Objects[objnum];
@@ -1572,8 +1572,8 @@ static void ship_vaporize(ship *shipp)
 	if(shipp == NULL){
 		return;
 	}
-	Assert((shipp->objnum >= 0) && (shipp->objnum < MAX_OBJECTS));
-	if((shipp->objnum < 0) || (shipp->objnum >= MAX_OBJECTS)){
+	Assert((shipp->objnum >= 0) && (shipp->objnum < objects_size()));
+	if((shipp->objnum < 0) || (shipp->objnum >= objects_size())){
 		return;
 	}
 	ship_objp = &Objects[shipp->objnum];
@@ -2022,7 +2022,7 @@ static void ship_do_damage(object *ship_objp, object *other_obj, vec3d *hitpos,
 	// Goober5000 - check to see what other_obj is
 	if (other_obj)
 	{
-		other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < MAX_WEAPONS));
+		other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < weapons_size()));
 		other_obj_is_beam = ((other_obj->type == OBJ_BEAM) && (other_obj->instance >= 0) && (other_obj->instance < MAX_BEAMS));
 		other_obj_is_shockwave = ((other_obj->type == OBJ_SHOCKWAVE) && (other_obj->instance >= 0) && (other_obj->instance < MAX_SHOCKWAVES));
 		other_obj_is_asteroid = ((other_obj->type == OBJ_ASTEROID) && (other_obj->instance >= 0) && (other_obj->instance < MAX_ASTEROIDS));
@@ -2299,7 +2299,7 @@ static void ship_do_damage(object *ship_objp, object *other_obj, vec3d *hitpos,
 						// don't call scoring for asteroids
 						break;
 					case OBJ_WEAPON:
-						if((other_obj->parent < 0) || (other_obj->parent >= MAX_OBJECTS)){
+						if((other_obj->parent < 0) || (other_obj->parent >= objects_size())){
 							scoring_add_damage(ship_objp, NULL, damage);
 						} else {
 							scoring_add_damage(ship_objp, &Objects[other_obj->parent], damage);
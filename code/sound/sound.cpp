@@ -24,6 +24,7 @@
 #include "sound/ds.h"
 #include "sound/ds3d.h"
 #include "sound/dscap.h"
+#include "sound/soundcache.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
@@ -36,6 +37,10 @@
 const unsigned int SND_ENHANCED_MAX_LIMIT = 15; // seems like a good max limit
 
 #define SND_F_USED			(1<<0)		// Sounds[] element is used
+#define SND_F_RETAINED		(1<<1)		// Sounds[] element isn't used anymore but still has its buffer, see snd_unload()
+
+// unloaded sounds keep their buffers up to this many bytes so the next level can use them right away
+#define SND_RETAINED_MAX_BYTES	(64 * 1024 * 1024)
 
 struct loaded_sound {
 	int sid; // software id
@@ -45,10 +50,20 @@ struct loaded_sound {
 	sound_info info;
 	int uncompressed_size; // size (in bytes) of sound (uncompressed)
 	int duration;
+	int refs;				// number of snd_load() calls not matched by snd_unload() yet
+	uint retained_order;	// when the sound was retained, the oldest one is freed first
 };
 
 SCP_vector<loaded_sound> Sounds;
 
+static size_t Snd_retained_bytes = 0;
+static uint Snd_retained_count = 0;
+
+// where the sound data loaded since the last snd_report_level_load() came from
+static size_t Snd_bytes_decoded = 0;
+static size_t Snd_bytes_cached = 0;
+static size_t Snd_bytes_retained = 0;
+
 int Sound_enabled = FALSE;				// global flag to turn sound on/off
 size_t Snd_sram;								// mem (in bytes) used up by storing sounds in system memory
 
@@ -278,6 +293,43 @@ void snd_spew_debug_info()
 	gr_printf_no_resize(sx, sy, "Total sounds : %d\n", game_sounds + interface_sounds + message_sounds);
 }
 
+#ifndef NDEBUG
+static void snd_check_3d_channels(const char* filename, int num_channels)
+{
+	if (num_channels <= 1) {
+		return;
+	}
+
+	// Retail has a few sounds that triggers this warning so we need to ignore those
+	const char* warning_ignore_list[] = {
+		"l_hit.wav",
+		"m_hit.wav",
+		"s_hit_2.wav",
+		"Pirate.wav",
+	};
+
+	for (auto& name : warning_ignore_list) {
+		if (!stricmp(name, filename)) {
+			return;
+		}
+	}
+
+	if (mod_supports_version(3, 8, 0)) {
+		// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
+		// with more than one channel. This will silence the warnings for any mod that does not support
+		// 3.8.0.
+		Warning(LOCATION,
+				"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
+				"one channel.",
+				filename);
+	} else {
+		mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
+				 "only have one channel.\n",
+				 filename));
+	}
+}
+#endif
+
 static std::unique_ptr<sound::IAudioFile> openAudioFile(const char* fileName)
 {
 #ifdef WITH_FFMPEG
@@ -320,9 +372,12 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 	if (!VALID_FNAME(entry->filename))
 		return sound_load_id::invalid();
 
+	size_t free_slot = Sounds.size();
+
 	for (n = 0; n < Sounds.size(); n++) {
-		if ( !(Sounds[n].flags & SND_F_USED) ) {
-			break;
+		if ( !(Sounds[n].flags & (SND_F_USED | SND_F_RETAINED)) ) {
+			if (free_slot == Sounds.size())
+				free_slot = n;
 		} else if ( !stricmp( Sounds[n].filename, entry->filename) ) {
 			// extra check: make sure the sound is actually loaded in a compatible way (2D vs. 3D)
 			//
@@ -330,11 +385,25 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 			//       but will not load a duplicate 2D entry to get stereo if 3D
 			//       version already loaded
 			if ( (Sounds[n].info.n_channels == 1) || !(flags & GAME_SND_USE_DS3D) ) {
+				if (Sounds[n].flags & SND_F_RETAINED) {
+					// still has its buffer from an earlier level
+					Sounds[n].flags = SND_F_USED;
+					Sounds[n].refs = 0;
+					Snd_retained_bytes -= Sounds[n].uncompressed_size;
+					Snd_bytes_retained += Sounds[n].uncompressed_size;
+
+					entry->id_sig = Sounds[n].sig;
+					entry->id     = sound_load_id(static_cast<int>(n));
+				}
+
+				Sounds[n].refs++;
 				return sound_load_id(static_cast<int>(n));
 			}
 		}
 	}
 
+	n = free_slot;
+
 	if ( n == Sounds.size() ) {
 		loaded_sound new_sound;
 		new_sound.sid   = -1;
@@ -351,61 +420,54 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 
 	nprintf(("Sound", "SOUND ==> Loading '%s'\n", entry->filename));
 
-	std::unique_ptr<sound::IAudioFile> audio_file = openAudioFile(entry->filename);
+	type = 0;
+	if (flags & GAME_SND_USE_DS3D) {
+		type |= DS_3D;
+	}
+
+	// decoding is the slow part of loading a sound, so see if it has been done before
+	auto cache_key = snd_cache_get_key(entry->filename, (type & DS_3D) != 0);
+	int source_channels = 1;
+	bool cached = true;
+
+	auto audio_file = snd_cache_load(cache_key, &source_channels);
 
 	if (audio_file == nullptr) {
-		return sound_load_id::invalid();
-	}
+		cached = false;
 
-	auto fileProps = audio_file->getFileProperties();
+		auto decoder = openAudioFile(entry->filename);
 
-	type = 0;
-	if (flags & GAME_SND_USE_DS3D) {
-		type |= DS_3D;
+		if (decoder == nullptr) {
+			return sound_load_id::invalid();
+		}
+
+		source_channels = decoder->getFileProperties().num_channels;
 
-		if (fileProps.num_channels > 1) {
+		if ((type & DS_3D) && source_channels > 1) {
 			// We need to resample the audio down to one channel
 			sound::ResampleProperties resample;
 			resample.num_channels = 1;
 
-			audio_file->setResamplingProperties(resample);
-			fileProps = audio_file->getFileProperties(); // Refresh properties so that we have accurate information
+			decoder->setResamplingProperties(resample);
+		}
 
-#ifndef NDEBUG
-			// Retail has a few sounds that triggers this warning so we need to ignore those
-			const char* warning_ignore_list[] = {
-				"l_hit.wav",
-				"m_hit.wav",
-				"s_hit_2.wav",
-				"Pirate.wav",
-			};
-
-			bool show_warning = true;
-			for (auto& name : warning_ignore_list) {
-				if (!stricmp(name, entry->filename)) {
-					show_warning = false;
-					break;
-				}
-			}
+		audio_file = sound::PcmAudioFile::decode(decoder.get());
 
-			if (show_warning) {
-				if (mod_supports_version(3, 8, 0)) {
-					// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
-					// with more than one channel. This will silence the warnings for any mod that does not support
-					// 3.8.0.
-					Warning(LOCATION,
-							"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
-							"one channel.",
-							entry->filename);
-				} else {
-					mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
-							 "only have one channel.\n",
-							 entry->filename));
-				}
-			}
-#endif
+		if (audio_file == nullptr) {
+			nprintf(("Sound", "SOUND ==> Could not decode '%s'\n", entry->filename));
+			return sound_load_id::invalid();
 		}
+
+		snd_cache_save(cache_key, *audio_file, source_channels);
+	}
+
+#ifndef NDEBUG
+	if (type & DS_3D) {
+		snd_check_3d_channels(entry->filename, source_channels);
 	}
+#endif
+
+	auto fileProps = audio_file->getFileProperties();
 
 	// Load was a success
 	si->n_channels        = fileProps.num_channels; // 16-bit channel count (nChannels)
@@ -423,11 +485,17 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 		return sound_load_id::invalid();
 	}
 
+	if (cached)
+		Snd_bytes_cached += audio_file->data().size();
+	else
+		Snd_bytes_decoded += audio_file->data().size();
+
 	// NOTE: "si" values can change once loaded in the buffer
 	snd->duration = fl2i(1000.0f * fileProps.duration);
 
 	strcpy_s( snd->filename, entry->filename );
 	snd->flags = SND_F_USED;
+	snd->refs = 1;
 
 	snd->sig = snd_next_sig++;
 	if (snd_next_sig < 0 ) snd_next_sig = 1;
@@ -439,11 +507,54 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 	return sound_load_id(static_cast<int>(n));
 }
 
+// frees the buffer of a sound for good
+static void snd_release(size_t n)
+{
+	auto& snd = Sounds[n];
+
+	ds_unload_buffer(snd.sid);
+
+	if (snd.sid != -1) {
+		Snd_sram -= snd.uncompressed_size;
+	}
+
+	if (snd.flags & SND_F_RETAINED) {
+		Snd_retained_bytes -= snd.uncompressed_size;
+	}
+
+	//If this sound is at the end of the array, we might as well get rid of it
+	if (n == Sounds.size() - 1) {
+		Sounds.pop_back();
+	} else {
+		snd.sid = -1;
+		snd.flags = 0;
+	}
+}
+
+// frees the sounds which were retained first until the rest fits into the budget
+static void snd_release_retained()
+{
+	while (Snd_retained_bytes > SND_RETAINED_MAX_BYTES) {
+		size_t oldest = Sounds.size();
+
+		for (size_t n = 0; n < Sounds.size(); n++) {
+			if ((Sounds[n].flags & SND_F_RETAINED) && (oldest == Sounds.size() || Sounds[n].retained_order < Sounds[oldest].retained_order))
+				oldest = n;
+		}
+
+		if (oldest == Sounds.size())
+			break;
+
+		snd_release(oldest);
+	}
+}
+
 // ---------------------------------------------------------------------------------------
 // snd_unload() 
 //
-// Unload a sound from memory.  This will release the storage, and the sound must be re-loaded via
-// sound_load() before it can be played again.
+// Unload a sound from memory.  The sound must be re-loaded via sound_load() before it can be played again.
+// Every snd_load() call holds a reference; when the last one goes away the buffer is retained for a while,
+// since the next level very likely uses most of the same sounds.  Loading the sound again then just picks it up.
 //
 int snd_unload(sound_load_id n)
 {
@@ -460,34 +571,57 @@ int snd_unload(sound_load_id n)
 
 	auto& snd = Sounds[n.value()];
 
-	ds_unload_buffer(snd.sid);
+	if ( !(snd.flags & SND_F_USED) ) {
+		return 0;
+	}
 
-	if (snd.sid != -1) {
-		Snd_sram -= snd.uncompressed_size;
+	if (--snd.refs > 0) {
+		return 1;
 	}
 
-	//If this sound is at the end of the array, we might as well get rid of it
-	if ((size_t)n.value() == Sounds.size() - 1) {
-		Sounds.pop_back();
-	} else {
-		snd.sid = -1;
-		snd.flags &= ~SND_F_USED;
+	if (snd.sid == -1) {
+		snd_release(n.value());
+		return 1;
 	}
 
+	snd.flags = SND_F_RETAINED;
+	snd.retained_order = Snd_retained_count++;
+	Snd_retained_bytes += snd.uncompressed_size;
+
+	snd_release_retained();
+
 	return 1;
 }
 
 // ---------------------------------------------------------------------------------------
 // snd_unload_all() 
 //
-// Unload all sounds from memory. If there's a problem unloading a file the array may not be fully cleared
-// but future files will still use unused spots, so the array size shouldn't grow out of control.
+// Unload all sounds from memory, including the retained ones. If there's a problem unloading a file the array may
+// not be fully cleared but future files will still use unused spots, so the array size shouldn't grow out of control.
 //
 void snd_unload_all()
 {
 	while ( !Sounds.empty() ) {
-		snd_unload(sound_load_id((int)(Sounds.size() - 1)));
+		snd_release(Sounds.size() - 1);
 	}
+
+	Snd_retained_bytes = 0;
+}
+
+// ---------------------------------------------------------------------------------------
+// snd_report_level_load()
+//
+// Logs how much sound data was decoded, read from the sound cache or still retained since the last call.
+//
+void snd_report_level_load()
+{
+	mprintf(("Sound data loaded: %.2f MB decoded, %.2f MB from the sound cache, %.2f MB still loaded (%.2f MB retained)\n",
+		Snd_bytes_decoded / (1024.0f * 1024.0f), Snd_bytes_cached / (1024.0f * 1024.0f),
+		Snd_bytes_retained / (1024.0f * 1024.0f), Snd_retained_bytes / (1024.0f * 1024.0f)));
+
+	Snd_bytes_decoded = 0;
+	Snd_bytes_cached = 0;
+	Snd_bytes_retained = 0;
 }
 
 // ---------------------------------------------------------------------------------------
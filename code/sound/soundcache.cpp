@@ -0,0 +1,282 @@
+
+#include "sound/soundcache.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "sound/audiostr.h"
+
+#include <md5.h>
+
+// bump this whenever the decoder or the downmixing changes what comes out
+#define SOUND_CACHE_VERSION		1
+
+#define SOUND_CACHE_MAGIC		0x43535346	// "FSSC"
+
+// a file whose decoded data isn't at least this much bigger is plain PCM already, caching it would only use disk space
+#define SOUND_CACHE_MIN_RATIO	2
+
+#define SOUND_CACHE_LOCATIONS	(CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
+
+// format tags of WAVs which hold plain samples
+#define WAV_FORMAT_PCM			0x0001
+#define WAV_FORMAT_IEEE_FLOAT	0x0003
+#define WAV_FORMAT_EXTENSIBLE	0xFFFE
+
+typedef struct sound_cache_header {
+	uint	magic;
+	uint	version;
+	uint	source_size;
+	int		source_channels;
+	int		bytes_per_sample;
+	int		num_channels;
+	int		sample_rate;
+	int		total_samples;
+	double	duration;
+	uint	data_size;
+} sound_cache_header;
+
+namespace sound {
+
+PcmAudioFile::PcmAudioFile(const AudioFileProperties& props, SCP_vector<uint8_t>&& data)
+	: _props(props), _data(std::move(data))
+{
+}
+
+std::unique_ptr<PcmAudioFile> PcmAudioFile::decode(IAudioFile* file)
+{
+	auto props = file->getFileProperties();
+
+	SCP_vector<uint8_t> data;
+	data.reserve(props.total_samples * props.bytes_per_sample * props.num_channels);
+
+	// same loop ds_load_buffer() used to run on the decoder directly
+	SCP_vector<uint8_t> buffer(props.sample_rate * props.bytes_per_sample * props.num_channels);
+	if (buffer.empty()) {
+		return nullptr;
+	}
+
+	int read;
+	while ((read = file->Read(&buffer[0], buffer.size())) >= 0) {
+		if (read == 0) {
+			// buffer not large enough
+			buffer.resize(buffer.size() * 2);
+		} else {
+			data.insert(data.end(), buffer.begin(), std::next(buffer.begin(), read));
+		}
+	}
+
+	if (data.empty()) {
+		return nullptr;
+	}
+
+	return std::unique_ptr<PcmAudioFile>(new PcmAudioFile(props, std::move(data)));
+}
+
+bool PcmAudioFile::Open(const char* /*pszFilename*/, bool /*keep_ext*/)
+{
+	return false;
+}
+
+bool PcmAudioFile::Cue()
+{
+	_pos = 0;
+	return true;
+}
+
+int PcmAudioFile::Read(uint8_t* pbDest, size_t cbSize)
+{
+	if (_pos >= _data.size()) {
+		return -1;
+	}
+
+	auto count = std::min(cbSize, _data.size() - _pos);
+	memcpy(pbDest, &_data[_pos], count);
+	_pos += count;
+
+	return static_cast<int>(count);
+}
+
+AudioFileProperties PcmAudioFile::getFileProperties()
+{
+	return _props;
+}
+
+void PcmAudioFile::setResamplingProperties(const ResampleProperties& /*resampleProps*/)
+{
+	UNREACHABLE("Decoded audio data can't be resampled!");
+}
+
+} // namespace sound
+
+// WAVs which hold plain samples decode into the same bytes, snd_cache_save() never keeps them anyway
+static bool snd_cache_is_plain_wav(CFILE* fp)
+{
+	ubyte header[22];
+
+	if (cfread(header, sizeof(header), 1, fp) != 1) {
+		return false;
+	}
+
+	// only the usual layout with the fmt chunk right after the RIFF header is recognized, anything else is hashed
+	if (memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVEfmt ", 8) != 0) {
+		return false;
+	}
+
+	auto format = (ushort)(header[20] | (header[21] << 8));
+
+	return format == WAV_FORMAT_PCM || format == WAV_FORMAT_IEEE_FLOAT || format == WAV_FORMAT_EXTENSIBLE;
+}
+
+sound_cache_key snd_cache_get_key(const char* filename, bool mono)
+{
+	sound_cache_key key;
+
+	if (Cmdline_nosoundcache) {
+		return key;
+	}
+
+	// find the file the same way the decoder does
+	auto res = cf_find_file_location_ext(filename, NUM_AUDIO_EXT, audio_ext_list, CF_TYPE_ANY, false);
+	if (!res.found || res.size == 0) {
+		return key;
+	}
+
+	CFILE* fp = cfopen_special(res.full_name.c_str(), "rb", res.size, res.offset, res.data_ptr, CF_TYPE_ANY);
+	if (fp == nullptr) {
+		return key;
+	}
+
+	if (snd_cache_is_plain_wav(fp)) {
+		cfclose(fp);
+		return key;
+	}
+
+	int header[2];
+	header[0] = SOUND_CACHE_VERSION;
+	header[1] = mono ? 1 : 0;
+
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(header), sizeof(header));
+
+	if (res.write_time != 0 && res.data_ptr == nullptr) {
+		// the file list knows where the file is and when it was written, that identifies it without reading all of it
+		std::int64_t location[3];
+		location[0] = (std::int64_t)res.offset;
+		location[1] = (std::int64_t)res.size;
+		location[2] = (std::int64_t)res.write_time;
+
+		cfclose(fp);
+
+		md5.update(res.full_name.c_str(), (MD5::size_type)res.full_name.size() + 1);
+		md5.update(reinterpret_cast<const char*>(location), sizeof(location));
+	} else {
+		SCP_vector<char> contents(res.size);
+		bool read = (cfseek(fp, 0, CF_SEEK_SET) == 0) && (cfread(contents.data(), (int)res.size, 1, fp) == 1);
+
+		cfclose(fp);
+
+		if (!read) {
+			return key;
+		}
+
+		md5.update(contents.data(), (MD5::size_type)contents.size());
+	}
+
+	md5.finalize();
+
+	char name[MAX_FILENAME_LEN];
+	sprintf(name, "sc%.20s.bx", md5.hexdigest().c_str());
+
+	key.name = name;
+	key.source_size = res.size;
+
+	return key;
+}
+
+std::unique_ptr<sound::PcmAudioFile> snd_cache_load(const sound_cache_key& key, int* source_channels)
+{
+	if (key.name.empty()) {
+		return nullptr;
+	}
+
+	CFILE* fp = cfopen(key.name.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, SOUND_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		return nullptr;
+	}
+
+	sound_cache_header header;
+	SCP_vector<uint8_t> data;
+	bool valid = false;
+
+	if (cfread(&header, sizeof(header), 1, fp) == 1) {
+		valid = (header.magic == SOUND_CACHE_MAGIC) && (header.version == SOUND_CACHE_VERSION)
+			&& (header.source_size == key.source_size) && (header.data_size > 0)
+			&& ((size_t)cfilelength(fp) == sizeof(header) + header.data_size);
+	}
+
+	if (valid) {
+		data.resize(header.data_size);
+		valid = cfread(data.data(), (int)header.data_size, 1, fp) == 1;
+	}
+
+	cfclose(fp);
+
+	if (!valid) {
+		mprintf(("Sound cache file %s is invalid, ignoring it\n", key.name.c_str()));
+		return nullptr;
+	}
+
+	sound::AudioFileProperties props;
+	props.bytes_per_sample = header.bytes_per_sample;
+	props.num_channels = header.num_channels;
+	props.sample_rate = header.sample_rate;
+	props.total_samples = header.total_samples;
+	props.duration = header.duration;
+
+	if (source_channels != nullptr) {
+		*source_channels = header.source_channels;
+	}
+
+	return std::unique_ptr<sound::PcmAudioFile>(new sound::PcmAudioFile(props, std::move(data)));
+}
+
+void snd_cache_save(const sound_cache_key& key, sound::PcmAudioFile& pcm, int source_channels)
+{
+	if (key.name.empty() || pcm.data().empty() || pcm.data().size() < key.source_size * SOUND_CACHE_MIN_RATIO) {
+		return;
+	}
+
+	auto props = pcm.getFileProperties();
+
+	sound_cache_header header;
+	memset(&header, 0, sizeof(header));
+	header.magic = SOUND_CACHE_MAGIC;
+	header.version = SOUND_CACHE_VERSION;
+	header.source_size = (uint)key.source_size;
+	header.source_channels = source_channels;
+	header.bytes_per_sample = props.bytes_per_sample;
+	header.num_channels = props.num_channels;
+	header.sample_rate = props.sample_rate;
+	header.total_samples = props.total_samples;
+	header.duration = props.duration;
+	header.data_size = (uint)pcm.data().size();
+
+	CFILE* fp = cfopen(key.name.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, SOUND_CACHE_LOCATIONS);
+
+	if (fp == nullptr) {
+		mprintf(("Could not open sound cache file %s for writing!\n", key.name.c_str()));
+		return;
+	}
+
+	bool written = cfwrite(&header, sizeof(header), 1, fp) == 1;
+	if (written) {
+		written = cfwrite(pcm.data().data(), (int)header.data_size, 1, fp) == 1;
+	}
+
+	cfclose(fp);
+
+	if (!written) {
+		mprintf(("Could not write sound cache file %s!\n", key.name.c_str()));
+		cf_delete(key.name.c_str(), CF_TYPE_CACHE, SOUND_CACHE_LOCATIONS);
+	}
+}
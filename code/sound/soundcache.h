@@ -0,0 +1,63 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "sound/IAudioFile.h"
+
+namespace sound {
+
+/**
+ * @brief Audio data which has already been decoded into memory
+ *
+ * This is what snd_load() hands to ds_load_buffer(), either filled from the sound cache or by decoding a file once.
+ */
+class PcmAudioFile : public IAudioFile {
+	AudioFileProperties _props;
+	SCP_vector<uint8_t> _data;
+	size_t _pos = 0;
+
+  public:
+	PcmAudioFile(const AudioFileProperties& props, SCP_vector<uint8_t>&& data);
+
+	/**
+	 * @brief Decodes all of a file
+	 * @return The decoded data or @c nullptr if nothing could be read from the file
+	 */
+	static std::unique_ptr<PcmAudioFile> decode(IAudioFile* file);
+
+	// the data is given to the constructor, there is nothing to open
+	bool Open(const char* pszFilename, bool keep_ext = true) override;
+
+	bool Cue() override;
+
+	int Read(uint8_t* pbDest, size_t cbSize) override;
+
+	AudioFileProperties getFileProperties() override;
+
+	// the data has already been decoded, so it can't be resampled anymore
+	void setResamplingProperties(const ResampleProperties& resampleProps) override;
+
+	const SCP_vector<uint8_t>& data() const { return _data; }
+};
+
+} // namespace sound
+
+// The sound cache keeps the decoded PCM data of compressed sound files in CF_TYPE_CACHE, so loading a level doesn't
+// have to decode every sound again. Cache files are named after a hash of where the sound file is, its size and when it
+// was written (or of its contents if the file list doesn't know that) and whether it was downmixed for 3D use; each is a
+// small header followed by the raw samples.
+
+// Identifies the decoded data of a sound file in the cache
+struct sound_cache_key {
+	SCP_string name;		// empty if the sound can't be cached
+	size_t source_size = 0;	// size of the sound file
+};
+
+// Builds the cache name of a sound file, uncompressed WAVs get an empty name since they aren't worth caching
+sound_cache_key snd_cache_get_key(const char* filename, bool mono);
+
+// Reads decoded data from the cache, returns nullptr if it isn't there
+// source_channels receives the channel count of the sound file before it was downmixed
+std::unique_ptr<sound::PcmAudioFile> snd_cache_load(const sound_cache_key& key, int* source_channels);
+
+// Stores decoded data in the cache, files which aren't compressed are skipped since decoding them is just a copy
+void snd_cache_save(const sound_cache_key& key, sound::PcmAudioFile& pcm, int source_channels);
@@ -0,0 +1,84 @@
+
+#include "sound/voicemanager.h"
+
+#include <algorithm>
+
+namespace sound {
+
+VoiceManager::VoiceManager(int full_updates, int stagger, float min_start_loudness)
+	: _full_updates(full_updates), _stagger(std::max(stagger, 1)), _min_start_loudness(min_start_loudness)
+{
+}
+
+void VoiceManager::begin()
+{
+	_candidates.clear();
+}
+
+void VoiceManager::add(int id, float loudness, bool playing)
+{
+	candidate c;
+	c.id = id;
+	c.loudness = loudness;
+	c.playing = playing;
+	_candidates.push_back(c);
+}
+
+void VoiceManager::run(IVoiceBackend& backend, int max_voices)
+{
+	++_frame;
+	_num_updated = 0;
+
+	std::make_heap(_candidates.begin(), _candidates.end());
+
+	// the loudest sounds come off the heap first, so the winners end up sorted by loudness
+	_winners.clear();
+	auto heap_end = _candidates.end();
+
+	while (heap_end != _candidates.begin() && static_cast<int>(_winners.size()) < max_voices) {
+		std::pop_heap(_candidates.begin(), heap_end);
+		--heap_end;
+
+		auto& c = *heap_end;
+
+		if (c.loudness < 0.0f) {
+			// out of range, and so is everything still on the heap
+			++heap_end;
+			break;
+		}
+
+		// too quiet to start, but a quieter sound which is already playing may keep going
+		if (!c.playing && c.loudness < _min_start_loudness) {
+			continue;
+		}
+
+		_winners.push_back(c);
+	}
+
+	// the losers have to give up their voices before the winners can start
+	for (auto it = _candidates.begin(); it != heap_end; ++it) {
+		if (it->playing) {
+			backend.stopVoice(it->id);
+		}
+	}
+
+	_num_playing = 0;
+
+	for (auto& c : _winners) {
+		if (!c.playing) {
+			if (!backend.startVoice(c.id)) {
+				continue;
+			}
+			// a sound which just started needs its first update right away
+			backend.updateVoice(c.id);
+			++_num_updated;
+		} else if (_num_playing < _full_updates || (static_cast<uint>(c.id) + _frame) % static_cast<uint>(_stagger) == 0) {
+			backend.updateVoice(c.id);
+			++_num_updated;
+		}
+
+		++_num_playing;
+	}
+}
+
+} // namespace sound
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace sound {
+
+/**
+ * @brief What the voice manager asks of the sound system
+ */
+class IVoiceBackend {
+  public:
+	virtual ~IVoiceBackend() = default;
+
+	/**
+	 * @brief Starts playing a sound
+	 * @return @c false if the sound couldn't be started, it is tried again on the next update
+	 */
+	virtual bool startVoice(int id) = 0;
+
+	virtual void stopVoice(int id) = 0;
+
+	// updates position, volume and Doppler of a playing sound
+	virtual void updateVoice(int id) = 0;
+};
+
+/**
+ * @brief A backend which plays nothing, for running the voice manager without a sound device
+ */
+class NullVoiceBackend : public IVoiceBackend {
+  public:
+	int starts = 0;
+	int stops = 0;
+	int updates = 0;
+
+	bool startVoice(int /*id*/) override
+	{
+		++starts;
+		return true;
+	}
+	void stopVoice(int /*id*/) override { ++stops; }
+	void updateVoice(int /*id*/) override { ++updates; }
+};
+
+/**
+ * @brief Decides which of many persistent sounds get one of a few voices
+ *
+ * Every update the owner adds all sounds it manages with an estimate of how loud they would be. The loudest ones which
+ * fit into the voices get to play, everything else is stopped, without searching the playing sounds for the quietest
+ * one each time a sound wants to start. Playing sounds are updated in order of loudness: the loudest ones on every
+ * update, the others in turns spread over a few updates since nobody hears their position being a little off.
+ */
+class VoiceManager {
+	struct candidate {
+		int id;
+		float loudness;
+		bool playing;
+
+		bool operator<(const candidate& other) const { return loudness < other.loudness; }
+	};
+
+	SCP_vector<candidate> _candidates;
+	SCP_vector<candidate> _winners;
+
+	int _full_updates = 0;
+	int _stagger = 1;
+	float _min_start_loudness = 0.0f;
+
+	uint _frame = 0;
+
+	// counts of the last update
+	int _num_playing = 0;
+	int _num_updated = 0;
+
+  public:
+	/**
+	 * @param full_updates How many of the loudest playing sounds are updated every time
+	 * @param stagger The other playing sounds are updated every this many updates
+	 * @param min_start_loudness Sounds quieter than this don't start playing, but keep playing if they already are
+	 */
+	VoiceManager(int full_updates, int stagger, float min_start_loudness);
+
+	/**
+	 * @brief Starts collecting the sounds for an update
+	 */
+	void begin();
+
+	/**
+	 * @brief Adds a sound
+	 * @param loudness Estimated volume, less than zero if the sound is out of range and has to stop
+	 */
+	void add(int id, float loudness, bool playing);
+
+	/**
+	 * @brief Starts, stops and updates the sounds which were added
+	 * @param max_voices How many of them may play at once
+	 */
+	void run(IVoiceBackend& backend, int max_voices);
+
+	int numPlaying() const { return _num_playing; }
+
+	int numUpdated() const { return _num_updated; }
+};
+
+} // namespace sound
@@ -44,7 +44,11 @@ add_file_folder("Autopilot"
 
 # Bmpman files
 add_file_folder("Bmpman"
+	bmpman/bm_decode.cpp
+	bmpman/bm_decode.h
 	bmpman/bm_internal.h
+	bmpman/bm_texcache.cpp
+	bmpman/bm_texcache.h
 	bmpman/bmpman.cpp
 	bmpman/bmpman.h
 )
@@ -119,6 +123,8 @@ endif()
 add_file_folder("ddsutils"
 	ddsutils/ddsutils.cpp
 	ddsutils/ddsutils.h
+	ddsutils/dxtc.cpp
+	ddsutils/dxtc.h
 )
 
 # Debris files
@@ -539,6 +545,8 @@ add_file_folder("Hud"
 	hud/hudtarget.h
 	hud/hudtargetbox.cpp
 	hud/hudtargetbox.h
+	hud/hudtargetcache.cpp
+	hud/hudtargetcache.h
 	hud/hudwingmanstatus.cpp
 	hud/hudwingmanstatus.h
 )
@@ -633,6 +641,7 @@ add_file_folder("Lighting"
 add_file_folder("Localization"
 	localization/fhash.cpp
 	localization/fhash.h
+	localization/lcl_strings.h
 	localization/localize.cpp
 	localization/localize.h
 )
@@ -686,6 +695,8 @@ add_file_folder("MenuUI"
 add_file_folder("Mission"
 	mission/missionbriefcommon.cpp
 	mission/missionbriefcommon.h
+	mission/missioncache.cpp
+	mission/missioncache.h
 	mission/missioncampaign.cpp
 	mission/missioncampaign.h
 	mission/missiongoals.cpp
@@ -744,6 +755,8 @@ add_file_folder("Model"
 	model/model.h
 	model/modelanim.cpp
 	model/modelanim.h
+	model/modelcache.cpp
+	model/modelcache.h
 	model/modelcollide.cpp
 	model/modelinterp.cpp
 	model/modeloctant.cpp
@@ -868,6 +881,8 @@ add_file_folder("Object"
 	object/objectdock.h
 	object/objectshield.cpp
 	object/objectshield.h
+	object/objectsnapshot.cpp
+	object/objectsnapshot.h
 	object/objectsnd.cpp
 	object/objectsnd.h
 	object/objectsort.cpp
@@ -915,6 +930,8 @@ add_file_folder("Parse"
 	parse/parselo.h
 	parse/sexp.cpp
 	parse/sexp.h
+	parse/tablecache.cpp
+	parse/tablecache.h
 )
 
 add_file_folder("Parse\\\\SEXP"
@@ -1015,6 +1032,8 @@ add_file_folder("Popup"
 add_file_folder("Radar"
 	radar/radar.cpp
 	radar/radar.h
+	radar/radarcontacts.cpp
+	radar/radarcontacts.h
 	radar/radardradis.cpp
 	radar/radardradis.h
 	radar/radarngon.cpp
@@ -1295,8 +1314,12 @@ add_file_folder("Sound"
 	sound/rtvoice.h
 	sound/sound.cpp
 	sound/sound.h
+	sound/soundcache.cpp
+	sound/soundcache.h
 	sound/speech.cpp
 	sound/speech.h
+	sound/voicemanager.cpp
+	sound/voicemanager.h
 	sound/voicerec.cpp
 	sound/voicerec.h
 )
@@ -1345,17 +1368,23 @@ add_file_folder("TgaUtils"
 
 # Tracing files
 add_file_folder("Tracing"
+	tracing/BinaryTraceFormat.h
+	tracing/BinaryTraceWriter.cpp
+	tracing/BinaryTraceWriter.h
 	tracing/categories.cpp
 	tracing/categories.h
+	tracing/EventRingBuffers.cpp
+	tracing/EventRingBuffers.h
 	tracing/FrameProfiler.h
 	tracing/FrameProfiler.cpp
+	tracing/FrameStats.h
+	tracing/FrameStats.cpp
 	tracing/MainFrameTimer.h
 	tracing/MainFrameTimer.cpp
 	tracing/Monitor.h
 	tracing/Monitor.cpp
 	tracing/scopes.cpp
 	tracing/scopes.h
-	tracing/ThreadedEventProcessor.h
 	tracing/TraceEventWriter.h
 	tracing/TraceEventWriter.cpp
 	tracing/tracing.h
@@ -1383,14 +1412,18 @@ add_file_folder("Ui"
 )
 
 add_file_folder("Utils"
+	utils/chunked_pool.h
 	utils/encoding.cpp
 	utils/encoding.h
 	utils/event.h
 	utils/finally.h
 	utils/HeapAllocator.cpp
 	utils/HeapAllocator.h
+	utils/hdr_histogram.h
 	utils/id.h
+	utils/name_index.h
 	utils/RandomRange.h
+	utils/spsc_ring_buffer.h
 	utils/string_utils.cpp
 	utils/string_utils.h
 	utils/strings.h
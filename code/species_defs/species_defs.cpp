@@ -14,9 +14,12 @@
 #include "localization/localize.h"
 #include "parse/parselo.h"
 #include "species_defs/species_defs.h"
+#include "utils/name_index.h"
 
 
 SCP_vector<species_info> Species_info;
+static util::name_index Species_info_names([]() { return static_cast<int>(Species_info.size()); },
+                                           [](int index) -> const char* { return Species_info[index].species_name; });
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
@@ -350,6 +353,7 @@ void species_init()
 		return;
 
 	Species_info.clear();
+	Species_info_names.invalidate();
 
 
 	if (cf_exists_full("species_defs.tbl", CF_TYPE_TABLES))
@@ -365,11 +369,5 @@ void species_init()
 
 int species_info_lookup(const char *species_name)
 {
-	for (int i = 0; i < static_cast<int>(Species_info.size()); i++)
-	{
-		if (!stricmp(Species_info[i].species_name, species_name))
-			return i;
-	}
-
-	return -1;
+	return Species_info_names.find(species_name);
 }
@@ -736,7 +736,7 @@ int scoring_eval_kill(object *ship_objp)
 			int si_index;
 
 			// bogus
-			if((plr->objnum < 0) || (plr->objnum >= MAX_OBJECTS)){
+			if((plr->objnum < 0) || (plr->objnum >= objects_size())){
 				return -1;
 			}			
 
@@ -904,8 +904,8 @@ int scoring_eval_kill_on_weapon(object *weapon_obj, object *other_obj) {
 
 	// we don't evaluate kills on anything except weapons
 	// also make sure there was a killer, and that it was a ship
-	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= MAX_WEAPONS)
-			|| (other_obj == nullptr) || (other_obj->type != OBJ_WEAPON) || (other_obj->instance < 0) || (other_obj->instance >= MAX_WEAPONS)
+	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= weapons_size())
+			|| (other_obj == nullptr) || (other_obj->type != OBJ_WEAPON) || (other_obj->instance < 0) || (other_obj->instance >= weapons_size())
 			|| (other_obj->parent == -1) || (Objects[other_obj->parent].type != OBJ_SHIP)) {
 		return -1;
 	}
@@ -945,7 +945,7 @@ int scoring_eval_kill_on_weapon(object *weapon_obj, object *other_obj) {
 		// if we found a valid player, evaluate some kill details
 		if(plr != NULL){
 			// bogus
-			if((plr->objnum < 0) || (plr->objnum >= MAX_OBJECTS)){
+			if((plr->objnum < 0) || (plr->objnum >= objects_size())){
 				return -1;
 			}
 
@@ -1123,7 +1123,7 @@ void scoring_eval_hit(object *hit_obj, object *other_obj,int from_blast)
 	
 	if((other_obj->type == OBJ_WEAPON) && !(Weapons[other_obj->instance].weapon_flags[Weapon::Weapon_Flags::Already_applied_stats])){		
 		// bogus weapon
-		if(other_obj->instance >= MAX_WEAPONS){
+		if(other_obj->instance >= weapons_size()){
 			return;
 		}
 
@@ -1131,7 +1131,7 @@ void scoring_eval_hit(object *hit_obj, object *other_obj,int from_blast)
 		if(other_obj->parent < 0){
 			return;
 		}
-		if(other_obj->parent >= MAX_OBJECTS){
+		if(other_obj->parent >= objects_size()){
 			return;
 		}
 		if(Objects[other_obj->parent].type != OBJ_SHIP){
@@ -1147,7 +1147,7 @@ void scoring_eval_hit(object *hit_obj, object *other_obj,int from_blast)
 		if(hit_obj->type == OBJ_WEAPON){
 
 			//Hit weapon is bogus
-			if (hit_obj->instance >= MAX_WEAPONS) {
+			if (hit_obj->instance >= weapons_size()) {
 				return;
 			}	
 
@@ -0,0 +1,255 @@
+#ifndef _BINARYTRACEFORMAT_H
+#define _BINARYTRACEFORMAT_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/** @file
+ *  @ingroup tracing
+ *
+ *  The on-disk format of binary traces, as written by -binary_profiling and read by tools/trace_converter.
+ *
+ *  A trace is a file header followed by a stream of records. Categories and scopes are written once as a name record
+ *  the first time they are used, events refer to them by id. All values are little endian.
+ *
+ *  @note This file is shared with the converter tool and may only depend on the standard library.
+ */
+
+namespace tracing {
+namespace binary {
+
+const char FILE_MAGIC[4] = { 'F', 'S', 'T', 'R' };
+const std::uint32_t FORMAT_VERSION = 1;
+
+// magic, version, process id
+const size_t FILE_HEADER_SIZE = 16;
+
+enum class RecordType : std::uint8_t {
+	Name = 1,
+	Event = 2
+};
+
+enum class NameKind : std::uint8_t {
+	Category = 0,
+	Scope = 1
+};
+
+/**
+ * @brief The event types, same as tracing::EventType
+ */
+enum class EventKind : std::uint8_t {
+	Complete = 1, Begin, End,
+
+	AsyncBegin, AsyncStep, AsyncEnd,
+
+	Counter
+};
+
+const std::uint8_t EVENT_FLAG_GPU = 1 << 0;
+
+const std::uint16_t NO_SCOPE = 0xFFFF;
+const std::uint16_t MAX_NAME_ID = 0xFFFE;
+
+// type, kind, id, length, the name follows
+const size_t NAME_RECORD_HEADER_SIZE = 6;
+
+// type, kind, flags, padding, category, scope, tid, timestamp, duration/value
+const size_t EVENT_RECORD_SIZE = 28;
+
+struct name_record {
+	NameKind kind = NameKind::Category;
+	std::uint16_t id = 0;
+	std::string name;
+};
+
+struct event_record {
+	EventKind kind = EventKind::Complete;
+	std::uint8_t flags = 0;
+	std::uint16_t category = 0;
+	std::uint16_t scope = NO_SCOPE;
+	std::uint32_t tid = 0;
+
+	std::uint64_t timestamp = 0;	// nanoseconds since tracing was initialized
+	std::uint64_t duration = 0;		// nanoseconds, complete events only
+	float value = 0.f;				// counter events only
+};
+
+namespace detail {
+inline void put_u16(std::uint8_t* out, std::uint16_t val) {
+	out[0] = static_cast<std::uint8_t>(val);
+	out[1] = static_cast<std::uint8_t>(val >> 8);
+}
+inline void put_u32(std::uint8_t* out, std::uint32_t val) {
+	for (int i = 0; i < 4; ++i) {
+		out[i] = static_cast<std::uint8_t>(val >> (i * 8));
+	}
+}
+inline void put_u64(std::uint8_t* out, std::uint64_t val) {
+	for (int i = 0; i < 8; ++i) {
+		out[i] = static_cast<std::uint8_t>(val >> (i * 8));
+	}
+}
+inline std::uint16_t get_u16(const std::uint8_t* in) {
+	return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+inline std::uint32_t get_u32(const std::uint8_t* in) {
+	std::uint32_t val = 0;
+	for (int i = 0; i < 4; ++i) {
+		val |= static_cast<std::uint32_t>(in[i]) << (i * 8);
+	}
+	return val;
+}
+inline std::uint64_t get_u64(const std::uint8_t* in) {
+	std::uint64_t val = 0;
+	for (int i = 0; i < 8; ++i) {
+		val |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+	}
+	return val;
+}
+}
+
+/**
+ * @brief Writes the file header
+ * @param out Buffer with room for FILE_HEADER_SIZE bytes
+ * @param pid The id of the process which wrote the trace
+ */
+inline void encode_header(std::uint8_t* out, std::int64_t pid) {
+	memcpy(out, FILE_MAGIC, sizeof(FILE_MAGIC));
+	detail::put_u32(out + 4, FORMAT_VERSION);
+	detail::put_u64(out + 8, static_cast<std::uint64_t>(pid));
+}
+
+/**
+ * @brief Reads the file header
+ * @return false if this is not a binary trace or was written by an incompatible version
+ */
+inline bool decode_header(const std::uint8_t* in, size_t size, std::int64_t* pid) {
+	if (size < FILE_HEADER_SIZE || memcmp(in, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+		return false;
+	}
+	if (detail::get_u32(in + 4) != FORMAT_VERSION) {
+		return false;
+	}
+
+	*pid = static_cast<std::int64_t>(detail::get_u64(in + 8));
+	return true;
+}
+
+inline size_t name_record_size(const name_record& name) {
+	return NAME_RECORD_HEADER_SIZE + name.name.size();
+}
+
+/**
+ * @brief Writes a name record
+ * @param out Buffer with room for name_record_size() bytes
+ * @return The number of bytes written
+ */
+inline size_t encode_name(std::uint8_t* out, const name_record& name) {
+	out[0] = static_cast<std::uint8_t>(RecordType::Name);
+	out[1] = static_cast<std::uint8_t>(name.kind);
+	detail::put_u16(out + 2, name.id);
+	detail::put_u16(out + 4, static_cast<std::uint16_t>(name.name.size()));
+	memcpy(out + NAME_RECORD_HEADER_SIZE, name.name.data(), name.name.size());
+
+	return name_record_size(name);
+}
+
+/**
+ * @brief Writes an event record
+ * @param out Buffer with room for EVENT_RECORD_SIZE bytes
+ * @return The number of bytes written
+ */
+inline size_t encode_event(std::uint8_t* out, const event_record& evt) {
+	out[0] = static_cast<std::uint8_t>(RecordType::Event);
+	out[1] = static_cast<std::uint8_t>(evt.kind);
+	out[2] = evt.flags;
+	out[3] = 0;
+	detail::put_u16(out + 4, evt.category);
+	detail::put_u16(out + 6, evt.scope);
+	detail::put_u32(out + 8, evt.tid);
+	detail::put_u64(out + 12, evt.timestamp);
+
+	if (evt.kind == EventKind::Counter) {
+		std::uint32_t bits;
+		memcpy(&bits, &evt.value, sizeof(bits));
+		detail::put_u64(out + 20, bits);
+	} else {
+		detail::put_u64(out + 20, evt.duration);
+	}
+
+	return EVENT_RECORD_SIZE;
+}
+
+/**
+ * @brief Reads the record at the start of a buffer
+ *
+ * @param in The buffer
+ * @param size The number of bytes left in the buffer
+ * @param type Set to the type of the record
+ * @param name Filled in if the record is a name record
+ * @param evt Filled in if the record is an event record
+ * @return The size of the record, or 0 if the buffer doesn't hold a complete, valid record
+ */
+inline size_t decode_record(const std::uint8_t* in, size_t size, RecordType* type, name_record* name,
+                            event_record* evt) {
+	if (size < 1) {
+		return 0;
+	}
+
+	switch (static_cast<RecordType>(in[0])) {
+	case RecordType::Name: {
+		if (size < NAME_RECORD_HEADER_SIZE) {
+			return 0;
+		}
+
+		size_t length = detail::get_u16(in + 4);
+		if (size < NAME_RECORD_HEADER_SIZE + length || in[1] > static_cast<std::uint8_t>(NameKind::Scope)) {
+			return 0;
+		}
+
+		*type = RecordType::Name;
+		name->kind = static_cast<NameKind>(in[1]);
+		name->id = detail::get_u16(in + 2);
+		name->name.assign(reinterpret_cast<const char*>(in + NAME_RECORD_HEADER_SIZE), length);
+
+		return NAME_RECORD_HEADER_SIZE + length;
+	}
+	case RecordType::Event: {
+		if (size < EVENT_RECORD_SIZE) {
+			return 0;
+		}
+		if (in[1] < static_cast<std::uint8_t>(EventKind::Complete) || in[1] > static_cast<std::uint8_t>(EventKind::Counter)) {
+			return 0;
+		}
+
+		*type = RecordType::Event;
+		evt->kind = static_cast<EventKind>(in[1]);
+		evt->flags = in[2];
+		evt->category = detail::get_u16(in + 4);
+		evt->scope = detail::get_u16(in + 6);
+		evt->tid = detail::get_u32(in + 8);
+		evt->timestamp = detail::get_u64(in + 12);
+		evt->duration = 0;
+		evt->value = 0.f;
+
+		if (evt->kind == EventKind::Counter) {
+			auto bits = static_cast<std::uint32_t>(detail::get_u64(in + 20));
+			memcpy(&evt->value, &bits, sizeof(bits));
+		} else {
+			evt->duration = detail::get_u64(in + 20);
+		}
+
+		return EVENT_RECORD_SIZE;
+	}
+	default:
+		return 0;
+	}
+}
+
+}
+}
+
+#endif // _BINARYTRACEFORMAT_H
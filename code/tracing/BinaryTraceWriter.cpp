@@ -0,0 +1,130 @@
+
+#include "tracing/BinaryTraceWriter.h"
+#include "tracing/BinaryTraceFormat.h"
+
+#include <cinttypes>
+
+namespace
+{
+using namespace tracing;
+
+// The file is written in blocks of this size
+const size_t BLOCK_SIZE = 1024 * 1024;
+
+binary::EventKind getEventKind(EventType type) {
+	switch(type) {
+		case EventType::Complete:
+			return binary::EventKind::Complete;
+		case EventType::Begin:
+			return binary::EventKind::Begin;
+		case EventType::End:
+			return binary::EventKind::End;
+		case EventType::AsyncBegin:
+			return binary::EventKind::AsyncBegin;
+		case EventType::AsyncStep:
+			return binary::EventKind::AsyncStep;
+		case EventType::AsyncEnd:
+			return binary::EventKind::AsyncEnd;
+		case EventType::Counter:
+			return binary::EventKind::Counter;
+		default:
+			UNREACHABLE("Invalid enum value!");
+			return binary::EventKind::Complete;
+	}
+}
+}
+
+namespace tracing
+{
+
+BinaryTraceWriter::BinaryTraceWriter(std::int64_t pid) : _out("tracing/trace.fstrace", std::ios::binary) {
+	_block.resize(BLOCK_SIZE);
+
+	binary::encode_header(reserve(binary::FILE_HEADER_SIZE), pid);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+	flush();
+	_out.close();
+
+	mprintf(("Tracing: Wrote %" PRIu64 " events to the binary trace\n", _numEvents));
+}
+
+void BinaryTraceWriter::flush() {
+	if (_used > 0) {
+		_out.write(reinterpret_cast<const char*>(_block.data()), static_cast<std::streamsize>(_used));
+		_used = 0;
+	}
+}
+
+std::uint8_t* BinaryTraceWriter::reserve(size_t size) {
+	Assertion(size <= _block.size(), "Trace record of %d bytes is too big!", static_cast<int>(size));
+
+	if (_used + size > _block.size()) {
+		flush();
+	}
+
+	auto ptr = _block.data() + _used;
+	_used += size;
+
+	return ptr;
+}
+
+std::uint16_t BinaryTraceWriter::getCategoryId(const Category* category) {
+	auto iter = _categoryIds.find(category);
+	if (iter != _categoryIds.end()) {
+		return iter->second;
+	}
+
+	Assertion(_categoryIds.size() < binary::MAX_NAME_ID, "Too many tracing categories for the binary trace format!");
+
+	binary::name_record name;
+	name.kind = binary::NameKind::Category;
+	name.id = static_cast<std::uint16_t>(_categoryIds.size());
+	name.name = category->getName();
+
+	binary::encode_name(reserve(binary::name_record_size(name)), name);
+
+	_categoryIds.emplace(category, name.id);
+	return name.id;
+}
+
+std::uint16_t BinaryTraceWriter::getScopeId(const Scope* scope) {
+	if (scope == nullptr) {
+		return binary::NO_SCOPE;
+	}
+
+	auto iter = _scopeIds.find(scope);
+	if (iter != _scopeIds.end()) {
+		return iter->second;
+	}
+
+	Assertion(_scopeIds.size() < binary::MAX_NAME_ID, "Too many tracing scopes for the binary trace format!");
+
+	binary::name_record name;
+	name.kind = binary::NameKind::Scope;
+	name.id = static_cast<std::uint16_t>(_scopeIds.size());
+	name.name = scope->getName();
+
+	binary::encode_name(reserve(binary::name_record_size(name)), name);
+
+	_scopeIds.emplace(scope, name.id);
+	return name.id;
+}
+
+void BinaryTraceWriter::processEvent(const trace_event* event) {
+	binary::event_record evt;
+	evt.kind = getEventKind(event->type);
+	evt.flags = (event->pid == GPU_PID) ? binary::EVENT_FLAG_GPU : 0;
+	evt.category = getCategoryId(event->category);
+	evt.scope = getScopeId(event->scope);
+	evt.tid = static_cast<std::uint32_t>(event->tid);
+	evt.timestamp = event->timestamp;
+	evt.duration = event->duration;
+	evt.value = event->value;
+
+	binary::encode_event(reserve(binary::EVENT_RECORD_SIZE), evt);
+
+	++_numEvents;
+}
+}
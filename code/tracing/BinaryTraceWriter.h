@@ -0,0 +1,49 @@
+#ifndef _BINARYTRACEWRITER_H
+#define _BINARYTRACEWRITER_H
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+
+#include <fstream>
+
+/** @file
+ *  @ingroup tracing
+ */
+
+namespace tracing
+{
+/**
+ * @brief Writes events in the binary trace format
+ *
+ * Events are encoded into a memory block which is written to the file once it's full, so the file is only touched every
+ * few ten thousand events. Use tools/trace_converter to turn the trace into a JSON file for chrome://tracing.
+ */
+class BinaryTraceWriter
+{
+	std::ofstream _out;
+
+	SCP_vector<std::uint8_t> _block;
+	size_t _used = 0;
+
+	SCP_unordered_map<const Category*, std::uint16_t> _categoryIds;
+	SCP_unordered_map<const Scope*, std::uint16_t> _scopeIds;
+
+	std::uint64_t _numEvents = 0;
+
+	void flush();
+
+	std::uint8_t* reserve(size_t size);
+
+	std::uint16_t getCategoryId(const Category* category);
+	std::uint16_t getScopeId(const Scope* scope);
+
+public:
+	explicit BinaryTraceWriter(std::int64_t pid);
+	~BinaryTraceWriter();
+
+	void processEvent(const trace_event* event);
+};
+}
+
+#endif // _BINARYTRACEWRITER_H
@@ -0,0 +1,115 @@
+
+#include "tracing/EventRingBuffers.h"
+
+#include <cinttypes>
+#include <chrono>
+
+namespace {
+// How long the background thread sleeps if there was nothing to do
+const std::chrono::milliseconds IDLE_SLEEP(2);
+
+std::atomic<int> next_generation(1);
+
+struct thread_buffer_cache {
+	int generation = 0;
+	void* buffer = nullptr;
+};
+
+thread_local thread_buffer_cache this_thread_buffer;
+}
+
+namespace tracing {
+
+EventRingBuffers::EventRingBuffers(size_t buffer_size, EventHandler handler)
+	: _bufferSize(buffer_size), _handler(std::move(handler)), _generation(next_generation++), _shutdown(false),
+	  _numStalls(0) {
+	// Only start the thread once everything it uses is set up
+	_worker_thread = std::thread(&EventRingBuffers::workerThread, this);
+}
+
+EventRingBuffers::~EventRingBuffers() {
+	_shutdown.store(true);
+	_worker_thread.join();
+
+	auto stalls = _numStalls.load();
+	if (stalls > 0) {
+		mprintf(("Tracing: Threads had to wait %" PRIu64 " times for room in their event buffer\n", stalls));
+	}
+}
+
+EventRingBuffers::thread_buffer* EventRingBuffers::getThreadBuffer() {
+	if (this_thread_buffer.generation == _generation) {
+		return static_cast<thread_buffer*>(this_thread_buffer.buffer);
+	}
+
+	std::unique_ptr<thread_buffer> buffer(new thread_buffer(_bufferSize));
+	auto ptr = buffer.get();
+
+	{
+		std::lock_guard<std::mutex> guard(_buffersMutex);
+		_buffers.push_back(std::move(buffer));
+	}
+
+	this_thread_buffer.generation = _generation;
+	this_thread_buffer.buffer = ptr;
+
+	return ptr;
+}
+
+void EventRingBuffers::processEvent(const trace_event* event) {
+	auto buffer = getThreadBuffer();
+
+	if (buffer->try_push(*event)) {
+		return;
+	}
+
+	_numStalls.fetch_add(1, std::memory_order_relaxed);
+
+	while (!buffer->try_push(*event)) {
+		std::this_thread::yield();
+	}
+}
+
+size_t EventRingBuffers::drain(SCP_vector<thread_buffer*>& buffers) {
+	{
+		// New threads may have registered since the last time
+		std::lock_guard<std::mutex> guard(_buffersMutex);
+		if (buffers.size() != _buffers.size()) {
+			buffers.clear();
+			for (auto& buffer : _buffers) {
+				buffers.push_back(buffer.get());
+			}
+		}
+	}
+
+	size_t num_events = 0;
+	trace_event evt;
+
+	for (auto buffer : buffers) {
+		// Only take what's there right now so a busy thread can't keep the others waiting
+		auto available = buffer->size();
+
+		for (size_t i = 0; i < available && buffer->try_pop(evt); ++i) {
+			_handler(&evt);
+			++num_events;
+		}
+	}
+
+	return num_events;
+}
+
+void EventRingBuffers::workerThread() {
+	SCP_vector<thread_buffer*> buffers;
+
+	while (!_shutdown.load()) {
+		if (drain(buffers) == 0) {
+			std::this_thread::sleep_for(IDLE_SLEEP);
+		}
+	}
+
+	// Get the events which were submitted before the shutdown
+	while (drain(buffers) > 0) {
+	}
+}
+
+}
@@ -0,0 +1,80 @@
+#ifndef _EVENTRINGBUFFERS_H
+#define _EVENTRINGBUFFERS_H
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+
+#include "utils/spsc_ring_buffer.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/** @file
+ *  @ingroup tracing
+ */
+
+namespace tracing {
+
+/**
+ * @brief Hands trace events from any number of threads to a single background thread
+ *
+ * Every thread which submits events gets its own single-producer ring buffer the first time it does so. Submitting an
+ * event is a copy into that buffer and never takes a lock, the background thread regularly drains all buffers and calls
+ * the handler for every event. Events of one thread are handled in the order they were pushed, there is no ordering
+ * between threads.
+ *
+ * If a buffer fills up faster than it's drained the submitting thread waits for room instead of dropping the event.
+ */
+class EventRingBuffers {
+ public:
+	typedef std::function<void(const trace_event*)> EventHandler;
+
+ private:
+	typedef util::spsc_ring_buffer<trace_event> thread_buffer;
+
+	size_t _bufferSize;
+	EventHandler _handler;
+
+	// Only registration of a new thread and the background thread lock this, buffers live as long as this object
+	std::mutex _buffersMutex;
+	SCP_vector<std::unique_ptr<thread_buffer>> _buffers;
+
+	// Tells the thread local buffer pointers of different instances apart
+	int _generation;
+
+	std::atomic<bool> _shutdown;
+	std::atomic<std::uint64_t> _numStalls;
+
+	std::thread _worker_thread;
+
+	thread_buffer* getThreadBuffer();
+
+	size_t drain(SCP_vector<thread_buffer*>& buffers);
+
+	void workerThread();
+
+ public:
+	/**
+	 * @param buffer_size The number of events each thread can have in flight
+	 * @param handler Called from the background thread for every event
+	 */
+	EventRingBuffers(size_t buffer_size, EventHandler handler);
+
+	/**
+	 * @brief Handles the remaining events and stops the background thread
+	 */
+	~EventRingBuffers();
+
+	EventRingBuffers(const EventRingBuffers&) = delete;
+	EventRingBuffers& operator=(const EventRingBuffers&) = delete;
+
+	void processEvent(const trace_event* event);
+};
+
+}
+
+#endif // _EVENTRINGBUFFERS_H
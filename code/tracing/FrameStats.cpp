@@ -0,0 +1,325 @@
+
+#include "tracing/FrameStats.h"
+#include "parse/parselo.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+
+namespace {
+using namespace tracing;
+
+// 50ms, a frame that long is a visible hitch
+const std::uint64_t DEFAULT_SPIKE_THRESHOLD = 50000;
+
+// How many spikes are kept for the report
+const size_t MAX_SPIKES = 100;
+
+void appendf(SCP_string& out, const char* format, ...) {
+	SCP_string line;
+
+	va_list args;
+	va_start(args, format);
+	vsprintf(line, format, args);
+	va_end(args);
+
+	out += line;
+}
+
+json_t* histogram_to_json(const util::hdr_histogram& histogram) {
+	return json_pack("{sIsIsIsIsIsf}",
+	                 "count", (json_int_t)histogram.count(),
+	                 "p50", (json_int_t)histogram.percentile(50.0),
+	                 "p95", (json_int_t)histogram.percentile(95.0),
+	                 "p99", (json_int_t)histogram.percentile(99.0),
+	                 "max", (json_int_t)histogram.max(),
+	                 "mean", histogram.mean());
+}
+}
+
+namespace tracing {
+
+FrameStats::FrameStats() : _spikeThreshold(DEFAULT_SPIKE_THRESHOLD) {
+	_categories.resize(static_cast<size_t>(Category::getNumCategories()));
+	_touched.reserve(_categories.size());
+	_childTimes.reserve(32);
+}
+
+FrameStats::category_stats& FrameStats::getStats(const Category* category) {
+	auto index = static_cast<size_t>(category->getIndex());
+
+	// Monitors and scripts create their categories whenever they like
+	if (index >= _categories.size()) {
+		_categories.resize(index + 1);
+	}
+
+	auto& stats = _categories[index];
+
+	if (stats.name.empty()) {
+		stats.name = category->getName();
+	}
+
+	if (!stats.touched) {
+		stats.touched = true;
+		_touched.push_back(static_cast<int>(index));
+	}
+
+	return stats;
+}
+
+void FrameStats::beginScope() {
+	_childTimes.push_back(0);
+}
+
+void FrameStats::endScope(const Category* category, std::uint64_t duration) {
+	std::uint64_t child_time = 0;
+	if (!_childTimes.empty()) {
+		child_time = _childTimes.back();
+		_childTimes.pop_back();
+	}
+
+	if (!_childTimes.empty()) {
+		_childTimes.back() += duration;
+	}
+
+	auto& stats = getStats(category);
+	stats.frame_time += duration;
+	stats.frame_self_time += (duration > child_time) ? (duration - child_time) : 0;
+}
+
+void FrameStats::monitorValue(const Category* category, float value) {
+	auto& stats = getStats(category);
+	stats.is_monitor = true;
+	stats.monitor_value = value;
+}
+
+void FrameStats::clearFrame() {
+	for (auto index : _touched) {
+		auto& stats = _categories[index];
+
+		stats.frame_time = 0;
+		stats.frame_self_time = 0;
+		stats.touched = false;
+	}
+	_touched.clear();
+}
+
+void FrameStats::frameBegin(std::uint64_t timestamp) {
+	// Whatever happened between frames (loading, menus) isn't part of any frame
+	clearFrame();
+
+	_frameStart = timestamp;
+	_inFrame = true;
+}
+
+void FrameStats::frameEnd(std::uint64_t timestamp) {
+	if (!_inFrame) {
+		return;
+	}
+	_inFrame = false;
+
+	auto frame_time = (timestamp - _frameStart) / 1000;
+
+	_frameTimes.record(frame_time);
+	++_numFrames;
+
+	for (auto index : _touched) {
+		auto& stats = _categories[index];
+
+		if (stats.is_monitor) {
+			stats.histogram.record((stats.monitor_value > 0.f) ? static_cast<std::uint64_t>(stats.monitor_value + 0.5f) : 0);
+		} else {
+			stats.histogram.record(stats.frame_time / 1000);
+		}
+	}
+
+	if (frame_time > _spikeThreshold) {
+		recordSpike(frame_time);
+	}
+
+	clearFrame();
+}
+
+void FrameStats::recordSpike(std::uint64_t frame_time) {
+	spike spk;
+	spk.frame = _numFrames;
+	spk.frame_time = frame_time;
+
+	// Keep the categories with the most self time, sorted by it
+	for (auto index : _touched) {
+		auto& stats = _categories[index];
+		if (stats.is_monitor) {
+			continue;
+		}
+
+		spike_cause cause;
+		cause.category = index;
+		cause.self_time = stats.frame_self_time / 1000;
+
+		for (int i = 0; i < NUM_SPIKE_CAUSES; ++i) {
+			if (spk.causes[i].category < 0 || cause.self_time > spk.causes[i].self_time) {
+				std::swap(cause, spk.causes[i]);
+			}
+		}
+	}
+
+	++_numSpikes;
+
+	_spikes.push_back(spk);
+	if (_spikes.size() > MAX_SPIKES) {
+		_spikes.pop_front();
+	}
+}
+
+void FrameStats::reset() {
+	clearFrame();
+
+	for (auto& stats : _categories) {
+		stats.histogram.reset();
+	}
+
+	_frameTimes.reset();
+	_numFrames = 0;
+	_numSpikes = 0;
+	_spikes.clear();
+}
+
+void FrameStats::setSpikeThreshold(std::uint64_t threshold) {
+	_spikeThreshold = threshold;
+}
+
+std::uint64_t FrameStats::getSpikeThreshold() const {
+	return _spikeThreshold;
+}
+
+SCP_string FrameStats::getSummary(size_t num_categories) const {
+	SCP_string out;
+
+	appendf(out, "%" PRIu64 " frames, frame time p50 %.2fms, p95 %.2fms, p99 %.2fms, max %.2fms\n", _numFrames,
+	        _frameTimes.percentile(50.0) / 1000.0, _frameTimes.percentile(95.0) / 1000.0,
+	        _frameTimes.percentile(99.0) / 1000.0, _frameTimes.max() / 1000.0);
+	appendf(out, "%" PRIu64 " spikes above %.2fms\n", _numSpikes, _spikeThreshold / 1000.0);
+
+	SCP_vector<const category_stats*> sorted;
+	for (auto& stats : _categories) {
+		if (!stats.is_monitor && stats.histogram.count() > 0) {
+			sorted.push_back(&stats);
+		}
+	}
+
+	std::sort(sorted.begin(), sorted.end(), [](const category_stats* left, const category_stats* right) {
+		return left->histogram.percentile(99.0) > right->histogram.percentile(99.0);
+	});
+
+	if (sorted.size() > num_categories) {
+		sorted.resize(num_categories);
+	}
+
+	if (!sorted.empty()) {
+		out += "Categories with the highest p99 (ms):\n";
+	}
+
+	for (auto stats : sorted) {
+		appendf(out, "  %-40s p50 %7.2f  p95 %7.2f  p99 %7.2f  max %7.2f\n", stats->name.c_str(),
+		        stats->histogram.percentile(50.0) / 1000.0, stats->histogram.percentile(95.0) / 1000.0,
+		        stats->histogram.percentile(99.0) / 1000.0, stats->histogram.max() / 1000.0);
+	}
+
+	return out;
+}
+
+SCP_string FrameStats::getCategoryReport(const SCP_string& filter, bool monitors) const {
+	SCP_string out;
+
+	for (auto& stats : _categories) {
+		if (stats.is_monitor != monitors || stats.histogram.count() == 0) {
+			continue;
+		}
+		if (!filter.empty() && stristr(stats.name.c_str(), filter.c_str()) == nullptr) {
+			continue;
+		}
+
+		if (monitors) {
+			appendf(out, "  %-40s %7" PRIu64 " frames  p50 %7" PRIu64 "  p95 %7" PRIu64 "  p99 %7" PRIu64 "  max %7" PRIu64
+			        "\n", stats.name.c_str(), stats.histogram.count(), stats.histogram.percentile(50.0),
+			        stats.histogram.percentile(95.0), stats.histogram.percentile(99.0), stats.histogram.max());
+		} else {
+			appendf(out, "  %-40s %7" PRIu64 " frames  p50 %7.2fms  p95 %7.2fms  p99 %7.2fms  max %7.2fms\n",
+			        stats.name.c_str(), stats.histogram.count(), stats.histogram.percentile(50.0) / 1000.0,
+			        stats.histogram.percentile(95.0) / 1000.0, stats.histogram.percentile(99.0) / 1000.0,
+			        stats.histogram.max() / 1000.0);
+		}
+	}
+
+	if (out.empty()) {
+		out = "Nothing recorded\n";
+	}
+
+	return out;
+}
+
+SCP_string FrameStats::getSpikeReport(size_t num_spikes) const {
+	SCP_string out;
+
+	appendf(out, "%" PRIu64 " spikes above %.2fms\n", _numSpikes, _spikeThreshold / 1000.0);
+
+	auto first = (_spikes.size() > num_spikes) ? (_spikes.size() - num_spikes) : 0;
+
+	for (auto i = first; i < _spikes.size(); ++i) {
+		auto& spk = _spikes[i];
+
+		appendf(out, "  frame %" PRIu64 ": %.2fms", spk.frame, spk.frame_time / 1000.0);
+
+		for (auto& cause : spk.causes) {
+			if (cause.category >= 0) {
+				appendf(out, ", %s %.2fms", _categories[cause.category].name.c_str(), cause.self_time / 1000.0);
+			}
+		}
+
+		out += "\n";
+	}
+
+	return out;
+}
+
+json_t* FrameStats::toJson() const {
+	auto root = json_object();
+
+	json_object_set_new(root, "frames", json_integer((json_int_t)_numFrames));
+	json_object_set_new(root, "frame_time_us", histogram_to_json(_frameTimes));
+	json_object_set_new(root, "spike_threshold_us", json_integer((json_int_t)_spikeThreshold));
+	json_object_set_new(root, "num_spikes", json_integer((json_int_t)_numSpikes));
+
+	auto spikes = json_array();
+	for (auto& spk : _spikes) {
+		auto causes = json_array();
+		for (auto& cause : spk.causes) {
+			if (cause.category >= 0) {
+				json_array_append_new(causes, json_pack("{sssI}", "category", _categories[cause.category].name.c_str(),
+				                                        "self_time_us", (json_int_t)cause.self_time));
+			}
+		}
+
+		json_array_append_new(spikes, json_pack("{sIsIso}", "frame", (json_int_t)spk.frame, "frame_time_us",
+		                                        (json_int_t)spk.frame_time, "causes", causes));
+	}
+	json_object_set_new(root, "spikes", spikes);
+
+	auto categories = json_object();
+	auto monitors = json_object();
+	for (auto& stats : _categories) {
+		if (stats.histogram.count() == 0) {
+			continue;
+		}
+
+		json_object_set_new(stats.is_monitor ? monitors : categories, stats.name.c_str(),
+		                    histogram_to_json(stats.histogram));
+	}
+	// Category values are in microseconds, monitors are whatever they count
+	json_object_set_new(root, "categories_us", categories);
+	json_object_set_new(root, "monitors", monitors);
+
+	return root;
+}
+
+}
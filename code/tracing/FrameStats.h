@@ -0,0 +1,119 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+
+#include "utils/hdr_histogram.h"
+
+#include <jansson.h>
+
+/** @file
+ *  @ingroup tracing
+ */
+
+namespace tracing {
+
+/**
+ * @brief Keeps frame time statistics for long play sessions
+ *
+ * For every frame this collects how much time was spent in each tracing category and the last value of each monitor,
+ * and adds those to a histogram per category. A frame which takes longer than the spike threshold is remembered
+ * together with the categories which took the most time in it (not counting the time spent in nested categories).
+ *
+ * Only events of the main thread are used. Frames are delimited by the MainFrame async events.
+ */
+class FrameStats {
+ public:
+	static const int NUM_SPIKE_CAUSES = 3;
+
+	struct spike_cause {
+		int category = -1;
+		std::uint64_t self_time = 0;	// microseconds
+	};
+
+	struct spike {
+		std::uint64_t frame = 0;
+		std::uint64_t frame_time = 0;	// microseconds
+		spike_cause causes[NUM_SPIKE_CAUSES];
+	};
+
+ private:
+	struct category_stats {
+		SCP_string name;
+		bool is_monitor = false;
+
+		// microseconds per frame for categories, values for monitors
+		util::hdr_histogram histogram;
+
+		// this frame, in nanoseconds
+		std::uint64_t frame_time = 0;
+		std::uint64_t frame_self_time = 0;
+		float monitor_value = 0.f;
+		bool touched = false;
+	};
+
+	SCP_vector<category_stats> _categories;		// by category index, grown as needed
+	SCP_vector<int> _touched;					// the categories which have data for the current frame
+	SCP_vector<std::uint64_t> _childTimes;		// time spent in nested categories, one entry per open scope
+
+	util::hdr_histogram _frameTimes;
+	std::uint64_t _frameStart = 0;
+	bool _inFrame = false;
+	std::uint64_t _numFrames = 0;
+
+	std::uint64_t _spikeThreshold;
+	std::uint64_t _numSpikes = 0;
+	SCP_deque<spike> _spikes;					// the most recent spikes
+
+	category_stats& getStats(const Category* category);
+
+	void recordSpike(std::uint64_t frame_time);
+
+	void clearFrame();
+
+ public:
+	FrameStats();
+
+	// Called by the tracing code
+	void beginScope();
+	void endScope(const Category* category, std::uint64_t duration);
+	void monitorValue(const Category* category, float value);
+	void frameBegin(std::uint64_t timestamp);
+	void frameEnd(std::uint64_t timestamp);
+
+	/**
+	 * @brief Forgets everything which was recorded so far
+	 */
+	void reset();
+
+	/**
+	 * @brief Frames which take longer than this are recorded as spikes
+	 * @param threshold The threshold in microseconds
+	 */
+	void setSpikeThreshold(std::uint64_t threshold);
+	std::uint64_t getSpikeThreshold() const;
+
+	/**
+	 * @brief Frame time percentiles and the categories with the worst 99th percentile
+	 * @param num_categories How many categories to list
+	 */
+	SCP_string getSummary(size_t num_categories) const;
+
+	/**
+	 * @brief The statistics of all categories, or all monitors, whose name contains the filter (case insensitive)
+	 */
+	SCP_string getCategoryReport(const SCP_string& filter, bool monitors) const;
+
+	/**
+	 * @brief The most recent spikes and what caused them
+	 * @param num_spikes How many spikes to list
+	 */
+	SCP_string getSpikeReport(size_t num_spikes) const;
+
+	/**
+	 * @brief Everything that was recorded, as a JSON object
+	 */
+	json_t* toJson() const;
+};
+
+}
@@ -3,8 +3,6 @@
 #include "globalincs/pstypes.h"
 #include "tracing/tracing.h"
 
-#include "tracing/ThreadedEventProcessor.h"
-
 #include <fstream>
 
 
@@ -25,7 +23,5 @@ class MainFrameTimer
 
 	void processEvent(const trace_event* event);
 };
-
-typedef ThreadedEventProcessor<MainFrameTimer> ThreadedMainFrameTimer;
 }
 
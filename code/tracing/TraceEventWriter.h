@@ -5,8 +5,6 @@
 #include "globalincs/pstypes.h"
 #include "tracing/tracing.h"
 
-#include "tracing/ThreadedEventProcessor.h"
-
 #include <fstream>
 
 /** @file
@@ -26,8 +24,6 @@ public:
 
 	void processEvent(const trace_event* event);
 };
-
-typedef ThreadedEventProcessor<TraceEventWriter> ThreadedTraceEventWriter;
 }
 
 #endif // _TRACEEVENTWRITER_H
@@ -1,9 +1,24 @@
 
 #include "tracing/categories.h"
 
+#include <atomic>
+
 namespace tracing {
 
-Category::Category(const char* name, bool is_graphics) : _name(name), _graphics_category(is_graphics) {
+namespace {
+// Categories are global variables so this can't be a global variable itself. Monitors create theirs on first use, which
+// may be on any thread.
+std::atomic<int>& category_counter() {
+	static std::atomic<int> counter(0);
+	return counter;
+}
+}
+
+Category::Category(const char* name, bool is_graphics) : _name(name), _graphics_category(is_graphics),
+                                                         _index(category_counter()++) {
+}
+int Category::getNumCategories() {
+	return category_counter().load();
 }
 const char* Category::getName() const {
 	return _name.c_str();
@@ -83,6 +98,7 @@ Category BuildShadowMap("Build Shadow Map", true);
 Category RenderScene("Render scene", true);
 Category RenderTrails("Render trails", true);
 Category MoveObjects("Move Objects", false);
+Category ObjectSnapshot("Object snapshot", false);
 Category ProcessParticleEffects("Process particle effects", false);
 Category TrailsMoveAll("Trails move all", false);
 Category Simulation("Simulation", false);
@@ -136,6 +152,7 @@ Category LoadSound("Load Sound", false);
 Category LevelPageIn("Level page in", false);
 Category PageInStop("Finish page in", false);
 Category PageInSingleBitmap("Page in single bitmap", false);
+Category TextureEviction("Texture eviction", false);
 Category ShipPageIn("Ship page in", false);
 Category WeaponPageIn("Weapon page in", false);
 
@@ -17,12 +17,23 @@ namespace tracing {
 class Category {
 	const SCP_string _name;
 	bool _graphics_category;
+	int _index;
  public:
 	Category(const char* name, bool is_graphics);
 
 	const char* getName() const;
 
 	bool usesGPUCounter() const;
+
+	/**
+	 * @brief A number unique to this category, categories are numbered from 0 in the order they were created
+	 */
+	int getIndex() const { return _index; }
+
+	/**
+	 * @brief The number of categories created so far, including the ones of monitors
+	 */
+	static int getNumCategories();
 };
 
 extern Category LuaOnFrame;
@@ -96,6 +107,7 @@ extern Category BuildShadowMap;
 extern Category RenderScene;
 extern Category RenderTrails;
 extern Category MoveObjects;
+extern Category ObjectSnapshot;
 extern Category ProcessParticleEffects;
 extern Category TrailsMoveAll;
 extern Category Simulation;
@@ -150,6 +162,7 @@ extern Category LoadSound;
 extern Category LevelPageIn;
 extern Category PageInStop;
 extern Category PageInSingleBitmap;
+extern Category TextureEviction;
 extern Category ShipPageIn;
 extern Category WeaponPageIn;
 
@@ -1,9 +1,15 @@
 
 #include "tracing/tracing.h"
+#include "cfile/cfile.h"
+#include "debugconsole/console.h"
 #include "graphics/2d.h"
+#include "libs/jansson.h"
 #include "parse/parselo.h"
 #include "io/timer.h"
 
+#include "BinaryTraceWriter.h"
+#include "EventRingBuffers.h"
+#include "FrameStats.h"
 #include "TraceEventWriter.h"
 #include "MainFrameTimer.h"
 #include "FrameProfiler.h"
@@ -52,10 +58,21 @@ namespace {
 
 using namespace tracing;
 
-std::unique_ptr<ThreadedTraceEventWriter> traceEventWriter;
-std::unique_ptr<ThreadedMainFrameTimer> mainFrameTimer;
+// The number of events each thread can submit before the background thread has to catch up
+const size_t EVENT_BUFFER_SIZE = 16384;
+
+// These are only used from the background thread of eventBuffers
+std::unique_ptr<TraceEventWriter> traceEventWriter;
+std::unique_ptr<BinaryTraceWriter> binaryTraceWriter;
+std::unique_ptr<MainFrameTimer> mainFrameTimer;
+
+std::unique_ptr<EventRingBuffers> eventBuffers;
+
 std::unique_ptr<FrameProfiler> frameProfiler;
 
+// Always on, only used from the main thread
+std::unique_ptr<FrameStats> frameStats;
+
 SCP_vector<int> query_objects;
 // The GPU timestamp queries use an internal free list to reduce the number of graphics API calls
 SCP_queue<int> free_query_objects;
@@ -102,6 +119,17 @@ bool do_async_events = false;
 bool do_counter_events = false;
 std::int64_t main_thread_id = -1;
 
+// get_tid() and get_pid() are system calls, which adds up with every scope being timed for the frame statistics
+thread_local std::int64_t this_thread_id = -1;
+std::int64_t process_id = -1;
+
+std::int64_t current_tid() {
+	if (this_thread_id < 0) {
+		this_thread_id = get_tid();
+	}
+	return this_thread_id;
+}
+
 int gpu_start_query = -1;
 std::uint64_t gpu_start_time = 0;
 std::uint64_t cpu_start_time = 0;
@@ -115,17 +143,28 @@ void submit_event(trace_event* evt) {
 		evt->timestamp -= cpu_start_time;
 	}
 
+	if (eventBuffers) {
+		// The writers are fed from the background thread
+		eventBuffers->processEvent(evt);
+	}
+
+	if (frameProfiler) {
+		frameProfiler->processEvent(evt);
+	}
+}
+
+void process_buffered_event(const trace_event* evt) {
 	if (traceEventWriter) {
-		// Trace event writer receives all events
+		// Trace event writers receive all events
 		traceEventWriter->processEvent(evt);
 	}
 
-	if (mainFrameTimer) {
-		mainFrameTimer->processEvent(evt);
+	if (binaryTraceWriter) {
+		binaryTraceWriter->processEvent(evt);
 	}
 
-	if (frameProfiler) {
-		frameProfiler->processEvent(evt);
+	if (mainFrameTimer) {
+		mainFrameTimer->processEvent(evt);
 	}
 }
 
@@ -204,8 +243,29 @@ void init_event(const Category& category, trace_event* evt) {
 
 	evt->timestamp = timer_get_nanoseconds();
 
-	evt->pid = get_pid();
-	evt->tid = get_tid();
+	evt->pid = process_id;
+	evt->tid = current_tid();
+}
+
+void write_frame_stats(const char* mission_filename) {
+	SCP_string name = "frame_stats_";
+	name += (mission_filename != nullptr && *mission_filename != '\0') ? mission_filename : "unknown";
+	drop_extension(name);
+	name += ".json";
+
+	std::unique_ptr<json_t> json(frameStats->toJson());
+	json_object_set_new(json.get(), "mission", json_string((mission_filename != nullptr) ? mission_filename : ""));
+
+	auto cfp = cfopen(name.c_str(), "wt", CFILE_NORMAL, CF_TYPE_DATA);
+	if (cfp == nullptr) {
+		mprintf(("Tracing: Could not write frame statistics to %s\n", name.c_str()));
+		return;
+	}
+
+	json_dump_cfile(json.get(), cfp, JSON_INDENT(2));
+	cfclose(cfp);
+
+	mprintf(("Tracing: Wrote frame statistics to %s\n", name.c_str()));
 }
 }
 
@@ -216,20 +276,31 @@ void init() {
 	do_counter_events = false;
 
 	if (Cmdline_json_profiling) {
-		traceEventWriter.reset(new ThreadedTraceEventWriter());
+		traceEventWriter.reset(new TraceEventWriter());
+		do_trace_events = true;
+		do_async_events = true;
+		do_counter_events = true;
+	}
+	if (Cmdline_binary_profiling) {
+		binaryTraceWriter.reset(new BinaryTraceWriter(get_pid()));
 		do_trace_events = true;
 		do_async_events = true;
 		do_counter_events = true;
 	}
 	if (Cmdline_profile_write_file) {
-		mainFrameTimer.reset(new ThreadedMainFrameTimer());
+		mainFrameTimer.reset(new MainFrameTimer());
 		do_async_events = true;
 	}
+	if (traceEventWriter || binaryTraceWriter || mainFrameTimer) {
+		eventBuffers.reset(new EventRingBuffers(EVENT_BUFFER_SIZE, process_buffered_event));
+	}
 	if (Cmdline_frame_profile) {
 		frameProfiler.reset(new FrameProfiler());
 		do_trace_events = true;
 	}
 
+	frameStats.reset(new FrameStats());
+
 	do_gpu_queries = gr_is_capable(CAPABILITY_TIMESTAMP_QUERY);
 
 	if (do_gpu_queries) {
@@ -237,7 +308,8 @@ void init() {
 	}
 	cpu_start_time = timer_get_nanoseconds();
 
-	main_thread_id = get_tid();
+	process_id = get_pid();
+	main_thread_id = current_tid();
 
 	initialized = true;
 }
@@ -260,6 +332,16 @@ SCP_string get_frame_profile_output() {
 	return frameProfiler->getContent();
 }
 
+void frame_stats_mission_done(const char* mission_filename) {
+	if (!frameStats) {
+		return;
+	}
+
+	write_frame_stats(mission_filename);
+
+	frameStats->reset();
+}
+
 void shutdown() {
 	while (!gpu_events.empty()) {
 		process_events();
@@ -273,21 +355,27 @@ void shutdown() {
 	}
 	query_objects.clear();
 
+	// This handles the remaining events so it must go before the writers
+	eventBuffers = nullptr;
+
 	mainFrameTimer = nullptr;
+	binaryTraceWriter = nullptr;
 	traceEventWriter = nullptr;
 
+	frameStats = nullptr;
+
 	initialized = false;
 }
 
 namespace complete {
 
 void start(const Category& category, trace_event* evt) {
-	if (!do_trace_events) {
-		// No one to process the event is here
+	if (!initialized) {
 		return;
 	}
 
-	if (!initialized) {
+	if (!do_trace_events && !frameStats) {
+		// No one to process the event is here
 		return;
 	}
 
@@ -295,6 +383,16 @@ void start(const Category& category, trace_event* evt) {
 
 	evt->duration = 0;
 	evt->type = EventType::Complete;
+
+	if (frameStats && evt->tid == main_thread_id) {
+		frameStats->beginScope();
+	}
+
+	if (!do_trace_events) {
+		// Only needed for the frame statistics
+		return;
+	}
+
 	evt->event_id = ++current_id;
 
 	if (do_gpu_queries && category.usesGPUCounter()) {
@@ -314,8 +412,8 @@ void start(const Category& category, trace_event* evt) {
 }
 
 void end(trace_event* evt) {
-	if (!do_trace_events) {
-		// No one to process the event is here
+	if (evt->type != EventType::Complete) {
+		// start() didn't do anything
 		return;
 	}
 
@@ -323,10 +421,19 @@ void end(trace_event* evt) {
 		return;
 	}
 
-	Assertion(evt->pid == get_pid(), "Complete events must be generated from the same process!");
-	Assertion(evt->tid == get_tid(), "Complete events must be generated from the same thread!");
+	Assertion(evt->pid == process_id, "Complete events must be generated from the same process!");
+	Assertion(evt->tid == current_tid(), "Complete events must be generated from the same thread!");
 
 	evt->duration = timer_get_nanoseconds() - evt->timestamp;
+
+	if (frameStats && evt->tid == main_thread_id) {
+		frameStats->endScope(evt->category, evt->duration);
+	}
+
+	if (!do_trace_events) {
+		return;
+	}
+
 	evt->end_event_id = ++current_id;
 
 	// Process CPU events
@@ -354,6 +461,10 @@ void end(trace_event* evt) {
 namespace async {
 
 void begin(const Category& category, const Scope& async_scope) {
+	if (frameStats && &category == &MainFrame && &async_scope == &MainFrameScope) {
+		frameStats->frameBegin(timer_get_nanoseconds());
+	}
+
 	if (!do_async_events) {
 		return;
 	}
@@ -384,6 +495,10 @@ void step(const Category& category, const Scope& async_scope) {
 }
 
 void end(const Category& category, const Scope& async_scope) {
+	if (frameStats && &category == &MainFrame && &async_scope == &MainFrameScope) {
+		frameStats->frameEnd(timer_get_nanoseconds());
+	}
+
 	if (!do_async_events) {
 		return;
 	}
@@ -403,6 +518,10 @@ void end(const Category& category, const Scope& async_scope) {
 namespace counter {
 
 void value(const Category& category, float value) {
+	if (frameStats && initialized && current_tid() == main_thread_id) {
+		frameStats->monitorValue(&category, value);
+	}
+
 	if (!do_counter_events) {
 		return;
 	}
@@ -419,3 +538,67 @@ void value(const Category& category, float value) {
 }
 
 }
+
+DCF(frame_stats, "Shows frame time statistics of the current mission (Usage: frame_stats [spikes|categories|monitors|threshold|reset|dump])")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: frame_stats [spikes|categories|monitors|threshold|reset|dump]\n");
+		dc_printf("Without arguments shows the frame time percentiles and the categories with the worst p99.\n");
+		dc_printf("  spikes [count]       the most recent frames above the spike threshold and what took the most time in them\n");
+		dc_printf("  categories [filter]  all tracing categories whose name contains <filter>\n");
+		dc_printf("  monitors [filter]    all monitors whose name contains <filter>\n");
+		dc_printf("  threshold <ms>       sets the spike threshold\n");
+		dc_printf("  reset                forgets everything recorded so far\n");
+		dc_printf("  dump                 writes the statistics to data/frame_stats_current.json\n");
+		return;
+	}
+
+	if (!frameStats) {
+		dc_printf("Frame statistics are not available\n");
+		return;
+	}
+
+	if (dc_optional_string("spikes")) {
+		int count = 10;
+		dc_maybe_stuff_int(&count);
+
+		dc_printf("%s", frameStats->getSpikeReport(static_cast<size_t>(std::max(count, 0))).c_str());
+		return;
+	}
+
+	bool monitors = false;
+	if (dc_optional_string("categories") || (monitors = dc_optional_string("monitors"))) {
+		SCP_string filter;
+		dc_maybe_stuff_string_white(filter);
+
+		dc_printf("%s", frameStats->getCategoryReport(filter, monitors).c_str());
+		return;
+	}
+
+	if (dc_optional_string("threshold")) {
+		float threshold;
+		dc_stuff_float(&threshold);
+
+		if (threshold <= 0.0f) {
+			dc_printf("The threshold must be greater than 0\n");
+			return;
+		}
+
+		frameStats->setSpikeThreshold(static_cast<std::uint64_t>(threshold * 1000.0f));
+		dc_printf("Frames longer than %.2fms are now recorded as spikes\n", threshold);
+		return;
+	}
+
+	if (dc_optional_string("reset")) {
+		frameStats->reset();
+		dc_printf("Frame statistics reset\n");
+		return;
+	}
+
+	if (dc_optional_string("dump")) {
+		write_frame_stats("current");
+		return;
+	}
+
+	dc_printf("%s", frameStats->getSummary(10).c_str());
+}
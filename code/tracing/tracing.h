@@ -74,6 +74,15 @@ void frame_profile_process_frame();
  */
 SCP_string get_frame_profile_output();
 
+/**
+ * @brief Writes the frame statistics of a mission to data/frame_stats_<mission>.json and starts over
+ *
+ * The statistics are always collected, use the frame_stats debug console command to look at them while playing.
+ *
+ * @param mission_filename The filename of the mission which just ended
+ */
+void frame_stats_mission_done(const char* mission_filename);
+
 /**
  * @brief Deinitializes the tracing subsystem
  */
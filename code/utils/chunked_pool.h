@@ -0,0 +1,231 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+namespace util {
+
+/**
+ * @brief A growable array of slots whose addresses never change
+ *
+ * The slots are allocated in chunks of ChunkSize elements. Growing the pool adds another chunk instead of moving the
+ * existing ones so pointers to slots (linked lists, object_h, etc.) stay valid for the lifetime of the pool. New slots
+ * start out zero filled and default constructed, same as a global array of T would be.
+ *
+ * Slots can be handed out with allocate() and given back with release(), both are O(1). Users which keep track of the
+ * free slots themselves (like the object free list) can use grow() instead and ignore the built-in free list.
+ *
+ * @tparam T The type of the slots
+ * @tparam ChunkSize How many slots are added at once, must be a power of two
+ */
+template<typename T, int ChunkSize>
+class chunked_pool {
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two!");
+
+ public:
+	/**
+	 * @brief A function which is called for every slot a new chunk adds
+	 *
+	 * This is where slots get marked as unused, it's called after the slot has been default constructed.
+	 */
+	typedef std::function<void(T&)> SlotInitializer;
+
+ private:
+	struct chunk_range {
+		T* first;
+		int index;
+
+		bool operator<(const chunk_range& other) const { return first < other.first; }
+	};
+
+	SCP_vector<T*> _chunks;
+	SCP_vector<chunk_range> _ranges;	// the chunks, sorted by address for index_of()
+	SCP_vector<int> _freeSlots;			// stack of the slots which can be handed out by allocate()
+
+	int _maxSize = 0;
+	SlotInitializer _initializer;
+
+ public:
+	explicit chunked_pool(const SlotInitializer& initializer = SlotInitializer()) : _initializer(initializer) {}
+
+	~chunked_pool() {
+		for (auto chunk : _chunks) {
+			for (int i = 0; i < ChunkSize; ++i) {
+				chunk[i].~T();
+			}
+			vm_free(chunk);
+		}
+	}
+
+	// Slots are referred to by address, so the pool itself can't be moved around either
+	chunked_pool(const chunked_pool&) = delete;
+	chunked_pool& operator=(const chunked_pool&) = delete;
+
+	inline T& operator[](int index) {
+		Assertion(index >= 0 && index < size(), "Pool index %d is out of range (size %d)!", index, size());
+		return _chunks[index / ChunkSize][index & (ChunkSize - 1)];
+	}
+	inline const T& operator[](int index) const {
+		Assertion(index >= 0 && index < size(), "Pool index %d is out of range (size %d)!", index, size());
+		return _chunks[index / ChunkSize][index & (ChunkSize - 1)];
+	}
+
+	/**
+	 * @brief The number of slots in the pool, used or not
+	 */
+	inline int size() const { return static_cast<int>(_chunks.size()) * ChunkSize; }
+
+	/**
+	 * @brief Limits how big the pool may grow, 0 means no limit
+	 *
+	 * The limit is rounded up to a whole chunk. It doesn't shrink a pool which is already bigger than that.
+	 */
+	void set_max_size(int max_size) { _maxSize = max_size; }
+
+	/**
+	 * @brief Gets the index of a slot from its address
+	 *
+	 * This is O(log(number of chunks)).
+	 *
+	 * @return The index of the slot, or -1 if ptr doesn't point into this pool
+	 */
+	int index_of(const T* ptr) const {
+		chunk_range key;
+		key.first = const_cast<T*>(ptr);
+		key.index = 0;
+
+		// the last chunk starting at or before ptr
+		auto iter = std::upper_bound(_ranges.begin(), _ranges.end(), key);
+		if (iter == _ranges.begin()) {
+			return -1;
+		}
+		--iter;
+
+		if (ptr >= iter->first + ChunkSize) {
+			return -1;
+		}
+
+		return iter->index + static_cast<int>(ptr - iter->first);
+	}
+
+	/**
+	 * @brief Adds a chunk of slots to the pool
+	 *
+	 * The new slots are not added to the free list.
+	 *
+	 * @return The index of the first new slot, or -1 if the pool is already at its maximum size
+	 */
+	int grow() {
+		if (_maxSize > 0 && size() >= _maxSize) {
+			return -1;
+		}
+
+		auto chunk = reinterpret_cast<T*>(vm_malloc(sizeof(T) * ChunkSize));
+		memset(reinterpret_cast<void*>(chunk), 0, sizeof(T) * ChunkSize);
+
+		for (int i = 0; i < ChunkSize; ++i) {
+			new (&chunk[i]) T();
+
+			if (_initializer) {
+				_initializer(chunk[i]);
+			}
+		}
+
+		int first = size();
+		_chunks.push_back(chunk);
+
+		chunk_range range;
+		range.first = chunk;
+		range.index = first;
+		_ranges.insert(std::upper_bound(_ranges.begin(), _ranges.end(), range), range);
+
+		return first;
+	}
+
+	/**
+	 * @brief Hands out a free slot, growing the pool if there are none left
+	 *
+	 * The slot isn't touched, it has whatever state it was released in.
+	 *
+	 * @return The index of the slot, or -1 if the pool is full
+	 */
+	int allocate() {
+		if (_freeSlots.empty()) {
+			int first = grow();
+			if (first < 0) {
+				return -1;
+			}
+
+			// hand out the lowest indices first
+			for (int i = first + ChunkSize - 1; i >= first; --i) {
+				_freeSlots.push_back(i);
+			}
+		}
+
+		int index = _freeSlots.back();
+		_freeSlots.pop_back();
+
+		return index;
+	}
+
+	/**
+	 * @brief Puts a slot back on the free list
+	 */
+	void release(int index) {
+		Assertion(index >= 0 && index < size(), "Released pool index %d is out of range (size %d)!", index, size());
+		_freeSlots.push_back(index);
+	}
+
+	/**
+	 * @brief Marks every slot as free
+	 *
+	 * Slots are handed out in order of their index again afterwards.
+	 */
+	void release_all() {
+		_freeSlots.clear();
+		_freeSlots.reserve(static_cast<size_t>(size()));
+
+		for (int i = size() - 1; i >= 0; --i) {
+			_freeSlots.push_back(i);
+		}
+	}
+
+	/**
+	 * @brief Frees the chunks which are only needed for slots at or after new_size
+	 *
+	 * The size is rounded up to a whole chunk. The freed slots are destroyed and dropped from the free list, everything
+	 * before them stays where it is.
+	 */
+	void shrink(int new_size) {
+		auto keep = static_cast<size_t>((std::max(new_size, 0) + ChunkSize - 1) / ChunkSize);
+
+		while (_chunks.size() > keep) {
+			auto chunk = _chunks.back();
+
+			for (int i = 0; i < ChunkSize; ++i) {
+				chunk[i].~T();
+			}
+
+			_ranges.erase(std::find_if(_ranges.begin(), _ranges.end(),
+			                           [chunk](const chunk_range& range) { return range.first == chunk; }));
+			_chunks.pop_back();
+
+			vm_free(chunk);
+		}
+
+		int current_size = size();
+		_freeSlots.erase(std::remove_if(_freeSlots.begin(), _freeSlots.end(),
+		                                [current_size](int index) { return index >= current_size; }),
+		                 _freeSlots.end());
+	}
+
+	/**
+	 * @brief The number of slots allocate() can hand out without growing the pool
+	 */
+	inline int num_free() const { return static_cast<int>(_freeSlots.size()); }
+};
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+
+namespace util {
+
+/**
+ * @brief A histogram of integer values with a fixed relative precision
+ *
+ * The buckets are linear up to 2^SubBucketBits and logarithmic after that, with 2^(SubBucketBits-1) buckets per power of
+ * two (like HdrHistogram). With the default of 7 bits every value is reported within 1/64 of its actual value while the
+ * whole range up to 2^32 only takes 1792 buckets. Recording a value is a couple of bit operations and an increment.
+ *
+ * The buckets are only allocated once the first value is recorded so unused histograms are cheap to keep around.
+ */
+class hdr_histogram {
+	static const int SubBucketBits = 7;
+	static const std::uint64_t SubBucketCount = 1 << SubBucketBits;
+	static const std::uint64_t SubBucketHalf = SubBucketCount / 2;
+
+	// Values up to 2^MaxValueBits-1 can be recorded, bigger ones are clamped
+	static const int MaxValueBits = 32;
+
+	SCP_vector<std::uint32_t> _counts;
+
+	std::uint64_t _total = 0;
+	std::uint64_t _min = 0;
+	std::uint64_t _max = 0;
+	std::uint64_t _sum = 0;
+
+	static int highest_bit(std::uint64_t value) {
+		int bit = 0;
+		while (value >>= 1) {
+			++bit;
+		}
+		return bit;
+	}
+
+	static size_t bucket_index(std::uint64_t value) {
+		if (value < SubBucketCount) {
+			return static_cast<size_t>(value);
+		}
+
+		int exponent = highest_bit(value) - SubBucketBits + 1;
+		return static_cast<size_t>(exponent * SubBucketHalf + (value >> exponent));
+	}
+
+	// the highest value which ends up in the bucket
+	static std::uint64_t bucket_value(size_t index) {
+		if (index < SubBucketCount) {
+			return index;
+		}
+
+		auto exponent = static_cast<int>(index / SubBucketHalf) - 1;
+		auto mantissa = index - exponent * SubBucketHalf;
+
+		return ((mantissa + 1) << exponent) - 1;
+	}
+
+ public:
+	/**
+	 * @brief Adds a value to the histogram
+	 */
+	void record(std::uint64_t value) {
+		const std::uint64_t max_value = (static_cast<std::uint64_t>(1) << MaxValueBits) - 1;
+		if (value > max_value) {
+			value = max_value;
+		}
+
+		if (_counts.empty()) {
+			_counts.resize(bucket_index(max_value) + 1, 0);
+		}
+
+		++_counts[bucket_index(value)];
+
+		if (_total == 0 || value < _min) {
+			_min = value;
+		}
+		if (value > _max) {
+			_max = value;
+		}
+
+		++_total;
+		_sum += value;
+	}
+
+	/**
+	 * @brief Gets the value below which the given percentage of the recorded values are
+	 *
+	 * @param percent The percentile, 0 to 100
+	 * @return The value, or 0 if nothing was recorded
+	 */
+	std::uint64_t percentile(double percent) const {
+		if (_total == 0) {
+			return 0;
+		}
+
+		CLAMP(percent, 0.0, 100.0);
+
+		auto wanted = static_cast<std::uint64_t>(percent / 100.0 * _total + 0.5);
+		if (wanted < 1) {
+			wanted = 1;
+		}
+
+		std::uint64_t seen = 0;
+		for (size_t i = 0; i < _counts.size(); ++i) {
+			seen += _counts[i];
+
+			if (seen >= wanted) {
+				auto value = bucket_value(i);
+				return (value > _max) ? _max : ((value < _min) ? _min : value);
+			}
+		}
+
+		return _max;
+	}
+
+	inline std::uint64_t count() const { return _total; }
+	inline std::uint64_t min() const { return _min; }
+	inline std::uint64_t max() const { return _max; }
+
+	double mean() const {
+		return (_total == 0) ? 0.0 : static_cast<double>(_sum) / _total;
+	}
+
+	/**
+	 * @brief Forgets all recorded values, the buckets stay allocated
+	 */
+	void reset() {
+		std::fill(_counts.begin(), _counts.end(), 0);
+
+		_total = 0;
+		_min = 0;
+		_max = 0;
+		_sum = 0;
+	}
+};
+
+}
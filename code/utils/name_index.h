@@ -0,0 +1,171 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <cctype>
+
+namespace util {
+
+/**
+ * @brief A case-insensitive hash index over the names of a table like Ship_info or Weapon_info
+ *
+ * The index does not own or copy any names, it only maps the hash of a name to the index of its entry and asks the table
+ * for the name of that entry when a hash matches. That keeps the indices of the table stable and means an entry which
+ * was renamed or removed in the meantime can never be returned for the wrong name.
+ *
+ * Entries which are appended to the table are picked up automatically by the next find() since the index remembers how
+ * many entries it has already seen. Everything else has to be reported:
+ * - add() after the name of an existing entry changed or an entry was filled in out of order
+ * - invalidate() after entries were removed, reordered or the table was reset
+ *
+ * Entries with an empty name are skipped. If several entries share a name the one which was indexed first is found,
+ * which for appended entries is the one with the lowest index, same as a linear search.
+ */
+class name_index {
+ public:
+	typedef int (*count_func)();
+	typedef const char* (*name_func)(int index);
+
+	// FNV-1a of the lower case name
+	static std::uint32_t hash(const char* name) {
+		std::uint32_t value = 2166136261u;
+		for (; *name != '\0'; ++name) {
+			value ^= static_cast<std::uint32_t>(tolower(static_cast<unsigned char>(*name)));
+			value *= 16777619u;
+		}
+		return value;
+	}
+
+ private:
+	struct slot {
+		std::uint32_t hash;
+		int index;
+	};
+
+	count_func _count;
+	name_func _name_at;
+
+	SCP_vector<slot> _slots;
+	size_t _used = 0;
+	// the entries below this have been indexed
+	int _indexed = 0;
+
+	void insert(int index) {
+		auto name = _name_at(index);
+		if (name == nullptr || *name == '\0') {
+			return;
+		}
+
+		auto value = hash(name);
+		auto mask = _slots.size() - 1;
+		auto pos = value & mask;
+
+		while (_slots[pos].index >= 0) {
+			pos = (pos + 1) & mask;
+		}
+
+		_slots[pos].hash = value;
+		_slots[pos].index = index;
+		++_used;
+	}
+
+	// makes room for at least this many names while keeping the table at most half full
+	bool needs_rebuild(size_t used) const { return used * 2 > _slots.size(); }
+
+	void rebuild(int count) {
+		size_t capacity = 16;
+		while (capacity < static_cast<size_t>(count) * 2) {
+			capacity *= 2;
+		}
+
+		slot empty;
+		empty.hash = 0;
+		empty.index = -1;
+		_slots.assign(capacity, empty);
+		_used = 0;
+
+		for (int i = 0; i < count; ++i) {
+			insert(i);
+		}
+		_indexed = count;
+	}
+
+	void sync() {
+		auto count = _count();
+
+		if (_slots.empty() || count < _indexed || needs_rebuild(_used + static_cast<size_t>(count - _indexed))) {
+			rebuild(count);
+			return;
+		}
+
+		for (; _indexed < count; ++_indexed) {
+			insert(_indexed);
+		}
+	}
+
+ public:
+	/**
+	 * @param count Returns the number of entries in the table
+	 * @param name_at Returns the name of an entry, may return nullptr for unused entries
+	 */
+	name_index(count_func count, name_func name_at) : _count(count), _name_at(name_at) {}
+
+	/**
+	 * @brief Looks up a name, case-insensitively
+	 * @return The index of the entry or -1 if there is none
+	 */
+	int find(const char* name) {
+		Assertion(name != nullptr, "NULL name passed to name_index::find");
+
+		sync();
+
+		auto value = hash(name);
+		auto mask = _slots.size() - 1;
+
+		for (auto pos = value & mask; _slots[pos].index >= 0; pos = (pos + 1) & mask) {
+			if (_slots[pos].hash != value) {
+				continue;
+			}
+
+			auto index = _slots[pos].index;
+			if (index >= _count()) {
+				continue;
+			}
+
+			auto entry_name = _name_at(index);
+			if (entry_name != nullptr && !stricmp(entry_name, name)) {
+				return index;
+			}
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Indexes the current name of an entry again, the old name is simply not found anymore
+	 */
+	void add(int index) {
+		if (index >= _indexed) {
+			// will be picked up by the next find()
+			return;
+		}
+
+		if (needs_rebuild(_used + 1)) {
+			rebuild(_indexed);
+			return;
+		}
+
+		insert(index);
+	}
+
+	/**
+	 * @brief Drops everything, the next find() indexes the whole table again
+	 */
+	void invalidate() {
+		_slots.clear();
+		_used = 0;
+		_indexed = 0;
+	}
+};
+
+}
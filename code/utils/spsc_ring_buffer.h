@@ -0,0 +1,95 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <atomic>
+
+namespace util {
+
+/**
+ * @brief A fixed size, lock-free queue for exactly one producer and one consumer thread
+ *
+ * Neither side ever blocks or takes a lock. try_push() fails if the queue is full and try_pop() fails if it's empty, it's
+ * up to the caller to decide whether to wait, retry or drop the item.
+ *
+ * @tparam T The type of the items, must be copyable
+ */
+template<typename T>
+class spsc_ring_buffer {
+	SCP_vector<T> _items;
+	size_t _mask;
+
+	// The read and write positions are only ever incremented, they are wrapped when the items are accessed. Each one is
+	// written by one thread only and kept on its own cache line so the two threads don't keep stealing it from each other.
+	char _pad0[64];
+	std::atomic<size_t> _head; // next item to pop, written by the consumer
+	char _pad1[64];
+	std::atomic<size_t> _tail; // next item to push, written by the producer
+	char _pad2[64];
+
+ public:
+	/**
+	 * @param capacity The number of items the queue can hold, rounded up to a power of two
+	 */
+	explicit spsc_ring_buffer(size_t capacity) : _head(0), _tail(0) {
+		size_t size = 1;
+		while (size < capacity) {
+			size <<= 1;
+		}
+
+		_items.resize(size);
+		_mask = size - 1;
+	}
+
+	spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+	spsc_ring_buffer& operator=(const spsc_ring_buffer&) = delete;
+
+	/**
+	 * @brief Adds an item to the back of the queue, may only be called from the producer thread
+	 *
+	 * @return false if the queue is full
+	 */
+	bool try_push(const T& item) {
+		auto tail = _tail.load(std::memory_order_relaxed);
+
+		if (tail - _head.load(std::memory_order_acquire) > _mask) {
+			return false;
+		}
+
+		_items[tail & _mask] = item;
+		_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief Takes the item at the front of the queue, may only be called from the consumer thread
+	 *
+	 * @return false if the queue is empty
+	 */
+	bool try_pop(T& item) {
+		auto head = _head.load(std::memory_order_relaxed);
+
+		if (head == _tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+
+		item = _items[head & _mask];
+		_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief The number of items in the queue
+	 *
+	 * Only a snapshot if the other thread is active at the same time.
+	 */
+	size_t size() const {
+		return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+	}
+
+	inline size_t capacity() const { return _mask + 1; }
+};
+
+}
@@ -633,7 +633,7 @@ int beam_get_weapon_info_index(object *bm)
 int beam_get_num_collisions(int objnum)
 {	
 	// sanity checks
-	if((objnum < 0) || (objnum >= MAX_OBJECTS)){
+	if((objnum < 0) || (objnum >= objects_size())){
 		Int3();
 		return -1;
 	}
@@ -659,7 +659,7 @@ int beam_get_num_collisions(int objnum)
 int beam_get_collision(int objnum, int num, int *collision_objnum, mc_info **cinfo)
 {
 	// sanity checks
-	if((objnum < 0) || (objnum >= MAX_OBJECTS)){
+	if((objnum < 0) || (objnum >= objects_size())){
 		Int3();
 		return 0;
 	}
@@ -1745,7 +1745,7 @@ void beam_apply_lighting()
 		l = &Beam_lights[idx];		
 
 		// bad object
-		if((l->objnum < 0) || (l->objnum >= MAX_OBJECTS) || (l->bm == NULL)){
+		if((l->objnum < 0) || (l->objnum >= objects_size()) || (l->bm == NULL)){
 			continue;
 		}
 
@@ -3016,7 +3016,7 @@ void beam_handle_collisions(beam *b)
 		int target = b->f_collisions[idx].c_objnum;
 
 		// if we have an invalid object
-		if((target < 0) || (target >= MAX_OBJECTS)){
+		if((target < 0) || (target >= objects_size())){
 			continue;
 		}
 
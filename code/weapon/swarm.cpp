@@ -191,7 +191,7 @@ void swarm_update_direction(object *objp)
 	float			vel, target_dist, radius;
 	physics_info	*pi;
 
-	Assert(objp->instance >= 0 && objp->instance < MAX_WEAPONS);
+	Assert(objp->instance >= 0 && objp->instance < weapons_size());
 
 	wp = &Weapons[objp->instance];
 
@@ -444,15 +444,15 @@ void turret_swarm_set_up_info(int parent_objnum, ship_subsys *turret, weapon_inf
 	*/
 
 	// get ship pointer	
-	Assert((parent_objnum >= 0) && (parent_objnum < MAX_OBJECTS));
-	if((parent_objnum < 0) || (parent_objnum >= MAX_OBJECTS)){
+	Assert((parent_objnum >= 0) && (parent_objnum < objects_size()));
+	if((parent_objnum < 0) || (parent_objnum >= objects_size())){
 		return;
 	}
 	parent_obj = &Objects[parent_objnum];
 	Assert(parent_obj->type == OBJ_SHIP);
 	shipp = &Ships[parent_obj->instance];
-	Assert((turret->turret_enemy_objnum >= 0) && (turret->turret_enemy_objnum < MAX_OBJECTS));
-	if((turret->turret_enemy_objnum < 0) || (turret->turret_enemy_objnum >= MAX_OBJECTS)){
+	Assert((turret->turret_enemy_objnum >= 0) && (turret->turret_enemy_objnum < objects_size()));
+	if((turret->turret_enemy_objnum < 0) || (turret->turret_enemy_objnum >= objects_size())){
 		return;
 	}
 	target_obj = &Objects[turret->turret_enemy_objnum];
@@ -16,59 +16,83 @@
 #include "render/3d.h" 
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/chunked_pool.h"
 #include "weapon/trails.h"
 
-int Num_trails;
-trail Trails;
+#define TRAIL_POOL_CHUNK_SIZE		64
+#define TRAIL_INFO_POOL_CHUNK_SIZE	64
+
+// how many trails there is room for at the start of a level, the pools grow if a mission needs more
+#define TRAILS_INITIAL_SIZE			256
+
+// Trails are handed out from a pool so creating one for every missile of a swarm volley doesn't hit the heap.
+// The pool keeps its memory between levels.
+static util::chunked_pool<trail, TRAIL_POOL_CHUNK_SIZE> Trail_pool;
+
+// trail_info of the trails whose owner is gone, see trail_object_died()
+static util::chunked_pool<trail_info, TRAIL_INFO_POOL_CHUNK_SIZE> Trail_orphan_info;
+
+// every trail in use, in the order they were created
+static SCP_vector<trail*> Trails_active;
+
+static void trail_free(trail *trailp)
+{
+	if (trailp->orphan_info >= 0) {
+		Trail_orphan_info.release(trailp->orphan_info);
+		trailp->orphan_info = -1;
+	}
+
+	trailp->info = NULL;
+	Trail_pool.release(trailp->pool_index);
+}
 
 // Reset everything between levels
 void trail_level_init()
 {
-	Num_trails = 0;
-	Trails.next = &Trails;
+	Trails_active.clear();
+	Trails_active.reserve(TRAILS_INITIAL_SIZE);
+
+	while (Trail_pool.size() < TRAILS_INITIAL_SIZE) {
+		Trail_pool.grow();
+	}
+
+	Trail_pool.release_all();
+	Trail_orphan_info.release_all();
 }
 
 void trail_level_close()
 {
-	trail *nextp;
-	for(trail *trailp = Trails.next; trailp != &Trails; trailp = nextp)
-	{
-		nextp = trailp->next;
+	Trails_active.clear();
 
-		//Now we can delete it
-		delete trailp;
-	}
-
-	Num_trails=0;
-	Trails.next = &Trails;
+	Trail_pool.release_all();
+	Trail_orphan_info.release_all();
 }
 
-//returns the number of a free trail
-//returns -1 if no free trails
-trail *trail_create(trail_info *info)
+//returns a new trail
+//returns NULL if no trails should be created
+trail *trail_create(const trail_info *info)
 {
 	// standalone server should never create trails
 	// No trails at slot 0
 	if((Game_mode & GM_STANDALONE_SERVER) || !Detail.weapon_extras)
 		return NULL;
 
-	// Make a new trail
-	trail *trailp = new trail;
+	int index = Trail_pool.allocate();
+	if (index < 0)
+		return NULL;
 
-	// increment counter
-	Num_trails++;
+	trail *trailp = &Trail_pool[index];
 
 	// Init the trail data
-	trailp->info = *info;
+	trailp->info = info;
 	trailp->tail = 0;
 	trailp->head = 0;	
 	trailp->object_died = false;		
-	trailp->trail_stamp = timestamp(trailp->info.stamp);
+	trailp->trail_stamp = timestamp(info->stamp);
+	trailp->pool_index = index;
+	trailp->orphan_info = -1;
 
-	//Add it to the front of the list
-	//This is quickest since there are no prev vars
-	trailp->next = Trails.next;
-	Trails.next = trailp;
+	Trails_active.push_back(trailp);
 
 	return trailp;
 }
@@ -172,7 +196,7 @@ void trail_render( trail * trailp )
 		return;
 	}
 
-	trail_info *ti	= &trailp->info;
+	const trail_info *ti = trailp->info;
 
 	int n = trailp->tail;
 
@@ -332,54 +356,66 @@ void trail_set_segment( trail *trailp, vec3d *pos )
 	trailp->pos[next] = *pos;
 }
 
+// ages the segments first to last-1, this is kept a plain loop over the array so the compiler can vectorize it
+static void trail_age_segments(float *val, int first, int last, float time_delta)
+{
+	for (int i = first; i < last; i++) {
+		val[i] += time_delta;
+	}
+}
+
 void trail_move_all(float frametime)
 {
 	TRACE_SCOPE(tracing::TrailsMoveAll);
 
-	int num_alive_segments,n;
-	float time_delta;
-	trail *next_trail;
-	trail *prev_trail = &Trails;
-
-	for (trail *trailp = Trails.next; trailp != &Trails; trailp = next_trail) {
-		next_trail = trailp->next;
-
-		num_alive_segments = 0;
+	size_t num_active = 0;
 
+	for (auto trailp : Trails_active) {
 		if ( trailp->tail != trailp->head )	{
-			n = trailp->tail;			
-			time_delta = frametime / trailp->info.max_life;
-			do	{
-				n--;
-				if ( n < 0 ) n = NUM_TRAIL_SECTIONS-1;
-
-				trailp->val[n] += time_delta;
+			float time_delta = frametime / trailp->info->max_life;
 
-				if ( trailp->val[n] <= 1.0f ) {
-					num_alive_segments++;	// Record how many still alive.
-				}
-
-			} while ( n != trailp->head );
-		}		
-	
-		if ( (num_alive_segments < 1) && trailp->object_died)
-		{
-			prev_trail->next = trailp->next;
-			delete trailp;
+			if (trailp->head < trailp->tail) {
+				trail_age_segments(trailp->val, trailp->head, trailp->tail, time_delta);
+			} else {
+				trail_age_segments(trailp->val, trailp->head, NUM_TRAIL_SECTIONS, time_delta);
+				trail_age_segments(trailp->val, 0, trailp->tail, time_delta);
+			}
 
-			// decrement counter
-			Num_trails--;
+			// All segments age at the same rate and new ones are added at the tail, so the dead segments are always
+			// at the head of the queue. Drop them so they aren't aged over and over again.
+			while ( (trailp->head != trailp->tail) && (trailp->val[trailp->head] > 1.0f) ) {
+				trailp->head++;
+				if ( trailp->head >= NUM_TRAIL_SECTIONS )
+					trailp->head = 0;
+			}
 		}
-		else
-		{
-			prev_trail = trailp;
+
+		if ( (trailp->tail == trailp->head) && trailp->object_died ) {
+			trail_free(trailp);
+		} else {
+			// compact the list of trails in place, keeping them in order
+			Trails_active[num_active++] = trailp;
 		}
 	}
+
+	Trails_active.resize(num_active);
 }
 
 void trail_object_died( trail *trailp )
 {
+	if (trailp->object_died)
+		return;
+
 	trailp->object_died = true;
+
+	// The trail lives on until it has faded out, but the info it was created with may not. Ship afterburner trails
+	// share the info of their ship, which is reset when the ship slot is used again.
+	int index = Trail_orphan_info.allocate();
+	if (index >= 0) {
+		Trail_orphan_info[index] = *trailp->info;
+		trailp->info = &Trail_orphan_info[index];
+		trailp->orphan_info = index;
+	}
 }
 
 void trail_render_all()
@@ -391,7 +427,7 @@ void trail_render_all()
 	if ( !Detail.weapon_extras )
 		return;
 
-	for(trail *trailp = Trails.next; trailp!=&Trails; trailp = trailp->next )
+	for (auto trailp : Trails_active)
 	{
 		//trail_add_batch(trailp);
 		trail_render(trailp);
@@ -408,5 +444,5 @@ int trail_stamp_elapsed(trail *trailp)
 
 void trail_set_stamp(trail *trailp)
 {
-	trailp->trail_stamp = timestamp(trailp->info.stamp);
+	trailp->trail_stamp = timestamp(trailp->info->stamp);
 }
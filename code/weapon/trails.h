@@ -38,11 +38,11 @@ typedef struct trail {
 	bool	object_died;					// set to zero as long as object	
 	int		trail_stamp;					// trail timestamp	
 
-	// trail info
-	trail_info info;							// this is passed when creating a trail
-
-	struct	trail * next;
+	// trail info, shared with the weapon or ship which created the trail
+	const trail_info *info;				// this is passed when creating a trail
 
+	int		pool_index;						// slot of this trail in the trail pool
+	int		orphan_info;					// slot of the copy of info made by trail_object_died(), -1 if there is none
 } trail;
 
 // Call at the start of freespace to init trails
@@ -61,8 +61,9 @@ void trail_render_all();
 // The following functions are what the weapon code calls
 // to deal with trails:
 
-// Returns -1 if failed
-trail *trail_create(trail_info *info);
+// Returns NULL if failed
+// info is not copied, it must stay valid until trail_object_died() is called
+trail *trail_create(const trail_info *info);
 void trail_add_segment( trail *trailp, vec3d *pos );
 void trail_set_segment( trail *trailp, vec3d *pos );
 void trail_object_died( trail *trailp );
@@ -21,6 +21,7 @@
 #include "weapon/shockwave.h"
 #include "weapon/trails.h"
 #include "particle/ParticleManager.h"
+#include "utils/chunked_pool.h"
 #include "weapon/weapon_flags.h"
 #include "decals/decals.h"
 
@@ -214,7 +215,10 @@ typedef struct spawn_weapon_info
 #define BEAM_FAR_LENGTH				30000.0f
 
 
-extern weapon Weapons[MAX_WEAPONS];
+// slots are added in chunks, so pointers to weapons stay valid when the pool grows
+#define WEAPON_POOL_CHUNK_SIZE		512
+
+extern util::chunked_pool<weapon, WEAPON_POOL_CHUNK_SIZE> Weapons;
 
 #define WEAPON_TITLE_LEN			48
 
@@ -539,11 +543,21 @@ extern int Default_cmeasure_index;
 extern int Num_player_weapon_precedence;				// Number of weapon types in Player_weapon_precedence
 extern int Player_weapon_precedence[MAX_WEAPON_TYPES];	// Array of weapon types, precedence list for player weapon selection
 
-#define WEAPON_INDEX(wp)			(int)(wp-Weapons)
+#define WEAPON_INDEX(wp)			Weapons.index_of(wp)
+
+/**
+ * @brief The number of weapon slots, every valid weapon number is less than this
+ */
+inline int weapons_size()
+{
+	return Weapons.size();
+}
 
 
 int weapon_info_lookup(const char *name);
 int weapon_info_get_index(weapon_info *wip);
+// has to be called when the name of a weapon class is changed after it was parsed
+void weapon_info_name_changed(int weapon_info_index);
 
 inline int weapon_info_size()
 {
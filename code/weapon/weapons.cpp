@@ -51,6 +51,7 @@
 #include "particle/effects/ParticleEmitterEffect.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/name_index.h"
 #include "weapon.h"
 
 
@@ -78,12 +79,15 @@ DCF_BOOL( weapon_flyby, Weapon_flyby_sound_enabled )
 
 static int Weapon_flyby_sound_timer;	
 
-weapon Weapons[MAX_WEAPONS];
+// new slots have to look unused to everything which scans the weapons
+util::chunked_pool<weapon, WEAPON_POOL_CHUNK_SIZE> Weapons([](weapon& wp) {
+	wp.objnum = -1;
+	wp.weapon_info_index = -1;
+});
 SCP_vector<weapon_info> Weapon_info;
 
 #define		MISSILE_OBJ_USED	(1<<0)			// flag used in missile_obj struct
-#define		MAX_MISSILE_OBJS	MAX_WEAPONS		// max number of missiles tracked in missile list
-missile_obj Missile_objs[MAX_MISSILE_OBJS];	// array used to store missile object indexes
+util::chunked_pool<missile_obj, WEAPON_POOL_CHUNK_SIZE> Missile_objs;	// used to store missile object indexes
 missile_obj Missile_obj_list;						// head of linked list of missile_obj structs
 
 //WEAPON SUBTYPE STUFF
@@ -465,9 +469,11 @@ void missile_obj_list_init()
 	int i;
 
 	list_init(&Missile_obj_list);
-	for ( i = 0; i < MAX_MISSILE_OBJS; i++ ) {
+	for ( i = 0; i < Missile_objs.size(); i++ ) {
 		Missile_objs[i].flags = 0;
 	}
+
+	Missile_objs.release_all();
 }
 
 /**
@@ -476,13 +482,9 @@ void missile_obj_list_init()
  */
 int missile_obj_list_add(int objnum)
 {
-	int i;
+	int i = Missile_objs.allocate();
 
-	for ( i = 0; i < MAX_MISSILE_OBJS; i++ ) {
-		if ( !(Missile_objs[i].flags & MISSILE_OBJ_USED) )
-			break;
-	}
-	if ( i == MAX_MISSILE_OBJS ) {
+	if ( i < 0 ) {
 		Error(LOCATION, "Fatal Error: Ran out of missile object nodes\n");
 		return -1;
 	}
@@ -501,9 +503,10 @@ int missile_obj_list_add(int objnum)
  */
 void missle_obj_list_remove(int index)
 {
-	Assert(index >= 0 && index < MAX_MISSILE_OBJS);
+	Assert(index >= 0 && index < Missile_objs.size());
 	list_remove(&Missile_obj_list, &Missile_objs[index]);	
 	Missile_objs[index].flags = 0;
+	Missile_objs.release(index);
 }
 
 /**
@@ -512,10 +515,13 @@ void missle_obj_list_remove(int index)
  */
 missile_obj *missile_obj_return_address(int index)
 {
-	Assert(index >= 0 && index < MAX_MISSILE_OBJS);
+	Assert(index >= 0 && index < Missile_objs.size());
 	return &Missile_objs[index];
 }
 
+static util::name_index Weapon_info_names([]() { return weapon_info_size(); },
+                                          [](int index) -> const char* { return Weapon_info[index].name; });
+
 /**
  * Return the index of Weapon_info[].name that is *name.
  */
@@ -523,11 +529,12 @@ int weapon_info_lookup(const char *name)
 {
 	Assertion(name != nullptr, "NULL name passed to weapon_info_lookup");
 
-	for (auto it = Weapon_info.cbegin(); it != Weapon_info.cend(); ++it)
-		if (!stricmp(name, it->name))
-			return (int)std::distance(Weapon_info.cbegin(), it);
+	return Weapon_info_names.find(name);
+}
 
-	return -1;
+void weapon_info_name_changed(int weapon_info_index)
+{
+	Weapon_info_names.add(weapon_info_index);
 }
 
 /**
@@ -826,6 +833,7 @@ int parse_weapon(int subtype, bool replace, const char *filename)
 		if (w_id >= 0) {
 			mprintf(("Removing previously parsed weapon '%s'\n", fname));
 			Weapon_info.erase(Weapon_info.begin() + w_id);
+			Weapon_info_names.invalidate();
 		}
 
 		if (!skip_to_start_of_string_either("$Name:", "#End")) {
@@ -3126,6 +3134,7 @@ void weapon_sort_by_type()
 	for (i = 0; i < num_child_secondaries; i++, weapon_index++)
 		Weapon_info[weapon_index] = child_secondaries[i];
 
+	Weapon_info_names.invalidate();
 
 	if (lasers)			delete [] lasers;
 	if (big_lasers)		delete [] big_lasers;
@@ -3553,6 +3562,7 @@ void weapon_init()
 		// parse weapons.tbl
 		Removed_weapons.clear();
 		Weapon_info.clear();
+		Weapon_info_names.invalidate();
 		parse_weaponstbl("weapons.tbl");
 
 		parse_modular_table(NOX("*-wep.tbm"), parse_weaponstbl);
@@ -3616,10 +3626,17 @@ void weapon_level_init()
 
 	// Reset everything between levels
 	Num_weapons = 0;
-	for (i=0; i<MAX_WEAPONS; i++)	{
+
+	// start out with room for MAX_WEAPONS, more slots are added during the mission if needed
+	while (Weapons.size() < MAX_WEAPONS) {
+		Weapons.grow();
+	}
+
+	for (i=0; i<Weapons.size(); i++)	{
 		Weapons[i].objnum = -1;
 		Weapons[i].weapon_info_index = -1;
 	}
+	Weapons.release_all();
 
 	for (i = 0; i < weapon_info_size(); i++) {
 		Weapon_info[i].damage_type_idx = Weapon_info[i].damage_type_idx_sav;
@@ -3706,6 +3723,7 @@ void weapon_delete(object *obj)
 	}
 
 	wp->objnum = -1;
+	Weapons.release(num);
 	Num_weapons--;
 	Assert(Num_weapons >= 0);
 }
@@ -4777,7 +4795,7 @@ void weapon_process_post(object * obj, float frame_time)
 				ai_info	*parent_aip;
 
 				parent_aip = NULL;
-				if (obj->parent != Player_obj-Objects) {
+				if (obj->parent != OBJ_INDEX(Player_obj)) {
 					parent_aip = &Ai_info[Ships[Objects[obj->parent].instance].ai_index];
 				}
 
@@ -5144,7 +5162,6 @@ int Weapons_created = 0;
 int weapon_create( vec3d * pos, matrix * porient, int weapon_type, int parent_objnum, int group_id, int is_locked, int is_spawned, float fof_cooldown, ship_subsys * src_turret)
 {
 	int			n, objnum;
-	int num_deleted;
 	object		*objp, *parent_objp=NULL;
 	weapon		*wp;
 	weapon_info	*wip;
@@ -5209,36 +5226,6 @@ int weapon_create( vec3d * pos, matrix * porient, int weapon_type, int parent_ob
 		}
 	}
 
-	num_deleted = 0;
-	if (Num_weapons >= MAX_WEAPONS-5) {
-
-		//No, do remove for AI ships -- MK, 3/12/98  // don't need to try and delete weapons for ai ships
-		//if ( !(Objects[parent_objnum].flags[Object::Object_Flags::Player_ship]) )
-		//	return -1;
-
-		num_deleted = collide_remove_weapons();
-
-		nprintf(("WARNING", "Deleted %d weapons because of lack of slots\n", num_deleted));
-		if (num_deleted == 0){
-			return -1;
-		}
-	}
-
-	for (n=0; n<MAX_WEAPONS; n++ ){
-		if (Weapons[n].weapon_info_index < 0){
-			break;
-		}
-	}
-
-	if (n == MAX_WEAPONS) {
-		// if we supposedly deleted weapons above, what happened here!!!!
-		if (num_deleted){
-			Int3();				// get allender -- something funny is going on!!!
-		}
-
-		return -1;
-	}
-
 	// make sure we are loaded and useable
 	if ( (wip->render_type == WRT_POF) && (wip->model_num < 0) ) {
 		wip->model_num = model_load(wip->pofbitmap_name, 0, NULL);
@@ -5253,6 +5240,13 @@ int weapon_create( vec3d * pos, matrix * porient, int weapon_type, int parent_ob
 	if ( !used_weapons[weapon_type] )
 		weapon_load_bitmaps(weapon_type);
 
+	// the pool grows as needed, so this only fails if we're out of memory
+	n = Weapons.allocate();
+	if (n < 0) {
+		return -1;
+	}
+	Assert(Weapons[n].weapon_info_index < 0);
+
 	//I am hopeing that this way does not alter the input orient matrix
 	//Feild of Fire code -Bobboau
 	matrix morient;
@@ -5612,7 +5606,7 @@ void spawn_child_weapons(object *objp)
 
 	Assertion(objp->type == OBJ_WEAPON || objp->type == OBJ_BEAM, "spawn_child_weapons() doesn't make sense for non-weapon non-beam objects; get a coder!\n");
 	Assertion(objp->instance >= 0, "spawn_child_weapons() called with an object with an instance of %d; get a coder!\n", objp->instance);
-	Assertion(!(objp->type == OBJ_WEAPON) || (objp->instance < MAX_WEAPONS), "spawn_child_weapons() called with a weapon with an instance of %d while MAX_WEAPONS is %d; get a coder!\n", objp->instance, MAX_WEAPONS);
+	Assertion(!(objp->type == OBJ_WEAPON) || (objp->instance < weapons_size()), "spawn_child_weapons() called with a weapon with an instance of %d while there are only %d weapon slots; get a coder!\n", objp->instance, weapons_size());
 	Assertion(!(objp->type == OBJ_BEAM) || (objp->instance < MAX_BEAMS), "spawn_child_weapons() called with a beam with an instance of %d while MAX_BEAMS is %d; get a coder!\n", objp->instance, MAX_BEAMS);
 
 	if (objp->type == OBJ_WEAPON) {
@@ -6176,8 +6170,8 @@ void weapon_hit( object * weapon_obj, object * other_obj, vec3d * hitpos, int qu
 	if(weapon_obj == NULL){
 		return;
 	}
-	Assert((weapon_obj->type == OBJ_WEAPON) && (weapon_obj->instance >= 0) && (weapon_obj->instance < MAX_WEAPONS));
-	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= MAX_WEAPONS)){
+	Assert((weapon_obj->type == OBJ_WEAPON) && (weapon_obj->instance >= 0) && (weapon_obj->instance < weapons_size()));
+	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= weapons_size())){
 		return;
 	}
 
@@ -7240,6 +7234,47 @@ DCF(pspew, "Particle spew help and status provider")
 	dc_printf("Be advised, this effect is applied to _ALL_ weapons, and as such may drastically reduce framerates on lower powered platforms.\n");
 }
 
+DCF(weapon_stress, "Fires a lot of weapons around the player at once, to stress the object and weapon pools (Usage: weapon_stress <count>)")
+{
+	int count = 20000;
+
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: weapon_stress <count>\n");
+		dc_printf("Fires <count> of the player's first primary weapon outward from random points around the player ship. Defaults to 20000.\n");
+		return;
+	}
+
+	if (dc_optional_string_either("status", "--status") || dc_optional_string_either("?", "--?")) {
+		dc_printf("There are %d weapons in %d weapon slots and %d objects in %d object slots\n", Num_weapons, weapons_size(), Num_objects, objects_size());
+		return;
+	}
+
+	dc_maybe_stuff_int(&count);
+
+	if ( (Player_obj == nullptr) || (Player_ship == nullptr) || (Player_ship->weapons.num_primary_banks <= 0) ) {
+		dc_printf("Need a player ship with a primary weapon\n");
+		return;
+	}
+
+	int weapon_type = Player_ship->weapons.primary_bank_weapons[0];
+	int num_created = 0;
+
+	for (int i = 0; i < count; i++) {
+		vec3d dir, pos;
+		matrix orient;
+
+		vm_vec_rand_vec_quick(&dir);
+		vm_vec_scale_add(&pos, &Player_obj->pos, &dir, Player_obj->radius * 2.0f + frand_range(0.0f, 500.0f));
+		vm_vector_2_matrix(&orient, &dir, nullptr, nullptr);
+
+		if (weapon_create(&pos, &orient, weapon_type, OBJ_INDEX(Player_obj), -1) >= 0) {
+			num_created++;
+		}
+	}
+
+	dc_printf("Created %d of %d weapons, there are %d weapons in %d weapon slots and %d objects in %d object slots\n", num_created, count, Num_weapons, weapons_size(), Num_objects, objects_size());
+}
+
 /**
  * Return a scale factor for damage which should be applied for 2 collisions
  */
@@ -7261,14 +7296,14 @@ float weapon_get_damage_scale(weapon_info *wip, object *wep, object *target)
 	}
 
 	// don't scale any damage if its not a weapon	
-	if((wep->type != OBJ_WEAPON) || (wep->instance < 0) || (wep->instance >= MAX_WEAPONS)){
+	if((wep->type != OBJ_WEAPON) || (wep->instance < 0) || (wep->instance >= weapons_size())){
 		return 1.0f;
 	}
 	wp = &Weapons[wep->instance];
 
 	// was the weapon fired by the player
 	from_player = 0;
-	if((wep->parent >= 0) && (wep->parent < MAX_OBJECTS) && (Objects[wep->parent].flags[Object::Object_Flags::Player_ship])){
+	if((wep->parent >= 0) && (wep->parent < objects_size()) && (Objects[wep->parent].flags[Object::Object_Flags::Player_ship])){
 		from_player = 1;
 	}
 		
@@ -7339,7 +7374,7 @@ float weapon_get_damage_scale(weapon_info *wip, object *wep, object *target)
 
 void pause_in_flight_sounds()
 {
-	for (int i = 0; i < MAX_WEAPONS; i++)
+	for (int i = 0; i < weapons_size(); i++)
 	{
 		if (Weapons[i].objnum != -1)
 		{
@@ -41,6 +41,7 @@
 #include "asteroid/asteroid.h"
 #include "autopilot/autopilot.h"
 #include "bmpman/bmpman.h"
+#include "bmpman/bm_texcache.h"
 #include "cfile/cfile.h"
 #include "cmdline/cmdline.h"
 #include "cmeasure/cmeasure.h"
@@ -148,6 +149,7 @@
 #include "parse/parselo.h"
 #include "parse/sexp.h"
 #include "parse/sexp/sexp_lookup.h"
+#include "parse/tablecache.h"
 #include "particle/ParticleManager.h"
 #include "particle/particle.h"
 #include "pilotfile/pilotfile.h"
@@ -876,6 +878,8 @@ void game_level_close()
 		stars_level_close();
 
 		Pilot.save_savefile();
+
+		tracing::frame_stats_mission_done(Game_current_mission_filename);
 	}
 	else
 	{
@@ -1243,6 +1247,8 @@ void freespace_mission_load_stuff()
 			game_busy( NOX("** assigning sound environment for mission **") );
 			ship_assign_sound_all();	// assign engine sounds to ships
 			game_assign_sound_environment();	 // assign the sound environment for this mission
+
+			snd_report_level_load();
 		}
 
 		obj_merge_created_list();
@@ -1791,6 +1797,10 @@ void game_init()
 		bm_set_low_mem(0);		// Use all frames of bitmaps
 	}
 
+	// read and process all tables in one go so the processing can be spread over all cores, the parsing below stays
+	// serial since the tables depend on each other
+	parse_prepare_tables();
+
 	//WMC - Initialize my new GUI system
 	//This may seem scary, but it should take up 0 processing time and very little memory
 	//as long as it's not being used.
@@ -1917,6 +1927,10 @@ void game_init()
 
 	libs::discord::init();
 
+	parse_release_prepared_tables();
+	table_hash_finish();
+	table_report_print();
+
 	nprintf(("General", "Ships.tbl is : %s\n", Game_ships_tbl_valid ? "VALID" : "INVALID!!!!"));
 	nprintf(("General", "Weapons.tbl is : %s\n", Game_weapons_tbl_valid ? "VALID" : "INVALID!!!!"));
 
@@ -2112,6 +2126,9 @@ void game_show_framerate()
 		gr_printf_no_resize( sx, sy, NOX("Snds: %d"), snd_num_playing() );
 		sy += line_height;
 
+		gr_printf_no_resize( sx, sy, NOX("ARRV: %d"), Mission_arrival_checks );
+		sy += line_height;
+
 		if ( Timing_total > 0.01f )	{
 			gr_printf_no_resize(  sx, sy, NOX("CLEAR: %.0f%%"), Timing_clear*100.0f/Timing_total );
 			sy += line_height;
@@ -2591,7 +2608,7 @@ void player_repair_frame(float frametime)
 					&& (Net_player->player_id != np.player_id)
 					&& (np.m_player != nullptr)
 					&& (np.m_player->objnum >= 0)
-					&& (np.m_player->objnum < MAX_OBJECTS)){
+					&& (np.m_player->objnum < objects_size())){
 
 				// don't rearm/repair if the player is dead or dying/departing
 				if ( !NETPLAYER_IS_DEAD((&np)) && !(Ships[Objects[np.m_player->objnum].instance].is_dying_or_departing()) ) {
@@ -3440,7 +3457,7 @@ void game_simulation_frame()
 		ship_info *sip;
 		while((moveup != END_OF_LIST(&Ship_obj_list)) && (moveup != nullptr)){
 			// bogus
-			if((moveup->objnum < 0) || (moveup->objnum >= MAX_OBJECTS) || (Objects[moveup->objnum].type != OBJ_SHIP) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].instance >= MAX_SHIPS) || (Ships[Objects[moveup->objnum].instance].ship_info_index < 0) || (Ships[Objects[moveup->objnum].instance].ship_info_index >= ship_info_size())){
+			if((moveup->objnum < 0) || (moveup->objnum >= objects_size()) || (Objects[moveup->objnum].type != OBJ_SHIP) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].instance >= MAX_SHIPS) || (Ships[Objects[moveup->objnum].instance].ship_info_index < 0) || (Ships[Objects[moveup->objnum].instance].ship_info_index >= ship_info_size())){
 				moveup = GET_NEXT(moveup);
 				continue;
 			}
@@ -6415,6 +6432,13 @@ int game_main(int argc, char *argv[])
 		return 0;
 	}
 
+	// maybe compress all of the mod's textures into the texture cache, and exit
+	if (Cmdline_warm_texture_cache) {
+		bm_texcache_warm();
+		game_shutdown();
+		return 0;
+	}
+
 	if (!Is_standalone) {
 		movie::play("intro.mve");
 	}
@@ -0,0 +1,168 @@
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "ddsutils/ddsutils.h"
+#include "ddsutils/dxtc.h"
+
+namespace {
+// reference decoder for a 4 colour DXT1 block, output is BGR
+void decode_color_block(const ubyte* block, ubyte out[16][4])
+{
+	int color0 = block[0] | (block[1] << 8);
+	int color1 = block[2] | (block[3] << 8);
+	uint indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint)block[7] << 24);
+
+	int palette[4][3];
+	for (int i = 0; i < 2; ++i) {
+		int c = (i == 0) ? color0 : color1;
+		int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+		palette[i][0] = (b << 3) | (b >> 2);
+		palette[i][1] = (g << 2) | (g >> 4);
+		palette[i][2] = (r << 3) | (r >> 2);
+	}
+
+	for (int k = 0; k < 3; ++k) {
+		if (color0 > color1) {
+			palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+			palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+		} else {
+			palette[2][k] = (palette[0][k] + palette[1][k]) / 2;
+			palette[3][k] = 0;
+		}
+	}
+
+	for (int i = 0; i < 16; ++i) {
+		int idx = (indices >> (i * 2)) & 3;
+		for (int k = 0; k < 3; ++k) {
+			out[i][k] = (ubyte)palette[idx][k];
+		}
+	}
+}
+
+// reference decoder for a DXT5 alpha block
+void decode_alpha_block(const ubyte* block, ubyte out[16][4])
+{
+	int a0 = block[0], a1 = block[1];
+	std::uint64_t bits = 0;
+	for (int i = 0; i < 6; ++i) {
+		bits |= (std::uint64_t)block[2 + i] << (i * 8);
+	}
+
+	for (int i = 0; i < 16; ++i) {
+		int code = (int)((bits >> (i * 3)) & 7);
+		int a;
+		if (code == 0) {
+			a = a0;
+		} else if (code == 1) {
+			a = a1;
+		} else if (a0 > a1) {
+			a = ((8 - code) * a0 + (code - 1) * a1) / 7;
+		} else {
+			a = (code == 6) ? 0 : ((code == 7) ? 255 : ((6 - code) * a0 + (code - 1) * a1) / 5);
+		}
+		out[i][3] = (ubyte)a;
+	}
+}
+}
+
+TEST(DxtcTest, compressed_size)
+{
+	ASSERT_EQ(dxtc_compressed_size(256, 128, DDS_DXT1), (size_t)(64 * 32 * 8));
+	ASSERT_EQ(dxtc_compressed_size(256, 128, DDS_DXT5), (size_t)(64 * 32 * 16));
+
+	// partial and tiny mipmap levels still take up a whole block
+	ASSERT_EQ(dxtc_compressed_size(2, 1, DDS_DXT1), (size_t)8);
+	ASSERT_EQ(dxtc_compressed_size(6, 6, DDS_DXT5), (size_t)(4 * 16));
+}
+
+TEST(DxtcTest, gradient_color_block)
+{
+	ubyte src[16][4];
+	for (int i = 0; i < 16; ++i) {
+		src[i][0] = (ubyte)(40 + i * 10);
+		src[i][1] = (ubyte)(200 - i * 8);
+		src[i][2] = (ubyte)(100 + i * 4);
+		src[i][3] = 255;
+	}
+
+	ubyte block[8];
+	dxtc_compress_image(&src[0][0], 4, 4, DDS_DXT1, block);
+
+	// must be encoded in 4 colour mode, since there's no alpha to punch through
+	ASSERT_GT(block[0] | (block[1] << 8), block[2] | (block[3] << 8));
+
+	ubyte decoded[16][4];
+	decode_color_block(block, decoded);
+
+	for (int i = 0; i < 16; ++i) {
+		for (int k = 0; k < 3; ++k) {
+			ASSERT_LE(std::abs(decoded[i][k] - src[i][k]), 24) << "pixel " << i << " channel " << k;
+		}
+	}
+}
+
+TEST(DxtcTest, flat_color_block)
+{
+	ubyte src[16][4];
+	for (int i = 0; i < 16; ++i) {
+		src[i][0] = 16;
+		src[i][1] = 128;
+		src[i][2] = 248;
+		src[i][3] = 255;
+	}
+
+	ubyte block[8];
+	dxtc_compress_image(&src[0][0], 4, 4, DDS_DXT1, block);
+
+	ubyte decoded[16][4];
+	decode_color_block(block, decoded);
+
+	for (int i = 0; i < 16; ++i) {
+		for (int k = 0; k < 3; ++k) {
+			ASSERT_LE(std::abs(decoded[i][k] - src[i][k]), 4);
+		}
+	}
+}
+
+TEST(DxtcTest, alpha_block)
+{
+	ubyte src[16][4];
+	for (int i = 0; i < 16; ++i) {
+		src[i][0] = src[i][1] = src[i][2] = 128;
+		src[i][3] = (ubyte)(i * 17);
+	}
+
+	ubyte block[16];
+	dxtc_compress_image(&src[0][0], 4, 4, DDS_DXT5, block);
+
+	// full range, 8 value mode
+	ASSERT_EQ(block[0], 255);
+	ASSERT_EQ(block[1], 0);
+
+	ubyte decoded[16][4];
+	decode_alpha_block(block, decoded);
+
+	for (int i = 0; i < 16; ++i) {
+		ASSERT_LE(std::abs(decoded[i][3] - src[i][3]), 19) << "pixel " << i;
+	}
+}
+
+TEST(DxtcTest, small_image_is_edge_padded)
+{
+	// a 2x1 image still produces a single, fully defined block
+	ubyte src[2][4] = { { 0, 0, 255, 255 }, { 255, 0, 0, 255 } };
+
+	ubyte block[8];
+	dxtc_compress_image(&src[0][0], 2, 1, DDS_DXT1, block);
+
+	ubyte decoded[16][4];
+	decode_color_block(block, decoded);
+
+	// left column is red, the rest replicates the blue pixel (give or take the endpoint inset)
+	ASSERT_GE(decoded[0][2], 224);
+	ASSERT_LE(decoded[0][0], 32);
+	ASSERT_GE(decoded[15][0], 224);
+	ASSERT_LE(decoded[15][2], 32);
+}
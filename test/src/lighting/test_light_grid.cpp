@@ -0,0 +1,145 @@
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <climits>
+#include <random>
+
+#include "globalincs/pstypes.h"
+#include "lighting/lighting.h"
+#include "math/vecmat.h"
+
+namespace {
+struct test_object {
+	vec3d pos;
+	float rad;
+};
+
+light make_light(std::mt19937& gen, int index)
+{
+	std::uniform_real_distribution<float> pos_dist(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> rad_dist(10.0f, 400.0f);
+
+	light l;
+	memset(&l, 0, sizeof(l));
+
+	l.type = (index % 64 == 0) ? Light_Type::Tube : Light_Type::Point;
+	l.vec.xyz.x = pos_dist(gen);
+	l.vec.xyz.y = pos_dist(gen);
+	l.vec.xyz.z = pos_dist(gen);
+	l.vec2 = l.vec;
+	l.vec2.xyz.z += 300.0f;
+	l.rada = rad_dist(gen);
+	l.radb = l.rada * 2.0f;
+	l.rada_squared = l.rada * l.rada;
+	l.radb_squared = l.radb * l.radb;
+	l.intensity = 1.0f;
+	l.light_ignore_objnum = -1;
+	// Make some of the lights unique to one object
+	l.affected_objnum = (index % 16 == 1) ? index % 500 : -1;
+	l.instance = index;
+
+	return l;
+}
+
+void build_scene(scene_lights& scene, SCP_vector<test_object>& objects, size_t num_lights, size_t num_objects)
+{
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float> pos_dist(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> rad_dist(5.0f, 500.0f);
+
+	light sun;
+	memset(&sun, 0, sizeof(sun));
+	sun.type = Light_Type::Directional;
+	sun.vec = vmd_z_vector;
+	scene.addLight(&sun);
+
+	for (size_t i = 0; i < num_lights; ++i) {
+		auto l = make_light(gen, (int)i);
+		scene.addLight(&l);
+	}
+
+	for (size_t i = 0; i < num_objects; ++i) {
+		test_object obj;
+		obj.pos.xyz.x = pos_dist(gen);
+		obj.pos.xyz.y = pos_dist(gen);
+		obj.pos.xyz.z = pos_dist(gen);
+		obj.rad = rad_dist(gen);
+		objects.push_back(obj);
+	}
+}
+
+class LightGridTest : public ::testing::Test {
+  protected:
+	int _prevMinLights = 0;
+
+	void SetUp() override { _prevMinLights = Light_grid_min_lights; }
+	void TearDown() override { Light_grid_min_lights = _prevMinLights; }
+};
+}
+
+TEST_F(LightGridTest, matches_linear_filter)
+{
+	scene_lights scene;
+	SCP_vector<test_object> objects;
+	build_scene(scene, objects, 1000, 500);
+
+	for (size_t i = 0; i < objects.size(); ++i) {
+		auto& obj = objects[i];
+
+		Light_grid_min_lights = INT_MAX;
+		scene.setLightFilter((int)i, &obj.pos, obj.rad);
+		auto linear = scene.getFilteredLights();
+
+		Light_grid_min_lights = 0;
+		scene.setLightFilter((int)i, &obj.pos, obj.rad);
+		auto grid = scene.getFilteredLights();
+
+		ASSERT_EQ(linear, grid) << "Object " << i << " got different lights from the light grid!";
+	}
+}
+
+TEST_F(LightGridTest, no_dynamic_lights)
+{
+	scene_lights scene;
+
+	light sun;
+	memset(&sun, 0, sizeof(sun));
+	sun.type = Light_Type::Directional;
+	sun.vec = vmd_z_vector;
+	scene.addLight(&sun);
+
+	Light_grid_min_lights = 0;
+	scene.setLightFilter(0, &vmd_zero_vector, 100.0f);
+
+	ASSERT_TRUE(scene.getFilteredLights().empty());
+}
+
+TEST_F(LightGridTest, assignment_benchmark)
+{
+	scene_lights scene;
+	SCP_vector<test_object> objects;
+	build_scene(scene, objects, 1000, 500);
+
+	auto time_assignment = [&]() {
+		auto start = std::chrono::high_resolution_clock::now();
+		size_t total = 0;
+		for (size_t i = 0; i < objects.size(); ++i) {
+			scene.setLightFilter((int)i, &objects[i].pos, objects[i].rad);
+			total += scene.getFilteredLights().size();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::make_pair(std::chrono::duration<double, std::micro>(end - start).count(), total);
+	};
+
+	Light_grid_min_lights = INT_MAX;
+	auto linear = time_assignment();
+
+	Light_grid_min_lights = 0;
+	auto grid = time_assignment();
+
+	ASSERT_EQ(linear.second, grid.second);
+
+	std::cout << "Light assignment for 1000 lights and 500 objects: linear " << linear.first << "us, grid "
+	          << grid.first << "us" << std::endl;
+}
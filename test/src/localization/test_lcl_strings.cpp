@@ -0,0 +1,168 @@
+
+#include <gtest/gtest.h>
+
+#include "localization/lcl_strings.h"
+
+#include <chrono>
+
+using namespace localization;
+
+TEST(LclStringsTest, string_table_find)
+{
+	string_table table;
+
+	ASSERT_EQ(nullptr, table.find(0));
+
+	ASSERT_TRUE(table.insert(0, "zero", false));
+	ASSERT_TRUE(table.insert(300000, "mod", false));
+
+	ASSERT_STREQ("zero", table.find(0));
+	ASSERT_STREQ("mod", table.find(300000));
+	ASSERT_EQ(nullptr, table.find(1));
+	ASSERT_EQ(nullptr, table.find(-1));
+	ASSERT_EQ(2u, table.size());
+}
+
+TEST(LclStringsTest, string_table_duplicates)
+{
+	string_table table;
+
+	ASSERT_TRUE(table.insert(5, "first", false));
+
+	// a table keeps the first string
+	ASSERT_FALSE(table.insert(5, "second", false));
+	ASSERT_STREQ("first", table.find(5));
+
+	// a modular table replaces it
+	ASSERT_FALSE(table.insert(5, "third", true));
+	ASSERT_STREQ("third", table.find(5));
+
+	ASSERT_EQ(1u, table.size());
+}
+
+TEST(LclStringsTest, string_table_grows)
+{
+	string_table table;
+	char buf[32];
+
+	for (int i = 0; i < 5000; ++i) {
+		sprintf(buf, "string %d", i);
+		ASSERT_TRUE(table.insert(i * 3, buf, false));
+	}
+
+	// the strings don't move when the table grows
+	auto first = table.find(0);
+	for (int i = 5000; i < 10000; ++i) {
+		sprintf(buf, "string %d", i);
+		table.insert(i * 3, buf, false);
+	}
+	ASSERT_EQ(first, table.find(0));
+
+	for (int i = 0; i < 10000; ++i) {
+		sprintf(buf, "string %d", i);
+		ASSERT_STREQ(buf, table.find(i * 3));
+		ASSERT_EQ(nullptr, table.find(i * 3 + 1));
+	}
+
+	table.clear();
+	ASSERT_EQ(0u, table.size());
+	ASSERT_EQ(nullptr, table.find(0));
+}
+
+TEST(LclStringsTest, xstr_tag_cache)
+{
+	xstr_tag_cache cache(4);
+	SCP_string tag = "XSTR(\"Alpha 1\", 100)";
+
+	ASSERT_EQ(nullptr, cache.find(tag.c_str(), tag.length()));
+
+	cache.add(tag.c_str(), tag.length(), "Alpha 1", 100);
+
+	auto found = cache.find(tag.c_str(), tag.length());
+	ASSERT_NE(nullptr, found);
+	ASSERT_EQ("Alpha 1", found->text);
+	ASSERT_EQ(100, found->id);
+
+	// only the whole tag matches
+	ASSERT_EQ(nullptr, cache.find(tag.c_str(), tag.length() - 1));
+
+	// a full cache starts over
+	char buf[64];
+	for (int i = 0; i < 4; ++i) {
+		sprintf(buf, "XSTR(\"Beta %d\", %d)", i, i);
+		cache.add(buf, strlen(buf), buf, i);
+	}
+	ASSERT_EQ(nullptr, cache.find(tag.c_str(), tag.length()));
+	ASSERT_EQ(1u, cache.size());
+}
+
+TEST(LclStringsTest, lookup_benchmark)
+{
+	// about as many strings as tstrings.tbl and a few modular tables have
+	const int num_strings = 4000;
+	const int num_lookups = 1000000;
+
+	string_table table;
+	SCP_unordered_map<int, char*> map;
+	SCP_vector<int> ids;
+	SCP_vector<SCP_string> tags;
+	xstr_tag_cache cache(num_strings);
+
+	char buf[64];
+	for (int i = 0; i < num_strings; ++i) {
+		// retail ids are consecutive, mods use their own ranges
+		int id = (i % 2) ? i : 300000 + i;
+		sprintf(buf, "Translated string number %d", i);
+		table.insert(id, buf, false);
+		map.insert(std::make_pair(id, vm_strdup(buf)));
+		ids.push_back(id);
+
+		sprintf(buf, "XSTR(\"Message number %d\", %d)", i, id);
+		tags.push_back(buf);
+		cache.add(tags.back().c_str(), tags.back().length(), buf, id);
+	}
+
+	// look the strings up in a scattered order
+	SCP_vector<int> order(num_lookups);
+	for (int i = 0; i < num_lookups; ++i) {
+		order[i] = static_cast<int>((static_cast<std::int64_t>(i) * 7919) % num_strings);
+	}
+
+	size_t found = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < num_lookups; ++i) {
+		found += table.find(ids[order[i]]) != nullptr;
+	}
+	auto table_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	ASSERT_EQ(static_cast<size_t>(num_lookups), found);
+
+	// what lcl_ext_localize_sub() used to do
+	found = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < num_lookups; ++i) {
+		auto id = ids[order[i]];
+		if (map.find(id) != map.end()) {
+			// once for the length check, once for the copy
+			found += (map[id] != nullptr) && (map[id] != nullptr);
+		}
+	}
+	auto map_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	ASSERT_EQ(static_cast<size_t>(num_lookups), found);
+
+	found = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < num_lookups; ++i) {
+		auto& tag = tags[order[i]];
+		found += cache.find(tag.c_str(), tag.length()) != nullptr;
+	}
+	auto cache_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	ASSERT_EQ(static_cast<size_t>(num_lookups), found);
+
+	for (auto& entry : map) {
+		vm_free(entry.second);
+	}
+
+	std::cout << "XSTR lookups in " << num_strings << " strings: table " << (num_lookups / table_time)
+	          << "/s, unordered_map " << (num_lookups / map_time) << "/s, tag cache " << (num_lookups / cache_time)
+	          << "/s" << std::endl;
+}
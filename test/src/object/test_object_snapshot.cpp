@@ -0,0 +1,111 @@
+
+#include <gtest/gtest.h>
+
+#include "object/object.h"
+#include "object/objectsnapshot.h"
+
+#include <algorithm>
+
+namespace {
+size_t add_object(object_snapshot& snapshot, int objnum, float x, float y, float z, float radius) {
+	vec3d pos;
+	vm_vec_make(&pos, x, y, z);
+
+	return snapshot.add(objnum, objnum + 100, OBJ_SHIP, flagset<Object::Object_Flags>(), 0, pos, vmd_zero_vector, radius,
+	                    1.0f);
+}
+
+SCP_vector<int> query(const object_snapshot& snapshot, float x, float y, float z, float radius) {
+	vec3d center;
+	vm_vec_make(&center, x, y, z);
+
+	SCP_vector<int> found;
+	snapshot.query_sphere(center, radius, found);
+	std::sort(found.begin(), found.end());
+	return found;
+}
+}
+
+TEST(ObjectSnapshotTest, fields) {
+	object_snapshot snapshot;
+
+	vec3d pos, vel;
+	vm_vec_make(&pos, 1.0f, 2.0f, 3.0f);
+	vm_vec_make(&vel, 4.0f, 5.0f, 6.0f);
+	flagset<Object::Object_Flags> flags;
+	flags.set(Object::Object_Flags::Player_ship);
+
+	auto index = snapshot.add(7, 42, OBJ_SHIP, flags, 2, pos, vel, 10.0f, 0.5f);
+
+	ASSERT_EQ((size_t)0, index);
+	ASSERT_EQ((size_t)1, snapshot.size());
+	ASSERT_EQ(7, snapshot.objnum(0));
+	ASSERT_EQ(42, snapshot.signature(0));
+	ASSERT_EQ(OBJ_SHIP, snapshot.type(0));
+	ASSERT_TRUE(snapshot.flags(0)[Object::Object_Flags::Player_ship]);
+	ASSERT_EQ(2, snapshot.team(0));
+	auto snap_pos = snapshot.pos(0);
+	auto snap_vel = snapshot.vel(0);
+	ASSERT_TRUE(vm_vec_same(&pos, &snap_pos));
+	ASSERT_TRUE(vm_vec_same(&vel, &snap_vel));
+	ASSERT_FLOAT_EQ(10.0f, snapshot.radius(0));
+	ASSERT_FLOAT_EQ(0.5f, snapshot.hull_pct(0));
+
+	snapshot.clear();
+	ASSERT_EQ((size_t)0, snapshot.size());
+}
+
+TEST(ObjectSnapshotTest, query_sphere) {
+	object_snapshot snapshot;
+
+	add_object(snapshot, 0, 0.0f, 0.0f, 0.0f, 10.0f);
+	add_object(snapshot, 1, 150.0f, 0.0f, 0.0f, 10.0f);
+	// across a cell border
+	add_object(snapshot, 2, -120.0f, 0.0f, 0.0f, 10.0f);
+	// too far away, but big enough to reach into the sphere
+	add_object(snapshot, 3, 0.0f, 3000.0f, 0.0f, 2950.0f);
+	// far away
+	add_object(snapshot, 4, 0.0f, 0.0f, 5000.0f, 10.0f);
+	add_object(snapshot, 5, -80000.0f, 120000.0f, 0.0f, 10.0f);
+	snapshot.build_index();
+
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 2, 3 }), query(snapshot, 0.0f, 0.0f, 0.0f, 200.0f));
+	ASSERT_EQ(SCP_vector<int>({ 0, 2, 3 }), query(snapshot, 0.0f, 0.0f, 0.0f, 130.0f));
+	// the radius of the objects counts
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 3 }), query(snapshot, 75.0f, 0.0f, 0.0f, 66.0f));
+	ASSERT_EQ(SCP_vector<int>({ 4 }), query(snapshot, 0.0f, 0.0f, 5100.0f, 100.0f));
+	ASSERT_EQ(SCP_vector<int>({ 5 }), query(snapshot, -80000.0f, 120000.0f, 5.0f, 1.0f));
+	ASSERT_EQ(SCP_vector<int>(), query(snapshot, 20000.0f, 0.0f, 0.0f, 100.0f));
+
+	// a sphere that covers more cells than there are objects checks all of them
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 2, 3, 4 }), query(snapshot, 0.0f, 0.0f, 0.0f, 10000.0f));
+}
+
+TEST(ObjectSnapshotTest, query_matches_linear_search) {
+	object_snapshot snapshot;
+
+	for (int i = 0; i < 500; ++i) {
+		add_object(snapshot, i, (i * 397 % 1000) * 20.0f - 10000.0f, (i * 211 % 1000) * 20.0f - 10000.0f,
+		           (i * 631 % 1000) * 20.0f - 10000.0f, (i % 7 == 0) ? 800.0f : 20.0f);
+	}
+	snapshot.build_index();
+
+	for (int q = 0; q < 50; ++q) {
+		float x = (q * 173 % 100) * 200.0f - 10000.0f;
+		float y = (q * 59 % 100) * 200.0f - 10000.0f;
+		float z = (q * 89 % 100) * 200.0f - 10000.0f;
+		float radius = 200.0f + q * 40.0f;
+
+		SCP_vector<int> expected;
+		for (size_t i = 0; i < snapshot.size(); ++i) {
+			vec3d center;
+			vm_vec_make(&center, x, y, z);
+			vec3d pos = snapshot.pos(i);
+			if (vm_vec_dist(&center, &pos) <= radius + snapshot.radius(i)) {
+				expected.push_back(static_cast<int>(i));
+			}
+		}
+
+		ASSERT_EQ(expected, query(snapshot, x, y, z, radius));
+	}
+}
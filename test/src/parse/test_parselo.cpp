@@ -62,6 +62,31 @@ TEST_F(ParseloTest, utf8_with_bom) {
 	ASSERT_STREQ(content.c_str(), "Hello World");
 }
 
+TEST_F(ParseloTest, prepared_tables) {
+	read_file_text("test.tbl", CF_TYPE_TABLES);
+	SCP_string expected = Parse_text;
+	SCP_string expected_raw = Parse_text_raw;
+
+	parse_prepare_tables();
+
+	// the prepared text has to be exactly what reading the file produces
+	stop_parse();
+	read_file_text("test.tbl", CF_TYPE_TABLES);
+	ASSERT_STREQ(expected.c_str(), Parse_text);
+	ASSERT_STREQ(expected_raw.c_str(), Parse_text_raw);
+
+	// and parse like it
+	reset_parse();
+	required_string("#Start");
+	required_string("$Token:");
+
+	// handed out only once, reading it again goes to the file
+	read_file_text("test.tbl", CF_TYPE_TABLES);
+	ASSERT_STREQ(expected.c_str(), Parse_text);
+
+	parse_release_prepared_tables();
+}
+
 TEST(ParseloUtilTest, drop_trailing_whitespace_cstr) {
 	char test_str[256];
 
@@ -0,0 +1,165 @@
+
+#include <gtest/gtest.h>
+
+#include "graphics/2d.h"
+#include "graphics/render.h"
+#include "math/vecmat.h"
+#include "radar/radarcontacts.h"
+
+#include "util/FSTestFixture.h"
+
+#include <chrono>
+
+using namespace radar;
+
+namespace {
+const size_t NUM_CONTACTS = 2000;
+
+// contacts spread around the player in every direction
+void add_test_contacts(contact_list& contacts, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		float angle = i * 0.37f;
+		float height = (i % 17) * 100.0f - 800.0f;
+		float dist = 500.0f + (i % 101) * 50.0f;
+
+		vec3d pos;
+		vm_vec_make(&pos, cosf(angle) * dist, height, sinf(angle) * dist);
+
+		contacts.add(static_cast<int>(i), static_cast<int>(i) + 1, pos);
+	}
+}
+
+long long elapsed_us(std::chrono::high_resolution_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start)
+		.count();
+}
+}
+
+TEST(RadarContactsTest, project_matches_vecmat) {
+	contact_list contacts;
+	add_test_contacts(contacts, 50);
+
+	vec3d origin;
+	vm_vec_make(&origin, 10.0f, -20.0f, 30.0f);
+
+	angles view_angles = { 0.3f, 1.2f, -0.5f };
+	matrix orient;
+	vm_angles_2_matrix(&orient, &view_angles);
+
+	contacts.project(origin, orient);
+
+	ASSERT_EQ((size_t)50, contacts.size());
+	for (size_t i = 0; i < contacts.size(); ++i) {
+		vec3d world_pos = contacts.world_pos(i);
+		vec3d rel_pos, expected;
+		vm_vec_sub(&rel_pos, &world_pos, &origin);
+		vm_vec_rotate(&expected, &rel_pos, &orient);
+
+		vec3d eye_pos = contacts.eye_pos(i);
+		ASSERT_NEAR(expected.xyz.x, eye_pos.xyz.x, 0.01f);
+		ASSERT_NEAR(expected.xyz.y, eye_pos.xyz.y, 0.01f);
+		ASSERT_NEAR(expected.xyz.z, eye_pos.xyz.z, 0.01f);
+		ASSERT_NEAR(vm_vec_dist(&world_pos, &origin), contacts.dist(i), 0.01f);
+		ASSERT_EQ(static_cast<int>(i), contacts.objnum(i));
+		ASSERT_EQ(static_cast<int>(i) + 1, contacts.signature(i));
+	}
+}
+
+TEST(RadarContactsTest, project_flat) {
+	// straight ahead, straight behind, to the right, behind and above
+	const float x[] = { 0.0f, 0.001f, 100.0f, 0.0f };
+	const float y[] = { 0.0f, 0.0f, 0.0f, 50.0f };
+	const float z[] = { 100.0f, -100.0f, 0.0f, -50.0f };
+	float dist[4];
+	for (int i = 0; i < 4; ++i) {
+		dist[i] = sqrtf(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+	}
+
+	float out_x[4], out_y[4];
+	project_flat(x, y, z, dist, 4, out_x, out_y);
+
+	// too close to the center to have a direction
+	ASSERT_FLOAT_EQ(0.0f, out_x[0]);
+	ASSERT_FLOAT_EQ(0.0f, out_y[0]);
+	ASSERT_FLOAT_EQ(0.0f, out_x[1]);
+	ASSERT_FLOAT_EQ(0.0f, out_y[1]);
+
+	// halfway out for objects at a right angle, all the way out for objects behind the player
+	ASSERT_NEAR(0.5f, out_x[2], 0.001f);
+	ASSERT_NEAR(0.0f, out_y[2], 0.001f);
+	ASSERT_NEAR(0.0f, out_x[3], 0.001f);
+	ASSERT_NEAR(0.75f, out_y[3], 0.001f);
+}
+
+TEST(RadarContactsTest, clear) {
+	contact_list contacts;
+	add_test_contacts(contacts, 10);
+	contacts.project(vmd_zero_vector, vmd_identity_matrix);
+
+	contacts.clear();
+	ASSERT_EQ((size_t)0, contacts.size());
+}
+
+class RadarContactsBenchmark : public test::FSTestFixture {
+ public:
+	RadarContactsBenchmark() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) {}
+
+ protected:
+	void SetUp() override { test::FSTestFixture::SetUp(); }
+	void TearDown() override { test::FSTestFixture::TearDown(); }
+};
+
+TEST_F(RadarContactsBenchmark, contacts_2000) {
+	const int NUM_FRAMES = 100;
+
+	contact_list contacts;
+	SCP_vector<float> eye_x(NUM_CONTACTS), eye_y(NUM_CONTACTS), eye_z(NUM_CONTACTS), dist(NUM_CONTACTS);
+	SCP_vector<float> out_x(NUM_CONTACTS), out_y(NUM_CONTACTS);
+	SCP_vector<int> screen_x(NUM_CONTACTS), screen_y(NUM_CONTACTS);
+
+	long long gather_us = 0, project_us = 0, draw_us = 0, draw_single_us = 0;
+
+	for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+		auto start = std::chrono::high_resolution_clock::now();
+		contacts.clear();
+		add_test_contacts(contacts, NUM_CONTACTS);
+		gather_us += elapsed_us(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		contacts.project(vmd_zero_vector, vmd_identity_matrix);
+		for (size_t i = 0; i < NUM_CONTACTS; ++i) {
+			vec3d pos = contacts.eye_pos(i);
+			eye_x[i] = pos.xyz.x;
+			eye_y[i] = pos.xyz.y;
+			eye_z[i] = pos.xyz.z;
+			dist[i] = contacts.dist(i);
+		}
+		project_flat(eye_x.data(), eye_y.data(), eye_z.data(), dist.data(), NUM_CONTACTS, out_x.data(), out_y.data());
+		for (size_t i = 0; i < NUM_CONTACTS; ++i) {
+			screen_x[i] = fl2i(100.0f + out_x[i] * 60.0f);
+			screen_y[i] = fl2i(100.0f - out_y[i] * 60.0f);
+		}
+		project_us += elapsed_us(start);
+
+		// one draw for all of them like the radar does for a blip type, compared to a draw per blip
+		start = std::chrono::high_resolution_clock::now();
+		gr_circles(screen_x.data(), screen_y.data(), NUM_CONTACTS, 4, GR_RESIZE_NONE);
+		draw_us += elapsed_us(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < NUM_CONTACTS; ++i) {
+			gr_circle(screen_x[i], screen_y[i], 4, GR_RESIZE_NONE);
+		}
+		draw_single_us += elapsed_us(start);
+	}
+
+	for (size_t i = 0; i < NUM_CONTACTS; ++i) {
+		ASSERT_LE(std::abs(out_x[i]), 1.0f);
+		ASSERT_LE(std::abs(out_y[i]), 1.0f);
+	}
+
+	printf("%d contacts, per frame: gather %.1f us, project %.1f us, batched draw %.1f us (%.1f us with one draw per "
+	       "contact)\n",
+	       static_cast<int>(NUM_CONTACTS), gather_us / (double)NUM_FRAMES, project_us / (double)NUM_FRAMES,
+	       draw_us / (double)NUM_FRAMES, draw_single_us / (double)NUM_FRAMES);
+}
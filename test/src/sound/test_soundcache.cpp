@@ -0,0 +1,95 @@
+
+#include <gtest/gtest.h>
+
+#include "sound/soundcache.h"
+
+using namespace sound;
+
+namespace {
+// hands out a ramp of bytes in uneven pieces, like a decoder does
+class RampAudioFile : public IAudioFile {
+	int _pos = 0;
+	int _size;
+
+  public:
+	explicit RampAudioFile(int size) : _size(size) {}
+
+	bool Open(const char* /*pszFilename*/, bool /*keep_ext*/) override { return true; }
+	bool Cue() override {
+		_pos = 0;
+		return true;
+	}
+	int Read(uint8_t* pbDest, size_t cbSize) override {
+		if (_pos >= _size) {
+			return -1;
+		}
+		// nothing for a small buffer once in a while, the reader has to grow it
+		if (cbSize < 64 && _pos % 3 == 0) {
+			return 0;
+		}
+
+		int count = std::min(std::min((int)cbSize, 37), _size - _pos);
+		for (int i = 0; i < count; ++i) {
+			pbDest[i] = static_cast<uint8_t>(_pos + i);
+		}
+		_pos += count;
+		return count;
+	}
+	AudioFileProperties getFileProperties() override {
+		AudioFileProperties props;
+		props.bytes_per_sample = 2;
+		props.num_channels = 1;
+		props.sample_rate = 11;
+		props.total_samples = _size / 2;
+		props.duration = props.total_samples / 11.0;
+		return props;
+	}
+	void setResamplingProperties(const ResampleProperties& /*resampleProps*/) override {}
+};
+}
+
+TEST(SoundCacheTest, decode) {
+	RampAudioFile source(1000);
+
+	auto pcm = PcmAudioFile::decode(&source);
+
+	ASSERT_EQ(1000, (int)pcm->data().size());
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_EQ(static_cast<uint8_t>(i), pcm->data()[i]);
+	}
+
+	auto props = pcm->getFileProperties();
+	ASSERT_EQ(2, props.bytes_per_sample);
+	ASSERT_EQ(500, props.total_samples);
+}
+
+TEST(SoundCacheTest, decode_empty) {
+	RampAudioFile source(0);
+
+	ASSERT_EQ(nullptr, PcmAudioFile::decode(&source));
+}
+
+TEST(SoundCacheTest, read) {
+	SCP_vector<uint8_t> data;
+	for (int i = 0; i < 100; ++i) {
+		data.push_back(static_cast<uint8_t>(i));
+	}
+
+	AudioFileProperties props;
+	props.bytes_per_sample = 1;
+	props.num_channels = 1;
+	props.total_samples = 100;
+
+	PcmAudioFile pcm(props, std::move(data));
+
+	uint8_t buffer[64];
+	ASSERT_EQ(64, pcm.Read(buffer, sizeof(buffer)));
+	ASSERT_EQ(63, buffer[63]);
+	ASSERT_EQ(36, pcm.Read(buffer, sizeof(buffer)));
+	ASSERT_EQ(99, buffer[35]);
+	ASSERT_EQ(-1, pcm.Read(buffer, sizeof(buffer)));
+
+	ASSERT_TRUE(pcm.Cue());
+	ASSERT_EQ(64, pcm.Read(buffer, sizeof(buffer)));
+	ASSERT_EQ(0, buffer[0]);
+}
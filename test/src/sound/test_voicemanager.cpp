@@ -0,0 +1,184 @@
+
+#include <gtest/gtest.h>
+
+#include "sound/voicemanager.h"
+
+#include <chrono>
+
+using namespace sound;
+
+namespace {
+// remembers which sounds play, like the sound system would
+class RecordingVoiceBackend : public IVoiceBackend {
+  public:
+	SCP_vector<bool> playing;
+	SCP_vector<int> updates;
+	bool refuse_start = false;
+
+	explicit RecordingVoiceBackend(int num) : playing(num, false), updates(num, 0) {}
+
+	bool startVoice(int id) override
+	{
+		if (refuse_start) {
+			return false;
+		}
+		EXPECT_FALSE(playing[id]);
+		playing[id] = true;
+		return true;
+	}
+	void stopVoice(int id) override
+	{
+		EXPECT_TRUE(playing[id]);
+		playing[id] = false;
+	}
+	void updateVoice(int id) override
+	{
+		EXPECT_TRUE(playing[id]);
+		++updates[id];
+	}
+};
+
+// counts like the null backend but knows which sounds play, so they can be added correctly
+class CountingVoiceBackend : public NullVoiceBackend {
+  public:
+	SCP_vector<bool> playing;
+
+	explicit CountingVoiceBackend(int num) : playing(num, false) {}
+
+	bool startVoice(int id) override
+	{
+		playing[id] = true;
+		return NullVoiceBackend::startVoice(id);
+	}
+	void stopVoice(int id) override
+	{
+		playing[id] = false;
+		NullVoiceBackend::stopVoice(id);
+	}
+};
+
+void run_update(VoiceManager& voices, RecordingVoiceBackend& backend, const SCP_vector<float>& loudness, int max_voices)
+{
+	voices.begin();
+	for (size_t i = 0; i < loudness.size(); ++i) {
+		voices.add((int)i, loudness[i], backend.playing[i]);
+	}
+	voices.run(backend, max_voices);
+}
+} // namespace
+
+TEST(VoiceManagerTest, loudest_sounds_play)
+{
+	VoiceManager voices(8, 1, 0.1f);
+	RecordingVoiceBackend backend(6);
+
+	run_update(voices, backend, {0.2f, 0.9f, 0.5f, 0.3f, 0.8f, 0.4f}, 3);
+
+	ASSERT_EQ(3, voices.numPlaying());
+	ASSERT_EQ(SCP_vector<bool>({false, true, true, false, true, false}), backend.playing);
+
+	// sound 0 gets louder than the quietest playing one, which gives up its voice
+	run_update(voices, backend, {0.6f, 0.9f, 0.5f, 0.3f, 0.8f, 0.4f}, 3);
+
+	ASSERT_EQ(3, voices.numPlaying());
+	ASSERT_EQ(SCP_vector<bool>({true, true, false, false, true, false}), backend.playing);
+}
+
+TEST(VoiceManagerTest, out_of_range_stops)
+{
+	VoiceManager voices(8, 1, 0.1f);
+	RecordingVoiceBackend backend(3);
+
+	run_update(voices, backend, {0.5f, 0.5f, 0.5f}, 3);
+	ASSERT_EQ(3, voices.numPlaying());
+
+	run_update(voices, backend, {0.5f, -1.0f, 0.5f}, 3);
+
+	ASSERT_EQ(2, voices.numPlaying());
+	ASSERT_EQ(SCP_vector<bool>({true, false, true}), backend.playing);
+}
+
+TEST(VoiceManagerTest, quiet_sounds_keep_playing)
+{
+	VoiceManager voices(8, 1, 0.1f);
+	RecordingVoiceBackend backend(3);
+
+	// too quiet to start
+	run_update(voices, backend, {0.05f, 0.5f, 0.0f}, 3);
+	ASSERT_EQ(SCP_vector<bool>({false, true, false}), backend.playing);
+
+	// but not too quiet to keep playing, even behind a louder sound which doesn't start
+	run_update(voices, backend, {0.08f, 0.01f, 0.0f}, 3);
+	ASSERT_EQ(SCP_vector<bool>({false, true, false}), backend.playing);
+}
+
+TEST(VoiceManagerTest, refused_start_tried_again)
+{
+	VoiceManager voices(8, 1, 0.1f);
+	RecordingVoiceBackend backend(2);
+
+	backend.refuse_start = true;
+	run_update(voices, backend, {0.5f, 0.5f}, 2);
+	ASSERT_EQ(0, voices.numPlaying());
+	ASSERT_EQ(0, voices.numUpdated());
+
+	backend.refuse_start = false;
+	run_update(voices, backend, {0.5f, 0.5f}, 2);
+	ASSERT_EQ(2, voices.numPlaying());
+	ASSERT_EQ(SCP_vector<int>({1, 1}), backend.updates);
+}
+
+TEST(VoiceManagerTest, staggered_updates)
+{
+	VoiceManager voices(2, 4, 0.1f);
+	RecordingVoiceBackend backend(10);
+
+	SCP_vector<float> loudness;
+	for (int i = 0; i < 10; ++i) {
+		loudness.push_back(1.0f - i * 0.05f);
+	}
+
+	// the first update starts everything
+	run_update(voices, backend, loudness, 10);
+	ASSERT_EQ(10, voices.numUpdated());
+
+	for (int i = 0; i < 8; ++i) {
+		run_update(voices, backend, loudness, 10);
+		// the two loudest plus every fourth one of the other eight
+		ASSERT_EQ(4, voices.numUpdated());
+	}
+
+	ASSERT_EQ(9, backend.updates[0]);
+	ASSERT_EQ(9, backend.updates[1]);
+	for (int i = 2; i < 10; ++i) {
+		ASSERT_EQ(3, backend.updates[i]);
+	}
+}
+
+TEST(VoiceManagerTest, update_benchmark)
+{
+	const int num_sounds = 256;
+	const int num_updates = 10000;
+
+	VoiceManager voices(3, 2, 0.1f);
+	CountingVoiceBackend backend(num_sounds);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int update = 0; update < num_updates; ++update) {
+		voices.begin();
+		for (int i = 0; i < num_sounds; ++i) {
+			// sounds drift closer and further away
+			voices.add(i, static_cast<float>((i * 37 + update) % 100) / 100.0f, backend.playing[i]);
+		}
+		voices.run(backend, 12);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	ASSERT_EQ(12, voices.numPlaying());
+	ASSERT_EQ(backend.starts - backend.stops, 12);
+
+	auto seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << "Voice manager with " << num_sounds << " sounds: " << (num_updates / seconds) << " updates/s, "
+	          << backend.starts << " starts, " << backend.stops << " stops, " << backend.updates << " sound updates"
+	          << std::endl;
+}
@@ -10,6 +10,10 @@ add_file_folder("CFile"
     cfile/cfile.cpp
 )
 
+add_file_folder("DDSUtils"
+    ddsutils/test_dxtc.cpp
+)
+
 add_file_folder("Globalincs"
     globalincs/test_flagset.cpp
     globalincs/test_safe_strings.cpp
@@ -20,6 +24,14 @@ add_file_folder("Graphics"
 	   graphics/test_font.cpp
 )
 
+add_file_folder("Lighting"
+    lighting/test_light_grid.cpp
+)
+
+add_file_folder("Localization"
+    localization/test_lcl_strings.cpp
+)
+
 add_file_folder("menuui"
     menuui/test_intel_parse.cpp
 )
@@ -28,6 +40,10 @@ add_file_folder("mod"
     mod/test_mod_table.cpp
 )
 
+add_file_folder("Object"
+    object/test_object_snapshot.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
 )
@@ -36,6 +52,10 @@ add_file_folder("Pilotfile"
     pilotfile/plr.cpp
 )
 
+add_file_folder("Radar"
+    radar/test_radar_contacts.cpp
+)
+
 add_file_folder("Scripting"
     scripting/ade_args.cpp
     scripting/doc_parser.cpp
@@ -63,6 +83,15 @@ add_file_folder("Scripting\\\\Lua"
     scripting/lua/Value.cpp
 )
 
+add_file_folder("Sound"
+    sound/test_soundcache.cpp
+    sound/test_voicemanager.cpp
+)
+
+add_file_folder("Tracing"
+    tracing/test_binary_trace_format.cpp
+)
+
 add_file_folder("Test Util"
     util/FSTestFixture.cpp
     util/FSTestFixture.h
@@ -70,7 +99,11 @@ add_file_folder("Test Util"
 )
 
 add_file_folder("Utils"
+    utils/ChunkedPoolTest.cpp
+    utils/HdrHistogramTest.cpp
     utils/HeapAllocatorTest.cpp
+    utils/NameIndexTest.cpp
+    utils/SpscRingBufferTest.cpp
 )
 
 add_file_folder("Weapon"
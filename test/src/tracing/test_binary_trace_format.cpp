@@ -0,0 +1,101 @@
+
+#include <gtest/gtest.h>
+
+#include "tracing/BinaryTraceFormat.h"
+
+using namespace tracing::binary;
+
+TEST(BinaryTraceFormatTest, header)
+{
+	std::uint8_t data[FILE_HEADER_SIZE];
+	encode_header(data, 123456789012LL);
+
+	std::int64_t pid = 0;
+	ASSERT_TRUE(decode_header(data, sizeof(data), &pid));
+	ASSERT_EQ(123456789012LL, pid);
+
+	// too short
+	ASSERT_FALSE(decode_header(data, FILE_HEADER_SIZE - 1, &pid));
+
+	// not a trace
+	data[0] = '[';
+	ASSERT_FALSE(decode_header(data, sizeof(data), &pid));
+}
+
+TEST(BinaryTraceFormatTest, records)
+{
+	name_record name;
+	name.kind = NameKind::Scope;
+	name.id = 42;
+	name.name = "Main Frame";
+
+	event_record complete;
+	complete.kind = EventKind::Complete;
+	complete.flags = EVENT_FLAG_GPU;
+	complete.category = 7;
+	complete.scope = 42;
+	complete.tid = 0xDEADBEEF;
+	complete.timestamp = 0x0123456789ABCDEFULL;
+	complete.duration = 16666667;
+
+	event_record counter;
+	counter.kind = EventKind::Counter;
+	counter.category = 3;
+	counter.timestamp = 1000;
+	counter.value = 0.25f;
+
+	std::vector<std::uint8_t> data(name_record_size(name) + 2 * EVENT_RECORD_SIZE);
+	size_t pos = 0;
+	pos += encode_name(data.data() + pos, name);
+	pos += encode_event(data.data() + pos, complete);
+	pos += encode_event(data.data() + pos, counter);
+	ASSERT_EQ(data.size(), pos);
+
+	RecordType type;
+	name_record name_out;
+	event_record evt_out;
+
+	pos = 0;
+	auto size = decode_record(data.data(), data.size(), &type, &name_out, &evt_out);
+	ASSERT_EQ(name_record_size(name), size);
+	ASSERT_EQ(RecordType::Name, type);
+	ASSERT_EQ(NameKind::Scope, name_out.kind);
+	ASSERT_EQ(42, name_out.id);
+	ASSERT_EQ("Main Frame", name_out.name);
+	pos += size;
+
+	size = decode_record(data.data() + pos, data.size() - pos, &type, &name_out, &evt_out);
+	ASSERT_EQ(EVENT_RECORD_SIZE, size);
+	ASSERT_EQ(RecordType::Event, type);
+	ASSERT_EQ(EventKind::Complete, evt_out.kind);
+	ASSERT_EQ(EVENT_FLAG_GPU, evt_out.flags);
+	ASSERT_EQ(7, evt_out.category);
+	ASSERT_EQ(42, evt_out.scope);
+	ASSERT_EQ(0xDEADBEEF, evt_out.tid);
+	ASSERT_EQ(0x0123456789ABCDEFULL, evt_out.timestamp);
+	ASSERT_EQ((std::uint64_t)16666667, evt_out.duration);
+	pos += size;
+
+	size = decode_record(data.data() + pos, data.size() - pos, &type, &name_out, &evt_out);
+	ASSERT_EQ(EVENT_RECORD_SIZE, size);
+	ASSERT_EQ(EventKind::Counter, evt_out.kind);
+	ASSERT_EQ(NO_SCOPE, evt_out.scope);
+	ASSERT_FLOAT_EQ(0.25f, evt_out.value);
+}
+
+TEST(BinaryTraceFormatTest, truncated_records)
+{
+	event_record evt;
+	std::uint8_t data[EVENT_RECORD_SIZE];
+	encode_event(data, evt);
+
+	RecordType type;
+	name_record name_out;
+	event_record evt_out;
+
+	// a record cut off by a crash must not be read
+	ASSERT_EQ((size_t)0, decode_record(data, EVENT_RECORD_SIZE - 1, &type, &name_out, &evt_out));
+
+	data[0] = 0;
+	ASSERT_EQ((size_t)0, decode_record(data, EVENT_RECORD_SIZE, &type, &name_out, &evt_out));
+}
@@ -0,0 +1,166 @@
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "utils/chunked_pool.h"
+
+using namespace util;
+
+namespace {
+struct test_slot {
+	int value;
+	int id;
+};
+
+void initSlot(test_slot& slot) {
+	slot.value = -1;
+}
+}
+
+TEST(ChunkedPoolTests, allocateInOrder) {
+	chunked_pool<test_slot, 16> pool(initSlot);
+
+	ASSERT_EQ(0, pool.size());
+
+	for (int i = 0; i < 40; ++i) {
+		ASSERT_EQ(i, pool.allocate());
+	}
+
+	ASSERT_EQ(48, pool.size());
+	ASSERT_EQ(8, pool.num_free());
+
+	// new slots are zeroed and then initialized
+	ASSERT_EQ(-1, pool[47].value);
+	ASSERT_EQ(0, pool[47].id);
+}
+
+TEST(ChunkedPoolTests, releasedSlotsAreReused) {
+	chunked_pool<test_slot, 16> pool;
+
+	for (int i = 0; i < 16; ++i) {
+		pool.allocate();
+	}
+
+	pool.release(5);
+	pool.release(9);
+
+	ASSERT_EQ(9, pool.allocate());
+	ASSERT_EQ(5, pool.allocate());
+
+	// nothing free anymore, so this grows the pool
+	ASSERT_EQ(16, pool.allocate());
+	ASSERT_EQ(32, pool.size());
+}
+
+TEST(ChunkedPoolTests, maxSize) {
+	chunked_pool<test_slot, 16> pool;
+	pool.set_max_size(32);
+
+	for (int i = 0; i < 32; ++i) {
+		ASSERT_EQ(i, pool.allocate());
+	}
+
+	ASSERT_EQ(-1, pool.allocate());
+	ASSERT_EQ(-1, pool.grow());
+}
+
+TEST(ChunkedPoolTests, releaseAll) {
+	chunked_pool<test_slot, 16> pool;
+
+	for (int i = 0; i < 20; ++i) {
+		pool.allocate();
+	}
+
+	pool.release_all();
+
+	ASSERT_EQ(32, pool.num_free());
+	ASSERT_EQ(0, pool.allocate());
+}
+
+TEST(ChunkedPoolTests, shrink) {
+	chunked_pool<test_slot, 16> pool(initSlot);
+
+	for (int i = 0; i < 40; ++i) {
+		pool.allocate();
+	}
+	auto first = &pool[0];
+	auto last = &pool[35];
+	pool.release(3);
+	pool.release(35);
+
+	// rounded up to whole chunks
+	pool.shrink(17);
+	ASSERT_EQ(32, pool.size());
+	ASSERT_EQ(first, &pool[0]);
+	ASSERT_EQ(-1, pool.index_of(last));
+
+	// slots of the freed chunks are gone from the free list
+	ASSERT_EQ(1, pool.num_free());
+	ASSERT_EQ(3, pool.allocate());
+	ASSERT_EQ(32, pool.allocate());
+
+	pool.shrink(0);
+	ASSERT_EQ(0, pool.size());
+	ASSERT_EQ(0, pool.num_free());
+}
+
+TEST(ChunkedPoolTests, indexOf) {
+	chunked_pool<test_slot, 16> pool;
+
+	for (int i = 0; i < 5; ++i) {
+		pool.grow();
+	}
+
+	for (int i = 0; i < pool.size(); ++i) {
+		ASSERT_EQ(i, pool.index_of(&pool[i]));
+	}
+
+	test_slot other;
+	ASSERT_EQ(-1, pool.index_of(&other));
+	ASSERT_EQ(-1, pool.index_of(nullptr));
+}
+
+TEST(ChunkedPoolTests, stableAddresses) {
+	// churn through 20000 slots like a big battle full of weapons would, making sure nothing moves while the pool grows
+	chunked_pool<test_slot, 512> pool(initSlot);
+
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> chance(0, 3);
+
+	SCP_vector<int> used;
+	SCP_vector<test_slot*> addresses;
+
+	for (int i = 0; i < 20000; ++i) {
+		int index = pool.allocate();
+		ASSERT_GE(index, 0);
+		ASSERT_EQ(-1, pool[index].value);
+
+		pool[index].value = i;
+		pool[index].id = index;
+		used.push_back(index);
+
+		if (index >= (int)addresses.size()) {
+			addresses.resize(index + 1, nullptr);
+		}
+		if (addresses[index] == nullptr) {
+			addresses[index] = &pool[index];
+		}
+
+		// free some of the older slots again every now and then
+		if (chance(gen) == 0 && !used.empty()) {
+			int victim = used.front();
+			used.erase(used.begin());
+
+			pool[victim].value = -1;
+			pool.release(victim);
+		}
+	}
+
+	for (auto index : used) {
+		ASSERT_EQ(addresses[index], &pool[index]);
+		ASSERT_EQ(index, pool[index].id);
+		ASSERT_EQ(index, pool.index_of(&pool[index]));
+	}
+
+	ASSERT_EQ((int)used.size() + pool.num_free(), pool.size());
+}
@@ -0,0 +1,91 @@
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "utils/hdr_histogram.h"
+
+using namespace util;
+
+TEST(HdrHistogramTests, empty) {
+	hdr_histogram histogram;
+
+	ASSERT_EQ((std::uint64_t)0, histogram.count());
+	ASSERT_EQ((std::uint64_t)0, histogram.percentile(50.0));
+	ASSERT_EQ((std::uint64_t)0, histogram.max());
+	ASSERT_DOUBLE_EQ(0.0, histogram.mean());
+}
+
+TEST(HdrHistogramTests, smallValuesAreExact) {
+	hdr_histogram histogram;
+
+	for (std::uint64_t i = 1; i <= 100; ++i) {
+		histogram.record(i);
+	}
+
+	ASSERT_EQ((std::uint64_t)100, histogram.count());
+	ASSERT_EQ((std::uint64_t)1, histogram.min());
+	ASSERT_EQ((std::uint64_t)100, histogram.max());
+	ASSERT_EQ((std::uint64_t)50, histogram.percentile(50.0));
+	ASSERT_EQ((std::uint64_t)95, histogram.percentile(95.0));
+	ASSERT_EQ((std::uint64_t)99, histogram.percentile(99.0));
+	ASSERT_EQ((std::uint64_t)100, histogram.percentile(100.0));
+	ASSERT_DOUBLE_EQ(50.5, histogram.mean());
+}
+
+TEST(HdrHistogramTests, relativePrecision) {
+	// frame times in microseconds, from a few hundred to a few seconds
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<std::uint64_t> dist(200, 3000000);
+
+	SCP_vector<std::uint64_t> values;
+	hdr_histogram histogram;
+
+	for (int i = 0; i < 10000; ++i) {
+		auto value = dist(gen);
+		values.push_back(value);
+		histogram.record(value);
+	}
+
+	std::sort(values.begin(), values.end());
+
+	for (auto percent : { 10.0, 50.0, 90.0, 99.0, 99.9 }) {
+		auto exact = values[static_cast<size_t>(percent / 100.0 * values.size() + 0.5) - 1];
+		auto reported = histogram.percentile(percent);
+
+		// within the width of one bucket
+		ASSERT_LE(reported, exact + exact / 64 + 1) << "percentile " << percent;
+		ASSERT_GE(reported, exact) << "percentile " << percent;
+	}
+
+	ASSERT_EQ(values.back(), histogram.max());
+	ASSERT_EQ(values.back(), histogram.percentile(100.0));
+}
+
+TEST(HdrHistogramTests, spike) {
+	hdr_histogram histogram;
+
+	// a steady 60 fps with a single hitch
+	for (int i = 0; i < 999; ++i) {
+		histogram.record(16667);
+	}
+	histogram.record(250000);
+
+	ASSERT_NEAR(16667.0, (double)histogram.percentile(50.0), 16667.0 / 64);
+	ASSERT_NEAR(16667.0, (double)histogram.percentile(99.0), 16667.0 / 64);
+	ASSERT_EQ((std::uint64_t)250000, histogram.percentile(100.0));
+	ASSERT_EQ((std::uint64_t)250000, histogram.max());
+}
+
+TEST(HdrHistogramTests, reset) {
+	hdr_histogram histogram;
+
+	histogram.record(1000);
+	histogram.reset();
+
+	ASSERT_EQ((std::uint64_t)0, histogram.count());
+
+	histogram.record(10);
+	ASSERT_EQ((std::uint64_t)10, histogram.min());
+	ASSERT_EQ((std::uint64_t)10, histogram.percentile(50.0));
+}
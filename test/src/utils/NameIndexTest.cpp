@@ -0,0 +1,160 @@
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+#include "utils/name_index.h"
+
+using namespace util;
+
+namespace {
+SCP_vector<SCP_string> Names;
+
+int names_count() {
+	return static_cast<int>(Names.size());
+}
+
+const char* name_at(int index) {
+	return Names[index].c_str();
+}
+
+int linear_lookup(const char* name) {
+	for (int i = 0; i < names_count(); ++i) {
+		if (!stricmp(Names[i].c_str(), name)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+SCP_string class_name(int i) {
+	char buf[32];
+	sprintf(buf, "GTF Class#%d", i);
+	return buf;
+}
+}
+
+class NameIndexTest : public ::testing::Test {
+ protected:
+	void SetUp() override { Names.clear(); }
+	void TearDown() override { Names.clear(); }
+};
+
+TEST_F(NameIndexTest, hashIsCaseInsensitive) {
+	ASSERT_EQ(name_index::hash("GTF Ulysses"), name_index::hash("gtf ulysses"));
+	ASSERT_NE(name_index::hash("GTF Ulysses"), name_index::hash("GTF Ulysses#2"));
+}
+
+TEST_F(NameIndexTest, findsAppendedEntries) {
+	name_index index(names_count, name_at);
+
+	ASSERT_EQ(-1, index.find("GTF Ulysses"));
+
+	Names.push_back("GTF Ulysses");
+	Names.push_back("GTF Hercules");
+	Names.push_back("");
+
+	ASSERT_EQ(0, index.find("GTF Ulysses"));
+	ASSERT_EQ(1, index.find("gtf HERCULES"));
+	ASSERT_EQ(-1, index.find(""));
+	ASSERT_EQ(-1, index.find("GTF Hercules Mark II"));
+
+	// enough to grow the table a few times
+	for (int i = 0; i < 100; ++i) {
+		Names.push_back(class_name(i));
+	}
+	for (int i = 0; i < 100; ++i) {
+		ASSERT_EQ(i + 3, index.find(class_name(i).c_str()));
+	}
+	ASSERT_EQ(1, index.find("GTF Hercules"));
+}
+
+TEST_F(NameIndexTest, firstDuplicateWins) {
+	name_index index(names_count, name_at);
+
+	Names.push_back("GTF Ulysses");
+	Names.push_back("GTF Hercules");
+	Names.push_back("gtf ulysses");
+
+	ASSERT_EQ(0, index.find("GTF Ulysses"));
+}
+
+TEST_F(NameIndexTest, renamedEntries) {
+	name_index index(names_count, name_at);
+
+	Names.push_back("GTF Ulysses");
+	Names.push_back("GTF Hercules");
+	ASSERT_EQ(0, index.find("GTF Ulysses"));
+
+	Names[0] = "GTF Loki";
+
+	// the old name must not find the entry anymore, even without telling the index
+	ASSERT_EQ(-1, index.find("GTF Ulysses"));
+
+	index.add(0);
+	ASSERT_EQ(0, index.find("GTF Loki"));
+	ASSERT_EQ(1, index.find("GTF Hercules"));
+}
+
+TEST_F(NameIndexTest, removedEntries) {
+	name_index index(names_count, name_at);
+
+	Names.push_back("GTF Ulysses");
+	Names.push_back("GTF Hercules");
+	Names.push_back("GTF Loki");
+	ASSERT_EQ(2, index.find("GTF Loki"));
+
+	Names.erase(Names.begin());
+
+	// shrinking tables are noticed on their own
+	ASSERT_EQ(0, index.find("GTF Hercules"));
+	ASSERT_EQ(1, index.find("GTF Loki"));
+	ASSERT_EQ(-1, index.find("GTF Ulysses"));
+
+	// but an entry replaced in place has to be reported
+	Names.erase(Names.begin());
+	Names.push_back("GTF Ulysses");
+	index.invalidate();
+
+	ASSERT_EQ(0, index.find("GTF Loki"));
+	ASSERT_EQ(1, index.find("GTF Ulysses"));
+	ASSERT_EQ(-1, index.find("GTF Hercules"));
+}
+
+TEST_F(NameIndexTest, parseBenchmark) {
+	// Like parsing the ship tables of a large mod: every class is looked up before it is added to check for duplicates,
+	// then the classes are referenced a few times each by other tables and missions
+	const int NUM_CLASSES = 5000;
+	const int NUM_REFERENCES = 20000;
+
+	SCP_vector<SCP_string> class_names;
+	for (int i = 0; i < NUM_CLASSES; ++i) {
+		class_names.push_back(class_name(i));
+	}
+
+	auto run = [&](const char* label, int (*lookup)(const char*)) {
+		Names.clear();
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (const auto& name : class_names) {
+			EXPECT_EQ(-1, lookup(name.c_str()));
+			Names.push_back(name);
+		}
+		for (int i = 0; i < NUM_REFERENCES; ++i) {
+			auto expected = (i * 7919) % NUM_CLASSES;
+			EXPECT_EQ(expected, lookup(class_names[expected].c_str()));
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		std::cout << label << ": " << NUM_CLASSES << " classes, " << NUM_REFERENCES << " references in "
+		          << elapsed.count() << " us" << std::endl;
+	};
+
+	static name_index Index(names_count, name_at);
+
+	run("linear search", linear_lookup);
+	run("name_index", [](const char* name) {
+		return Index.find(name);
+	});
+}
@@ -0,0 +1,80 @@
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "utils/spsc_ring_buffer.h"
+
+using namespace util;
+
+TEST(SpscRingBufferTests, capacityIsPowerOfTwo) {
+	spsc_ring_buffer<int> buffer(100);
+
+	ASSERT_EQ((size_t)128, buffer.capacity());
+	ASSERT_EQ((size_t)0, buffer.size());
+}
+
+TEST(SpscRingBufferTests, pushPopInOrder) {
+	spsc_ring_buffer<int> buffer(4);
+
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(buffer.try_push(i));
+	}
+
+	// full
+	ASSERT_FALSE(buffer.try_push(4));
+	ASSERT_EQ((size_t)4, buffer.size());
+
+	int val;
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(buffer.try_pop(val));
+		ASSERT_EQ(i, val);
+	}
+
+	ASSERT_FALSE(buffer.try_pop(val));
+}
+
+TEST(SpscRingBufferTests, wrapAround) {
+	spsc_ring_buffer<int> buffer(4);
+
+	int val;
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_TRUE(buffer.try_push(i));
+		ASSERT_TRUE(buffer.try_push(i + 1));
+
+		ASSERT_TRUE(buffer.try_pop(val));
+		ASSERT_EQ(i, val);
+		ASSERT_TRUE(buffer.try_pop(val));
+		ASSERT_EQ(i + 1, val);
+	}
+
+	ASSERT_EQ((size_t)0, buffer.size());
+}
+
+TEST(SpscRingBufferTests, twoThreads) {
+	// the consumer has to see every item exactly once and in order, no matter how the threads interleave
+	const int NUM_ITEMS = 200000;
+	spsc_ring_buffer<int> buffer(64);
+
+	std::thread producer([&buffer]() {
+		for (int i = 0; i < NUM_ITEMS; ++i) {
+			while (!buffer.try_push(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	int expected = 0;
+	int val;
+	while (expected < NUM_ITEMS) {
+		if (buffer.try_pop(val)) {
+			ASSERT_EQ(expected, val);
+			++expected;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	ASSERT_FALSE(buffer.try_pop(val));
+}
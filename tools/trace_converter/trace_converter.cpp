@@ -0,0 +1,207 @@
+// Converts a binary trace written with -binary_profiling into the JSON format of chrome://tracing, the same format
+// -json_profiling writes directly.
+
+#include "tracing/BinaryTraceFormat.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace tracing::binary;
+
+namespace {
+
+const char* getTypeStr(EventKind kind) {
+	switch (kind) {
+	case EventKind::Complete:
+		return "X";
+	case EventKind::Begin:
+		return "B";
+	case EventKind::End:
+		return "E";
+	case EventKind::AsyncBegin:
+		return "b";
+	case EventKind::AsyncStep:
+		return "n";
+	case EventKind::AsyncEnd:
+		return "e";
+	case EventKind::Counter:
+		return "C";
+	default:
+		return "";
+	}
+}
+
+void writeTime(std::ostream& out, std::uint64_t time) {
+	auto flags = out.flags();
+	out << std::fixed << std::setprecision(3);
+
+	out << (time / 1000.);
+
+	out.flags(flags);
+}
+
+// JSON strings, the names come from the engine so they should be harmless anyway
+void writeString(std::ostream& out, const std::string& str) {
+	out << '"';
+	for (auto c : str) {
+		if (c == '"' || c == '\\') {
+			out << '\\';
+		}
+		out << c;
+	}
+	out << '"';
+}
+
+struct converter {
+	std::int64_t pid = 0;
+
+	std::unordered_map<std::uint16_t, std::string> categories;
+	std::unordered_map<std::uint16_t, std::string> scopes;
+
+	bool first_line = true;
+
+	size_t num_events = 0;
+	size_t num_discarded = 0;
+
+	void writeEvent(std::ostream& out, const event_record& evt) {
+		if (evt.kind == EventKind::Complete && evt.duration < 1000) {
+			// Discard events that are less than a microsecond long, same as the JSON writer of the engine
+			++num_discarded;
+			return;
+		}
+
+		if (!first_line) {
+			out << ",";
+		}
+		out << "\n{\"tid\": " << evt.tid << ",\"ts\":";
+
+		writeTime(out, evt.timestamp);
+
+		out << ",\"pid\":";
+		if (evt.flags & EVENT_FLAG_GPU) {
+			out << "\"GPU\"";
+		} else {
+			out << pid;
+		}
+
+		if (evt.scope != NO_SCOPE) {
+			out << ",\"cat\":";
+			writeString(out, scopes[evt.scope]);
+			out << ",\"id\":\"0x" << std::hex << evt.scope << std::dec << "\"";
+		}
+
+		out << ",\"name\":";
+		writeString(out, categories[evt.category]);
+		out << ",\"ph\":\"" << getTypeStr(evt.kind) << "\"";
+
+		if (evt.kind == EventKind::Complete) {
+			out << ",\"dur\":";
+			writeTime(out, evt.duration);
+		} else if (evt.kind == EventKind::Counter) {
+			auto flags = out.flags();
+			out << std::fixed;
+
+			out << ",\"args\": {\"value\": " << evt.value << "}";
+
+			out.flags(flags);
+		}
+
+		out << "}";
+
+		first_line = false;
+		++num_events;
+	}
+
+	bool convert(const std::vector<std::uint8_t>& data, std::ostream& out) {
+		if (!decode_header(data.data(), data.size(), &pid)) {
+			std::cerr << "Input is not a binary trace or was written by an incompatible version!" << std::endl;
+			return false;
+		}
+
+		out << "[";
+
+		size_t pos = FILE_HEADER_SIZE;
+		RecordType type;
+		name_record name;
+		event_record evt;
+
+		while (pos < data.size()) {
+			auto size = decode_record(data.data() + pos, data.size() - pos, &type, &name, &evt);
+
+			if (size == 0) {
+				// The game probably crashed while writing the trace, keep what we have
+				std::cerr << "Invalid or truncated record at offset " << pos << ", ignoring the rest of the trace."
+				          << std::endl;
+				break;
+			}
+
+			if (type == RecordType::Name) {
+				auto& names = (name.kind == NameKind::Category) ? categories : scopes;
+				names[name.id] = name.name;
+			} else {
+				writeEvent(out, evt);
+			}
+
+			pos += size;
+		}
+
+		out << "]\n";
+
+		return true;
+	}
+};
+
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2 || argc > 3) {
+		std::cerr << "Usage: " << argv[0] << " <trace.fstrace> [trace.json]" << std::endl;
+		return 1;
+	}
+
+	std::string input_name = argv[1];
+	std::string output_name;
+
+	if (argc == 3) {
+		output_name = argv[2];
+	} else {
+		output_name = input_name;
+
+		auto dot = output_name.rfind('.');
+		if (dot != std::string::npos) {
+			output_name.erase(dot);
+		}
+		output_name += ".json";
+	}
+
+	std::ifstream in(input_name, std::ios::binary);
+	if (!in) {
+		std::cerr << "Could not open " << input_name << "!" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+
+	std::ofstream out(output_name);
+	if (!out) {
+		std::cerr << "Could not open " << output_name << " for writing!" << std::endl;
+		return 1;
+	}
+
+	converter conv;
+	if (!conv.convert(data, out)) {
+		return 1;
+	}
+
+	std::cout << "Wrote " << conv.num_events << " events to " << output_name << " (" << conv.num_discarded
+	          << " events shorter than a microsecond discarded)" << std::endl;
+
+	return 0;
+}